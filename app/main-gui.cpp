@@ -3,9 +3,22 @@
 
 #include "../ui/window.h"
 #include "../core/audio/audio-engine.h"
+#include "../core/audio/audio-history.h"
+#include "../core/audio/audio-recorder.h"
+#include "../core/audio/meter-exporter.h"
+#include "../core/audio/meter-logger.h"
+#include "../core/audio/wasapi-capture.h"
 #include "../common/logger.h"
 #include "../common/config.h"
+#include "../common/file-watcher.h"
+#include "../common/trace.h"
 #include <windows.h>
+#include <algorithm>
+#include <chrono>
+#include <ctime>
+#include <iomanip>
+#include <memory>
+#include <sstream>
 
 using namespace openmeters;
 
@@ -28,6 +41,11 @@ public:
         (void)format;
     }
     
+    bool onAudioBlock(const core::audio::AudioBlock& block) override {
+        (void)block;
+        return true; // Meters only: no float copy needed
+    }
+    
     void onMeterData(const common::MeterSnapshot& snapshot) override {
         if (m_window) {
             m_window->updateMeters(snapshot);
@@ -45,15 +63,30 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine
     try {
         // Initialize logger
         std::string logPath = "logs/openmeters.log";
-        if (!common::Logger::initialize(logPath, common::LogLevel::Info, true)) {
+        if (!common::Logger::initialize(logPath, common::LogLevel::Info, true, common::LogMode::Asynchronous)) {
             MessageBoxA(nullptr, "Failed to initialize logger", "OpenMeters Error", MB_OK | MB_ICONERROR);
             return 1;
         }
         
         LOG_INFO("OpenMeters starting...");
         
-        // Load configuration
+        // Load configuration and reload it whenever the file is edited
         common::ConfigManager::load();
+        common::FileWatcher configWatcher;
+        configWatcher.start(common::ConfigManager::configPath(), [] { common::ConfigManager::reload(); });
+        
+        // Crash-safe binary log (decode with omlog_decode)
+        const common::AppConfig startupConfig = common::ConfigManager::config();
+        if (!startupConfig.binaryLogPath.empty()) {
+            common::Logger::openBinaryLog(startupConfig.binaryLogPath,
+                static_cast<std::size_t>(std::max(64, startupConfig.binaryLogSizeKB)) * 1024);
+        }
+        
+        // Hot-path tracing (exported as Chrome/Perfetto JSON on exit)
+        const std::string perfTracePath = startupConfig.perfTracePath;
+        if (!perfTracePath.empty()) {
+            common::trace::enable();
+        }
         
         // Create window
         ui::Window window;
@@ -64,8 +97,11 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine
             return 1;
         }
         
-        // Create audio engine
-        core::audio::AudioEngine engine;
+        // Create audio engine (optionally recording a capture trace for replay)
+        auto capture = std::make_unique<core::audio::WasapiCapture>();
+        capture->setTraceRecording(startupConfig.captureTracePath);
+        core::audio::AudioEngine engine(std::move(capture));
+        engine.setStatsLogInterval(std::chrono::seconds(std::max(0, startupConfig.statsLogInterval)));
         bool audioAvailable = engine.initialize();
         if (!audioAvailable) {
             LOG_WARNING("Audio engine failed to initialize. Meters will show zero until audio is available.");
@@ -80,10 +116,45 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine
         }
         
         GuiCallback callback(&window);
+        window.setAudioEngine(&engine);
+        
+        // Look-back audio for "Save History" and over dumps
+        core::audio::AudioHistory history;
+        if (audioAvailable && startupConfig.historySeconds > 0.0f &&
+            history.reserve(startupConfig.historySeconds, engine.getFormat())) {
+            engine.registerCallback(&history);
+            window.setAudioHistory(&history);
+        }
+        
+        // Record button (idle until started)
+        core::audio::AudioRecorder recorder;
+        if (audioAvailable && recorder.reserve(startupConfig.recordingBufferSeconds, engine.getFormat())) {
+            engine.registerCallback(&recorder);
+            window.setAudioRecorder(&recorder);
+        }
+        
+        // Long-running meter archive (convert with ommeter_csv)
+        core::audio::MeterLogger meterLogger;
+        if (audioAvailable && !startupConfig.meterLogDir.empty()) {
+            const std::time_t now = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+            std::ostringstream name;
+            name << startupConfig.meterLogDir << "/meters-" << std::put_time(std::localtime(&now), "%Y%m%d-%H%M%S") << ".ommeter";
+            if (meterLogger.start(name.str(), static_cast<std::uint32_t>(std::max(0, startupConfig.meterLogIntervalMs)),
+                                  static_cast<std::uint32_t>(std::max(1, startupConfig.meterLogFlushSeconds)))) {
+                engine.registerCallback(&meterLogger);
+            }
+        }
+        
+        // Live meters for other processes (read with client/openmeters-shm.h)
+        core::audio::MeterExporter exporter;
+        if (audioAvailable && !startupConfig.meterExportName.empty() &&
+            exporter.open(startupConfig.meterExportName, engine.getFormat())) {
+            engine.registerCallback(&exporter);
+        }
         
         if (audioAvailable) {
-            LOG_INFO("Audio format: " + std::to_string(engine.getFormat().sampleRate) + " Hz, " +
-                     std::to_string(engine.getFormat().channelCount) + " channel(s)");
+            LOG_INFO("Audio format: {} Hz, {} channel(s)",
+                     engine.getFormat().sampleRate, engine.getFormat().channelCount);
             
             // Register callback
             engine.registerCallback(&callback);
@@ -102,11 +173,32 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine
         // Cleanup
         LOG_INFO("Shutting down...");
         engine.stop();
+        if (audioAvailable) {
+            LOG_INFO(core::audio::formatEngineStats(engine.getStats()));
+        }
         engine.unregisterCallback(&callback);
+        engine.unregisterCallback(&history);
+        engine.unregisterCallback(&recorder);
+        engine.unregisterCallback(&meterLogger);
+        engine.unregisterCallback(&exporter);
+        recorder.stop();
+        meterLogger.stop();
+        exporter.close();
         engine.shutdown();
         window.shutdown();
         
+        if (!perfTracePath.empty()) {
+            common::trace::disable();
+            const long long events = common::trace::exportChromeTrace(perfTracePath);
+            if (events < 0) {
+                LOG_WARNING("Failed to write performance trace: {}", perfTracePath);
+            } else {
+                LOG_INFO("Wrote {} trace events to {}", events, perfTracePath);
+            }
+        }
+        
         // Save configuration
+        configWatcher.stop();
         common::ConfigManager::save();
         
         common::Logger::shutdown();
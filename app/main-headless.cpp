@@ -0,0 +1,507 @@
+// Headless metering daemon (openmetersd): the engine and its exporters
+// without a window, for servers and containers. Runs until SIGINT/SIGTERM
+// (Ctrl+C or console close on Windows); SIGHUP or editing the config file
+// re-applies the exporter settings.
+
+#include "../core/audio/audio-engine.h"
+#include "../core/audio/audio-history.h"
+#include "../core/audio/audio-recorder.h"
+#include "../core/audio/meter-exporter.h"
+#include "../core/audio/meter-logger.h"
+#include "../core/audio/replay-source.h"
+#include "../core/audio/stream-source.h"
+#include "../core/audio/synthetic-source.h"
+#include "../common/logger.h"
+#include "../common/config.h"
+#include "../common/file-watcher.h"
+#include "../common/trace.h"
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <ctime>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#ifdef _WIN32
+#include "../core/audio/wasapi-capture.h"
+#include <windows.h>
+#else
+#include <csignal>
+#include <pthread.h>
+#include <signal.h>
+#include <unistd.h>
+#endif
+
+using namespace openmeters;
+
+namespace {
+
+// While capturing, how often the main thread checks whether the source ended
+constexpr auto kSourceCheckInterval = std::chrono::seconds(1);
+
+// Audio kept on either side of an over in automatic dumps
+constexpr double kOverDumpMarginSeconds = 2.0;
+
+/**
+ * Shutdown and reload requests from signals, the console handler and the
+ * config file watcher. The main thread sleeps on it.
+ */
+class ControlEvents {
+public:
+    void requestQuit() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_quit = true;
+        }
+        m_wake.notify_all();
+    }
+
+    void requestReload() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_reload = true;
+        }
+        m_wake.notify_all();
+    }
+
+    /**
+     * Wait for a request (forever if timeout is zero).
+     *
+     * @return false once quit was requested; reload is set if a reload was
+     */
+    bool wait(std::chrono::milliseconds timeout, bool& reload) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        const auto pending = [this] { return m_quit || m_reload; };
+        if (timeout.count() == 0) {
+            m_wake.wait(lock, pending);
+        } else {
+            m_wake.wait_for(lock, timeout, pending);
+        }
+        reload = m_reload;
+        m_reload = false;
+        return !m_quit;
+    }
+
+private:
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    bool m_quit = false;
+    bool m_reload = false;
+};
+
+ControlEvents g_events;
+
+#ifdef _WIN32
+
+// Windows ends the process once the handler returns from a close, logoff
+// or shutdown event (and anyway after about 5 s)
+constexpr DWORD kCloseWaitMs = 4000;
+
+// Set by the main thread once the exporters are closed and the log flushed
+HANDLE g_shutdownDone = nullptr;
+
+BOOL WINAPI consoleHandler(DWORD type) {
+    g_events.requestQuit();
+    if (type == CTRL_CLOSE_EVENT || type == CTRL_LOGOFF_EVENT || type == CTRL_SHUTDOWN_EVENT) {
+        WaitForSingleObject(g_shutdownDone, kCloseWaitMs);
+    }
+    return TRUE;
+}
+
+#endif
+
+/**
+ * Settings that decide which exporters run. Everything else (ballistics,
+ * thresholds, dump directories) is read live from the config snapshot.
+ */
+struct ConsumerSettings {
+    std::string meterLogDir;
+    int meterLogIntervalMs = 0;
+    int meterLogFlushSeconds = 0;
+    std::string meterExportName;
+    bool record = false;
+    std::string recordingDir;
+    std::string recordingFormat;
+    float recordingBufferSeconds = 0.0f;
+    bool historyDumpOnOver = false;
+    float historySeconds = 0.0f;
+
+    explicit ConsumerSettings(const common::AppConfig& config)
+        : meterLogDir(config.meterLogDir)
+        , meterLogIntervalMs(config.meterLogIntervalMs)
+        , meterLogFlushSeconds(config.meterLogFlushSeconds)
+        , meterExportName(config.meterExportName)
+        , record(config.headlessRecord)
+        , recordingDir(config.recordingDir)
+        , recordingFormat(config.recordingFormat)
+        , recordingBufferSeconds(config.recordingBufferSeconds)
+        , historyDumpOnOver(config.historyDumpOnOver)
+        , historySeconds(config.historySeconds)
+    {
+    }
+
+    bool operator==(const ConsumerSettings&) const = default;
+};
+
+std::string timestampedPath(const std::string& dir, const char* prefix, const char* extension) {
+    const std::time_t now = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+    std::ostringstream name;
+    name << dir << "/" << prefix << std::put_time(std::localtime(&now), "%Y%m%d-%H%M%S") << extension;
+    return name.str();
+}
+
+core::audio::SampleFormat parseSampleFormat(const std::string& name) {
+    if (name == "float32") return core::audio::SampleFormat::Float32;
+    if (name == "float64") return core::audio::SampleFormat::Float64;
+    if (name == "int32")   return core::audio::SampleFormat::Int32;
+    if (name == "int24")   return core::audio::SampleFormat::Int24Packed;
+    if (name == "int16")   return core::audio::SampleFormat::Int16;
+    return core::audio::SampleFormat::Unknown;
+}
+
+/**
+ * Build the configured audio source.
+ */
+std::unique_ptr<core::audio::IAudioSource> makeSource(const std::string& spec, const common::AppConfig& config) {
+    if (spec == "synthetic") {
+        return std::make_unique<core::audio::SyntheticSource>();
+    }
+#ifdef _WIN32
+    if (spec == "wasapi") {
+        auto capture = std::make_unique<core::audio::WasapiCapture>();
+        capture->setTraceRecording(config.captureTracePath);
+        return capture;
+    }
+#endif
+    if (spec.rfind("replay:", 0) == 0) {
+        core::audio::ReplaySourceConfig replay;
+        replay.tracePath = spec.substr(7);
+        replay.loop = config.headlessLoop;
+        return std::make_unique<core::audio::ReplaySource>(replay);
+    }
+
+    core::audio::StreamSourceConfig stream;
+    stream.path = spec;
+    stream.format.sampleRate = static_cast<common::SampleRate>(std::max(0, config.headlessSampleRate));
+    stream.format.channelCount = static_cast<common::ChannelCount>(std::clamp(config.headlessChannels, 0, 255));
+    stream.sampleFormat = parseSampleFormat(config.headlessRawFormat);
+    stream.loop = config.headlessLoop;
+    return std::make_unique<core::audio::StreamSource>(stream);
+}
+
+/**
+ * The exporters attached to the engine. Without any, the daemon stops
+ * the engine and sleeps until the configuration changes.
+ */
+class Consumers {
+public:
+    explicit Consumers(core::audio::AudioEngine& engine) : m_engine(engine) {}
+
+    ~Consumers() {
+        detach();
+    }
+
+    /**
+     * Create and register the exporters the settings ask for.
+     *
+     * @return Number of exporters attached
+     */
+    std::size_t attach(const ConsumerSettings& settings) {
+        const common::AudioFormat format = m_engine.getFormat();
+
+        if (settings.historyDumpOnOver && settings.historySeconds > 0.0f) {
+            m_history = std::make_unique<core::audio::AudioHistory>();
+            if (m_history->reserve(settings.historySeconds, format)) {
+                m_engine.registerCallback(m_history.get());
+            } else {
+                m_history.reset();
+            }
+        }
+
+        if (settings.record) {
+            m_recorder = std::make_unique<core::audio::AudioRecorder>();
+            const std::string path = timestampedPath(settings.recordingDir, "recording-", ".wav");
+            // start() logs the path or the failure itself
+            if (!m_recorder->reserve(settings.recordingBufferSeconds, format)) {
+                LOG_ERROR("Failed to allocate a {} s recording buffer", settings.recordingBufferSeconds);
+                m_recorder.reset();
+            } else if (m_recorder->start(path, parseSampleFormat(settings.recordingFormat))) {
+                m_engine.registerCallback(m_recorder.get());
+            } else {
+                m_recorder.reset();
+            }
+        }
+
+        if (!settings.meterLogDir.empty()) {
+            m_meterLogger = std::make_unique<core::audio::MeterLogger>();
+            if (m_meterLogger->start(timestampedPath(settings.meterLogDir, "meters-", ".ommeter"),
+                                     static_cast<std::uint32_t>(std::max(0, settings.meterLogIntervalMs)),
+                                     static_cast<std::uint32_t>(std::max(1, settings.meterLogFlushSeconds)))) {
+                m_engine.registerCallback(m_meterLogger.get());
+            } else {
+                m_meterLogger.reset();
+            }
+        }
+
+        if (!settings.meterExportName.empty()) {
+            m_exporter = std::make_unique<core::audio::MeterExporter>();
+            if (m_exporter->open(settings.meterExportName, format)) {
+                m_engine.registerCallback(m_exporter.get());
+            } else {
+                m_exporter.reset();
+            }
+        }
+
+        return (m_history ? 1 : 0) + (m_recorder ? 1 : 0) + (m_meterLogger ? 1 : 0) + (m_exporter ? 1 : 0);
+    }
+
+    /**
+     * Unregister and close every exporter (the engine must be stopped).
+     */
+    void detach() {
+        if (m_history) {
+            m_engine.unregisterCallback(m_history.get());
+            m_history->endStream(); // The engine is stopped: write what is held
+            m_history->waitForDumps();
+            m_history.reset();
+        }
+        if (m_recorder) {
+            m_engine.unregisterCallback(m_recorder.get());
+            m_recorder->stop();
+            m_recorder.reset();
+        }
+        if (m_meterLogger) {
+            m_engine.unregisterCallback(m_meterLogger.get());
+            m_meterLogger->stop();
+            m_meterLogger.reset();
+        }
+        if (m_exporter) {
+            m_engine.unregisterCallback(m_exporter.get());
+            m_exporter->close();
+            m_exporter.reset();
+        }
+        m_overDumpEnd = 0; // Positions restart with the next history
+    }
+
+    /**
+     * Dump the audio around new overs (one file for overs close together).
+     */
+    void dumpOvers(std::uint64_t& cursor) {
+        common::OverEvent events[64];
+        while (const std::size_t count = m_engine.readOverEvents(cursor, events, 64, nullptr)) {
+            if (!m_history) {
+                continue;
+            }
+            const std::string dir = common::ConfigManager::config().historyDumpDir;
+            const auto margin = static_cast<std::uint64_t>(kOverDumpMarginSeconds * m_history->format().sampleRate);
+            for (std::size_t i = 0; i < count; ++i) {
+                if (events[i].position < m_overDumpEnd) {
+                    continue;
+                }
+                const std::uint64_t start = events[i].position > margin ? events[i].position - margin : 0;
+                m_history->requestDump(dir + "/over-" + std::to_string(events[i].position) + ".wav",
+                                       start, static_cast<std::size_t>(events[i].position + margin - start));
+                m_overDumpEnd = events[i].position + margin;
+            }
+        }
+    }
+
+private:
+    core::audio::AudioEngine& m_engine;
+    std::unique_ptr<core::audio::AudioHistory> m_history;
+    std::unique_ptr<core::audio::AudioRecorder> m_recorder;
+    std::unique_ptr<core::audio::MeterLogger> m_meterLogger;
+    std::unique_ptr<core::audio::MeterExporter> m_exporter;
+    std::uint64_t m_overDumpEnd = 0;
+};
+
+void printUsage() {
+    std::cout << "Usage: openmetersd [--config FILE] [--source SPEC]\n"
+                 "\n"
+                 "  --config FILE  Configuration file (default: the application config)\n"
+                 "  --source SPEC  Overrides headlessSource: synthetic, "
+#ifdef _WIN32
+                 "wasapi, "
+#endif
+                 "replay:TRACE,\n"
+                 "                 or a WAV/raw PCM file, a FIFO, or - for stdin\n"
+                 "\n"
+                 "Runs until SIGINT or SIGTERM. SIGHUP (or editing the config file)\n"
+                 "re-applies the exporter settings.\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::string configPath;
+    std::string sourceOverride;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--config") == 0 && i + 1 < argc) {
+            configPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--source") == 0 && i + 1 < argc) {
+            sourceOverride = argv[++i];
+        } else {
+            printUsage();
+            return std::strcmp(argv[i], "--help") == 0 ? 0 : 2;
+        }
+    }
+
+#ifndef _WIN32
+    // Signals are taken synchronously by one thread; every thread started
+    // from here on inherits the mask, so none of them is interrupted
+    sigset_t signals;
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGINT);
+    sigaddset(&signals, SIGTERM);
+    sigaddset(&signals, SIGHUP);
+    pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+    std::signal(SIGPIPE, SIG_IGN);
+#endif
+
+    if (!common::Logger::initialize("logs/openmetersd.log", common::LogLevel::Info, true, common::LogMode::Asynchronous)) {
+        std::cerr << "Failed to initialize logger\n";
+        return 1;
+    }
+    LOG_INFO("OpenMeters daemon starting...");
+
+    if (configPath.empty()) {
+        common::ConfigManager::load();
+    } else if (!common::ConfigManager::load(configPath)) {
+        LOG_WARNING("Could not read {}; using defaults", configPath);
+    }
+
+    // Reload on edit; the main thread re-applies the exporter settings
+    common::FileWatcher configWatcher;
+    configWatcher.start(common::ConfigManager::configPath(), [] {
+        common::ConfigManager::reload();
+        g_events.requestReload();
+    });
+
+    const common::AppConfig startupConfig = common::ConfigManager::config();
+    if (!startupConfig.binaryLogPath.empty()) {
+        common::Logger::openBinaryLog(startupConfig.binaryLogPath,
+            static_cast<std::size_t>(std::max(64, startupConfig.binaryLogSizeKB)) * 1024);
+    }
+
+    const std::string perfTracePath = startupConfig.perfTracePath;
+    if (!perfTracePath.empty()) {
+        common::trace::enable();
+    }
+
+    // The source is fixed for the life of the process
+    const std::string sourceSpec = sourceOverride.empty() ? startupConfig.headlessSource : sourceOverride;
+    core::audio::AudioEngine engine(makeSource(sourceSpec, startupConfig));
+    engine.setStatsLogInterval(std::chrono::seconds(std::max(0, startupConfig.statsLogInterval)));
+    if (!engine.initialize()) {
+        LOG_ERROR("Failed to initialize audio source: {}", sourceSpec);
+        configWatcher.stop();
+        common::Logger::shutdown();
+        return 1;
+    }
+    LOG_INFO("Source {}: {} Hz, {} channel(s)", sourceSpec, engine.getFormat().sampleRate, engine.getFormat().channelCount);
+
+#ifdef _WIN32
+    g_shutdownDone = CreateEventA(nullptr, TRUE, FALSE, nullptr);
+    SetConsoleCtrlHandler(consoleHandler, TRUE);
+#else
+    std::thread signalThread([&signals] {
+        for (;;) {
+            int signal = 0;
+            if (sigwait(&signals, &signal) != 0) {
+                continue;
+            }
+            if (signal == SIGHUP) {
+                common::ConfigManager::reload();
+                g_events.requestReload();
+                continue;
+            }
+            g_events.requestQuit();
+            return;
+        }
+    });
+#endif
+
+    Consumers consumers(engine);
+    ConsumerSettings applied(startupConfig);
+    std::uint64_t overCursor = 0;
+    bool running = false;
+
+    const auto apply = [&](const ConsumerSettings& settings) {
+        if (running) {
+            engine.stop();
+            running = false;
+            // Overs not yet read belong to the outgoing history; positions
+            // start again from zero once the engine restarts
+            consumers.dumpOvers(overCursor);
+        }
+        consumers.detach();
+        applied = settings;
+
+        if (consumers.attach(settings) == 0) {
+            // Nothing would read the meters: leave the source stopped
+            LOG_INFO("No exporters configured; idle until the configuration changes");
+            return;
+        }
+        running = engine.start();
+        if (!running) {
+            LOG_ERROR("Failed to start audio source: {}", sourceSpec);
+        }
+    };
+    apply(applied);
+
+    bool reload = false;
+    while (g_events.wait(running ? std::chrono::milliseconds(kSourceCheckInterval) : std::chrono::milliseconds(0), reload)) {
+        if (reload) {
+            const ConsumerSettings settings(common::ConfigManager::config());
+            if (!(settings == applied)) {
+                LOG_INFO("Exporter settings changed; re-applying");
+                apply(settings);
+            }
+        }
+        if (running) {
+            consumers.dumpOvers(overCursor);
+            if (!engine.isCapturing()) {
+                LOG_INFO("Audio source ended");
+                break;
+            }
+        }
+    }
+
+    LOG_INFO("Shutting down...");
+    engine.stop();
+    LOG_INFO(core::audio::formatEngineStats(engine.getStats()));
+    consumers.detach();
+    engine.shutdown();
+
+#ifndef _WIN32
+    // The signal thread is still in sigwait if the source ended on its own
+    if (signalThread.joinable()) {
+        pthread_kill(signalThread.native_handle(), SIGTERM);
+        signalThread.join();
+    }
+#endif
+
+    if (!perfTracePath.empty()) {
+        common::trace::disable();
+        const long long events = common::trace::exportChromeTrace(perfTracePath);
+        if (events < 0) {
+            LOG_WARNING("Failed to write performance trace: {}", perfTracePath);
+        } else {
+            LOG_INFO("Wrote {} trace events to {}", events, perfTracePath);
+        }
+    }
+
+    configWatcher.stop();
+    common::Logger::shutdown();
+#ifdef _WIN32
+    // Lets a console handler waiting on a close event return
+    SetEvent(g_shutdownDone);
+#endif
+    return 0;
+}
@@ -9,6 +9,8 @@
 #include "../common/meter-values.h"
 #include "../common/logger.h"
 #include "../common/config.h"
+#include "../common/file-watcher.h"
+#include <algorithm>
 #include <iostream>
 #include <iomanip>
 #include <chrono>
@@ -33,6 +35,11 @@ public:
         (void)format;
     }
     
+    bool onAudioBlock(const core::audio::AudioBlock& block) override {
+        (void)block;
+        return true; // Meters only: no float copy needed
+    }
+    
     void onMeterData(const common::MeterSnapshot& snapshot) override {
         // Print meter values
         std::cout << "\rPeak L: " << std::fixed << std::setprecision(3) << snapshot.peak.left
@@ -46,12 +53,21 @@ public:
 int main() {
     // Initialize logger
     std::string logPath = "logs/openmeters.log";
-    common::Logger::initialize(logPath, common::LogLevel::Info, true);
+    common::Logger::initialize(logPath, common::LogLevel::Info, true, common::LogMode::Asynchronous);
     
     LOG_INFO("OpenMeters starting (console mode)...");
     
-    // Load configuration
+    // Load configuration and reload it whenever the file is edited
     common::ConfigManager::load();
+    common::FileWatcher configWatcher;
+    configWatcher.start(common::ConfigManager::configPath(), [] { common::ConfigManager::reload(); });
+    
+    // Crash-safe binary log (decode with omlog_decode)
+    const common::AppConfig startupConfig = common::ConfigManager::config();
+    if (!startupConfig.binaryLogPath.empty()) {
+        common::Logger::openBinaryLog(startupConfig.binaryLogPath,
+            static_cast<std::size_t>(std::max(64, startupConfig.binaryLogSizeKB)) * 1024);
+    }
     
     std::cout << "OpenMeters - Audio Metering Test\n";
     std::cout << "================================\n\n";
@@ -108,6 +124,7 @@ int main() {
     engine.shutdown();
     
     // Save configuration
+    configWatcher.stop();
     common::ConfigManager::save();
     
     std::cout << "Shutdown complete.\n";
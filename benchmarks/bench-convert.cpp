@@ -0,0 +1,73 @@
+#include "bench-harness.h"
+#include "../core/audio/format-convert.h"
+
+namespace openmeters::bench {
+
+namespace {
+
+using core::audio::SampleFormat;
+
+struct FormatCase {
+    const char* name;
+    SampleFormat format;
+};
+
+constexpr FormatCase kFormats[] = {
+    {"int16", SampleFormat::Int16},
+    {"int24", SampleFormat::Int24Packed},
+    {"int32", SampleFormat::Int32},
+    {"float64", SampleFormat::Float64},
+};
+
+void runConvertCase(Runner& runner, const FormatCase& formatCase, std::size_t frames, std::size_t channels, bool aligned) {
+    const std::size_t samples = frames * channels;
+    const std::size_t sampleBytes = core::audio::bytesPerSample(formatCase.format);
+    // Unaligned: both buffers start one sample past a 64-byte boundary
+    const std::size_t offset = aligned ? 0 : sampleBytes;
+
+    std::vector<float> source(samples);
+    fillNoise(source.data(), samples);
+    SignalBuffer<std::uint8_t> native(samples * sampleBytes + offset, true);
+    SignalBuffer<float> floats(samples, aligned);
+    std::uint8_t* nativeData = native.data() + offset;
+    float* floatData = floats.data();
+    core::audio::convertFromFloat32(source.data(), nativeData, formatCase.format, samples);
+
+    const nlohmann::json params = {
+        {"format", formatCase.name},
+        {"frames", frames},
+        {"channels", channels},
+        {"aligned", aligned}
+    };
+
+    runner.run("convertToFloat32", params, frames, [&] {
+        core::audio::convertToFloat32(nativeData, formatCase.format, floatData, samples);
+        doNotOptimize(floatData[0]);
+    });
+
+    if (formatCase.format == SampleFormat::Float64) {
+        return; // Capture path only converts to float
+    }
+
+    std::copy(source.begin(), source.end(), floatData);
+    runner.run("convertFromFloat32", params, frames, [&] {
+        core::audio::convertFromFloat32(floatData, nativeData, formatCase.format, samples);
+        doNotOptimize(nativeData[0]);
+    });
+}
+
+} // namespace
+
+void runConvertBenchmarks(Runner& runner) {
+    for (const FormatCase& formatCase : kFormats) {
+        for (const std::size_t frames : kFrameSizes) {
+            for (const std::size_t channels : {1u, 2u}) {
+                for (const bool aligned : {true, false}) {
+                    runConvertCase(runner, formatCase, frames, channels, aligned);
+                }
+            }
+        }
+    }
+}
+
+} // namespace openmeters::bench
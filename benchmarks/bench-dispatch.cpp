@@ -0,0 +1,112 @@
+#include "bench-harness.h"
+#include "../core/audio/callback-dispatcher.h"
+#include "../core/audio/format-convert.h"
+#include <memory>
+#include <mutex>
+
+namespace openmeters::bench {
+
+namespace {
+
+using core::audio::SampleFormat;
+
+constexpr std::size_t kConsumerCounts[] = {1, 2, 4, 8};
+
+// Float consumer doing minimal work, so the cost measured is the fan-out
+class FloatConsumer : public core::audio::IAudioDataCallback {
+public:
+    void onAudioData(const float* buffer, std::size_t frameCount, const common::AudioFormat& format) override {
+        m_last = buffer[frameCount * format.samplesPerFrame() - 1];
+    }
+
+    void onMeterData(const common::MeterSnapshot&) override {}
+
+    float m_last = 0.0f;
+};
+
+// Mirrors Window::updateMeters: copy the snapshot under a mutex
+class SnapshotConsumer : public core::audio::IAudioDataCallback {
+public:
+    void onAudioData(const float*, std::size_t, const common::AudioFormat&) override {}
+
+    void onMeterData(const common::MeterSnapshot& snapshot) override {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_snapshot = snapshot;
+    }
+
+private:
+    std::mutex m_mutex;
+    common::MeterSnapshot m_snapshot;
+};
+
+void runFanOut(Runner& runner, const char* formatName, SampleFormat format, std::size_t frames, std::size_t consumers) {
+    common::AudioFormat audioFormat;
+    const std::size_t samples = frames * audioFormat.samplesPerFrame();
+
+    std::vector<float> source(samples);
+    fillNoise(source.data(), samples);
+    SignalBuffer<std::uint8_t> native(samples * core::audio::bytesPerSample(format), true);
+    core::audio::convertFromFloat32(source.data(), native.data(), format, samples);
+
+    std::vector<std::unique_ptr<FloatConsumer>> callbacks;
+    core::audio::CallbackDispatcher dispatcher;
+    for (std::size_t i = 0; i < consumers; ++i) {
+        callbacks.push_back(std::make_unique<FloatConsumer>());
+        dispatcher.add(callbacks.back().get());
+    }
+
+    common::BufferPool pool;
+    pool.reserve(samples * sizeof(float) + common::BufferPool::kDefaultAlignment);
+
+    core::audio::AudioBlock block;
+    block.data = native.data();
+    block.sampleFormat = format;
+    block.frameCount = frames;
+    block.format = audioFormat;
+
+    const nlohmann::json params = {
+        {"format", formatName},
+        {"frames", frames},
+        {"channels", audioFormat.channelCount},
+        {"consumers", consumers}
+    };
+    runner.run("fanOut", params, frames, [&] {
+        pool.reset();
+        doNotOptimize(dispatcher.dispatchBlock(block, pool));
+    });
+}
+
+void runSnapshotPublish(Runner& runner, std::size_t consumers) {
+    std::vector<std::unique_ptr<SnapshotConsumer>> callbacks;
+    core::audio::CallbackDispatcher dispatcher;
+    for (std::size_t i = 0; i < consumers; ++i) {
+        callbacks.push_back(std::make_unique<SnapshotConsumer>());
+        dispatcher.add(callbacks.back().get());
+    }
+
+    common::MeterSnapshot snapshot;
+    snapshot.peak.left = 0.5f;
+    snapshot.rms.left = 0.25f;
+
+    runner.run("publishSnapshot", {{"consumers", consumers}}, 1, [&] {
+        ++snapshot.timestampMs;
+        dispatcher.dispatchMeterData(snapshot);
+    });
+}
+
+} // namespace
+
+void runDispatchBenchmarks(Runner& runner) {
+    for (const std::size_t frames : kFrameSizes) {
+        for (const std::size_t consumers : kConsumerCounts) {
+            runFanOut(runner, "float32", SampleFormat::Float32, frames, consumers);
+            runFanOut(runner, "int16", SampleFormat::Int16, frames, consumers);
+        }
+    }
+
+    for (const std::size_t consumers : kConsumerCounts) {
+        runSnapshotPublish(runner, consumers);
+    }
+}
+
+} // namespace openmeters::bench
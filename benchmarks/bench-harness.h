@@ -0,0 +1,180 @@
+#pragma once
+
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace openmeters::bench {
+
+/**
+ * Keep a value alive so the optimizer cannot drop the computation producing it.
+ */
+template <typename T>
+inline void doNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const void* sink;
+    sink = &value;
+#endif
+}
+
+/**
+ * Byte buffer holding count elements of T, starting on a 64-byte boundary
+ * or deliberately one element past it (unaligned case).
+ */
+template <typename T>
+class SignalBuffer {
+public:
+    SignalBuffer(std::size_t count, bool aligned)
+        : m_storage((count + 1) * sizeof(T) + kAlignment)
+    {
+        const auto base = reinterpret_cast<std::uintptr_t>(m_storage.data());
+        const std::uintptr_t alignedBase = (base + kAlignment - 1) & ~(kAlignment - 1);
+        m_data = reinterpret_cast<T*>(alignedBase) + (aligned ? 0 : 1);
+    }
+
+    [[nodiscard]] T* data() noexcept { return m_data; }
+
+private:
+    static constexpr std::size_t kAlignment = 64;
+
+    std::vector<std::uint8_t> m_storage;
+    T* m_data = nullptr;
+};
+
+/**
+ * Deterministic noise in [-amplitude, amplitude] (xorshift; identical across runs).
+ */
+inline void fillNoise(float* dest, std::size_t count, float amplitude = 0.9f) {
+    std::uint32_t state = 0x12345678u;
+    for (std::size_t i = 0; i < count; ++i) {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        const float unit = static_cast<float>(state >> 8) * (1.0f / 8388608.0f); // [0, 2)
+        dest[i] = (unit - 1.0f) * amplitude;
+    }
+}
+
+/**
+ * Buffer sizes swept by the frame-based benchmarks.
+ */
+inline constexpr std::size_t kFrameSizes[] = {32, 128, 512, 2048, 8192};
+
+/**
+ * Minimal benchmark runner with JSON output.
+ * Each case is calibrated to run for at least minTime per repetition; the
+ * median of the repetitions is reported.
+ */
+class Runner {
+public:
+    struct Options {
+        std::string filter;                              // Substring match on the case name
+        std::chrono::milliseconds minTime{20};           // Per repetition
+        int repetitions = 5;
+        std::string tracePath;                           // Capture trace for replay (empty = generated)
+        std::chrono::milliseconds latencyTime{0};        // Headless capture-to-display run (0 = skip)
+    };
+
+    explicit Runner(const Options& options) : m_options(options) {}
+
+    /**
+     * Run one benchmark case.
+     *
+     * @param name Benchmark family (e.g. "peakMeter/float32")
+     * @param params Sweep parameters (frames, channels, aligned, ...)
+     * @param itemsPerIteration Frames (or messages) processed per call of body
+     * @param body Work for one iteration
+     */
+    template <typename Fn>
+    void run(const std::string& name, const nlohmann::json& params, std::size_t itemsPerIteration, Fn&& body) {
+        const std::string id = caseId(name, params);
+        if (!m_options.filter.empty() && id.find(m_options.filter) == std::string::npos) {
+            return;
+        }
+
+        // Calibrate: grow the batch until one batch takes at least minTime
+        std::uint64_t iterations = 1;
+        for (;;) {
+            const double elapsedNs = timeBatch(iterations, body);
+            if (elapsedNs >= static_cast<double>(std::chrono::nanoseconds(m_options.minTime).count())) {
+                break;
+            }
+            iterations *= elapsedNs < 1e6 ? 10 : 2;
+        }
+
+        std::vector<double> samples;
+        for (int rep = 0; rep < m_options.repetitions; ++rep) {
+            samples.push_back(timeBatch(iterations, body) / static_cast<double>(iterations));
+        }
+        std::sort(samples.begin(), samples.end());
+        const double median = samples[samples.size() / 2];
+
+        nlohmann::json result;
+        result["name"] = id;
+        result["family"] = name;
+        result["params"] = params;
+        result["iterations"] = iterations;
+        result["nsPerOp"] = median;
+        result["nsPerItem"] = itemsPerIteration ? median / static_cast<double>(itemsPerIteration) : median;
+        result["minNsPerOp"] = samples.front();
+        m_results.push_back(std::move(result));
+
+        reportProgress(id, median);
+    }
+
+    /**
+     * Capture trace requested on the command line (may be empty).
+     */
+    [[nodiscard]] const std::string& tracePath() const noexcept { return m_options.tracePath; }
+    
+    /**
+     * Duration of the headless latency measurement (zero = skip).
+     */
+    [[nodiscard]] std::chrono::milliseconds latencyTime() const noexcept { return m_options.latencyTime; }
+    
+    /**
+     * Attach a non-timing report (wall-clock measurements) to the output
+     * under key; compare_bench.py ignores these.
+     */
+    void addReport(const std::string& key, nlohmann::json report) { m_reports[key] = std::move(report); }
+
+    /**
+     * All results plus build/host context, ready to write out.
+     */
+    [[nodiscard]] nlohmann::json toJson() const;
+
+private:
+    template <typename Fn>
+    static double timeBatch(std::uint64_t iterations, Fn& body) {
+        const auto start = std::chrono::steady_clock::now();
+        for (std::uint64_t i = 0; i < iterations; ++i) {
+            body();
+        }
+        const auto end = std::chrono::steady_clock::now();
+        return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+    }
+
+    static std::string caseId(const std::string& name, const nlohmann::json& params);
+    static void reportProgress(const std::string& id, double nsPerOp);
+
+    Options m_options;
+    std::vector<nlohmann::json> m_results;
+    nlohmann::json m_reports = nlohmann::json::object();
+};
+
+// Benchmark families (one translation unit each)
+void runMeterBenchmarks(Runner& runner);
+void runConvertBenchmarks(Runner& runner);
+void runDispatchBenchmarks(Runner& runner);
+void runReplayBenchmarks(Runner& runner);
+void runTraceBenchmarks(Runner& runner);
+void runLoggerBenchmarks(Runner& runner);
+void runLatencyMeasurement(Runner& runner);
+
+} // namespace openmeters::bench
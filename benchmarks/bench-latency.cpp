@@ -0,0 +1,92 @@
+#include "bench-harness.h"
+#include "../core/audio/audio-engine.h"
+#include "../core/audio/synthetic-source.h"
+#include <atomic>
+#include <cstdio>
+#include <memory>
+#include <thread>
+
+namespace openmeters::bench {
+
+namespace {
+
+// Stand-in for the GUI callback: keeps the capture time of the newest snapshot
+class LatestSnapshot : public core::audio::IAudioDataCallback {
+public:
+    void onAudioData(const float*, std::size_t, const common::AudioFormat&) override {}
+
+    void onMeterData(const common::MeterSnapshot& snapshot) override {
+        m_captureTimeNs.store(snapshot.captureTimeNs, std::memory_order_release);
+    }
+
+    std::atomic<std::uint64_t> m_captureTimeNs{0};
+};
+
+nlohmann::json toJson(const common::LatencyHistogram::Summary& summary) {
+    return {
+        {"count", summary.count},
+        {"p50Ns", summary.p50},
+        {"p90Ns", summary.p90},
+        {"p99Ns", summary.p99},
+        {"maxNs", summary.max}
+    };
+}
+
+} // namespace
+
+/**
+ * Capture-to-display latency of the portable pipeline: a paced synthetic
+ * source (10 ms packets, like WASAPI shared mode) feeds the engine, and a
+ * headless 60 Hz frame loop "presents" the newest snapshot. Excludes the
+ * device and the GPU; measures metering, fan-out and the hand-off to the
+ * renderer, including the wait for the next frame.
+ */
+void runLatencyMeasurement(Runner& runner) {
+    if (runner.latencyTime().count() <= 0) {
+        return;
+    }
+
+    core::audio::SyntheticSourceConfig config;
+    config.framesPerBlock = 480;
+    config.paced = true;
+
+    core::audio::AudioEngine engine(std::make_unique<core::audio::SyntheticSource>(config));
+    LatestSnapshot latest;
+    engine.registerCallback(&latest);
+    if (!engine.initialize() || !engine.start()) {
+        return;
+    }
+
+    constexpr auto kFramePeriod = std::chrono::microseconds(16667);
+    const auto end = std::chrono::steady_clock::now() + runner.latencyTime();
+    auto nextFrame = std::chrono::steady_clock::now();
+    std::uint64_t reported = 0;
+    while (std::chrono::steady_clock::now() < end) {
+        nextFrame += kFramePeriod;
+        std::this_thread::sleep_until(nextFrame);
+
+        const std::uint64_t captureTimeNs = latest.m_captureTimeNs.load(std::memory_order_acquire);
+        if (captureTimeNs != 0 && captureTimeNs != reported) {
+            engine.recordDisplayLatency(captureTimeNs);
+            reported = captureTimeNs;
+        }
+    }
+
+    engine.stop();
+    const auto stats = engine.getStats();
+    engine.shutdown();
+
+    runner.addReport("latency", {
+        {"framesPerPacket", config.framesPerBlock},
+        {"packets", stats.packets},
+        {"display", toJson(stats.display)},
+        {"fanOut", toJson(stats.fanOut)}
+    });
+    std::fprintf(stderr, "captureToDisplay: p50 %.2f ms, p99 %.2f ms, max %.2f ms (%llu frames)\n",
+        static_cast<double>(stats.display.p50) / 1e6,
+        static_cast<double>(stats.display.p99) / 1e6,
+        static_cast<double>(stats.display.max) / 1e6,
+        static_cast<unsigned long long>(stats.display.count));
+}
+
+} // namespace openmeters::bench
@@ -0,0 +1,45 @@
+#include "bench-harness.h"
+#include "../common/logger.h"
+#include <filesystem>
+
+namespace openmeters::bench {
+
+void runLoggerBenchmarks(Runner& runner) {
+    const auto path = std::filesystem::temp_directory_path() / "openmeters_bench.log";
+    std::uint64_t frames = 480;
+
+    for (const auto mode : {common::LogMode::Synchronous, common::LogMode::Asynchronous}) {
+        const bool async = mode == common::LogMode::Asynchronous;
+        if (!common::Logger::initialize(path.string(), common::LogLevel::Info, false, mode)) {
+            continue;
+        }
+
+        // Below the runtime level: one atomic load, arguments never evaluated
+        runner.run("logDebugDisabled", {{"async", async}}, 1, [&frames] {
+            LOG_DEBUG("packet of {} frames, peak {:.2f}", frames++, 0.5);
+        });
+
+        // Async: encode arguments and push (the writer drops what it cannot keep up with)
+        runner.run("logInfoFormatted", {{"async", async}}, 1, [&frames] {
+            LOG_INFO("packet of {} frames, peak {:.2f}", frames++, 0.5);
+        });
+
+        common::Logger::shutdown();
+        std::filesystem::remove(path);
+    }
+
+    // Binary ring sink alone: claim + memcpy into the mapped file
+    const auto ringPath = std::filesystem::temp_directory_path() / "openmeters_bench.omlog";
+    common::LogRing ring;
+    if (ring.open(ringPath.string())) {
+        runner.run("logRingWrite", {}, 1, [&ring, &frames] {
+            const common::LogArg args[] = {common::makeLogArg(frames++), common::makeLogArg(0.5)};
+            ring.write(1, 0, __FILE__, __LINE__, "packet of {} frames, peak {:.2f}", args, 2);
+        });
+        ring.close();
+    }
+    std::filesystem::remove(ringPath);
+    std::filesystem::remove(ringPath.string() + ".prev");
+}
+
+} // namespace openmeters::bench
@@ -0,0 +1,124 @@
+#include "bench-harness.h"
+#include "../core/audio/format-convert.h"
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+
+using namespace openmeters;
+
+namespace openmeters::bench {
+
+namespace {
+
+const char* simdLevelName(core::audio::SimdLevel level) {
+    switch (level) {
+        case core::audio::SimdLevel::Avx2: return "avx2";
+        case core::audio::SimdLevel::Sse2: return "sse2";
+        default:                           return "scalar";
+    }
+}
+
+std::string compilerId() {
+#if defined(__clang__)
+    return "clang " __clang_version__;
+#elif defined(__GNUC__)
+    return "gcc " __VERSION__;
+#elif defined(_MSC_VER)
+    return "msvc " + std::to_string(_MSC_VER);
+#else
+    return "unknown";
+#endif
+}
+
+} // namespace
+
+std::string Runner::caseId(const std::string& name, const nlohmann::json& params) {
+    std::string id = name;
+    for (const auto& [key, value] : params.items()) {
+        id += "/" + key + ":" + (value.is_string() ? value.get<std::string>() : value.dump());
+    }
+    return id;
+}
+
+void Runner::reportProgress(const std::string& id, double nsPerOp) {
+    std::fprintf(stderr, "%-64s %12.1f ns\n", id.c_str(), nsPerOp);
+}
+
+nlohmann::json Runner::toJson() const {
+    nlohmann::json context;
+    context["timestamp"] = static_cast<long long>(std::time(nullptr));
+    context["compiler"] = compilerId();
+    context["simdLevel"] = simdLevelName(core::audio::supportedSimdLevel());
+#ifdef NDEBUG
+    context["buildType"] = "release";
+#else
+    context["buildType"] = "debug";
+#endif
+
+    nlohmann::json root;
+    root["context"] = context;
+    root["benchmarks"] = m_results;
+    if (!m_reports.empty()) {
+        root["reports"] = m_reports;
+    }
+    return root;
+}
+
+} // namespace openmeters::bench
+
+/**
+ * Usage: bench_openmeters [--out results.json] [--filter text] [--min-time ms] [--repetitions n]
+ *                         [--trace capture.omtrace] [--latency ms]
+ */
+int main(int argc, char* argv[]) {
+    bench::Runner::Options options;
+    std::string outPath;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (arg == "--out" && hasValue) {
+            outPath = argv[++i];
+        } else if (arg == "--filter" && hasValue) {
+            options.filter = argv[++i];
+        } else if (arg == "--min-time" && hasValue) {
+            options.minTime = std::chrono::milliseconds(std::atoi(argv[++i]));
+        } else if (arg == "--repetitions" && hasValue) {
+            options.repetitions = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--trace" && hasValue) {
+            options.tracePath = argv[++i];
+        } else if (arg == "--latency" && hasValue) {
+            options.latencyTime = std::chrono::milliseconds(std::atoi(argv[++i]));
+        } else {
+            std::cerr << "Usage: " << argv[0]
+                      << " [--out results.json] [--filter text] [--min-time ms] [--repetitions n]"
+                      << " [--trace capture.omtrace] [--latency ms]\n";
+            return 2;
+        }
+    }
+
+    bench::Runner runner(options);
+    bench::runMeterBenchmarks(runner);
+    bench::runConvertBenchmarks(runner);
+    bench::runDispatchBenchmarks(runner);
+    bench::runReplayBenchmarks(runner);
+    bench::runTraceBenchmarks(runner);
+    bench::runLoggerBenchmarks(runner);
+    bench::runLatencyMeasurement(runner);
+
+    const std::string json = runner.toJson().dump(2);
+    if (outPath.empty()) {
+        std::cout << json << "\n";
+        return 0;
+    }
+
+    std::ofstream file(outPath);
+    if (!file) {
+        std::cerr << "Failed to open " << outPath << "\n";
+        return 1;
+    }
+    file << json << "\n";
+    return 0;
+}
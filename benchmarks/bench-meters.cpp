@@ -0,0 +1,152 @@
+#include "bench-harness.h"
+#include "../client/openmeters-shm.h"
+#include "../common/meter-history.h"
+#include "../core/meters/ballistics.h"
+#include "../core/meters/over-detector.h"
+#include "../core/meters/peak-meter.h"
+#include "../core/meters/rms-meter.h"
+#include "../core/meters/sliding-rms.h"
+#include "../core/audio/format-convert.h"
+#include "../core/audio/meter-exporter.h"
+
+namespace openmeters::bench {
+
+namespace {
+
+template <typename Sample>
+void runMeterCase(
+    Runner& runner,
+    const char* formatName,
+    core::audio::SampleFormat format,
+    std::size_t frames,
+    common::ChannelCount channels,
+    bool aligned
+) {
+    common::AudioFormat audioFormat;
+    audioFormat.channelCount = channels;
+    const std::size_t samples = frames * audioFormat.samplesPerFrame();
+
+    std::vector<float> source(samples);
+    fillNoise(source.data(), samples);
+    SignalBuffer<Sample> buffer(samples, aligned);
+    core::audio::convertFromFloat32(source.data(), buffer.data(), format, samples);
+    const Sample* data = buffer.data();
+
+    const nlohmann::json params = {
+        {"format", formatName},
+        {"frames", frames},
+        {"channels", channels},
+        {"aligned", aligned}
+    };
+
+    core::meters::PeakMeter peakMeter;
+    runner.run("peakMeter", params, frames, [&] {
+        doNotOptimize(peakMeter.process(data, frames, audioFormat));
+    });
+
+    core::meters::RmsMeter rmsMeter;
+    runner.run("rmsMeter", params, frames, [&] {
+        doNotOptimize(rmsMeter.process(data, frames, audioFormat));
+    });
+
+    core::meters::SlidingRms slidingRms;
+    slidingRms.configure(300.0f, audioFormat.sampleRate);
+    runner.run("slidingRms", params, frames, [&] {
+        slidingRms.process(data, frames, audioFormat);
+        doNotOptimize(slidingRms.value());
+    });
+
+    // Noise stays below the threshold: the mask-test fast path
+    core::meters::OverDetector overDetector;
+    runner.run("overDetector", params, frames, [&] {
+        overDetector.process(data, frames, audioFormat);
+        doNotOptimize(overDetector.overCount());
+    });
+
+    // Sample-by-sample recurrences; PPM stands for all peak types. The
+    // scalar cases keep the SIMD path honest.
+    for (const auto type : {core::meters::BallisticsType::PpmType1, core::meters::BallisticsType::Vu}) {
+        for (const bool simd : {true, false}) {
+            nlohmann::json ballisticsParams = params;
+            ballisticsParams["type"] = type == core::meters::BallisticsType::Vu ? "vu" : "ppm";
+            ballisticsParams["simd"] = simd;
+            core::meters::Ballistics ballistics;
+            core::meters::BallisticsSettings settings;
+            settings.type = type;
+            ballistics.configure(settings, audioFormat.sampleRate);
+            ballistics.setSimd(simd);
+            runner.run("ballistics", ballisticsParams, frames, [&] {
+                ballistics.process(data, frames, audioFormat);
+                doNotOptimize(ballistics.level());
+            });
+        }
+    }
+}
+
+} // namespace
+
+void runMeterBenchmarks(Runner& runner) {
+    for (const std::size_t frames : kFrameSizes) {
+        for (const common::ChannelCount channels : {1, 2}) {
+            for (const bool aligned : {true, false}) {
+                runMeterCase<float>(runner, "float32", core::audio::SampleFormat::Float32, frames, channels, aligned);
+                runMeterCase<std::int16_t>(runner, "int16", core::audio::SampleFormat::Int16, frames, channels, aligned);
+                runMeterCase<std::int32_t>(runner, "int32", core::audio::SampleFormat::Int32, frames, channels, aligned);
+            }
+        }
+    }
+
+    // Silent packets: closed-form updates per RMS block or per packet, not per sample
+    for (const std::size_t frames : kFrameSizes) {
+        const common::AudioFormat format{48000, 2};
+        core::meters::SlidingRms slidingRms;
+        slidingRms.configure(300.0f, format.sampleRate);
+        runner.run("slidingRmsSilence", {{"frames", frames}}, frames, [&] {
+            slidingRms.processSilence(frames, format);
+            doNotOptimize(slidingRms.value());
+        });
+        core::meters::Ballistics ballistics;
+        core::meters::BallisticsSettings settings;
+        settings.type = core::meters::BallisticsType::Vu;
+        ballistics.configure(settings, format.sampleRate);
+        runner.run("ballisticsSilence", {{"frames", frames}, {"type", "vu"}}, frames, [&] {
+            ballistics.processSilence(frames, format);
+            doNotOptimize(ballistics.level());
+        });
+    }
+
+    // One snapshot per 10 ms packet into the default levels, then the
+    // queries a graph or alarm would make per frame
+    common::MeterHistory history;
+    common::MeterSnapshot snapshot;
+    runner.run("meterHistoryAdd", {}, 1, [&] {
+        snapshot.timestampMs += 10;
+        snapshot.peak.left = static_cast<float>(snapshot.timestampMs % 997) / 997.0f;
+        history.add(snapshot);
+    });
+    for (const std::uint64_t durationMs : {10000ull, 3600000ull}) {
+        runner.run("meterHistoryQuery", {{"durationMs", durationMs}}, 1, [&] {
+            doNotOptimize(history.queryLast(durationMs).peakMax.left);
+        });
+    }
+
+    // Shared-memory export: the seqlock write on the source thread, and one
+    // reader poll from another process's point of view
+    core::audio::MeterExporter exporter;
+    om_shm_reader reader;
+    if (exporter.open("openmeters-bench", common::AudioFormat{48000, 2}) &&
+        om_shm_open(&reader, "openmeters-bench") == OM_SHM_OK) {
+        runner.run("meterExportPublish", {}, 1, [&] {
+            snapshot.timestampMs += 10;
+            exporter.onMeterData(snapshot);
+        });
+        runner.run("meterExportRead", {}, 1, [&] {
+            om_meter_frame frame;
+            doNotOptimize(om_shm_read(&reader, &frame, nullptr));
+            doNotOptimize(frame.peak[0]);
+        });
+        om_shm_close(&reader);
+    }
+}
+
+} // namespace openmeters::bench
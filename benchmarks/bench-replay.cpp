@@ -0,0 +1,91 @@
+#include "bench-harness.h"
+#include "../core/audio/audio-engine.h"
+#include "../core/audio/capture-trace.h"
+#include "../core/audio/replay-source.h"
+#include <filesystem>
+#include <memory>
+
+namespace openmeters::bench {
+
+namespace {
+
+/**
+ * Write a one-second trace with WASAPI-like timing: 10 ms packets with
+ * jittered sizes, a silent stretch and a discontinuity.
+ */
+std::string writeReferenceTrace() {
+    const auto path = (std::filesystem::temp_directory_path() / "openmeters-bench.omtrace").string();
+
+    common::AudioFormat format;
+    core::audio::CaptureTraceWriter writer;
+    if (!writer.open(path, core::audio::SampleFormat::Float32, format)) {
+        return {};
+    }
+
+    std::vector<float> samples(1024 * format.samplesPerFrame());
+    fillNoise(samples.data(), samples.size());
+
+    std::uint64_t position = 0;
+    for (std::uint32_t packet = 0; packet < 100; ++packet) {
+        core::audio::CapturePacketInfo info;
+        info.frameCount = 480 + (packet % 3 == 0 ? 32u : 0u) - (packet % 5 == 0 ? 64u : 0u);
+        info.arrivalNs = position * 1000000000ull / format.sampleRate;
+        info.devicePosition = position;
+        if (packet >= 40 && packet < 50) {
+            info.flags = core::audio::CaptureFlags::Silent;
+        } else if (packet == 70) {
+            info.flags = core::audio::CaptureFlags::DataDiscontinuity;
+        }
+        writer.recordPacket(info, samples.data());
+        position += info.frameCount;
+    }
+    writer.close();
+    return path;
+}
+
+class NullConsumer : public core::audio::IAudioDataCallback {
+public:
+    void onAudioData(const float*, std::size_t, const common::AudioFormat&) override {}
+    void onMeterData(const common::MeterSnapshot& snapshot) override { doNotOptimize(snapshot); }
+};
+
+} // namespace
+
+void runReplayBenchmarks(Runner& runner) {
+    const std::string path = runner.tracePath().empty() ? writeReferenceTrace() : runner.tracePath();
+    if (path.empty()) {
+        return;
+    }
+
+    core::audio::ReplaySourceConfig config;
+    config.tracePath = path;
+    config.speed = 0.0; // Accelerated: measures CPU cost per trace, not wall time
+
+    auto source = std::make_unique<core::audio::ReplaySource>(config);
+    auto* replay = source.get();
+    core::audio::AudioEngine engine(std::move(source));
+    NullConsumer consumer;
+    engine.registerCallback(&consumer);
+    if (!engine.initialize()) {
+        return;
+    }
+
+    const nlohmann::json params = {
+        {"trace", runner.tracePath().empty() ? "reference" : std::filesystem::path(path).filename().string()},
+        {"packets", replay->packetCount()}
+    };
+    runner.run("replayEngine", params, replay->packetCount(), [&] {
+        engine.start();
+        while (engine.isCapturing()) {
+            std::this_thread::yield();
+        }
+        engine.stop();
+    });
+
+    engine.shutdown();
+    if (runner.tracePath().empty()) {
+        std::filesystem::remove(path);
+    }
+}
+
+} // namespace openmeters::bench
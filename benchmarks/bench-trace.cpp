@@ -0,0 +1,26 @@
+#include "bench-harness.h"
+#include "../common/trace.h"
+
+namespace openmeters::bench {
+
+void runTraceBenchmarks(Runner& runner) {
+    common::trace::registerThread("bench");
+
+    // An enabled zone reads the tick source twice; the rest is bookkeeping
+    runner.run("traceNow", {}, 1, [] {
+        doNotOptimize(common::trace::now());
+    });
+
+    for (const bool enabled : {false, true}) {
+        if (enabled) {
+            common::trace::enable();
+        }
+        runner.run("traceZone", {{"enabled", enabled}}, 1, [] {
+            TRACE_ZONE("bench.zone");
+        });
+        common::trace::disable();
+    }
+    common::trace::clear();
+}
+
+} // namespace openmeters::bench
@@ -0,0 +1,198 @@
+#ifndef _WIN32
+#define _POSIX_C_SOURCE 200809L /* shm_open in strict C builds */
+#endif
+
+#include "openmeters-shm.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+/* Tries before om_shm_read() gives up on a slot that keeps changing */
+#define OM_SHM_READ_ATTEMPTS 64
+
+#if defined(_MSC_VER) && !defined(__clang__)
+
+static void om_fence_acquire(void) {
+#if defined(_M_ARM64)
+    __dmb(_ARM64_BARRIER_ISHLD);
+#else
+    _ReadWriteBarrier(); /* x86/x64 loads are not reordered with other loads */
+#endif
+}
+
+static uint64_t om_load_u64(const uint64_t* p) {
+    const uint64_t value = *(const volatile uint64_t*)p;
+    om_fence_acquire();
+    return value;
+}
+
+static uint32_t om_load_u32(const uint32_t* p) {
+    const uint32_t value = *(const volatile uint32_t*)p;
+    om_fence_acquire();
+    return value;
+}
+
+#else
+
+static void om_fence_acquire(void) {
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+}
+
+static uint64_t om_load_u64(const uint64_t* p) {
+    return __atomic_load_n(p, __ATOMIC_ACQUIRE);
+}
+
+static uint32_t om_load_u32(const uint32_t* p) {
+    return __atomic_load_n(p, __ATOMIC_ACQUIRE);
+}
+
+#endif
+
+static void om_cpu_relax(void) {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    _mm_pause();
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+    __builtin_ia32_pause();
+#endif
+}
+
+static int om_validate(const om_shm_segment* segment, size_t size) {
+    if (size < sizeof(om_shm_segment) || om_load_u32(&segment->magic) != OM_SHM_MAGIC ||
+        segment->version != OM_SHM_VERSION || segment->segment_size > size ||
+        segment->frame_offset % 8 != 0 || segment->frame_offset < sizeof(om_shm_segment) ||
+        (size_t)segment->frame_offset + sizeof(uint64_t) + segment->frame_size > segment->segment_size) {
+        return OM_SHM_INVALID;
+    }
+    return OM_SHM_OK;
+}
+
+#ifdef _WIN32
+
+int om_shm_open(om_shm_reader* reader, const char* name) {
+    char path[256];
+    HANDLE mapping;
+    const void* view;
+    MEMORY_BASIC_INFORMATION info;
+
+    memset(reader, 0, sizeof(*reader));
+    snprintf(path, sizeof(path), "Local\\%s", name ? name : OM_SHM_DEFAULT_NAME);
+    mapping = OpenFileMappingA(FILE_MAP_READ, FALSE, path);
+    if (!mapping) {
+        return OM_SHM_NOT_FOUND;
+    }
+    view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!view || !VirtualQuery(view, &info, sizeof(info))) {
+        if (view) {
+            UnmapViewOfFile(view);
+        }
+        CloseHandle(mapping);
+        return OM_SHM_INVALID;
+    }
+
+    reader->segment = (const om_shm_segment*)view;
+    reader->size = info.RegionSize;
+    reader->mapping = mapping;
+    if (om_validate(reader->segment, reader->size) != OM_SHM_OK) {
+        om_shm_close(reader);
+        return OM_SHM_INVALID;
+    }
+    return OM_SHM_OK;
+}
+
+void om_shm_close(om_shm_reader* reader) {
+    if (reader->segment) {
+        UnmapViewOfFile(reader->segment);
+    }
+    if (reader->mapping) {
+        CloseHandle(reader->mapping);
+    }
+    memset(reader, 0, sizeof(*reader));
+}
+
+#else
+
+int om_shm_open(om_shm_reader* reader, const char* name) {
+    char path[256];
+    struct stat st;
+    void* view;
+    int fd;
+
+    memset(reader, 0, sizeof(*reader));
+    snprintf(path, sizeof(path), "/%s", name ? name : OM_SHM_DEFAULT_NAME);
+    fd = shm_open(path, O_RDONLY, 0);
+    if (fd < 0) {
+        return OM_SHM_NOT_FOUND;
+    }
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(om_shm_segment)) {
+        close(fd);
+        return OM_SHM_INVALID;
+    }
+    view = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd); /* The mapping keeps the segment */
+    if (view == MAP_FAILED) {
+        return OM_SHM_INVALID;
+    }
+
+    reader->segment = (const om_shm_segment*)view;
+    reader->size = (size_t)st.st_size;
+    if (om_validate(reader->segment, reader->size) != OM_SHM_OK) {
+        om_shm_close(reader);
+        return OM_SHM_INVALID;
+    }
+    return OM_SHM_OK;
+}
+
+void om_shm_close(om_shm_reader* reader) {
+    if (reader->segment) {
+        munmap((void*)reader->segment, reader->size);
+    }
+    memset(reader, 0, sizeof(*reader));
+}
+
+#endif
+
+int om_shm_read(const om_shm_reader* reader, om_meter_frame* frame, uint64_t* sequence) {
+    const unsigned char* base = (const unsigned char*)reader->segment;
+    const uint64_t* counter;
+    size_t bytes;
+    om_meter_frame copy;
+    int attempt;
+
+    if (!base) {
+        return OM_SHM_INVALID;
+    }
+    counter = (const uint64_t*)(base + reader->segment->frame_offset);
+    bytes = reader->segment->frame_size < sizeof(copy) ? reader->segment->frame_size : sizeof(copy);
+
+    for (attempt = 0; attempt < OM_SHM_READ_ATTEMPTS; ++attempt) {
+        const uint64_t before = om_load_u64(counter);
+        if (before & 1) {
+            om_cpu_relax(); /* Mid-write: a 64-byte copy, over in nanoseconds */
+            continue;
+        }
+        memset(&copy, 0, sizeof(copy));
+        memcpy(&copy, (const void*)(counter + 1), bytes);
+        om_fence_acquire();
+        if (om_load_u64(counter) == before) {
+            *frame = copy;
+            if (sequence) {
+                *sequence = before / 2;
+            }
+            return (om_load_u32(&reader->segment->flags) & OM_SHM_FLAG_LIVE) ? OM_SHM_OK : OM_SHM_STOPPED;
+        }
+    }
+    return OM_SHM_BUSY;
+}
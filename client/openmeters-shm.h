@@ -0,0 +1,118 @@
+/*
+ * Reader for the live meter values OpenMeters publishes in shared memory
+ * (AppConfig::meterExportName, core::audio::MeterExporter).
+ *
+ * Plain C, no dependencies: copy this header and openmeters-shm.c into
+ * another project, or link the openmeters_shm library.
+ *
+ * The exporter writes every meter snapshot into a one-cache-line slot
+ * guarded by a sequence counter (a seqlock): odd while the slot is being
+ * written, bumped to the next even value when done. om_shm_read() copies
+ * the slot and retries if the counter moved meanwhile. Reading takes no
+ * lock and makes no system call, so any number of readers can poll at
+ * kHz rates; the exporter never waits for them.
+ *
+ * Compatibility: version changes only for incompatible layouts. Newer
+ * exporters may append fields to om_meter_frame (frame_size grows);
+ * readers copy the fields they know.
+ *
+ * Thread safety: an om_shm_reader may be used by one thread at a time;
+ * open one per thread to poll from several.
+ */
+#ifndef OPENMETERS_SHM_H
+#define OPENMETERS_SHM_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define OM_SHM_MAGIC 0x4D534D4Fu /* "OMSM" */
+#define OM_SHM_VERSION 1u
+#define OM_SHM_DEFAULT_NAME "openmeters"
+
+/* om_shm_segment.flags */
+#define OM_SHM_FLAG_LIVE 0x1u /* Cleared when the exporter closes the segment */
+
+/* om_shm_read() / om_shm_open() results */
+#define OM_SHM_OK 0
+#define OM_SHM_BUSY 1          /* The slot kept changing under the reader; try again */
+#define OM_SHM_STOPPED 2       /* The exporter is gone; frame holds its last values */
+#define OM_SHM_NOT_FOUND (-1)  /* No segment with that name (exporter not running) */
+#define OM_SHM_INVALID (-2)    /* Not a meter segment, or an incompatible version */
+
+/*
+ * One meter snapshot. Levels are linear (1.0 = full scale), left then right.
+ */
+typedef struct om_meter_frame {
+    uint64_t timestamp_ms;    /* Since the audio engine started */
+    uint64_t capture_time_ns; /* Steady clock when the audio was captured (0 if unknown) */
+    float peak[2];            /* Packet sample peak */
+    float level[2];           /* Ballistic reading (digital peak, PPM or VU) */
+    float peak_hold[2];
+    float rms[2];
+} om_meter_frame;
+
+/*
+ * Segment layout (little-endian, native alignment):
+ *   om_shm_segment (64 bytes)
+ *   at frame_offset: uint64_t sequence, then frame_size bytes of om_meter_frame
+ */
+typedef struct om_shm_segment {
+    uint32_t magic;          /* OM_SHM_MAGIC, stored last when the segment is set up */
+    uint32_t version;        /* OM_SHM_VERSION */
+    uint32_t segment_size;
+    uint32_t frame_offset;   /* Of the sequence counter, 8-byte aligned */
+    uint32_t frame_size;     /* sizeof(om_meter_frame) in the exporter */
+    uint32_t sample_rate;
+    uint32_t channel_count;
+    uint32_t flags;          /* OM_SHM_FLAG_* */
+    uint64_t writer_pid;
+    uint8_t reserved[24];
+} om_shm_segment;
+
+/*
+ * The seqlock slot at frame_offset in version 1 (exactly one cache line).
+ */
+typedef struct om_shm_slot {
+    uint64_t sequence; /* Odd while the frame is written; / 2 = frames published */
+    om_meter_frame frame;
+    uint8_t reserved[8];
+} om_shm_slot;
+
+typedef struct om_shm_reader {
+    const om_shm_segment* segment;
+    size_t size;
+    void* mapping; /* Platform mapping handle (Windows) */
+} om_shm_reader;
+
+/*
+ * Map a published segment read-only.
+ *
+ * name: segment name as configured in OpenMeters (NULL: OM_SHM_DEFAULT_NAME)
+ * Returns OM_SHM_OK, OM_SHM_NOT_FOUND or OM_SHM_INVALID.
+ */
+int om_shm_open(om_shm_reader* reader, const char* name);
+
+/*
+ * Unmap the segment (safe on a reader that failed to open).
+ */
+void om_shm_close(om_shm_reader* reader);
+
+/*
+ * Copy the newest frame.
+ *
+ * sequence: if not NULL, receives the number of frames published so far
+ *           (compare with the previous call to see whether anything changed)
+ * Returns OM_SHM_OK, OM_SHM_STOPPED (frame is the last one published) or
+ * OM_SHM_BUSY (no consistent copy after several tries; frame untouched).
+ */
+int om_shm_read(const om_shm_reader* reader, om_meter_frame* frame, uint64_t* sequence);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* OPENMETERS_SHM_H */
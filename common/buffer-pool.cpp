@@ -0,0 +1,59 @@
+#include "buffer-pool.h"
+#include <new>
+
+namespace openmeters::common {
+
+BufferPool::~BufferPool() {
+    release();
+}
+
+bool BufferPool::reserve(std::size_t capacityBytes) {
+    release();
+
+    if (capacityBytes == 0) {
+        return true;
+    }
+
+    m_storage = static_cast<std::uint8_t*>(
+        ::operator new(capacityBytes, std::align_val_t(kDefaultAlignment), std::nothrow)
+    );
+    if (!m_storage) {
+        return false;
+    }
+
+    m_capacity = capacityBytes;
+    ResourceMonitor::trackAllocation(m_tag, m_capacity);
+    return true;
+}
+
+void BufferPool::release() noexcept {
+    if (m_storage) {
+        ::operator delete(m_storage, std::align_val_t(kDefaultAlignment));
+        m_storage = nullptr;
+        ResourceMonitor::trackRelease(m_tag, m_capacity);
+    }
+    m_capacity = 0;
+    m_offset = 0;
+    m_highWater = 0;
+}
+
+void* BufferPool::acquire(std::size_t bytes, std::size_t alignment) noexcept {
+    if (!m_storage || alignment == 0 || (alignment & (alignment - 1)) != 0) {
+        return nullptr;
+    }
+
+    const auto base = reinterpret_cast<std::uintptr_t>(m_storage);
+    const std::uintptr_t start = (base + m_offset + alignment - 1) & ~(alignment - 1);
+    const std::size_t end = static_cast<std::size_t>(start - base) + bytes;
+    if (end > m_capacity) {
+        return nullptr; // Exhausted: callers must not fall back to the heap
+    }
+
+    m_offset = end;
+    if (m_offset > m_highWater) {
+        m_highWater = m_offset;
+    }
+    return reinterpret_cast<void*>(start);
+}
+
+} // namespace openmeters::common
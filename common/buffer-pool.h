@@ -0,0 +1,103 @@
+#pragma once
+
+#include "resource-monitor.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace openmeters::common {
+
+/**
+ * Preallocated arena for per-packet buffers on the audio path.
+ * Storage is reserved once (e.g. at WasapiCapture::initialize from the
+ * endpoint's maximum buffer size); acquire() is a pointer bump and reset()
+ * releases every block at once, so the capture and analysis threads never
+ * touch the heap.
+ *
+ * Thread safety: Not thread-safe. Each real-time thread owns its own pool.
+ */
+class BufferPool {
+public:
+    /**
+     * Default block alignment (cache line, also satisfies AVX loads).
+     */
+    static constexpr std::size_t kDefaultAlignment = 64;
+
+    BufferPool() = default;
+    
+    /**
+     * @param tag Subsystem the reserved storage is accounted to
+     */
+    explicit BufferPool(MemoryTag tag) : m_tag(tag) {}
+    
+    ~BufferPool();
+
+    // Non-copyable, non-movable (blocks point into the arena)
+    BufferPool(const BufferPool&) = delete;
+    BufferPool& operator=(const BufferPool&) = delete;
+    BufferPool(BufferPool&&) = delete;
+    BufferPool& operator=(BufferPool&&) = delete;
+
+    /**
+     * Allocate backing storage. Not real-time safe; call during setup.
+     * Discards any previous storage and outstanding blocks.
+     *
+     * @param capacityBytes Arena size in bytes
+     * @return true if storage was allocated, false otherwise
+     */
+    bool reserve(std::size_t capacityBytes);
+
+    /**
+     * Free backing storage.
+     */
+    void release() noexcept;
+
+    /**
+     * Hand out an aligned block. Never allocates.
+     *
+     * @param bytes Block size in bytes
+     * @param alignment Power-of-two alignment
+     * @return Pointer to the block, or nullptr if the arena is exhausted
+     */
+    [[nodiscard]] void* acquire(std::size_t bytes, std::size_t alignment = kDefaultAlignment) noexcept;
+
+    /**
+     * Typed convenience wrapper around acquire().
+     *
+     * @param count Number of elements
+     * @return Pointer to uninitialized storage, or nullptr if exhausted
+     */
+    template <typename T>
+    [[nodiscard]] T* acquireArray(std::size_t count) noexcept {
+        const std::size_t alignment = alignof(T) > kDefaultAlignment ? alignof(T) : kDefaultAlignment;
+        return static_cast<T*>(acquire(count * sizeof(T), alignment));
+    }
+
+    /**
+     * Release every block handed out since the last reset. O(1).
+     */
+    void reset() noexcept { m_offset = 0; }
+
+    /**
+     * Arena size in bytes.
+     */
+    [[nodiscard]] std::size_t capacity() const noexcept { return m_capacity; }
+
+    /**
+     * Bytes handed out since the last reset (including alignment padding).
+     */
+    [[nodiscard]] std::size_t used() const noexcept { return m_offset; }
+
+    /**
+     * Largest used() observed since reserve().
+     */
+    [[nodiscard]] std::size_t highWaterMark() const noexcept { return m_highWater; }
+
+private:
+    MemoryTag m_tag = MemoryTag::Other;
+    std::uint8_t* m_storage = nullptr;
+    std::size_t m_capacity = 0;
+    std::size_t m_offset = 0;
+    std::size_t m_highWater = 0;
+};
+
+} // namespace openmeters::common
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+namespace openmeters::common {
+
+/**
+ * Monotonic time in nanoseconds (steady_clock).
+ * Common time base for capture timestamps, display times and stage
+ * durations, so they can be subtracted across threads.
+ */
+[[nodiscard]] inline std::uint64_t monotonicNanos() noexcept {
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()
+    ).count());
+}
+
+} // namespace openmeters::common
@@ -11,24 +11,120 @@
 
 namespace openmeters::common {
 
-AppConfig ConfigManager::s_config;
+namespace {
+const ConfigSnapshot s_defaultSnapshot{};
+} // namespace
 
-AppConfig& ConfigManager::get() {
-    return s_config;
+std::atomic<const ConfigSnapshot*> ConfigManager::s_current{&s_defaultSnapshot};
+std::atomic<std::uint64_t> ConfigManager::s_version{0};
+std::atomic<int> ConfigManager::s_activeReaders{0};
+std::mutex ConfigManager::s_mutex;
+std::unique_ptr<const ConfigSnapshot> ConfigManager::s_published;
+std::vector<std::unique_ptr<const ConfigSnapshot>> ConfigManager::s_retired;
+std::string ConfigManager::s_configPath;
+
+ConfigManager::ReadGuard::ReadGuard() noexcept {
+    // seq_cst pairs with the swap in publishLocked(): a reader that still
+    // sees the old snapshot is guaranteed to be counted when the writer checks
+    s_activeReaders.fetch_add(1);
+    m_snapshot = s_current.load();
+}
+
+ConfigManager::ReadGuard::~ReadGuard() {
+    s_activeReaders.fetch_sub(1, std::memory_order_release);
+}
+
+AppConfig ConfigManager::config() {
+    const ReadGuard guard;
+    return guard.config();
+}
+
+std::uint64_t ConfigManager::version() noexcept {
+    return s_version.load(std::memory_order_acquire);
+}
+
+std::uint64_t ConfigManager::publish(const AppConfig& config) {
+    std::lock_guard<std::mutex> lock(s_mutex);
+    return publishLocked(config);
+}
+
+bool ConfigManager::publishIfVersion(std::uint64_t expected, const AppConfig& config, std::uint64_t* version) {
+    std::lock_guard<std::mutex> lock(s_mutex);
+    const std::uint64_t current = s_current.load(std::memory_order_relaxed)->version;
+    const bool matches = current == expected;
+    const std::uint64_t published = matches ? publishLocked(config) : current;
+    if (version) {
+        *version = published;
+    }
+    return matches;
+}
+
+std::uint64_t ConfigManager::publishLocked(const AppConfig& config) {
+    const ConfigSnapshot* previous = s_current.load(std::memory_order_relaxed);
+    if (previous->config == config) {
+        return previous->version;
+    }
+    
+    const std::uint64_t version = previous->version + 1;
+    auto next = std::make_unique<const ConfigSnapshot>(ConfigSnapshot{version, config});
+    s_current.store(next.get());
+    s_version.store(version, std::memory_order_release);
+    if (s_published) {
+        s_retired.push_back(std::move(s_published));
+    }
+    s_published = std::move(next);
+    
+    // Readers may still hold a replaced snapshot. Rather than wait for them
+    // (the UI thread publishes too), free the retired ones only when no
+    // guard is active; otherwise a later publish does it.
+    if (s_activeReaders.load() == 0) {
+        s_retired.clear();
+    }
+    return version;
 }
 
 bool ConfigManager::load() {
-    std::string configPath = AppConfig::getDefaultConfigPath();
-    return s_config.loadFromFile(configPath);
+    return load(AppConfig::getDefaultConfigPath());
+}
+
+bool ConfigManager::load(const std::string& configPath) {
+    AppConfig config;
+    const bool loaded = config.loadFromFile(configPath);
+    
+    std::lock_guard<std::mutex> lock(s_mutex);
+    s_configPath = configPath;
+    if (loaded) {
+        publishLocked(config);
+    }
+    return loaded;
+}
+
+bool ConfigManager::reload() {
+    return load(configPath());
 }
 
 bool ConfigManager::save() {
-    std::string configPath = AppConfig::getDefaultConfigPath();
-    return s_config.saveToFile(configPath);
+    const std::string path = configPath();
+    return config().saveToFile(path);
 }
 
 void ConfigManager::reset() {
-    s_config = AppConfig();
+    publish(AppConfig());
+}
+
+std::size_t ConfigManager::retiredSnapshots() {
+    std::lock_guard<std::mutex> lock(s_mutex);
+    return s_retired.size();
+}
+
+std::string ConfigManager::configPath() {
+    {
+        std::lock_guard<std::mutex> lock(s_mutex);
+        if (!s_configPath.empty()) {
+            return s_configPath;
+        }
+    }
+    return AppConfig::getDefaultConfigPath();
 }
 
 std::string AppConfig::getDefaultConfigPath() {
@@ -73,11 +169,42 @@ bool AppConfig::loadFromFile(const std::string& configPath) {
         if (j.contains("meterUpdateRate")) meterUpdateRate = j["meterUpdateRate"];
         if (j.contains("showPeakMeter")) showPeakMeter = j["showPeakMeter"];
         if (j.contains("showRmsMeter")) showRmsMeter = j["showRmsMeter"];
+        if (j.contains("showHistoryGraph")) showHistoryGraph = j["showHistoryGraph"];
         if (j.contains("meterDecayRate")) meterDecayRate = j["meterDecayRate"];
+        if (j.contains("meterBallistics")) meterBallistics = j["meterBallistics"];
+        if (j.contains("meterAttackMs")) meterAttackMs = j["meterAttackMs"];
+        if (j.contains("meterReleaseDbPerSecond")) meterReleaseDbPerSecond = j["meterReleaseDbPerSecond"];
+        if (j.contains("meterHoldMs")) meterHoldMs = j["meterHoldMs"];
+        if (j.contains("rmsWindowMs")) rmsWindowMs = j["rmsWindowMs"];
+        if (j.contains("overThresholdDb")) overThresholdDb = j["overThresholdDb"];
+        if (j.contains("overSampleCount")) overSampleCount = j["overSampleCount"];
+        if (j.contains("idleAfterSeconds")) idleAfterSeconds = j["idleAfterSeconds"];
+        if (j.contains("idleUpdateRate")) idleUpdateRate = j["idleUpdateRate"];
+        if (j.contains("historySeconds")) historySeconds = j["historySeconds"];
+        if (j.contains("historyDumpDir")) historyDumpDir = j["historyDumpDir"];
+        if (j.contains("historyDumpOnOver")) historyDumpOnOver = j["historyDumpOnOver"];
+        if (j.contains("recordingDir")) recordingDir = j["recordingDir"];
+        if (j.contains("recordingFormat")) recordingFormat = j["recordingFormat"];
+        if (j.contains("recordingBufferSeconds")) recordingBufferSeconds = j["recordingBufferSeconds"];
         
         // Audio settings
         if (j.contains("autoStartCapture")) autoStartCapture = j["autoStartCapture"];
         if (j.contains("audioBufferSize")) audioBufferSize = j["audioBufferSize"];
+        if (j.contains("captureTracePath")) captureTracePath = j["captureTracePath"];
+        if (j.contains("perfTracePath")) perfTracePath = j["perfTracePath"];
+        if (j.contains("statsLogInterval")) statsLogInterval = j["statsLogInterval"];
+        if (j.contains("binaryLogPath")) binaryLogPath = j["binaryLogPath"];
+        if (j.contains("binaryLogSizeKB")) binaryLogSizeKB = j["binaryLogSizeKB"];
+        if (j.contains("meterLogDir")) meterLogDir = j["meterLogDir"];
+        if (j.contains("meterLogIntervalMs")) meterLogIntervalMs = j["meterLogIntervalMs"];
+        if (j.contains("meterLogFlushSeconds")) meterLogFlushSeconds = j["meterLogFlushSeconds"];
+        if (j.contains("meterExportName")) meterExportName = j["meterExportName"];
+        if (j.contains("headlessSource")) headlessSource = j["headlessSource"];
+        if (j.contains("headlessRawFormat")) headlessRawFormat = j["headlessRawFormat"];
+        if (j.contains("headlessSampleRate")) headlessSampleRate = j["headlessSampleRate"];
+        if (j.contains("headlessChannels")) headlessChannels = j["headlessChannels"];
+        if (j.contains("headlessLoop")) headlessLoop = j["headlessLoop"];
+        if (j.contains("headlessRecord")) headlessRecord = j["headlessRecord"];
         
         // UI settings
         if (j.contains("uiScale")) uiScale = j["uiScale"];
@@ -120,11 +247,42 @@ bool AppConfig::saveToFile(const std::string& configPath) const {
         j["meterUpdateRate"] = meterUpdateRate;
         j["showPeakMeter"] = showPeakMeter;
         j["showRmsMeter"] = showRmsMeter;
+        j["showHistoryGraph"] = showHistoryGraph;
         j["meterDecayRate"] = meterDecayRate;
+        j["meterBallistics"] = meterBallistics;
+        j["meterAttackMs"] = meterAttackMs;
+        j["meterReleaseDbPerSecond"] = meterReleaseDbPerSecond;
+        j["meterHoldMs"] = meterHoldMs;
+        j["rmsWindowMs"] = rmsWindowMs;
+        j["overThresholdDb"] = overThresholdDb;
+        j["overSampleCount"] = overSampleCount;
+        j["idleAfterSeconds"] = idleAfterSeconds;
+        j["idleUpdateRate"] = idleUpdateRate;
+        j["historySeconds"] = historySeconds;
+        j["historyDumpDir"] = historyDumpDir;
+        j["historyDumpOnOver"] = historyDumpOnOver;
+        j["recordingDir"] = recordingDir;
+        j["recordingFormat"] = recordingFormat;
+        j["recordingBufferSeconds"] = recordingBufferSeconds;
         
         // Audio settings
         j["autoStartCapture"] = autoStartCapture;
         j["audioBufferSize"] = audioBufferSize;
+        j["captureTracePath"] = captureTracePath;
+        j["perfTracePath"] = perfTracePath;
+        j["statsLogInterval"] = statsLogInterval;
+        j["binaryLogPath"] = binaryLogPath;
+        j["binaryLogSizeKB"] = binaryLogSizeKB;
+        j["meterLogDir"] = meterLogDir;
+        j["meterLogIntervalMs"] = meterLogIntervalMs;
+        j["meterLogFlushSeconds"] = meterLogFlushSeconds;
+        j["meterExportName"] = meterExportName;
+        j["headlessSource"] = headlessSource;
+        j["headlessRawFormat"] = headlessRawFormat;
+        j["headlessSampleRate"] = headlessSampleRate;
+        j["headlessChannels"] = headlessChannels;
+        j["headlessLoop"] = headlessLoop;
+        j["headlessRecord"] = headlessRecord;
         
         // UI settings
         j["uiScale"] = uiScale;
@@ -1,8 +1,11 @@
 #pragma once
 
 #include "types.h"
+#include <atomic>
+#include <cstdint>
 #include <string>
 #include <memory>
+#include <mutex>
 #include <vector>
 #include <nlohmann/json.hpp>
 
@@ -25,11 +28,44 @@ struct AppConfig {
     float meterUpdateRate = 60.0f; // Updates per second
     bool showPeakMeter = true;
     bool showRmsMeter = true;
-    float meterDecayRate = 0.95f; // Peak hold decay
+    bool showHistoryGraph = false; // Scrolling peak/RMS graph of the last 10 s
+    float meterDecayRate = 0.95f; // Peak hold fall per update, after meterHoldMs
+    std::string meterBallistics = "digital"; // "digital", "ppm1", "ppm2" (IEC 60268-10 Type I/II) or "vu"
+    float meterAttackMs = 0.0f;   // Digital peak integration time (0 = instant)
+    float meterReleaseDbPerSecond = 20.0f; // Digital peak fall rate
+    float meterHoldMs = 1000.0f;  // Peak hold time
+    float rmsWindowMs = 300.0f;   // RMS integration time
+    float overThresholdDb = -0.01f; // Sample level that counts toward an over (dBFS)
+    int overSampleCount = 3;      // Consecutive samples at the threshold that make an over
+    float idleAfterSeconds = 10.0f; // Digital silence before meters and the overlay slow down (0 = never)
+    float idleUpdateRate = 4.0f;  // Snapshots and redraws per second while idle
+    float historySeconds = 30.0f; // Look-back audio kept for dumps to WAV (0 = off; read at startup)
+    std::string historyDumpDir = "recordings"; // Where history dumps are written
+    bool historyDumpOnOver = false; // Dump the audio around each over automatically
+    std::string recordingDir = "recordings"; // Where recordings are written
+    std::string recordingFormat = "float32"; // Recording sample format: "float32", "int24" or "int16"
+    float recordingBufferSeconds = 10.0f; // Disk stall a recording rides out without dropping audio (read at startup)
     
     // Audio settings
     bool autoStartCapture = false;
     float audioBufferSize = 0.1f; // seconds
+    std::string captureTracePath; // Record a capture trace for replay (empty = off)
+    std::string perfTracePath;    // Record hot-path zones, export Chrome JSON on exit (empty = off)
+    int statsLogInterval = 60;    // Seconds between engine stats log lines (0 = off)
+    std::string binaryLogPath;    // Crash-safe binary log ring, decode with omlog_decode (empty = off)
+    int binaryLogSizeKB = 4096;   // Binary log ring size
+    std::string meterLogDir;      // Archive meter readings as .ommeter logs here (empty = off; read at startup)
+    int meterLogIntervalMs = 1000; // Meter log aggregation interval (0 = every snapshot)
+    int meterLogFlushSeconds = 5; // Meter log data a crash or power loss can lose, at most
+    std::string meterExportName;  // Publish live meters in shared memory under this name (empty = off; read at startup)
+    
+    // Headless daemon (openmetersd) settings
+    std::string headlessSource = "synthetic"; // "synthetic", "wasapi" (Windows), "replay:<trace>", or a WAV/raw file, FIFO or "-" (stdin)
+    std::string headlessRawFormat = "float32"; // Raw PCM encoding: "float32", "float64", "int32", "int24" or "int16"
+    int headlessSampleRate = 48000; // Raw PCM sample rate
+    int headlessChannels = 2;       // Raw PCM channels (1 or 2)
+    bool headlessLoop = false;      // Start a file over at its end instead of exiting
+    bool headlessRecord = false;    // Record to recordingDir while the daemon runs
     
     // UI settings
     float uiScale = 1.0f;
@@ -56,37 +92,144 @@ struct AppConfig {
      * Returns: %APPDATA%/OpenMeters/config.json on Windows
      */
     static std::string getDefaultConfigPath();
+    
+    bool operator==(const AppConfig&) const = default;
+};
+
+/**
+ * One published configuration. Never modified after publication.
+ */
+struct ConfigSnapshot {
+    std::uint64_t version = 0; // Increases by one per publish
+    AppConfig config;
 };
 
 /**
  * Configuration manager.
- * Singleton pattern for global configuration access.
+ * 
+ * Settings are published as immutable, versioned snapshots behind an
+ * atomic pointer: readers (including the audio thread, once per packet)
+ * pin the current snapshot with a ReadGuard, which costs two atomic
+ * increments and never locks. Changes go through publish(), which copies
+ * the whole configuration into a new snapshot and swaps it in. Replaced
+ * snapshots are retired and freed by a later publish once no guard is
+ * active, so memory stays at a few snapshots however often settings
+ * change. Guards must therefore be short-lived (one packet, one frame);
+ * code that keeps settings longer copies them with config().
+ * 
+ * Thread safety: ReadGuard, config() and version() are lock-free and may
+ * be used from any thread, including real-time ones. The other functions
+ * serialize on an internal mutex.
  */
 class ConfigManager {
 public:
     /**
-     * Get the global configuration instance.
+     * Pins the current snapshot for the guard's lifetime.
+     * 
+     * Thread: Any (lock-free)
+     */
+    class ReadGuard {
+    public:
+        ReadGuard() noexcept;
+        ~ReadGuard();
+        
+        // Non-copyable, non-movable
+        ReadGuard(const ReadGuard&) = delete;
+        ReadGuard& operator=(const ReadGuard&) = delete;
+        ReadGuard(ReadGuard&&) = delete;
+        ReadGuard& operator=(ReadGuard&&) = delete;
+        
+        [[nodiscard]] const ConfigSnapshot& snapshot() const noexcept { return *m_snapshot; }
+        [[nodiscard]] const AppConfig& config() const noexcept { return m_snapshot->config; }
+        
+    private:
+        const ConfigSnapshot* m_snapshot;
+    };
+    
+    /**
+     * Copy of the current configuration, for settings kept past one use.
+     * 
+     * Thread: Any (allocates; not for real-time threads)
+     */
+    [[nodiscard]] static AppConfig config();
+    
+    /**
+     * Version of the current snapshot (cheap change check).
+     * 
+     * Thread: Any (lock-free)
      */
-    static AppConfig& get();
+    [[nodiscard]] static std::uint64_t version() noexcept;
     
     /**
-     * Load configuration from default location.
+     * Publish a new configuration. Does nothing if it equals the current one.
+     * 
+     * @return Version of the (possibly unchanged) current snapshot
+     */
+    static std::uint64_t publish(const AppConfig& config);
+    
+    /**
+     * Publish an edit of the snapshot with version expected. Fails, leaving
+     * the newer snapshot in place, if something else (a reload) published
+     * in between, so a stale working copy cannot overwrite it.
+     * 
+     * @param version Receives the version of the current snapshot (optional)
+     * @return true if the current snapshot now holds config
+     */
+    static bool publishIfVersion(std::uint64_t expected, const AppConfig& config, std::uint64_t* version = nullptr);
+    
+    /**
+     * Load configuration from the default location and publish it.
      */
     static bool load();
     
     /**
-     * Save configuration to default location.
+     * Load configuration from a file and publish it. The path is remembered
+     * for reload() and save(). Keys missing from the file take their
+     * default values.
+     * 
+     * @param configPath Path to config file (JSON)
+     * @return true if loaded successfully, false otherwise (current
+     *         snapshot unchanged)
+     */
+    static bool load(const std::string& configPath);
+    
+    /**
+     * Load the file last passed to load() again (hot reload).
+     */
+    static bool reload();
+    
+    /**
+     * Save the current snapshot to the loaded (or default) location.
      */
     static bool save();
     
     /**
-     * Reset to default configuration.
+     * Publish the default configuration.
      */
     static void reset();
+    
+    /**
+     * File used by reload() and save().
+     */
+    [[nodiscard]] static std::string configPath();
+    
+    /**
+     * Snapshots replaced but not yet freed (for tests).
+     */
+    [[nodiscard]] static std::size_t retiredSnapshots();
 
 private:
     ConfigManager() = default;
-    static AppConfig s_config;
+    
+    static std::uint64_t publishLocked(const AppConfig& config);
+    
+    static std::atomic<const ConfigSnapshot*> s_current;
+    static std::atomic<std::uint64_t> s_version;
+    static std::atomic<int> s_activeReaders;
+    static std::mutex s_mutex;
+    static std::unique_ptr<const ConfigSnapshot> s_published; // Owns s_current (unless it is the default)
+    static std::vector<std::unique_ptr<const ConfigSnapshot>> s_retired; // Replaced; freed once readers drain
+    static std::string s_configPath;
 };
 
 } // namespace openmeters::common
@@ -0,0 +1,192 @@
+#include "content-hash.h"
+#include "mapped-file.h"
+#include <algorithm>
+#include <cstring>
+
+namespace openmeters::common {
+
+namespace {
+
+constexpr std::uint64_t kPrime1 = 11400714785074694791ULL;
+constexpr std::uint64_t kPrime2 = 14029467366897019727ULL;
+constexpr std::uint64_t kPrime3 = 1609587929392839161ULL;
+constexpr std::uint64_t kPrime4 = 9650029242287828579ULL;
+constexpr std::uint64_t kPrime5 = 2870177450012600261ULL;
+
+constexpr std::uint64_t rotl(std::uint64_t value, int bits) noexcept {
+    return (value << bits) | (value >> (64 - bits));
+}
+
+inline std::uint64_t read64(const std::uint8_t* p) noexcept {
+    std::uint64_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+inline std::uint32_t read32(const std::uint8_t* p) noexcept {
+    std::uint32_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+inline std::uint64_t round(std::uint64_t acc, std::uint64_t input) noexcept {
+    acc += input * kPrime2;
+    acc = rotl(acc, 31);
+    return acc * kPrime1;
+}
+
+inline std::uint64_t mergeRound(std::uint64_t acc, std::uint64_t value) noexcept {
+    acc ^= round(0, value);
+    return acc * kPrime1 + kPrime4;
+}
+
+} // namespace
+
+ContentHasher::ContentHasher(std::uint64_t seed) noexcept {
+    reset(seed);
+}
+
+void ContentHasher::reset(std::uint64_t seed) noexcept {
+    m_seed = seed;
+    m_acc[0] = seed + kPrime1 + kPrime2;
+    m_acc[1] = seed + kPrime2;
+    m_acc[2] = seed;
+    m_acc[3] = seed - kPrime1;
+    m_bufferSize = 0;
+    m_totalLength = 0;
+}
+
+void ContentHasher::update(const void* data, std::size_t length) noexcept {
+    if (!data || length == 0) {
+        return;
+    }
+
+    const auto* p = static_cast<const std::uint8_t*>(data);
+    const std::uint8_t* const end = p + length;
+    m_totalLength += length;
+
+    // Top up a partially filled stripe first
+    if (m_bufferSize > 0) {
+        const std::size_t fill = std::min<std::size_t>(32 - m_bufferSize, length);
+        std::memcpy(m_buffer + m_bufferSize, p, fill);
+        m_bufferSize += fill;
+        p += fill;
+        if (m_bufferSize < 32) {
+            return;
+        }
+        m_acc[0] = round(m_acc[0], read64(m_buffer));
+        m_acc[1] = round(m_acc[1], read64(m_buffer + 8));
+        m_acc[2] = round(m_acc[2], read64(m_buffer + 16));
+        m_acc[3] = round(m_acc[3], read64(m_buffer + 24));
+        m_bufferSize = 0;
+    }
+
+    // Bulk: four independent lanes per 32-byte stripe
+    std::uint64_t v1 = m_acc[0];
+    std::uint64_t v2 = m_acc[1];
+    std::uint64_t v3 = m_acc[2];
+    std::uint64_t v4 = m_acc[3];
+    while (end - p >= 32) {
+        v1 = round(v1, read64(p));
+        v2 = round(v2, read64(p + 8));
+        v3 = round(v3, read64(p + 16));
+        v4 = round(v4, read64(p + 24));
+        p += 32;
+    }
+    m_acc[0] = v1;
+    m_acc[1] = v2;
+    m_acc[2] = v3;
+    m_acc[3] = v4;
+
+    // Keep the tail for the next update or digest
+    if (p < end) {
+        m_bufferSize = static_cast<std::size_t>(end - p);
+        std::memcpy(m_buffer, p, m_bufferSize);
+    }
+}
+
+std::uint64_t ContentHasher::digest() const noexcept {
+    std::uint64_t h;
+
+    if (m_totalLength >= 32) {
+        h = rotl(m_acc[0], 1) + rotl(m_acc[1], 7) + rotl(m_acc[2], 12) + rotl(m_acc[3], 18);
+        h = mergeRound(h, m_acc[0]);
+        h = mergeRound(h, m_acc[1]);
+        h = mergeRound(h, m_acc[2]);
+        h = mergeRound(h, m_acc[3]);
+    } else {
+        h = m_seed + kPrime5;
+    }
+
+    h += m_totalLength;
+
+    const std::uint8_t* p = m_buffer;
+    const std::uint8_t* const end = m_buffer + m_bufferSize;
+
+    while (end - p >= 8) {
+        h ^= round(0, read64(p));
+        h = rotl(h, 27) * kPrime1 + kPrime4;
+        p += 8;
+    }
+
+    if (end - p >= 4) {
+        h ^= static_cast<std::uint64_t>(read32(p)) * kPrime1;
+        h = rotl(h, 23) * kPrime2 + kPrime3;
+        p += 4;
+    }
+
+    while (p < end) {
+        h ^= static_cast<std::uint64_t>(*p) * kPrime5;
+        h = rotl(h, 11) * kPrime1;
+        ++p;
+    }
+
+    // Final avalanche
+    h ^= h >> 33;
+    h *= kPrime2;
+    h ^= h >> 29;
+    h *= kPrime3;
+    h ^= h >> 32;
+
+    return h;
+}
+
+std::uint64_t ContentHasher::hash(const void* data, std::size_t length, std::uint64_t seed) noexcept {
+    ContentHasher hasher(seed);
+    hasher.update(data, length);
+    return hasher.digest();
+}
+
+bool hashFileContents(const std::string& path, std::uint64_t& outHash) {
+    MappedFile file;
+    if (!file.open(path)) {
+        return false;
+    }
+
+    // Hash in large slices so the kernel read-ahead stays ahead of us
+    constexpr std::size_t kSliceBytes = 4 * 1024 * 1024;
+    ContentHasher hasher;
+    const std::uint8_t* data = file.data();
+    std::size_t remaining = file.size();
+    while (remaining > 0) {
+        const std::size_t slice = remaining < kSliceBytes ? remaining : kSliceBytes;
+        hasher.update(data, slice);
+        data += slice;
+        remaining -= slice;
+    }
+
+    outHash = hasher.digest();
+    return true;
+}
+
+std::string hashToHex(std::uint64_t hash) {
+    static constexpr char kDigits[] = "0123456789abcdef";
+    std::string hex(16, '0');
+    for (int i = 15; i >= 0; --i) {
+        hex[static_cast<std::size_t>(i)] = kDigits[hash & 0xF];
+        hash >>= 4;
+    }
+    return hex;
+}
+
+} // namespace openmeters::common
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace openmeters::common {
+
+/**
+ * Streaming 64-bit content hash (XXH64).
+ * Fast non-cryptographic hash used to address cached analysis results.
+ * Feeding the same bytes in any chunking produces the same digest.
+ *
+ * Thread safety: Not thread-safe. Use one hasher per thread.
+ */
+class ContentHasher {
+public:
+    explicit ContentHasher(std::uint64_t seed = 0) noexcept;
+
+    /**
+     * Reset to the initial state.
+     */
+    void reset(std::uint64_t seed = 0) noexcept;
+
+    /**
+     * Feed bytes into the hash.
+     *
+     * @param data Pointer to bytes
+     * @param length Number of bytes
+     */
+    void update(const void* data, std::size_t length) noexcept;
+
+    /**
+     * Compute the digest of all bytes fed so far.
+     * Does not modify the hasher state.
+     */
+    [[nodiscard]] std::uint64_t digest() const noexcept;
+
+    /**
+     * One-shot hash of a buffer.
+     */
+    [[nodiscard]] static std::uint64_t hash(
+        const void* data,
+        std::size_t length,
+        std::uint64_t seed = 0
+    ) noexcept;
+
+private:
+    std::uint64_t m_seed = 0;
+    std::uint64_t m_acc[4] = {};
+    std::uint8_t m_buffer[32] = {};
+    std::size_t m_bufferSize = 0;
+    std::uint64_t m_totalLength = 0;
+};
+
+/**
+ * Hash the contents of a file through a read-only memory mapping.
+ *
+ * @param path Path to the file
+ * @param outHash Receives the digest
+ * @return true if the file could be read, false otherwise
+ */
+bool hashFileContents(const std::string& path, std::uint64_t& outHash);
+
+/**
+ * Format a 64-bit hash as 16 lowercase hex digits.
+ */
+[[nodiscard]] std::string hashToHex(std::uint64_t hash);
+
+} // namespace openmeters::common
@@ -0,0 +1,24 @@
+#pragma once
+
+// x86-64 builds can always use SSE2; AVX2 kernels are selected at runtime
+#if defined(__x86_64__) || defined(_M_X64)
+#define OPENMETERS_SIMD_X86 1
+#endif
+
+// GCC/Clang need per-function target attributes for AVX2; MSVC does not
+#if defined(OPENMETERS_SIMD_X86) && (defined(__GNUC__) || defined(__clang__))
+#define OPENMETERS_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define OPENMETERS_TARGET_AVX2
+#endif
+
+namespace openmeters::common {
+
+/**
+ * Check whether the CPU and OS support AVX2.
+ * Detected once; cheap to call afterwards.
+ * Always false on non-x86 targets.
+ */
+[[nodiscard]] bool cpuSupportsAvx2() noexcept;
+
+} // namespace openmeters::common
@@ -0,0 +1,162 @@
+#pragma once
+
+#include "resource-monitor.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+
+namespace openmeters::common {
+
+/**
+ * Single-producer, multi-consumer broadcast ring of small fixed-size events.
+ *
+ * Every consumer sees every event: consumers do not remove anything, they
+ * keep their own cursor (the index of the next event to read) and copy
+ * what was written since. The producer never waits. When a consumer
+ * falls more than capacity() events behind, the oldest events are
+ * overwritten and read() skips them and reports how many were lost.
+ *
+ * Each slot carries a sequence number that is odd while the slot is being
+ * written, so a reader racing the producer detects a torn copy and
+ * treats the event as lost.
+ *
+ * Thread safety: One producer thread calls push(); any number of threads
+ * call read() with their own cursor. reserve() must happen before either
+ * starts. push() never locks or allocates.
+ */
+template <typename T>
+class EventRing {
+    static_assert(std::is_trivially_copyable_v<T>, "Events are copied while the producer may write");
+
+public:
+    EventRing() = default;
+
+    /**
+     * @param tag Subsystem the ring storage is accounted to
+     */
+    explicit EventRing(MemoryTag tag) : m_tag(tag) {}
+
+    ~EventRing() {
+        if (m_slots) {
+            ResourceMonitor::trackRelease(m_tag, capacity() * sizeof(Slot));
+        }
+    }
+
+    // Non-copyable, non-movable
+    EventRing(const EventRing&) = delete;
+    EventRing& operator=(const EventRing&) = delete;
+    EventRing(EventRing&&) = delete;
+    EventRing& operator=(EventRing&&) = delete;
+
+    /**
+     * Allocate slots (rounded up to a power of two). Not real-time safe.
+     *
+     * @param eventCount Minimum number of events kept
+     * @return true if storage was allocated, false otherwise
+     */
+    bool reserve(std::size_t eventCount) {
+        if (m_slots || eventCount == 0) {
+            return false;
+        }
+        std::size_t count = 1;
+        while (count < eventCount) {
+            count <<= 1;
+        }
+        m_slots = std::make_unique<Slot[]>(count);
+        m_mask = count - 1;
+        ResourceMonitor::trackAllocation(m_tag, count * sizeof(Slot));
+        return true;
+    }
+
+    /**
+     * Append an event, overwriting the oldest one when the ring is full.
+     * Dropped silently if reserve() was never called.
+     *
+     * Thread: Producer
+     */
+    void push(const T& event) noexcept {
+        if (!m_slots) {
+            return;
+        }
+        const std::uint64_t index = m_writeIndex.load(std::memory_order_relaxed);
+        Slot& slot = m_slots[index & m_mask];
+        slot.sequence.store(index * 2 + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        slot.event = event;
+        slot.sequence.store(index * 2 + 2, std::memory_order_release);
+        m_writeIndex.store(index + 1, std::memory_order_release);
+    }
+
+    /**
+     * Copy the events written since cursor, oldest first.
+     *
+     * @param cursor Index of the next event to read (start at 0 or at
+     *        writeIndex() to skip history); advanced past what was read
+     *        and what was lost
+     * @param events Receives up to maxEvents events
+     * @param maxEvents Size of events
+     * @param lost If not null, receives the number of events that were
+     *        overwritten before they could be read
+     * @return Number of events copied
+     *
+     * Thread: Any consumer
+     */
+    std::size_t read(std::uint64_t& cursor, T* events, std::size_t maxEvents, std::uint64_t* lost = nullptr) const noexcept {
+        std::uint64_t skipped = 0;
+        std::size_t copied = 0;
+        const std::uint64_t end = m_writeIndex.load(std::memory_order_acquire);
+        if (cursor > end) {
+            cursor = end; // Not a cursor of this ring
+        }
+        if (m_slots && end - cursor > capacity()) {
+            skipped = end - capacity() - cursor;
+            cursor = end - capacity();
+        }
+        while (m_slots && cursor < end && copied < maxEvents) {
+            const Slot& slot = m_slots[cursor & m_mask];
+            const std::uint64_t expected = cursor * 2 + 2;
+            if (slot.sequence.load(std::memory_order_acquire) == expected) {
+                const T event = slot.event;
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (slot.sequence.load(std::memory_order_relaxed) == expected) {
+                    events[copied++] = event;
+                    ++cursor;
+                    continue;
+                }
+            }
+            ++skipped; // Overwritten while we were reading
+            ++cursor;
+        }
+        if (lost) {
+            *lost = skipped;
+        }
+        return copied;
+    }
+
+    /**
+     * Number of events pushed so far (the cursor that skips all history).
+     */
+    [[nodiscard]] std::uint64_t writeIndex() const noexcept {
+        return m_writeIndex.load(std::memory_order_acquire);
+    }
+
+    /**
+     * Number of events kept.
+     */
+    [[nodiscard]] std::size_t capacity() const noexcept { return m_slots ? m_mask + 1 : 0; }
+
+private:
+    struct Slot {
+        std::atomic<std::uint64_t> sequence{0};
+        T event{};
+    };
+
+    MemoryTag m_tag = MemoryTag::Other;
+    std::unique_ptr<Slot[]> m_slots;
+    std::size_t m_mask = 0;
+    alignas(64) std::atomic<std::uint64_t> m_writeIndex{0};
+};
+
+} // namespace openmeters::common
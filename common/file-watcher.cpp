@@ -0,0 +1,214 @@
+#include "file-watcher.h"
+#include "logger.h"
+#include <filesystem>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <algorithm>
+#include <cwctype>
+#elif defined(__linux__)
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace openmeters::common {
+
+namespace {
+
+constexpr std::chrono::milliseconds kPollInterval{50};
+
+// Wait between checks for stop() while no change is pending
+constexpr std::chrono::milliseconds kIdleInterval{250};
+
+#if !defined(_WIN32) && !defined(__linux__)
+std::chrono::nanoseconds lastWriteTime(const std::string& path) {
+    std::error_code error;
+    const auto time = std::filesystem::last_write_time(path, error);
+    return error ? std::chrono::nanoseconds(0) : std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch());
+}
+#endif
+
+} // namespace
+
+FileWatcher::~FileWatcher() {
+    stop();
+}
+
+bool FileWatcher::start(const std::string& path, std::function<void()> onChange) {
+    stop();
+
+    const std::filesystem::path filePath(path);
+    std::filesystem::path directory = filePath.parent_path();
+    if (directory.empty()) {
+        directory = ".";
+    }
+    m_path = path;
+    m_fileName = filePath.filename().string();
+    m_onChange = std::move(onChange);
+
+#ifdef _WIN32
+    m_directory = CreateFileW(
+        directory.wstring().c_str(),
+        FILE_LIST_DIRECTORY,
+        FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+        nullptr,
+        OPEN_EXISTING,
+        FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED,
+        nullptr
+    );
+    if (m_directory == INVALID_HANDLE_VALUE) {
+        m_directory = nullptr;
+        LOG_WARNING("Cannot watch directory: {}", directory.string());
+        return false;
+    }
+    m_event = CreateEventA(nullptr, TRUE, FALSE, nullptr);
+    m_overlapped = new OVERLAPPED{};
+    static_cast<OVERLAPPED*>(m_overlapped)->hEvent = m_event;
+    if (!m_event || !ReadDirectoryChangesW(m_directory, m_buffer, sizeof(m_buffer), FALSE,
+            FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_FILE_NAME, nullptr,
+            static_cast<OVERLAPPED*>(m_overlapped), nullptr)) {
+        LOG_WARNING("Cannot watch directory: {}", directory.string());
+        closeWatch();
+        return false;
+    }
+#elif defined(__linux__)
+    m_notifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (m_notifyFd < 0 || inotify_add_watch(m_notifyFd, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO) < 0) {
+        LOG_WARNING("Cannot watch directory: {}", directory.string());
+        closeWatch();
+        return false;
+    }
+#else
+    m_lastWrite = lastWriteTime(m_path);
+#endif
+
+    m_stop.store(false, std::memory_order_relaxed);
+    m_thread = std::thread(&FileWatcher::run, this);
+    return true;
+}
+
+void FileWatcher::stop() {
+    if (!m_thread.joinable()) {
+        return;
+    }
+    m_stop.store(true, std::memory_order_relaxed);
+    m_thread.join();
+    closeWatch();
+}
+
+void FileWatcher::run() {
+    bool pending = false;
+    auto lastEvent = std::chrono::steady_clock::now();
+    while (!m_stop.load(std::memory_order_relaxed)) {
+        if (waitForChange(pending ? kPollInterval : kIdleInterval)) {
+            pending = true;
+            lastEvent = std::chrono::steady_clock::now();
+        } else if (pending && std::chrono::steady_clock::now() - lastEvent >= kSettleTime) {
+            pending = false;
+            m_onChange();
+        }
+    }
+}
+
+#ifdef _WIN32
+
+bool FileWatcher::waitForChange(std::chrono::milliseconds timeout) {
+    auto* overlapped = static_cast<OVERLAPPED*>(m_overlapped);
+    if (WaitForSingleObject(m_event, static_cast<DWORD>(timeout.count())) != WAIT_OBJECT_0) {
+        return false;
+    }
+
+    DWORD bytes = 0;
+    const BOOL completed = GetOverlappedResult(m_directory, overlapped, &bytes, FALSE);
+    ResetEvent(m_event);
+
+    // No bytes means the notification buffer overflowed: assume it changed
+    bool changed = !completed || bytes == 0;
+    const std::wstring target = std::filesystem::path(m_fileName).wstring();
+    const auto sameName = [&](const WCHAR* name, std::size_t length) {
+        return length == target.size() && std::equal(name, name + length, target.begin(),
+            [](wchar_t a, wchar_t b) { return std::towlower(a) == std::towlower(b); });
+    };
+    for (std::size_t offset = 0; completed && bytes > 0 && !changed;) {
+        const auto* info = reinterpret_cast<const FILE_NOTIFY_INFORMATION*>(m_buffer + offset);
+        changed = sameName(info->FileName, info->FileNameLength / sizeof(WCHAR));
+        if (info->NextEntryOffset == 0) {
+            break;
+        }
+        offset += info->NextEntryOffset;
+    }
+
+    // Queue the next read before handling this one so no change is missed
+    ReadDirectoryChangesW(m_directory, m_buffer, sizeof(m_buffer), FALSE,
+        FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_FILE_NAME, nullptr, overlapped, nullptr);
+    return changed;
+}
+
+void FileWatcher::closeWatch() {
+    auto* overlapped = static_cast<OVERLAPPED*>(m_overlapped);
+    if (m_directory) {
+        if (overlapped) {
+            DWORD bytes = 0;
+            CancelIoEx(m_directory, overlapped);
+            GetOverlappedResult(m_directory, overlapped, &bytes, TRUE);
+        }
+        CloseHandle(m_directory);
+        m_directory = nullptr;
+    }
+    if (m_event) {
+        CloseHandle(m_event);
+        m_event = nullptr;
+    }
+    delete overlapped;
+    m_overlapped = nullptr;
+}
+
+#elif defined(__linux__)
+
+bool FileWatcher::waitForChange(std::chrono::milliseconds timeout) {
+    pollfd descriptor{m_notifyFd, POLLIN, 0};
+    if (poll(&descriptor, 1, static_cast<int>(timeout.count())) <= 0) {
+        return false;
+    }
+
+    alignas(inotify_event) char buffer[4096];
+    bool changed = false;
+    ssize_t bytes;
+    while ((bytes = read(m_notifyFd, buffer, sizeof(buffer))) > 0) {
+        for (ssize_t offset = 0; offset < bytes;) {
+            const auto* event = reinterpret_cast<const inotify_event*>(buffer + offset);
+            if ((event->mask & IN_Q_OVERFLOW) || (event->len > 0 && m_fileName == event->name)) {
+                changed = true;
+            }
+            offset += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+        }
+    }
+    return changed;
+}
+
+void FileWatcher::closeWatch() {
+    if (m_notifyFd >= 0) {
+        ::close(m_notifyFd);
+        m_notifyFd = -1;
+    }
+}
+
+#else
+
+bool FileWatcher::waitForChange(std::chrono::milliseconds timeout) {
+    std::this_thread::sleep_for(timeout);
+    const auto lastWrite = lastWriteTime(m_path);
+    if (lastWrite == m_lastWrite) {
+        return false;
+    }
+    m_lastWrite = lastWrite;
+    return true;
+}
+
+void FileWatcher::closeWatch() {
+}
+
+#endif
+
+} // namespace openmeters::common
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <string>
+#include <thread>
+
+namespace openmeters::common {
+
+/**
+ * Watches one file and calls back after it changes.
+ *
+ * The file's directory is watched (inotify on Linux,
+ * ReadDirectoryChangesW on Windows, modification-time polling elsewhere)
+ * so that editors which save by writing a temporary file and renaming it
+ * over the original are seen too. A burst of events (truncate, write,
+ * rename) is reported once, after the file has been quiet for kSettleTime.
+ *
+ * Thread safety: start() and stop() from one control thread. The callback
+ * runs on the watcher thread.
+ */
+class FileWatcher {
+public:
+    static constexpr std::chrono::milliseconds kSettleTime{100};
+
+    FileWatcher() = default;
+    ~FileWatcher();
+
+    // Non-copyable, non-movable
+    FileWatcher(const FileWatcher&) = delete;
+    FileWatcher& operator=(const FileWatcher&) = delete;
+    FileWatcher(FileWatcher&&) = delete;
+    FileWatcher& operator=(FileWatcher&&) = delete;
+
+    /**
+     * Start watching. The file does not need to exist yet; its directory does.
+     *
+     * @param path File to watch
+     * @param onChange Called on the watcher thread after each change
+     * @return true if the watch was set up, false otherwise
+     */
+    bool start(const std::string& path, std::function<void()> onChange);
+
+    /**
+     * Stop watching and join the watcher thread (waits for a running callback).
+     */
+    void stop();
+
+    [[nodiscard]] bool isRunning() const noexcept { return m_thread.joinable(); }
+
+private:
+    /**
+     * Watcher thread: collects events and calls back once they settle.
+     */
+    void run();
+
+    /**
+     * Wait up to timeout for an event on the watched file.
+     *
+     * @return true if the file changed
+     */
+    bool waitForChange(std::chrono::milliseconds timeout);
+
+    /**
+     * Release the OS watch handles.
+     */
+    void closeWatch();
+
+    std::string m_path;
+    std::string m_fileName;
+    std::function<void()> m_onChange;
+    std::thread m_thread;
+    std::atomic<bool> m_stop{false};
+
+#ifdef _WIN32
+    void* m_directory = nullptr;     // HANDLE opened with FILE_LIST_DIRECTORY
+    void* m_event = nullptr;         // Signalled when an overlapped read completes
+    void* m_overlapped = nullptr;    // OVERLAPPED for the pending read
+    alignas(8) unsigned char m_buffer[4096];
+#elif defined(__linux__)
+    int m_notifyFd = -1;
+#else
+    std::chrono::nanoseconds m_lastWrite{0}; // Modification time seen last (polling)
+#endif
+};
+
+} // namespace openmeters::common
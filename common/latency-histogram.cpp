@@ -0,0 +1,97 @@
+#include "latency-histogram.h"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <limits>
+
+namespace openmeters::common {
+
+LatencyHistogram::LatencyHistogram() {
+    reset();
+}
+
+std::size_t LatencyHistogram::bucketIndex(std::uint64_t value) noexcept {
+    if (value < kSubBuckets) {
+        return static_cast<std::size_t>(value);
+    }
+    // Top kSubBucketBits + 1 significant bits select the bucket
+    const unsigned shift = static_cast<unsigned>(std::bit_width(value)) - kSubBucketBits - 1;
+    const std::size_t sub = static_cast<std::size_t>(value >> shift) & (kSubBuckets - 1);
+    return (shift + 1) * kSubBuckets + sub;
+}
+
+std::uint64_t LatencyHistogram::bucketUpperBound(std::size_t index) noexcept {
+    if (index < kSubBuckets) {
+        return index;
+    }
+    const unsigned shift = static_cast<unsigned>(index / kSubBuckets) - 1;
+    const std::uint64_t base = (kSubBuckets | (index & (kSubBuckets - 1))) << shift;
+    return base + ((std::uint64_t{1} << shift) - 1);
+}
+
+void LatencyHistogram::record(std::uint64_t value) noexcept {
+    m_buckets[bucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+    m_count.fetch_add(1, std::memory_order_relaxed);
+    m_sum.fetch_add(value, std::memory_order_relaxed);
+
+    std::uint64_t current = m_min.load(std::memory_order_relaxed);
+    while (value < current && !m_min.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+    }
+    current = m_max.load(std::memory_order_relaxed);
+    while (value > current && !m_max.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+    }
+}
+
+std::uint64_t LatencyHistogram::valueAtPercentile(double percentile) const noexcept {
+    std::uint64_t total = 0;
+    for (const auto& bucket : m_buckets) {
+        total += bucket.load(std::memory_order_relaxed);
+    }
+    if (total == 0) {
+        return 0;
+    }
+
+    const double clamped = std::clamp(percentile, 0.0, 100.0);
+    const auto target = std::max<std::uint64_t>(1, static_cast<std::uint64_t>(std::ceil(clamped / 100.0 * static_cast<double>(total))));
+
+    std::uint64_t seen = 0;
+    for (std::size_t i = 0; i < kBucketCount; ++i) {
+        seen += m_buckets[i].load(std::memory_order_relaxed);
+        if (seen >= target) {
+            return std::min(bucketUpperBound(i), m_max.load(std::memory_order_relaxed));
+        }
+    }
+    return m_max.load(std::memory_order_relaxed);
+}
+
+LatencyHistogram::Summary LatencyHistogram::summarize() const noexcept {
+    Summary summary;
+    summary.count = m_count.load(std::memory_order_relaxed);
+    if (summary.count == 0) {
+        return summary;
+    }
+    summary.min = m_min.load(std::memory_order_relaxed);
+    summary.max = m_max.load(std::memory_order_relaxed);
+    summary.mean = static_cast<double>(m_sum.load(std::memory_order_relaxed)) / static_cast<double>(summary.count);
+    summary.p50 = valueAtPercentile(50.0);
+    summary.p90 = valueAtPercentile(90.0);
+    summary.p99 = valueAtPercentile(99.0);
+    summary.p999 = valueAtPercentile(99.9);
+    return summary;
+}
+
+std::uint64_t LatencyHistogram::count() const noexcept {
+    return m_count.load(std::memory_order_relaxed);
+}
+
+void LatencyHistogram::reset() noexcept {
+    for (auto& bucket : m_buckets) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+    m_count.store(0, std::memory_order_relaxed);
+    m_sum.store(0, std::memory_order_relaxed);
+    m_min.store(std::numeric_limits<std::uint64_t>::max(), std::memory_order_relaxed);
+    m_max.store(0, std::memory_order_relaxed);
+}
+
+} // namespace openmeters::common
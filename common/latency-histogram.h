@@ -0,0 +1,92 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace openmeters::common {
+
+/**
+ * Log-linear (HDR-style) histogram of durations in nanoseconds.
+ *
+ * Values below 16 are counted exactly; above that, each power of two is
+ * split into 16 sub-buckets, so any reported percentile is within ~6% of
+ * the true value across the full 64-bit range. Storage is fixed (~8 KB),
+ * and record() is a handful of relaxed atomic operations, so it can be
+ * called from real-time threads.
+ *
+ * Thread safety: record() from any number of threads; summarize() and
+ * reset() from any thread (a summary taken while recording is approximate).
+ */
+class LatencyHistogram {
+public:
+    /**
+     * Percentile summary of recorded values (all zero when empty).
+     */
+    struct Summary {
+        std::uint64_t count = 0;
+        std::uint64_t min = 0;
+        std::uint64_t max = 0;
+        double mean = 0.0;
+        std::uint64_t p50 = 0;
+        std::uint64_t p90 = 0;
+        std::uint64_t p99 = 0;
+        std::uint64_t p999 = 0;
+    };
+
+    LatencyHistogram();
+
+    // Non-copyable, non-movable
+    LatencyHistogram(const LatencyHistogram&) = delete;
+    LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+    LatencyHistogram(LatencyHistogram&&) = delete;
+    LatencyHistogram& operator=(LatencyHistogram&&) = delete;
+
+    /**
+     * Record one value. Lock-free and allocation-free.
+     *
+     * @param value Duration in nanoseconds
+     */
+    void record(std::uint64_t value) noexcept;
+
+    /**
+     * Value at a percentile (highest value equivalent to its bucket,
+     * clamped to the recorded maximum).
+     *
+     * @param percentile 0.0 to 100.0
+     * @return Value, or 0 if nothing was recorded
+     */
+    [[nodiscard]] std::uint64_t valueAtPercentile(double percentile) const noexcept;
+
+    /**
+     * Count, min/max/mean and the p50/p90/p99/p99.9 values.
+     */
+    [[nodiscard]] Summary summarize() const noexcept;
+
+    /**
+     * Number of recorded values.
+     */
+    [[nodiscard]] std::uint64_t count() const noexcept;
+
+    /**
+     * Forget all recorded values.
+     */
+    void reset() noexcept;
+
+private:
+    static constexpr unsigned kSubBucketBits = 4;
+    static constexpr std::size_t kSubBuckets = std::size_t{1} << kSubBucketBits;
+    static constexpr std::size_t kBucketCount = (64 - kSubBucketBits + 1) * kSubBuckets;
+
+    [[nodiscard]] static std::size_t bucketIndex(std::uint64_t value) noexcept;
+    [[nodiscard]] static std::uint64_t bucketUpperBound(std::size_t index) noexcept;
+
+    std::array<std::atomic<std::uint64_t>, kBucketCount> m_buckets;
+    std::atomic<std::uint64_t> m_count{0};
+    std::atomic<std::uint64_t> m_sum{0};
+    std::atomic<std::uint64_t> m_min;
+    std::atomic<std::uint64_t> m_max{0};
+};
+
+} // namespace openmeters::common
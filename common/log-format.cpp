@@ -0,0 +1,192 @@
+#include "log-format.h"
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+
+namespace openmeters::common {
+
+namespace {
+
+struct FormatSpec {
+    int precision = -1;
+    char type = 0;
+};
+
+FormatSpec parseSpec(std::string_view spec) {
+    FormatSpec result;
+    std::size_t pos = 0;
+    if (pos < spec.size() && spec[pos] == ':') {
+        ++pos;
+    }
+    if (pos < spec.size() && spec[pos] == '.') {
+        ++pos;
+        int precision = 0;
+        while (pos < spec.size() && spec[pos] >= '0' && spec[pos] <= '9') {
+            precision = precision * 10 + (spec[pos] - '0');
+            ++pos;
+        }
+        result.precision = std::min(precision, 30);
+    }
+    if (pos < spec.size()) {
+        result.type = spec[pos];
+    }
+    return result;
+}
+
+void appendArg(std::string& out, const LogArg& arg, const FormatSpec& spec) {
+    char buffer[64];
+    std::to_chars_result result{buffer, std::errc()};
+    switch (arg.type) {
+        case LogArg::Type::Int:
+            result = std::to_chars(buffer, buffer + sizeof(buffer), arg.i, spec.type == 'x' ? 16 : 10);
+            break;
+        case LogArg::Type::UInt:
+            result = std::to_chars(buffer, buffer + sizeof(buffer), arg.u, spec.type == 'x' ? 16 : 10);
+            break;
+        case LogArg::Type::Double:
+            if (spec.type == 'f' || spec.type == 'e' || spec.type == 'g' || spec.precision >= 0) {
+                const auto format = spec.type == 'e' ? std::chars_format::scientific
+                                  : spec.type == 'g' ? std::chars_format::general
+                                  : std::chars_format::fixed;
+                result = std::to_chars(buffer, buffer + sizeof(buffer), arg.d, format, spec.precision >= 0 ? spec.precision : 6);
+            } else {
+                result = std::to_chars(buffer, buffer + sizeof(buffer), arg.d); // Shortest round trip
+            }
+            break;
+        case LogArg::Type::Bool:
+            out += arg.b ? "true" : "false";
+            return;
+        case LogArg::Type::Char:
+            out += arg.c;
+            return;
+        case LogArg::Type::String:
+            out += arg.s;
+            return;
+    }
+    if (result.ec == std::errc()) {
+        out.append(buffer, result.ptr);
+    }
+}
+
+template <typename T>
+void put(std::uint8_t*& cursor, const T& value) noexcept {
+    std::memcpy(cursor, &value, sizeof(T));
+    cursor += sizeof(T);
+}
+
+template <typename T>
+T get(const std::uint8_t*& cursor) noexcept {
+    T value;
+    std::memcpy(&value, cursor, sizeof(T));
+    cursor += sizeof(T);
+    return value;
+}
+
+std::size_t payloadSize(LogArg::Type type) noexcept {
+    switch (type) {
+        case LogArg::Type::Bool:
+        case LogArg::Type::Char:
+            return 1;
+        case LogArg::Type::String:
+            return sizeof(std::uint16_t);
+        default:
+            return 8;
+    }
+}
+
+} // namespace
+
+void formatLogMessage(std::string& out, std::string_view pattern, const LogArg* args, std::size_t count) {
+    std::size_t next = 0;
+    std::size_t pos = 0;
+    while (pos < pattern.size()) {
+        const char ch = pattern[pos];
+        if (ch == '{' && pos + 1 < pattern.size() && pattern[pos + 1] == '{') {
+            out += '{';
+            pos += 2;
+        } else if (ch == '}' && pos + 1 < pattern.size() && pattern[pos + 1] == '}') {
+            out += '}';
+            pos += 2;
+        } else if (ch == '{') {
+            const std::size_t close = pattern.find('}', pos);
+            if (close == std::string_view::npos) {
+                out.append(pattern.substr(pos));
+                return;
+            }
+            if (next < count) {
+                appendArg(out, args[next++], parseSpec(pattern.substr(pos + 1, close - pos - 1)));
+            } else {
+                out.append(pattern.substr(pos, close - pos + 1));
+            }
+            pos = close + 1;
+        } else {
+            out += ch;
+            ++pos;
+        }
+    }
+}
+
+std::size_t encodeLogArgs(const LogArg* args, std::size_t count, std::uint8_t* buffer, std::size_t capacity, bool* truncated) noexcept {
+    std::uint8_t* cursor = buffer;
+    const std::uint8_t* end = buffer + capacity;
+    for (std::size_t i = 0; i < count; ++i) {
+        const LogArg& arg = args[i];
+        if (static_cast<std::size_t>(end - cursor) < 1 + payloadSize(arg.type)) {
+            *truncated = true;
+            break;
+        }
+        put(cursor, static_cast<std::uint8_t>(arg.type));
+        switch (arg.type) {
+            case LogArg::Type::Int:    put(cursor, arg.i); break;
+            case LogArg::Type::UInt:   put(cursor, arg.u); break;
+            case LogArg::Type::Double: put(cursor, arg.d); break;
+            case LogArg::Type::Bool:   put(cursor, static_cast<std::uint8_t>(arg.b)); break;
+            case LogArg::Type::Char:   put(cursor, arg.c); break;
+            case LogArg::Type::String: {
+                const std::size_t room = static_cast<std::size_t>(end - cursor) - sizeof(std::uint16_t);
+                const std::size_t length = std::min({arg.s.size(), room, std::size_t{0xFFFF}});
+                if (length < arg.s.size()) {
+                    *truncated = true;
+                }
+                put(cursor, static_cast<std::uint16_t>(length));
+                std::memcpy(cursor, arg.s.data(), length);
+                cursor += length;
+                break;
+            }
+        }
+    }
+    return static_cast<std::size_t>(cursor - buffer);
+}
+
+std::size_t decodeLogArgs(const std::uint8_t* buffer, std::size_t bytes, LogArg* args, std::size_t maxArgs) noexcept {
+    const std::uint8_t* cursor = buffer;
+    const std::uint8_t* end = buffer + bytes;
+    std::size_t count = 0;
+    while (count < maxArgs && cursor < end) {
+        const auto type = static_cast<LogArg::Type>(get<std::uint8_t>(cursor));
+        if (static_cast<std::size_t>(end - cursor) < payloadSize(type)) {
+            break;
+        }
+        LogArg& arg = args[count];
+        arg.type = type;
+        switch (type) {
+            case LogArg::Type::Int:    arg.i = get<std::int64_t>(cursor); break;
+            case LogArg::Type::UInt:   arg.u = get<std::uint64_t>(cursor); break;
+            case LogArg::Type::Double: arg.d = get<double>(cursor); break;
+            case LogArg::Type::Bool:   arg.b = get<std::uint8_t>(cursor) != 0; break;
+            case LogArg::Type::Char:   arg.c = get<char>(cursor); break;
+            case LogArg::Type::String: {
+                const std::size_t length = std::min<std::size_t>(get<std::uint16_t>(cursor), static_cast<std::size_t>(end - cursor));
+                arg.s = std::string_view(reinterpret_cast<const char*>(cursor), length);
+                cursor += length;
+                break;
+            }
+            default:
+                return count; // Corrupt record
+        }
+        ++count;
+    }
+    return count;
+}
+
+} // namespace openmeters::common
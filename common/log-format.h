@@ -0,0 +1,110 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace openmeters::common {
+
+/**
+ * One captured log argument. String arguments are views, so a LogArg must
+ * not outlive the value it was made from.
+ */
+struct LogArg {
+    enum class Type : std::uint8_t {
+        Int,
+        UInt,
+        Double,
+        Bool,
+        Char,
+        String
+    };
+
+    Type type = Type::Int;
+    union {
+        std::int64_t i;
+        std::uint64_t u;
+        double d;
+        bool b;
+        char c;
+    };
+    std::string_view s;
+
+    LogArg() : i(0) {}
+};
+
+/**
+ * Most arguments one log call can carry.
+ */
+inline constexpr std::size_t kMaxLogArgs = 16;
+
+/**
+ * Capture a value as a LogArg (integers, floating point, bool, char and
+ * strings; anything else must be converted by the caller).
+ */
+template <typename T>
+LogArg makeLogArg(const T& value) noexcept {
+    using U = std::decay_t<T>;
+    LogArg arg;
+    if constexpr (std::is_same_v<U, bool>) {
+        arg.type = LogArg::Type::Bool;
+        arg.b = value;
+    } else if constexpr (std::is_same_v<U, char>) {
+        arg.type = LogArg::Type::Char;
+        arg.c = value;
+    } else if constexpr (std::is_enum_v<U>) {
+        return makeLogArg(static_cast<std::underlying_type_t<U>>(value));
+    } else if constexpr (std::is_integral_v<U> && std::is_signed_v<U>) {
+        arg.type = LogArg::Type::Int;
+        arg.i = static_cast<std::int64_t>(value);
+    } else if constexpr (std::is_integral_v<U>) {
+        arg.type = LogArg::Type::UInt;
+        arg.u = static_cast<std::uint64_t>(value);
+    } else if constexpr (std::is_floating_point_v<U>) {
+        arg.type = LogArg::Type::Double;
+        arg.d = static_cast<double>(value);
+    } else if constexpr (std::is_array_v<T> && std::is_convertible_v<const T&, std::string_view>) {
+        arg.type = LogArg::Type::String;
+        arg.s = std::string_view(value);
+    } else if constexpr (std::is_same_v<U, const char*> || std::is_same_v<U, char*>) {
+        arg.type = LogArg::Type::String;
+        arg.s = value ? std::string_view(value) : std::string_view("(null)");
+    } else if constexpr (std::is_convertible_v<const T&, std::string_view>) {
+        arg.type = LogArg::Type::String; // std::string, std::string_view
+        arg.s = std::string_view(value);
+    } else {
+        static_assert(sizeof(T) == 0, "Unsupported log argument type; convert it to a string or number");
+    }
+    return arg;
+}
+
+/**
+ * Substitute arguments into a std::format-style pattern.
+ *
+ * Supports "{}" placeholders in order, "{{" / "}}" escapes and a small
+ * spec subset: "{:.3f}", "{:e}", "{:g}" for floating point and "{:x}"
+ * for integers. Placeholders without an argument are kept as written;
+ * extra arguments are ignored.
+ *
+ * @param out Receives the message (appended)
+ */
+void formatLogMessage(std::string& out, std::string_view pattern, const LogArg* args, std::size_t count);
+
+/**
+ * Serialize arguments into a compact binary form (type tag + value;
+ * strings copied inline). Strings are cut to fit the buffer.
+ *
+ * @return Bytes written; *truncated is set if anything did not fit
+ */
+std::size_t encodeLogArgs(const LogArg* args, std::size_t count, std::uint8_t* buffer, std::size_t capacity, bool* truncated) noexcept;
+
+/**
+ * Read arguments written by encodeLogArgs. String arguments view buffer.
+ *
+ * @return Number of arguments decoded
+ */
+std::size_t decodeLogArgs(const std::uint8_t* buffer, std::size_t bytes, LogArg* args, std::size_t maxArgs) noexcept;
+
+} // namespace openmeters::common
@@ -0,0 +1,275 @@
+#include "log-ring.h"
+#include "resource-monitor.h"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <new>
+#include <vector>
+
+namespace openmeters::common {
+
+namespace {
+
+constexpr char kMagic[8] = {'O', 'M', 'L', 'O', 'G', 'R', 'N', 'G'};
+constexpr std::uint32_t kVersion = 2;
+constexpr std::uint32_t kCommitMagic = 0x474C4D4F; // "OMLG"
+constexpr std::size_t kMaxRecordBytes = 4096;
+constexpr std::size_t kMaxArgBytes = 1024;
+constexpr std::size_t kMaxFileBytes = 255;
+
+constexpr std::uint8_t kFlagFormatted = 1;
+constexpr std::uint8_t kFlagTruncated = 2;
+
+// Precedes every record; records start 8-byte aligned
+struct RecordHeader {
+    std::uint64_t position;    // Ring position of this record (rejects stale laps)
+    std::uint32_t size;        // Header and payload, padded to 8 bytes
+    std::uint32_t commit;      // Checksum of the record (taken with commit = 0), stored last
+    std::int64_t timeNs;
+    std::uint32_t line;
+    std::uint16_t fileBytes;
+    std::uint16_t patternBytes;
+    std::uint16_t argBytes;
+    std::uint8_t level;
+    std::uint8_t flags;
+    std::uint32_t reserved;
+};
+static_assert(sizeof(RecordHeader) == 40, "RecordHeader layout");
+static_assert(offsetof(RecordHeader, commit) % 8 == 4, "Commit word must not straddle the ring end");
+
+// FNV-1a, continued across the pieces of a record
+constexpr std::uint32_t kHashBasis = 2166136261u;
+
+std::uint32_t hashBytes(std::uint32_t hash, const void* data, std::size_t bytes) noexcept {
+    const auto* in = static_cast<const std::uint8_t*>(data);
+    for (std::size_t i = 0; i < bytes; ++i) {
+        hash = (hash ^ in[i]) * 16777619u;
+    }
+    return hash;
+}
+
+const char* baseName(const char* path) noexcept {
+    const char* name = path;
+    for (const char* p = path; *p; ++p) {
+        if (*p == '/' || *p == '\\') {
+            name = p + 1;
+        }
+    }
+    return name;
+}
+
+} // namespace
+
+// Start of the ring file; the write position sits on its own cache line
+struct LogRing::FileHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t headerBytes;
+    std::uint64_t capacity;
+    alignas(64) std::atomic<std::uint64_t> writePos{0};
+};
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free, "Mapped write position must be address-free");
+
+namespace {
+constexpr std::size_t kHeaderBytes = 128;
+constexpr std::size_t kWritePosOffset = 64;
+} // namespace
+
+LogRing::~LogRing() {
+    close();
+}
+
+bool LogRing::open(const std::string& path, std::size_t capacityBytes) {
+    static_assert(sizeof(FileHeader) <= kHeaderBytes && offsetof(FileHeader, writePos) == kWritePosOffset);
+    close();
+
+    std::size_t capacity = kMinCapacity;
+    while (capacity < capacityBytes) {
+        capacity <<= 1;
+    }
+
+    // Keep the previous run's ring: it is the one worth reading after a crash
+    std::error_code error;
+    const std::filesystem::path ringPath(path);
+    if (std::filesystem::exists(ringPath, error)) {
+        std::filesystem::rename(ringPath, ringPath.string() + ".prev", error);
+    } else if (ringPath.has_parent_path()) {
+        std::filesystem::create_directories(ringPath.parent_path(), error);
+    }
+
+    if (!m_file.create(path, kHeaderBytes + capacity)) {
+        return false;
+    }
+
+    std::uint8_t* base = m_file.mutableData();
+    auto* header = new (base) FileHeader{};
+    std::memcpy(header->magic, kMagic, sizeof(kMagic));
+    header->version = kVersion;
+    header->headerBytes = static_cast<std::uint32_t>(kHeaderBytes);
+    header->capacity = capacity;
+
+    m_records = base + kHeaderBytes;
+    m_mask = capacity - 1;
+    m_header = header;
+    ResourceMonitor::trackAllocation(MemoryTag::Logging, m_file.size());
+    return true;
+}
+
+void LogRing::close() {
+    if (!m_header) {
+        return;
+    }
+    ResourceMonitor::trackRelease(MemoryTag::Logging, m_file.size());
+    m_file.flush();
+    m_file.close();
+    m_header = nullptr;
+    m_records = nullptr;
+    m_mask = 0;
+}
+
+std::uint64_t LogRing::bytesWritten() const noexcept {
+    return m_header ? m_header->writePos.load(std::memory_order_relaxed) : 0;
+}
+
+void LogRing::copyIn(std::uint64_t position, const void* source, std::size_t bytes) noexcept {
+    const std::size_t start = static_cast<std::size_t>(position) & m_mask;
+    const std::size_t firstChunk = std::min(bytes, m_mask + 1 - start);
+    const auto* in = static_cast<const std::uint8_t*>(source);
+    std::memcpy(m_records + start, in, firstChunk);
+    std::memcpy(m_records, in + firstChunk, bytes - firstChunk);
+}
+
+void LogRing::write(
+    std::uint8_t level,
+    std::int64_t timeNs,
+    const char* file,
+    int line,
+    std::string_view pattern,
+    const LogArg* args,
+    std::size_t count
+) noexcept {
+    if (!m_header) {
+        return;
+    }
+
+    RecordHeader header{};
+    header.timeNs = timeNs;
+    header.level = level;
+    header.line = line > 0 ? static_cast<std::uint32_t>(line) : 0;
+
+    const char* name = file ? baseName(file) : "";
+    header.fileBytes = static_cast<std::uint16_t>(std::min(std::strlen(name), kMaxFileBytes));
+
+    std::uint8_t argBuffer[kMaxArgBytes];
+    bool truncated = false;
+    if (args) {
+        header.flags |= kFlagFormatted;
+        header.argBytes = static_cast<std::uint16_t>(encodeLogArgs(args, count, argBuffer, sizeof(argBuffer), &truncated));
+    }
+
+    const std::size_t room = kMaxRecordBytes - sizeof(RecordHeader) - header.fileBytes - header.argBytes;
+    header.patternBytes = static_cast<std::uint16_t>(std::min(pattern.size(), room));
+    if (truncated || header.patternBytes < pattern.size()) {
+        header.flags |= kFlagTruncated;
+    }
+
+    const std::size_t payload = header.fileBytes + header.patternBytes + header.argBytes;
+    header.size = static_cast<std::uint32_t>((sizeof(RecordHeader) + payload + 7) & ~std::size_t{7});
+
+    // Claim, fill, then commit; the commit word tells the decoder the record is whole
+    const std::uint64_t position = m_header->writePos.fetch_add(header.size, std::memory_order_relaxed);
+    header.position = position;
+    header.commit = 0;
+    std::uint32_t hash = hashBytes(kHashBasis, &header, sizeof(header));
+    hash = hashBytes(hash, name, header.fileBytes);
+    hash = hashBytes(hash, pattern.data(), header.patternBytes);
+    hash = hashBytes(hash, argBuffer, header.argBytes);
+    copyIn(position, &header, sizeof(header));
+    std::uint64_t offset = position + sizeof(header);
+    copyIn(offset, name, header.fileBytes);
+    offset += header.fileBytes;
+    copyIn(offset, pattern.data(), header.patternBytes);
+    offset += header.patternBytes;
+    copyIn(offset, argBuffer, header.argBytes);
+
+    auto* commit = reinterpret_cast<std::uint32_t*>(m_records + ((position + offsetof(RecordHeader, commit)) & m_mask));
+    std::atomic_ref<std::uint32_t>(*commit).store(kCommitMagic ^ hash, std::memory_order_release);
+}
+
+long long LogRing::decode(const std::uint8_t* data, std::size_t size, const std::function<void(const LogRingRecord&)>& sink) {
+    if (!data || size < kHeaderBytes || std::memcmp(data, kMagic, sizeof(kMagic)) != 0) {
+        return -1;
+    }
+
+    std::uint32_t version;
+    std::uint32_t headerBytes;
+    std::uint64_t capacity;
+    std::uint64_t end;
+    std::memcpy(&version, data + offsetof(FileHeader, version), sizeof(version));
+    std::memcpy(&headerBytes, data + offsetof(FileHeader, headerBytes), sizeof(headerBytes));
+    std::memcpy(&capacity, data + offsetof(FileHeader, capacity), sizeof(capacity));
+    std::memcpy(&end, data + kWritePosOffset, sizeof(end));
+    if (version != kVersion || headerBytes != kHeaderBytes || capacity == 0 ||
+        (capacity & (capacity - 1)) != 0 || capacity > size - kHeaderBytes) {
+        return -1;
+    }
+
+    const std::uint8_t* records = data + kHeaderBytes;
+    const std::uint64_t mask = capacity - 1;
+    auto read = [&](std::uint64_t position, void* dest, std::size_t bytes) {
+        const std::size_t start = static_cast<std::size_t>(position & mask);
+        const std::size_t firstChunk = std::min<std::size_t>(bytes, capacity - start);
+        auto* out = static_cast<std::uint8_t*>(dest);
+        std::memcpy(out, records + start, firstChunk);
+        std::memcpy(out + firstChunk, records, bytes - firstChunk);
+    };
+
+    // Only the newest capacity bytes are intact; resynchronize on 8-byte
+    // boundaries past records that were cut by the wrap, torn or overwritten
+    std::vector<std::uint8_t> payload(kMaxRecordBytes);
+    LogArg args[kMaxLogArgs];
+    long long count = 0;
+    std::uint64_t position = end > capacity ? end - capacity : 0;
+    while (position + sizeof(RecordHeader) <= end) {
+        RecordHeader header;
+        read(position, &header, sizeof(header));
+        const std::size_t payloadBytes = static_cast<std::size_t>(header.fileBytes) + header.patternBytes + header.argBytes;
+        if (header.position != position || header.size > kMaxRecordBytes || header.size > end - position ||
+            sizeof(RecordHeader) + payloadBytes > header.size) {
+            position += 8;
+            continue;
+        }
+
+        // A writer a lap behind may have copied over the record after it
+        // was committed; the checksum catches that as well as a torn write
+        read(position + sizeof(header), payload.data(), payloadBytes);
+        RecordHeader hashed = header;
+        hashed.commit = 0;
+        const std::uint32_t hash = hashBytes(hashBytes(kHashBasis, &hashed, sizeof(hashed)), payload.data(), payloadBytes);
+        if (header.commit != (kCommitMagic ^ hash)) {
+            position += 8;
+            continue;
+        }
+        const auto* text = reinterpret_cast<const char*>(payload.data());
+        const std::string_view pattern(text + header.fileBytes, header.patternBytes);
+
+        LogRingRecord record;
+        record.timeNs = header.timeNs;
+        record.level = header.level;
+        record.file.assign(text, header.fileBytes);
+        record.line = header.line;
+        record.truncated = (header.flags & kFlagTruncated) != 0;
+        if (header.flags & kFlagFormatted) {
+            const std::size_t argCount = decodeLogArgs(payload.data() + header.fileBytes + header.patternBytes, header.argBytes, args, kMaxLogArgs);
+            formatLogMessage(record.message, pattern, args, argCount);
+        } else {
+            record.message.assign(pattern);
+        }
+        sink(record);
+        ++count;
+        position += header.size;
+    }
+    return count;
+}
+
+} // namespace openmeters::common
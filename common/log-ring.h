@@ -0,0 +1,121 @@
+#pragma once
+
+#include "log-format.h"
+#include "mapped-file.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+
+namespace openmeters::common {
+
+/**
+ * One record read back from a log ring file.
+ */
+struct LogRingRecord {
+    std::int64_t timeNs = 0;  // Wall clock, ns since the epoch
+    std::uint8_t level = 0;   // LogLevel value
+    std::string file;         // Source file name (no directory)
+    std::uint32_t line = 0;
+    std::string message;      // Formatted message
+    bool truncated = false;   // Message was cut to fit the record
+};
+
+/**
+ * Crash-safe binary log sink: a fixed-size ring in a memory-mapped file.
+ *
+ * Each log call claims space with one atomic add on the write position
+ * (kept in the mapped header) and memcpys a self-describing record: time,
+ * level, file name, line, pattern and encoded arguments. Nothing is
+ * formatted and no system call is made. Pages written this way belong to
+ * the OS, so the newest capacity bytes of records survive the process
+ * crashing; decode() (or the omlog_decode tool) turns them back into text.
+ * Old records are overwritten once the ring wraps.
+ *
+ * A record is valid only when its commit word, written last, matches a
+ * checksum of the record and its position; records torn by a crash,
+ * overwritten by a later lap, or partly overwritten by a writer that fell
+ * a lap behind are skipped.
+ *
+ * Thread safety: write() is lock-free and may be called from any number
+ * of threads, including real-time ones. open() and close() must not race
+ * with write().
+ */
+class LogRing {
+public:
+    static constexpr std::size_t kDefaultCapacity = 4 * 1024 * 1024;
+    static constexpr std::size_t kMinCapacity = 64 * 1024;
+
+    LogRing() = default;
+    ~LogRing();
+
+    // Non-copyable, non-movable
+    LogRing(const LogRing&) = delete;
+    LogRing& operator=(const LogRing&) = delete;
+    LogRing(LogRing&&) = delete;
+    LogRing& operator=(LogRing&&) = delete;
+
+    /**
+     * Create the ring file. An existing file at path (the previous run's
+     * ring) is first renamed to path + ".prev" so it can still be decoded.
+     *
+     * @param path Ring file path
+     * @param capacityBytes Record area size (rounded up to a power of two)
+     * @return true if the file was created and mapped, false otherwise
+     */
+    bool open(const std::string& path, std::size_t capacityBytes = kDefaultCapacity);
+
+    /**
+     * Unmap the file (its contents stay decodable).
+     */
+    void close();
+
+    [[nodiscard]] bool isOpen() const noexcept { return m_header != nullptr; }
+
+    /**
+     * Append a record.
+     *
+     * @param args Arguments substituted into pattern when decoded, or
+     *             nullptr to store pattern as the finished message
+     *
+     * Thread: Any
+     */
+    void write(
+        std::uint8_t level,
+        std::int64_t timeNs,
+        const char* file,
+        int line,
+        std::string_view pattern,
+        const LogArg* args,
+        std::size_t count
+    ) noexcept;
+
+    /**
+     * Total bytes written since open (including overwritten records).
+     */
+    [[nodiscard]] std::uint64_t bytesWritten() const noexcept;
+
+    /**
+     * Decode the valid records of a ring file image, oldest first.
+     *
+     * @param data File contents
+     * @param size File size in bytes
+     * @param sink Receives each record
+     * @return Number of records decoded, or -1 if data is not a log ring
+     */
+    static long long decode(const std::uint8_t* data, std::size_t size, const std::function<void(const LogRingRecord&)>& sink);
+
+private:
+    struct FileHeader;
+
+    void copyIn(std::uint64_t position, const void* source, std::size_t bytes) noexcept;
+
+    MappedFile m_file;
+    FileHeader* m_header = nullptr;
+    std::uint8_t* m_records = nullptr;
+    std::size_t m_mask = 0;
+};
+
+} // namespace openmeters::common
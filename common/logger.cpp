@@ -2,19 +2,89 @@
 #include <iostream>
 #include <filesystem>
 #include <algorithm>
+#include <cstring>
+#include <vector>
 
 namespace openmeters::common {
 
+namespace {
+
+constexpr std::size_t kQueueCells = 4096; // 512 KB of 128-byte cells
+constexpr std::size_t kMaxSites = 4096;
+constexpr auto kWriterIdleInterval = std::chrono::milliseconds(5);
+constexpr auto kWriterMaxIdleInterval = std::chrono::milliseconds(80); // Backed off to while nothing is logged
+
+// Fixed part of a queued record; the message bytes follow
+struct RecordHeader {
+    std::int64_t timeNs;     // Wall clock, ns since the epoch
+    std::uint32_t site;      // Call site ID (0 = none)
+    std::uint8_t level;
+    std::uint8_t truncated;  // Message was cut to fit the record
+    std::uint8_t formatted;  // Payload is a pattern pointer and encoded arguments
+    std::uint8_t reserved;
+};
+static_assert(sizeof(RecordHeader) == 16, "RecordHeader layout");
+
+constexpr std::size_t kMaxMessageBytes = MpscRecordQueue::kMaxRecordBytes - sizeof(RecordHeader);
+
+// Call sites (__FILE__, __LINE__) interned into a fixed open-addressing
+// table so records carry a 32-bit ID instead of a pointer and line
+struct LogSite {
+    std::atomic<std::uint32_t> state{0}; // 0 = empty, 1 = being written, 2 = ready
+    const char* file = nullptr;
+    int line = 0;
+};
+LogSite s_sites[kMaxSites];
+
+std::uint32_t internSite(const char* file, int line) noexcept {
+    if (!file) {
+        return 0;
+    }
+    const auto key = reinterpret_cast<std::uintptr_t>(file) ^ (static_cast<std::uintptr_t>(line) << 20);
+    const std::size_t start = static_cast<std::size_t>((key * 0x9E3779B97F4A7C15ull) >> 40);
+    for (std::size_t probe = 0; probe < kMaxSites; ++probe) {
+        const std::size_t index = (start + probe) % kMaxSites;
+        LogSite& site = s_sites[index];
+        std::uint32_t state = site.state.load(std::memory_order_acquire);
+        if (state == 0 && site.state.compare_exchange_strong(state, 1, std::memory_order_acquire)) {
+            site.file = file;
+            site.line = line;
+            site.state.store(2, std::memory_order_release);
+            return static_cast<std::uint32_t>(index + 1);
+        }
+        while (state == 1) {
+            state = site.state.load(std::memory_order_acquire); // Another thread is filling it in
+        }
+        if (site.file == file && site.line == line) {
+            return static_cast<std::uint32_t>(index + 1);
+        }
+    }
+    return 0; // Table full: logged without a location
+}
+
+} // namespace
+
 std::unique_ptr<std::ofstream> Logger::s_logFile = nullptr;
 std::recursive_mutex Logger::s_logMutex;
-LogLevel Logger::s_minLevel = LogLevel::Info;
+std::atomic<LogLevel> Logger::s_minLevel{LogLevel::Info};
 bool Logger::s_consoleEnabled = true;
 bool Logger::s_initialized = false;
 
+std::unique_ptr<MpscRecordQueue> Logger::s_queue;
+std::thread Logger::s_writer;
+std::atomic<bool> Logger::s_asyncActive{false};
+std::atomic<std::uint32_t> Logger::s_producers{0};
+std::atomic<bool> Logger::s_writerStop{false};
+std::atomic<std::uint64_t> Logger::s_dropped{0};
+
+std::unique_ptr<LogRing> Logger::s_ring;
+std::atomic<LogRing*> Logger::s_activeRing{nullptr};
+
 bool Logger::initialize(
     const std::string& logFilePath,
     LogLevel minLevel,
-    bool enableConsole
+    bool enableConsole,
+    LogMode mode
 ) {
     std::lock_guard<std::recursive_mutex> lock(s_logMutex);
     
@@ -22,7 +92,7 @@ bool Logger::initialize(
         return true; // Already initialized
     }
     
-    s_minLevel = minLevel;
+    s_minLevel.store(minLevel);
     s_consoleEnabled = enableConsole;
     
     // Create log directory if it doesn't exist
@@ -46,17 +116,49 @@ bool Logger::initialize(
     
     s_initialized = true;
     
+    if (mode == LogMode::Asynchronous) {
+        s_queue = std::make_unique<MpscRecordQueue>(MemoryTag::Logging);
+        s_queue->reserve(kQueueCells);
+        s_dropped.store(0);
+        s_writerStop.store(false);
+        s_writer = std::thread(&Logger::writerLoop);
+        s_asyncActive.store(true);
+    }
+    
     // Log initialization
-    info("Logger initialized - Log file: " + logFilePath);
+    info("Logger initialized - Log file: " + logFilePath +
+         (mode == LogMode::Asynchronous ? " (asynchronous)" : ""));
     
     return true;
 }
 
 void Logger::shutdown() {
+    bool drained = false;
+    if (s_asyncActive.load()) {
+        info("Logger shutting down");
+        
+        // Later calls write synchronously; wait out calls already queueing,
+        // then let the writer drain everything before it exits
+        s_asyncActive.store(false);
+        while (s_producers.load() != 0) {
+            std::this_thread::yield();
+        }
+        s_writerStop.store(true);
+        if (s_writer.joinable()) {
+            s_writer.join();
+        }
+        s_queue.reset();
+        drained = true;
+    }
+    
+    closeBinaryLog();
+    
     std::lock_guard<std::recursive_mutex> lock(s_logMutex);
     
     if (s_initialized && s_logFile) {
-        info("Logger shutting down");
+        if (!drained) {
+            info("Logger shutting down");
+        }
         s_logFile->flush();
         s_logFile->close();
         s_logFile.reset();
@@ -70,10 +172,36 @@ void Logger::log(
     const char* file,
     int line
 ) {
-    if (level < s_minLevel) {
+    if (!isEnabled(level)) {
         return; // Below minimum level
     }
     
+    writeBinary(level, file, line, message, nullptr, 0);
+    if (enqueue(level, file, line, message, nullptr, 0)) {
+        return;
+    }
+    writeLog(level, message, file, line);
+}
+
+void Logger::emit(
+    LogLevel level,
+    const char* file,
+    int line,
+    std::string_view pattern,
+    const LogArg* args,
+    std::size_t count
+) {
+    writeBinary(level, file, line, pattern, args, count);
+    if (enqueue(level, file, line, pattern, args, count)) {
+        return;
+    }
+    
+    std::string message;
+    if (args) {
+        formatLogMessage(message, pattern, args, count);
+    } else {
+        message.assign(pattern);
+    }
     writeLog(level, message, file, line);
 }
 
@@ -98,13 +226,198 @@ void Logger::fatal(const std::string& message, const char* file, int line) {
 }
 
 void Logger::setMinLevel(LogLevel level) {
-    std::lock_guard<std::recursive_mutex> lock(s_logMutex);
-    s_minLevel = level;
+    s_minLevel.store(level, std::memory_order_relaxed);
 }
 
 LogLevel Logger::getMinLevel() {
-    std::lock_guard<std::recursive_mutex> lock(s_logMutex);
-    return s_minLevel;
+    return s_minLevel.load(std::memory_order_relaxed);
+}
+
+std::uint64_t Logger::droppedMessages() {
+    return s_dropped.load(std::memory_order_relaxed);
+}
+
+bool Logger::openBinaryLog(const std::string& path, std::size_t capacityBytes) {
+    closeBinaryLog();
+    
+    auto ring = std::make_unique<LogRing>();
+    if (!ring->open(path, capacityBytes)) {
+        LOG_ERROR("Failed to create binary log: {}", path);
+        return false;
+    }
+    s_ring = std::move(ring);
+    s_activeRing.store(s_ring.get());
+    LOG_INFO("Binary log ring: {} ({} KB)", path, capacityBytes / 1024);
+    return true;
+}
+
+void Logger::closeBinaryLog() {
+    if (!s_activeRing.exchange(nullptr)) {
+        return;
+    }
+    while (s_producers.load() != 0) {
+        std::this_thread::yield();
+    }
+    s_ring.reset();
+}
+
+void Logger::writeBinary(
+    LogLevel level,
+    const char* file,
+    int line,
+    std::string_view pattern,
+    const LogArg* args,
+    std::size_t count
+) {
+    if (!s_activeRing.load(std::memory_order_relaxed)) {
+        return;
+    }
+    
+    // Same producer count as enqueue(), so closeBinaryLog() can wait out writers
+    s_producers.fetch_add(1);
+    if (LogRing* ring = s_activeRing.load()) {
+        const auto timeNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch()
+        ).count();
+        ring->write(static_cast<std::uint8_t>(level), timeNs, file, line, pattern, args, count);
+    }
+    s_producers.fetch_sub(1, std::memory_order_release);
+}
+
+bool Logger::enqueue(
+    LogLevel level,
+    const char* file,
+    int line,
+    std::string_view pattern,
+    const LogArg* args,
+    std::size_t count
+) {
+    // Registering as a producer before checking the mode lets shutdown()
+    // wait for every record that saw asynchronous mode
+    s_producers.fetch_add(1);
+    if (!s_asyncActive.load()) {
+        s_producers.fetch_sub(1);
+        return false;
+    }
+    
+    RecordHeader header{};
+    header.timeNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()
+    ).count();
+    header.site = internSite(file, line);
+    header.level = static_cast<std::uint8_t>(level);
+    
+    bool pushed;
+    if (args) {
+        // Pattern literal by address, arguments in binary; the writer formats
+        std::uint8_t payload[kMaxMessageBytes];
+        const char* patternData = pattern.data();
+        std::memcpy(payload, &patternData, sizeof(patternData));
+        bool truncated = false;
+        const std::size_t bytes = sizeof(patternData) +
+            encodeLogArgs(args, count, payload + sizeof(patternData), sizeof(payload) - sizeof(patternData), &truncated);
+        header.formatted = 1;
+        header.truncated = truncated ? 1 : 0;
+        pushed = s_queue->push(&header, sizeof(header), payload, bytes);
+    } else {
+        const std::size_t length = std::min(pattern.size(), kMaxMessageBytes);
+        header.truncated = length < pattern.size() ? 1 : 0;
+        pushed = s_queue->push(&header, sizeof(header), pattern.data(), length);
+    }
+    
+    if (!pushed) {
+        s_dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+    s_producers.fetch_sub(1, std::memory_order_release);
+    return true;
+}
+
+void Logger::writerLoop() {
+    ResourceMonitor::registerCurrentThread(ThreadRole::Logger);
+    
+    std::vector<std::uint8_t> record(MpscRecordQueue::kMaxRecordBytes);
+    std::string batch;
+    std::string message;
+    std::uint64_t reportedDrops = 0;
+    auto idleInterval = kWriterIdleInterval;
+    
+    for (;;) {
+        // Every push finished before shutdown() set the stop flag, so one
+        // more full drain after seeing it leaves the queue empty
+        const bool stopping = s_writerStop.load(std::memory_order_acquire);
+        
+        std::size_t written = 0;
+        {
+            std::lock_guard<std::recursive_mutex> lock(s_logMutex);
+            std::size_t bytes;
+            while ((bytes = s_queue->pop(record.data(), record.size())) != 0) {
+                RecordHeader header;
+                std::memcpy(&header, record.data(), sizeof(header));
+                const std::uint8_t* payload = record.data() + sizeof(header);
+                const std::size_t payloadBytes = bytes - sizeof(header);
+                if (header.formatted) {
+                    const char* pattern;
+                    std::memcpy(&pattern, payload, sizeof(pattern));
+                    LogArg args[kMaxLogArgs];
+                    const std::size_t count = decodeLogArgs(payload + sizeof(pattern), payloadBytes - sizeof(pattern), args, kMaxLogArgs);
+                    message.clear();
+                    formatLogMessage(message, pattern, args, count);
+                } else {
+                    message.assign(reinterpret_cast<const char*>(payload), payloadBytes);
+                }
+                if (header.truncated) {
+                    message += " [truncated]";
+                }
+                
+                const char* file = nullptr;
+                int line = 0;
+                if (header.site != 0) {
+                    file = s_sites[header.site - 1].file;
+                    line = s_sites[header.site - 1].line;
+                }
+                const auto time = std::chrono::system_clock::time_point(
+                    std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::nanoseconds(header.timeNs))
+                );
+                const auto level = static_cast<LogLevel>(header.level);
+                const std::string entry = formatEntry(level, time, file, line, message);
+                batch += entry;
+                if (s_consoleEnabled) {
+                    (level >= LogLevel::Error ? std::cerr : std::cout) << entry;
+                }
+                ++written;
+            }
+            
+            const std::uint64_t dropped = s_dropped.load(std::memory_order_relaxed);
+            if (dropped != reportedDrops) {
+                const std::string entry = formatEntry(LogLevel::Warning, std::chrono::system_clock::now(), nullptr, 0,
+                    "Log queue full - dropped " + std::to_string(dropped - reportedDrops) + " message(s)");
+                batch += entry;
+                if (s_consoleEnabled) {
+                    std::cout << entry;
+                }
+                reportedDrops = dropped;
+            }
+            
+            // One write and flush per batch
+            if (!batch.empty() && s_logFile && s_logFile->is_open()) {
+                *s_logFile << batch;
+                s_logFile->flush();
+            }
+            batch.clear();
+        }
+        
+        if (stopping) {
+            return;
+        }
+        // Poll less often the longer the queue stays empty, so an idle
+        // process is not woken 200 times a second
+        if (written == 0) {
+            std::this_thread::sleep_for(idleInterval);
+            idleInterval = std::min(idleInterval * 2, kWriterMaxIdleInterval);
+        } else {
+            idleInterval = kWriterIdleInterval;
+        }
+    }
 }
 
 void Logger::writeLog(
@@ -121,7 +434,17 @@ void Logger::writeLog(
         return;
     }
     
-    std::string timestamp = getTimestamp();
+    writeEntry(level, formatEntry(level, std::chrono::system_clock::now(), file, line, message));
+}
+
+std::string Logger::formatEntry(
+    LogLevel level,
+    std::chrono::system_clock::time_point time,
+    const char* file,
+    int line,
+    const std::string& message
+) {
+    std::string timestamp = getTimestamp(time);
     std::string levelStr = levelToString(level);
     
     // Format: [TIMESTAMP] [LEVEL] [FILE:LINE] MESSAGE
@@ -144,8 +467,10 @@ void Logger::writeLog(
     
     logLine << " " << message << std::endl;
     
-    std::string logEntry = logLine.str();
-    
+    return logLine.str();
+}
+
+void Logger::writeEntry(LogLevel level, const std::string& logEntry) {
     // Write to file
     if (s_logFile && s_logFile->is_open()) {
         *s_logFile << logEntry;
@@ -173,8 +498,7 @@ std::string Logger::levelToString(LogLevel level) {
     }
 }
 
-std::string Logger::getTimestamp() {
-    auto now = std::chrono::system_clock::now();
+std::string Logger::getTimestamp(std::chrono::system_clock::time_point now) {
     auto time = std::chrono::system_clock::to_time_t(now);
     auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
         now.time_since_epoch()
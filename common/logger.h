@@ -1,5 +1,8 @@
 #pragma once
 
+#include "log-format.h"
+#include "log-ring.h"
+#include "mpsc-queue.h"
 #include <string>
 #include <fstream>
 #include <mutex>
@@ -7,6 +10,9 @@
 #include <chrono>
 #include <iomanip>
 #include <sstream>
+#include <atomic>
+#include <cstdint>
+#include <thread>
 
 namespace openmeters::common {
 
@@ -21,11 +27,37 @@ enum class LogLevel {
     Fatal = 4
 };
 
+/**
+ * How log calls reach the file.
+ */
+enum class LogMode {
+    Synchronous, // Format and write on the calling thread
+    Asynchronous // Queue a binary record; a background thread formats and writes
+};
+
 /**
  * Simple file-based logger with console output.
  * Thread-safe logging system for production use.
+ *
+ * In asynchronous mode a log call copies level, wall-clock timestamp, call
+ * site ID and message into a bounded lock-free queue and returns. The
+ * writer thread formats queued records and writes them in batches. When
+ * the queue is full the record is dropped and counted; the writer reports
+ * drops in the log.
+ * 
+ * The LOG_* macros check the level (one relaxed atomic load) before
+ * evaluating their arguments, and take std::format-style patterns:
+ * LOG_DEBUG("packet of {} frames, peak {:.2f}", frames, peak). Arguments
+ * are formatted only when the message is written; in asynchronous mode
+ * that happens on the writer thread, so a formatted call allocates
+ * nothing. A single non-literal argument (e.g. a std::string built with
+ * +) is logged verbatim.
+ * 
+ * openBinaryLog() adds a crash-safe sink: every record is also copied
+ * into a memory-mapped ring file on the calling thread (see LogRing).
  * 
- * Thread safety: All logging operations are thread-safe.
+ * Thread safety: All logging operations are thread-safe. In asynchronous
+ * mode logging never locks.
  */
 class Logger {
 public:
@@ -35,16 +67,20 @@ public:
      * @param logFilePath Path to log file (e.g., "logs/openmeters.log")
      * @param minLevel Minimum log level to write (default: Info)
      * @param enableConsole Also write to console (default: true)
+     * @param mode Write on the calling thread or through the background writer
      * @return true if initialization succeeded, false otherwise
      */
     static bool initialize(
         const std::string& logFilePath,
         LogLevel minLevel = LogLevel::Info,
-        bool enableConsole = true
+        bool enableConsole = true,
+        LogMode mode = LogMode::Synchronous
     );
     
     /**
      * Shutdown the logger and close log file.
+     * In asynchronous mode every record queued before this call is written
+     * before the file is closed.
      */
     static void shutdown();
     
@@ -63,6 +99,40 @@ public:
         int line = 0
     );
     
+    /**
+     * Log a message built from a pattern and arguments (see LOG_* macros).
+     * The pattern must be a string literal: asynchronous records keep a
+     * pointer to it. Without arguments the pattern is logged verbatim.
+     */
+    template <std::size_t N, typename... Args>
+    static void logFormatted(LogLevel level, const char* file, int line, const char (&pattern)[N], const Args&... args) {
+        if (!isEnabled(level)) {
+            return;
+        }
+        if constexpr (sizeof...(Args) == 0) {
+            emit(level, file, line, std::string_view(pattern), nullptr, 0);
+        } else {
+            static_assert(sizeof...(Args) <= kMaxLogArgs, "Too many log arguments");
+            const LogArg captured[] = {makeLogArg(args)...};
+            emit(level, file, line, std::string_view(pattern), captured, sizeof...(Args));
+        }
+    }
+    
+    /**
+     * Log a prebuilt message verbatim (LOG_* with one non-literal argument).
+     */
+    static void logFormatted(LogLevel level, const char* file, int line, const std::string& message) {
+        log(level, message, file, line);
+    }
+    
+    /**
+     * Check whether a level passes the runtime minimum.
+     * Lock-free; the LOG_* macros call this before evaluating arguments.
+     */
+    [[nodiscard]] static bool isEnabled(LogLevel level) noexcept {
+        return level >= s_minLevel.load(std::memory_order_relaxed);
+    }
+    
     /**
      * Log a debug message.
      */
@@ -98,6 +168,22 @@ public:
      * Get current minimum log level.
      */
     static LogLevel getMinLevel();
+    
+    /**
+     * Records dropped because the asynchronous queue was full.
+     */
+    static std::uint64_t droppedMessages();
+    
+    /**
+     * Also write every record to a memory-mapped ring file that survives a
+     * crash; decode it with omlog_decode. The previous run's ring is kept
+     * as path + ".prev". Closed by shutdown().
+     *
+     * @param path Ring file path (e.g., "logs/openmeters.omlog")
+     * @param capacityBytes Size of the record area
+     * @return true if the ring was created, false otherwise
+     */
+    static bool openBinaryLog(const std::string& path, std::size_t capacityBytes = LogRing::kDefaultCapacity);
 
 private:
     Logger() = default;
@@ -110,22 +196,90 @@ private:
         int line
     );
     
+    static void emit(
+        LogLevel level,
+        const char* file,
+        int line,
+        std::string_view pattern,
+        const LogArg* args,
+        std::size_t count
+    );
+    
+    static void writeBinary(
+        LogLevel level,
+        const char* file,
+        int line,
+        std::string_view pattern,
+        const LogArg* args,
+        std::size_t count
+    );
+    
+    static void closeBinaryLog();
+    
+    static bool enqueue(
+        LogLevel level,
+        const char* file,
+        int line,
+        std::string_view pattern,
+        const LogArg* args,
+        std::size_t count
+    );
+    
+    static void writerLoop();
+    
+    static std::string formatEntry(
+        LogLevel level,
+        std::chrono::system_clock::time_point time,
+        const char* file,
+        int line,
+        const std::string& message
+    );
+    
+    static void writeEntry(LogLevel level, const std::string& entry);
+    
     static std::string levelToString(LogLevel level);
-    static std::string getTimestamp();
+    static std::string getTimestamp(std::chrono::system_clock::time_point time);
     
     static std::unique_ptr<std::ofstream> s_logFile;
     static std::recursive_mutex s_logMutex;
-    static LogLevel s_minLevel;
+    static std::atomic<LogLevel> s_minLevel;
     static bool s_consoleEnabled;
     static bool s_initialized;
+    
+    // Asynchronous mode
+    static std::unique_ptr<MpscRecordQueue> s_queue;
+    static std::thread s_writer;
+    static std::atomic<bool> s_asyncActive;     // Log calls go to the queue
+    static std::atomic<std::uint32_t> s_producers; // Log calls inside enqueue() or writeBinary()
+    static std::atomic<bool> s_writerStop;
+    static std::atomic<std::uint64_t> s_dropped;
+    
+    // Binary ring sink
+    static std::unique_ptr<LogRing> s_ring;
+    static std::atomic<LogRing*> s_activeRing;     // Null when closed
 };
 
+// Compile-time floor: calls below this level (0 = Debug ... 4 = Fatal)
+// are discarded entirely, arguments included
+#ifndef OPENMETERS_MIN_LOG_LEVEL
+#define OPENMETERS_MIN_LOG_LEVEL 0
+#endif
+
+#define OPENMETERS_LOG(level, ...)                                                                \
+    do {                                                                                          \
+        if constexpr (static_cast<int>(level) >= OPENMETERS_MIN_LOG_LEVEL) {                      \
+            if (openmeters::common::Logger::isEnabled(level)) {                                   \
+                openmeters::common::Logger::logFormatted(level, __FILE__, __LINE__, __VA_ARGS__); \
+            }                                                                                     \
+        }                                                                                         \
+    } while (0)
+
 // Convenience macros
-#define LOG_DEBUG(msg) openmeters::common::Logger::debug(msg, __FILE__, __LINE__)
-#define LOG_INFO(msg) openmeters::common::Logger::info(msg, __FILE__, __LINE__)
-#define LOG_WARNING(msg) openmeters::common::Logger::warning(msg, __FILE__, __LINE__)
-#define LOG_ERROR(msg) openmeters::common::Logger::error(msg, __FILE__, __LINE__)
-#define LOG_FATAL(msg) openmeters::common::Logger::fatal(msg, __FILE__, __LINE__)
+#define LOG_DEBUG(...) OPENMETERS_LOG(openmeters::common::LogLevel::Debug, __VA_ARGS__)
+#define LOG_INFO(...) OPENMETERS_LOG(openmeters::common::LogLevel::Info, __VA_ARGS__)
+#define LOG_WARNING(...) OPENMETERS_LOG(openmeters::common::LogLevel::Warning, __VA_ARGS__)
+#define LOG_ERROR(...) OPENMETERS_LOG(openmeters::common::LogLevel::Error, __VA_ARGS__)
+#define LOG_FATAL(...) OPENMETERS_LOG(openmeters::common::LogLevel::Fatal, __VA_ARGS__)
 
 } // namespace openmeters::common
 
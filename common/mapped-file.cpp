@@ -0,0 +1,258 @@
+#include "mapped-file.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace openmeters::common {
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept {
+    moveFrom(other);
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        close();
+        moveFrom(other);
+    }
+    return *this;
+}
+
+void MappedFile::moveFrom(MappedFile& other) noexcept {
+    m_data = other.m_data;
+    m_size = other.m_size;
+    m_open = other.m_open;
+    m_writable = other.m_writable;
+#ifdef _WIN32
+    m_fileHandle = other.m_fileHandle;
+    m_mappingHandle = other.m_mappingHandle;
+    other.m_fileHandle = nullptr;
+    other.m_mappingHandle = nullptr;
+#else
+    m_fd = other.m_fd;
+    other.m_fd = -1;
+#endif
+    other.m_data = nullptr;
+    other.m_size = 0;
+    other.m_open = false;
+    other.m_writable = false;
+}
+
+#ifdef _WIN32
+
+bool MappedFile::open(const std::string& path) {
+    close();
+
+    HANDLE file = CreateFileA(
+        path.c_str(),
+        GENERIC_READ,
+        FILE_SHARE_READ,
+        nullptr,
+        OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+        nullptr
+    );
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize)) {
+        CloseHandle(file);
+        return false;
+    }
+
+    m_fileHandle = file;
+    m_size = static_cast<std::size_t>(fileSize.QuadPart);
+    m_open = true;
+
+    if (m_size == 0) {
+        return true; // Nothing to map
+    }
+
+    m_mappingHandle = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!m_mappingHandle) {
+        close();
+        return false;
+    }
+
+    m_data = static_cast<const std::uint8_t*>(
+        MapViewOfFile(m_mappingHandle, FILE_MAP_READ, 0, 0, 0)
+    );
+    if (!m_data) {
+        close();
+        return false;
+    }
+
+    return true;
+}
+
+bool MappedFile::create(const std::string& path, std::size_t size) {
+    close();
+    if (size == 0) {
+        return false;
+    }
+
+    HANDLE file = CreateFileA(
+        path.c_str(),
+        GENERIC_READ | GENERIC_WRITE,
+        FILE_SHARE_READ,
+        nullptr,
+        CREATE_ALWAYS,
+        FILE_ATTRIBUTE_NORMAL,
+        nullptr
+    );
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+
+    m_fileHandle = file;
+    m_size = size;
+    m_open = true;
+
+    // Sizing the mapping extends the file
+    const auto size64 = static_cast<std::uint64_t>(size);
+    m_mappingHandle = CreateFileMappingA(
+        file, nullptr, PAGE_READWRITE,
+        static_cast<DWORD>(size64 >> 32), static_cast<DWORD>(size64 & 0xFFFFFFFFu), nullptr
+    );
+    if (!m_mappingHandle) {
+        close();
+        return false;
+    }
+
+    m_data = static_cast<const std::uint8_t*>(
+        MapViewOfFile(m_mappingHandle, FILE_MAP_WRITE, 0, 0, 0)
+    );
+    if (!m_data) {
+        close();
+        return false;
+    }
+
+    m_writable = true;
+    return true;
+}
+
+void MappedFile::flush() noexcept {
+    if (m_writable && m_data) {
+        FlushViewOfFile(m_data, 0);
+    }
+}
+
+void MappedFile::close() {
+    if (m_data) {
+        UnmapViewOfFile(m_data);
+        m_data = nullptr;
+    }
+    if (m_mappingHandle) {
+        CloseHandle(m_mappingHandle);
+        m_mappingHandle = nullptr;
+    }
+    if (m_fileHandle) {
+        CloseHandle(m_fileHandle);
+        m_fileHandle = nullptr;
+    }
+    m_size = 0;
+    m_open = false;
+    m_writable = false;
+}
+
+#else
+
+bool MappedFile::open(const std::string& path) {
+    close();
+
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat st {};
+    if (fstat(fd, &st) != 0) {
+        ::close(fd);
+        return false;
+    }
+
+    m_fd = fd;
+    m_size = static_cast<std::size_t>(st.st_size);
+    m_open = true;
+
+    if (m_size == 0) {
+        return true; // Nothing to map
+    }
+
+    void* mapping = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (mapping == MAP_FAILED) {
+        close();
+        return false;
+    }
+
+    // Sequential scans are the common case (hashing, decoding)
+    madvise(mapping, m_size, MADV_SEQUENTIAL);
+    m_data = static_cast<const std::uint8_t*>(mapping);
+
+    return true;
+}
+
+bool MappedFile::create(const std::string& path, std::size_t size) {
+    close();
+    if (size == 0) {
+        return false;
+    }
+
+    const int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        return false;
+    }
+    if (ftruncate(fd, static_cast<off_t>(size)) != 0) {
+        ::close(fd);
+        return false;
+    }
+
+    m_fd = fd;
+    m_size = size;
+    m_open = true;
+
+    void* mapping = mmap(nullptr, m_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (mapping == MAP_FAILED) {
+        close();
+        return false;
+    }
+
+    m_data = static_cast<const std::uint8_t*>(mapping);
+    m_writable = true;
+    return true;
+}
+
+void MappedFile::flush() noexcept {
+    if (m_writable && m_data) {
+        msync(const_cast<std::uint8_t*>(m_data), m_size, MS_ASYNC);
+    }
+}
+
+void MappedFile::close() {
+    if (m_data) {
+        munmap(const_cast<std::uint8_t*>(m_data), m_size);
+        m_data = nullptr;
+    }
+    if (m_fd >= 0) {
+        ::close(m_fd);
+        m_fd = -1;
+    }
+    m_size = 0;
+    m_open = false;
+    m_writable = false;
+}
+
+#endif
+
+} // namespace openmeters::common
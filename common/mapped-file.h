@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace openmeters::common {
+
+/**
+ * Memory-mapped file.
+ * Maps an entire file into the address space so it can be scanned without
+ * copying through stream buffers. Files made with create() are mapped
+ * shared and writable: stores go straight to the OS page cache and are
+ * kept even if the process crashes.
+ *
+ * Thread safety: Not thread-safe. The mapped bytes may be read concurrently.
+ */
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    // Non-copyable, movable
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    /**
+     * Map a file for reading.
+     * Empty files open successfully with a null data pointer.
+     *
+     * @param path Path to the file
+     * @return true if the file was mapped, false otherwise
+     */
+    bool open(const std::string& path);
+
+    /**
+     * Create (or truncate) a zero-filled file and map it for writing.
+     *
+     * @param path Path to the file
+     * @param size File size in bytes (must be non-zero)
+     * @return true if the file was created and mapped, false otherwise
+     */
+    bool create(const std::string& path, std::size_t size);
+
+    /**
+     * Ask the OS to start writing dirty pages back to disk (does not wait).
+     * Only needed for durability across power loss, not process crashes.
+     */
+    void flush() noexcept;
+
+    /**
+     * Unmap the file and release handles.
+     */
+    void close();
+
+    /**
+     * Pointer to the first mapped byte (nullptr if closed or empty).
+     */
+    [[nodiscard]] const std::uint8_t* data() const noexcept { return m_data; }
+
+    /**
+     * Writable pointer to the mapping (nullptr unless made with create()).
+     */
+    [[nodiscard]] std::uint8_t* mutableData() noexcept {
+        return m_writable ? const_cast<std::uint8_t*>(m_data) : nullptr;
+    }
+
+    /**
+     * Size of the mapping in bytes.
+     */
+    [[nodiscard]] std::size_t size() const noexcept { return m_size; }
+
+    /**
+     * Check if a file is currently open.
+     */
+    [[nodiscard]] bool isOpen() const noexcept { return m_open; }
+
+private:
+    void moveFrom(MappedFile& other) noexcept;
+
+    const std::uint8_t* m_data = nullptr;
+    std::size_t m_size = 0;
+    bool m_open = false;
+    bool m_writable = false;
+
+#ifdef _WIN32
+    void* m_fileHandle = nullptr;
+    void* m_mappingHandle = nullptr;
+#else
+    int m_fd = -1;
+#endif
+};
+
+} // namespace openmeters::common
@@ -0,0 +1,222 @@
+#include "meter-history.h"
+#include <algorithm>
+#include <cmath>
+
+namespace openmeters::common {
+
+MeterHistory::MeterHistory(MemoryTag tag) : m_tag(tag) {
+    configure({{10, 6000}, {1000, 3600}, {60000, 1440}});
+}
+
+MeterHistory::~MeterHistory() {
+    ResourceMonitor::trackRelease(m_tag, memoryBytes());
+}
+
+bool MeterHistory::configure(const std::vector<MeterHistoryLevel>& levels) {
+    for (const MeterHistoryLevel& level : levels) {
+        if (level.resolutionMs == 0 || level.bucketCount == 0) {
+            return false;
+        }
+    }
+
+    ResourceMonitor::trackRelease(m_tag, memoryBytes());
+    m_levels.clear();
+    for (const MeterHistoryLevel& config : levels) {
+        Level level;
+        level.config = config;
+        level.tree.assign(2 * static_cast<std::size_t>(config.bucketCount), Node{});
+        m_levels.push_back(std::move(level));
+    }
+    ResourceMonitor::trackAllocation(m_tag, memoryBytes());
+
+    m_newestMs = 0;
+    m_empty = true;
+    return true;
+}
+
+void MeterHistory::reset() noexcept {
+    for (Level& level : m_levels) {
+        std::fill(level.tree.begin(), level.tree.end(), Node{});
+        level.newestBucket = 0;
+    }
+    m_newestMs = 0;
+    m_empty = true;
+}
+
+void MeterHistory::add(const MeterSnapshot& snapshot) noexcept {
+    if (!m_empty && snapshot.timestampMs < m_newestMs) {
+        reset(); // Time went backwards: a new engine run
+    }
+    for (Level& level : m_levels) {
+        addToLevel(level, snapshot);
+    }
+    m_newestMs = snapshot.timestampMs;
+    m_empty = false;
+}
+
+void MeterHistory::addToLevel(Level& level, const MeterSnapshot& snapshot) noexcept {
+    const std::size_t count = level.config.bucketCount;
+    const std::uint64_t bucket = snapshot.timestampMs / level.config.resolutionMs;
+    const bool newBucket = m_empty || bucket != level.newestBucket;
+
+    if (!m_empty && newBucket) {
+        // Buckets skipped since the newest one hold stale data from a lap ago
+        if (bucket - level.newestBucket >= count) {
+            std::fill(level.tree.begin(), level.tree.end(), Node{});
+        } else {
+            for (std::uint64_t skipped = level.newestBucket + 1; skipped < bucket; ++skipped) {
+                setLeaf(level, static_cast<std::size_t>(skipped % count), Node{});
+            }
+        }
+    }
+
+    Node sample;
+    sample.peakMax[0] = snapshot.peak.left;
+    sample.peakMax[1] = snapshot.peak.right;
+    sample.rmsMax[0] = sample.rmsMin[0] = snapshot.rms.left;
+    sample.rmsMax[1] = sample.rmsMin[1] = snapshot.rms.right;
+    sample.energy[0] = static_cast<double>(snapshot.rms.left) * snapshot.rms.left;
+    sample.energy[1] = static_cast<double>(snapshot.rms.right) * snapshot.rms.right;
+    sample.snapshots = 1;
+
+    const auto slot = static_cast<std::size_t>(bucket % count);
+    Node leaf = newBucket ? Node{} : level.tree[count + slot];
+    combine(leaf, sample);
+    setLeaf(level, slot, leaf);
+    level.newestBucket = bucket;
+}
+
+void MeterHistory::setLeaf(Level& level, std::size_t slot, const Node& node) noexcept {
+    // Bottom-up tree: node i combines 2i and 2i+1 (any leaf count works, the ops commute)
+    std::size_t i = level.config.bucketCount + slot;
+    level.tree[i] = node;
+    for (; i > 1; i >>= 1) {
+        Node parent = level.tree[i];
+        combine(parent, level.tree[i ^ 1]);
+        level.tree[i >> 1] = parent;
+    }
+}
+
+void MeterHistory::combine(Node& into, const Node& from) noexcept {
+    if (from.snapshots == 0) {
+        return;
+    }
+    if (into.snapshots == 0) {
+        into = from;
+        return;
+    }
+    for (int ch = 0; ch < 2; ++ch) {
+        into.peakMax[ch] = std::max(into.peakMax[ch], from.peakMax[ch]);
+        into.rmsMax[ch] = std::max(into.rmsMax[ch], from.rmsMax[ch]);
+        into.rmsMin[ch] = std::min(into.rmsMin[ch], from.rmsMin[ch]);
+        into.energy[ch] += from.energy[ch];
+    }
+    into.snapshots += from.snapshots;
+}
+
+MeterAggregate MeterHistory::toAggregate(const Node& node) noexcept {
+    MeterAggregate aggregate;
+    aggregate.snapshots = node.snapshots;
+    if (node.snapshots == 0) {
+        return aggregate;
+    }
+    aggregate.peakMax = {node.peakMax[0], node.peakMax[1]};
+    aggregate.rmsMax = {node.rmsMax[0], node.rmsMax[1]};
+    aggregate.rmsMin = {node.rmsMin[0], node.rmsMin[1]};
+    aggregate.rmsMean = {static_cast<float>(std::sqrt(node.energy[0] / node.snapshots)),
+                         static_cast<float>(std::sqrt(node.energy[1] / node.snapshots))};
+    return aggregate;
+}
+
+MeterHistory::Node MeterHistory::querySlots(const Level& level, std::size_t begin, std::size_t end) const noexcept {
+    Node result;
+    const std::size_t count = level.config.bucketCount;
+    for (std::size_t l = begin + count, r = end + count; l < r; l >>= 1, r >>= 1) {
+        if (l & 1) {
+            combine(result, level.tree[l++]);
+        }
+        if (r & 1) {
+            combine(result, level.tree[--r]);
+        }
+    }
+    return result;
+}
+
+MeterHistory::Node MeterHistory::queryBuckets(const Level& level, std::uint64_t first, std::uint64_t last) const noexcept {
+    // The buckets occupy a contiguous run of ring slots, possibly wrapping
+    const std::size_t count = level.config.bucketCount;
+    const auto begin = static_cast<std::size_t>(first % count);
+    const auto end = static_cast<std::size_t>(last % count);
+    if (begin <= end) {
+        return querySlots(level, begin, end + 1);
+    }
+    Node result = querySlots(level, begin, count);
+    combine(result, querySlots(level, 0, end + 1));
+    return result;
+}
+
+MeterAggregate MeterHistory::query(std::uint64_t fromMs, std::uint64_t toMs) const noexcept {
+    if (m_empty || m_levels.empty() || toMs <= fromMs) {
+        return {};
+    }
+
+    // Finest level whose ring still reaches back to fromMs
+    const Level* chosen = &m_levels.back();
+    std::uint64_t oldest = 0;
+    for (const Level& level : m_levels) {
+        const std::uint64_t span = level.config.bucketCount - 1;
+        oldest = level.newestBucket > span ? level.newestBucket - span : 0;
+        if (fromMs / level.config.resolutionMs >= oldest) {
+            chosen = &level;
+            break;
+        }
+    }
+    const std::uint64_t span = chosen->config.bucketCount - 1;
+    oldest = chosen->newestBucket > span ? chosen->newestBucket - span : 0;
+
+    const std::uint32_t resolution = chosen->config.resolutionMs;
+    const std::uint64_t first = std::max(fromMs / resolution, oldest);
+    const std::uint64_t last = std::min((toMs - 1) / resolution, chosen->newestBucket);
+    if (first > last) {
+        return {};
+    }
+
+    MeterAggregate aggregate = toAggregate(queryBuckets(*chosen, first, last));
+    aggregate.startMs = first * resolution;
+    aggregate.endMs = (last + 1) * resolution;
+    return aggregate;
+}
+
+MeterAggregate MeterHistory::queryLast(std::uint64_t durationMs) const noexcept {
+    const std::uint64_t toMs = m_newestMs + 1;
+    return query(toMs > durationMs ? toMs - durationMs : 0, toMs);
+}
+
+std::size_t MeterHistory::copyBuckets(std::size_t levelIndex, std::size_t count, MeterAggregate* dest) const noexcept {
+    if (m_empty || levelIndex >= m_levels.size() || !dest) {
+        return 0;
+    }
+
+    const Level& level = m_levels[levelIndex];
+    const std::size_t held = static_cast<std::size_t>(
+        std::min<std::uint64_t>(level.config.bucketCount, level.newestBucket + 1));
+    count = std::min(count, held);
+    const std::uint64_t first = level.newestBucket + 1 - count;
+    for (std::size_t i = 0; i < count; ++i) {
+        const std::uint64_t bucket = first + i;
+        dest[i] = toAggregate(level.tree[level.config.bucketCount + bucket % level.config.bucketCount]);
+        dest[i].startMs = bucket * level.config.resolutionMs;
+        dest[i].endMs = dest[i].startMs + level.config.resolutionMs;
+    }
+    return count;
+}
+
+std::size_t MeterHistory::memoryBytes() const noexcept {
+    std::size_t bytes = 0;
+    for (const Level& level : m_levels) {
+        bytes += level.tree.size() * sizeof(Node);
+    }
+    return bytes;
+}
+
+} // namespace openmeters::common
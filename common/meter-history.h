@@ -0,0 +1,147 @@
+#pragma once
+
+#include "meter-values.h"
+#include "resource-monitor.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace openmeters::common {
+
+/**
+ * Resolution and length of one MeterHistory level.
+ */
+struct MeterHistoryLevel {
+    std::uint32_t resolutionMs = 0; // Bucket width
+    std::uint32_t bucketCount = 0;  // Buckets kept (span = resolutionMs * bucketCount)
+};
+
+/**
+ * Meter values aggregated over a span of time: one bucket, or a range.
+ * RMS means are power averages (energy mean, then root), so they read as
+ * the RMS level over the whole span.
+ */
+struct MeterAggregate {
+    PeakValue peakMax;     // Highest packet peak
+    RmsValue rmsMax;       // Highest RMS reading
+    RmsValue rmsMin;       // Lowest RMS reading
+    RmsValue rmsMean;      // Power mean of the RMS readings
+    std::uint64_t startMs = 0;   // Start of the first bucket covered
+    std::uint64_t endMs = 0;     // End of the last bucket covered
+    std::uint32_t snapshots = 0; // Snapshots aggregated (0: nothing recorded in the span)
+};
+
+/**
+ * Scrolling history of meter snapshots at several resolutions (by default
+ * 10 ms for 1 minute, 1 s for 1 hour and 1 min for 24 hours).
+ *
+ * Each level is a ring of fixed-width time buckets holding peak maximum,
+ * RMS minimum/maximum and RMS energy, so memory is bounded and
+ * preallocated. A segment tree over each ring answers range queries such
+ * as "max peak over the last 10 s" in O(log n) without rescanning
+ * snapshots; add() updates one leaf and its ancestors per level.
+ *
+ * Buckets are addressed by snapshot time (MeterSnapshot::timestampMs).
+ * Buckets without snapshots read as empty. A timestamp earlier than the
+ * newest one (engine restart) clears the history.
+ *
+ * Thread safety: Not thread-safe. add() and the queries must be
+ * serialized by the caller. add() never allocates.
+ */
+class MeterHistory {
+public:
+    /**
+     * Default levels: 10 ms x 6000, 1 s x 3600, 1 min x 1440.
+     *
+     * @param tag Subsystem the history storage is accounted to
+     */
+    explicit MeterHistory(MemoryTag tag = MemoryTag::Other);
+    ~MeterHistory();
+
+    // Non-copyable, non-movable
+    MeterHistory(const MeterHistory&) = delete;
+    MeterHistory& operator=(const MeterHistory&) = delete;
+    MeterHistory(MeterHistory&&) = delete;
+    MeterHistory& operator=(MeterHistory&&) = delete;
+
+    /**
+     * Replace the levels (clears the history). Not real-time safe.
+     *
+     * @param levels Levels from finest to coarsest; zero widths or counts are rejected
+     * @return true if configured, false if a level is invalid
+     */
+    bool configure(const std::vector<MeterHistoryLevel>& levels);
+
+    /**
+     * Add a snapshot to the bucket its timestamp falls in, at every level.
+     */
+    void add(const MeterSnapshot& snapshot) noexcept;
+
+    /**
+     * Aggregate over [fromMs, toMs), widened to whole buckets of the
+     * finest level that still holds fromMs (the coarsest one if none
+     * does). Parts of the range outside the history are left out.
+     */
+    [[nodiscard]] MeterAggregate query(std::uint64_t fromMs, std::uint64_t toMs) const noexcept;
+
+    /**
+     * Aggregate over the last durationMs up to the newest snapshot.
+     */
+    [[nodiscard]] MeterAggregate queryLast(std::uint64_t durationMs) const noexcept;
+
+    /**
+     * Copy the newest buckets of one level, oldest first (for graphs).
+     *
+     * @param level Index into the configured levels
+     * @param count Buckets wanted
+     * @param dest Receives min(count, buckets held) buckets, ending with
+     *        the bucket of the newest snapshot
+     * @return Number of buckets copied
+     */
+    std::size_t copyBuckets(std::size_t level, std::size_t count, MeterAggregate* dest) const noexcept;
+
+    /**
+     * Forget every snapshot (levels are kept).
+     */
+    void reset() noexcept;
+
+    [[nodiscard]] std::size_t levelCount() const noexcept { return m_levels.size(); }
+    [[nodiscard]] const MeterHistoryLevel& level(std::size_t index) const noexcept { return m_levels[index].config; }
+
+    /**
+     * Timestamp of the newest snapshot (0 if empty).
+     */
+    [[nodiscard]] std::uint64_t newestMs() const noexcept { return m_newestMs; }
+
+private:
+    // Segment tree node: what range queries combine
+    struct Node {
+        float peakMax[2] = {0.0f, 0.0f};
+        float rmsMax[2] = {0.0f, 0.0f};
+        float rmsMin[2] = {0.0f, 0.0f};
+        double energy[2] = {0.0, 0.0}; // Sum of squared RMS readings
+        std::uint32_t snapshots = 0;
+    };
+
+    struct Level {
+        MeterHistoryLevel config;
+        std::vector<Node> tree;          // Leaves at [bucketCount, 2 * bucketCount)
+        std::uint64_t newestBucket = 0;  // Bucket index (timestampMs / resolutionMs)
+    };
+
+    static void combine(Node& into, const Node& from) noexcept;
+    static MeterAggregate toAggregate(const Node& node) noexcept;
+
+    void addToLevel(Level& level, const MeterSnapshot& snapshot) noexcept;
+    void setLeaf(Level& level, std::size_t slot, const Node& node) noexcept;
+    Node queryBuckets(const Level& level, std::uint64_t first, std::uint64_t last) const noexcept;
+    Node querySlots(const Level& level, std::size_t begin, std::size_t end) const noexcept;
+    std::size_t memoryBytes() const noexcept;
+
+    MemoryTag m_tag = MemoryTag::Other;
+    std::vector<Level> m_levels;
+    std::uint64_t m_newestMs = 0;
+    bool m_empty = true;
+};
+
+} // namespace openmeters::common
@@ -0,0 +1,499 @@
+#include "meter-log.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace openmeters::common {
+
+namespace {
+
+constexpr std::uint32_t kFormatVersion = 1;
+constexpr std::size_t kColumnCount = 5;
+constexpr std::uint64_t kMaxTimestampMs = 1ull << 61; // Keeps delta-of-delta codes within 63 bits
+
+// Worst case per entry: a 10-byte timestamp varint and four 5-byte level varints
+constexpr std::size_t kMaxEntryBytes = 10 + 4 * 5;
+
+void writeVarint(std::vector<std::uint8_t>& out, std::uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<std::uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<std::uint8_t>(value));
+}
+
+std::uint64_t zigzag(std::int64_t value) noexcept {
+    return (static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63);
+}
+
+std::int64_t unzigzag(std::uint64_t value) noexcept {
+    return static_cast<std::int64_t>(value >> 1) ^ -static_cast<std::int64_t>(value & 1);
+}
+
+// Column values as tagged varints: literal (low bit 0) or a run of zeros (low bit 1)
+class RunEncoder {
+public:
+    explicit RunEncoder(std::vector<std::uint8_t>& out) : m_out(out) {}
+
+    void put(std::int64_t value) {
+        if (value == 0) {
+            ++m_zeros;
+            return;
+        }
+        finish();
+        writeVarint(m_out, zigzag(value) << 1);
+    }
+
+    void finish() {
+        if (m_zeros != 0) {
+            writeVarint(m_out, (m_zeros << 1) | 1);
+            m_zeros = 0;
+        }
+    }
+
+private:
+    std::vector<std::uint8_t>& m_out;
+    std::uint64_t m_zeros = 0;
+};
+
+class RunDecoder {
+public:
+    RunDecoder(const std::uint8_t* data, std::size_t size) : m_pos(data), m_end(data + size) {}
+
+    bool next(std::int64_t& value) noexcept {
+        if (m_zeros == 0) {
+            std::uint64_t raw = 0;
+            if (!readVarint(raw)) {
+                return false;
+            }
+            if ((raw & 1) == 0) {
+                value = unzigzag(raw >> 1);
+                return true;
+            }
+            m_zeros = raw >> 1;
+            if (m_zeros == 0) {
+                return false;
+            }
+        }
+        --m_zeros;
+        value = 0;
+        return true;
+    }
+
+    // Every byte consumed and no run left over
+    [[nodiscard]] bool finished() const noexcept { return m_zeros == 0 && m_pos == m_end; }
+
+private:
+    bool readVarint(std::uint64_t& value) noexcept {
+        value = 0;
+        for (int shift = 0; shift < 64 && m_pos < m_end; shift += 7) {
+            const std::uint8_t byte = *m_pos++;
+            value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    const std::uint8_t* m_pos;
+    const std::uint8_t* m_end;
+    std::uint64_t m_zeros = 0;
+};
+
+std::int32_t toCode(float linear, double step, const MeterLogHeader& header) noexcept {
+    if (!(linear > 0.0f)) {
+        return header.floorCode;
+    }
+    const double code = std::round(20.0 * std::log10(static_cast<double>(linear)) / step);
+    return static_cast<std::int32_t>(std::clamp(code, static_cast<double>(header.floorCode),
+                                                static_cast<double>(header.ceilingCode)));
+}
+
+float fromCode(std::int64_t code, double step, const MeterLogHeader& header) noexcept {
+    if (code <= header.floorCode) {
+        return 0.0f;
+    }
+    return static_cast<float>(std::pow(10.0, static_cast<double>(code) * step / 20.0));
+}
+
+float levelColumn(const MeterLogEntry& entry, std::size_t column) noexcept {
+    switch (column) {
+        case 1:  return entry.peak.left;
+        case 2:  return entry.peak.right;
+        case 3:  return entry.rms.left;
+        default: return entry.rms.right;
+    }
+}
+
+float& levelColumn(MeterLogEntry& entry, std::size_t column) noexcept {
+    switch (column) {
+        case 1:  return entry.peak.left;
+        case 2:  return entry.peak.right;
+        case 3:  return entry.rms.left;
+        default: return entry.rms.right;
+    }
+}
+
+} // namespace
+
+MeterLogWriter::MeterLogWriter(MemoryTag tag) : m_tag(tag) {}
+
+MeterLogWriter::~MeterLogWriter() {
+    close();
+    ResourceMonitor::trackRelease(m_tag, bufferBytes());
+}
+
+bool MeterLogWriter::open(const std::string& path, std::uint32_t intervalMs, double dbStep) {
+    if (isOpen() || !(dbStep >= 0.001 && dbStep <= 10.0)) {
+        return false;
+    }
+
+    if (m_entries.capacity() == 0) {
+        m_entries.reserve(kChunkEntries);
+        m_encoded.reserve(sizeof(MeterLogChunkHeader) + kChunkEntries * kMaxEntryBytes);
+        ResourceMonitor::trackAllocation(m_tag, bufferBytes());
+    }
+
+    m_header = MeterLogHeader{};
+    m_header.version = kFormatVersion;
+    m_header.intervalMs = intervalMs;
+    m_header.stepMilliDb = static_cast<std::uint32_t>(std::lround(dbStep * 1000.0));
+    m_dbStep = m_header.stepMilliDb / 1000.0;
+    m_header.floorCode = static_cast<std::int32_t>(std::lround(kFloorDb / m_dbStep));
+    m_header.ceilingCode = static_cast<std::int32_t>(std::lround(kCeilingDb / m_dbStep));
+    m_header.chunkEntries = kChunkEntries;
+
+    if (!m_file.create(path) || !m_file.writeAt(0, &m_header, sizeof(m_header))) {
+        m_file.close();
+        return false;
+    }
+    m_offset = sizeof(m_header);
+    m_entryCount = 0;
+    m_failed = false;
+    m_entries.clear();
+    m_index.clear();
+    m_pending = false;
+    return true;
+}
+
+bool MeterLogWriter::add(const MeterSnapshot& snapshot) {
+    if (!isOpen()) {
+        return false;
+    }
+    if (m_header.intervalMs == 0) {
+        return append({snapshot.timestampMs, snapshot.peak, snapshot.rms});
+    }
+
+    bool ok = true;
+    const std::uint64_t interval = snapshot.timestampMs / m_header.intervalMs;
+    if (m_pending && interval != m_pendingInterval) {
+        ok = appendPending();
+    }
+
+    const double energy[2] = {static_cast<double>(snapshot.rms.left) * snapshot.rms.left,
+                              static_cast<double>(snapshot.rms.right) * snapshot.rms.right};
+    if (!m_pending) {
+        m_pending = true;
+        m_pendingInterval = interval;
+        m_pendingEntry.timestampMs = interval * m_header.intervalMs;
+        m_pendingEntry.peak = snapshot.peak;
+        m_pendingEnergy[0] = energy[0];
+        m_pendingEnergy[1] = energy[1];
+        m_pendingCount = 1;
+    } else {
+        m_pendingEntry.peak.left = std::max(m_pendingEntry.peak.left, snapshot.peak.left);
+        m_pendingEntry.peak.right = std::max(m_pendingEntry.peak.right, snapshot.peak.right);
+        m_pendingEnergy[0] += energy[0];
+        m_pendingEnergy[1] += energy[1];
+        ++m_pendingCount;
+    }
+    return ok;
+}
+
+bool MeterLogWriter::appendPending() {
+    m_pending = false;
+    m_pendingEntry.rms.left = static_cast<float>(std::sqrt(m_pendingEnergy[0] / m_pendingCount));
+    m_pendingEntry.rms.right = static_cast<float>(std::sqrt(m_pendingEnergy[1] / m_pendingCount));
+    return append(m_pendingEntry);
+}
+
+bool MeterLogWriter::append(const MeterLogEntry& entry) {
+    if (!isOpen() || entry.timestampMs >= kMaxTimestampMs) {
+        return false;
+    }
+    m_entries.push_back(entry);
+    ++m_entryCount;
+    if (m_entries.size() < kChunkEntries) {
+        return true;
+    }
+    return flush();
+}
+
+bool MeterLogWriter::flush() {
+    if (!isOpen() || m_entries.empty()) {
+        return !m_failed;
+    }
+
+    MeterLogChunkHeader chunk;
+    chunk.entryCount = static_cast<std::uint32_t>(m_entries.size());
+    chunk.firstMs = m_entries.front().timestampMs;
+    chunk.lastMs = m_entries.back().timestampMs;
+
+    m_encoded.assign(sizeof(chunk), 0);
+    std::size_t columnStart = m_encoded.size();
+    {
+        RunEncoder encoder(m_encoded);
+        std::uint64_t previous = chunk.firstMs;
+        std::int64_t previousDelta = 0;
+        for (const MeterLogEntry& entry : m_entries) {
+            const auto delta = static_cast<std::int64_t>(entry.timestampMs - previous);
+            encoder.put(delta - previousDelta);
+            previous = entry.timestampMs;
+            previousDelta = delta;
+        }
+        encoder.finish();
+    }
+    chunk.columnBytes[0] = static_cast<std::uint32_t>(m_encoded.size() - columnStart);
+
+    for (std::size_t column = 1; column < kColumnCount; ++column) {
+        columnStart = m_encoded.size();
+        RunEncoder encoder(m_encoded);
+        std::int64_t previous = 0;
+        for (const MeterLogEntry& entry : m_entries) {
+            const std::int32_t code = toCode(levelColumn(entry, column), m_dbStep, m_header);
+            encoder.put(code - previous);
+            previous = code;
+        }
+        encoder.finish();
+        chunk.columnBytes[column] = static_cast<std::uint32_t>(m_encoded.size() - columnStart);
+    }
+    std::memcpy(m_encoded.data(), &chunk, sizeof(chunk));
+
+    // The entries are gone either way, so memory stays bounded after a failure
+    m_entries.clear();
+    if (!m_file.writeAt(m_offset, m_encoded.data(), m_encoded.size())) {
+        m_failed = true;
+        return false;
+    }
+    m_index.push_back({m_offset, chunk.firstMs, chunk.lastMs, chunk.entryCount, 0});
+    m_offset += m_encoded.size();
+    return !m_failed;
+}
+
+bool MeterLogWriter::sync() {
+    if (!flush()) {
+        return false;
+    }
+    if (!m_file.sync()) {
+        m_failed = true;
+        return false;
+    }
+    return true;
+}
+
+bool MeterLogWriter::close() {
+    if (!isOpen()) {
+        return false;
+    }
+
+    bool ok = true;
+    if (m_pending) {
+        ok = appendPending();
+    }
+    ok = flush() && ok;
+
+    MeterLogFooter footer;
+    footer.indexOffset = m_offset;
+    footer.chunkCount = static_cast<std::uint32_t>(m_index.size());
+    const std::size_t indexBytes = m_index.size() * sizeof(MeterLogIndexEntry);
+    ok = (m_index.empty() || m_file.writeAt(m_offset, m_index.data(), indexBytes)) && ok;
+    ok = m_file.writeAt(m_offset + indexBytes, &footer, sizeof(footer)) && ok;
+    m_offset += indexBytes + sizeof(footer);
+
+    m_file.close();
+    m_index.clear();
+    m_index.shrink_to_fit();
+    return ok && !m_failed;
+}
+
+std::size_t MeterLogWriter::bufferBytes() const noexcept {
+    return m_entries.capacity() * sizeof(MeterLogEntry) + m_encoded.capacity();
+}
+
+bool MeterLogReader::open(const std::string& path) {
+    close();
+    if (!m_file.open(path) || m_file.size() < sizeof(MeterLogHeader)) {
+        close();
+        return false;
+    }
+
+    std::memcpy(&m_header, m_file.data(), sizeof(m_header));
+    if (std::memcmp(m_header.magic, "OMML", 4) != 0 || m_header.version != kFormatVersion ||
+        m_header.stepMilliDb == 0 || m_header.floorCode >= m_header.ceilingCode || m_header.chunkEntries == 0) {
+        close();
+        return false;
+    }
+
+    if (!loadIndex()) {
+        scanChunks();
+    }
+    return true;
+}
+
+void MeterLogReader::close() {
+    m_file.close();
+    m_header = MeterLogHeader{};
+    m_index.clear();
+    m_complete = false;
+}
+
+bool MeterLogReader::loadIndex() {
+    const std::size_t size = m_file.size();
+    if (size < sizeof(MeterLogHeader) + sizeof(MeterLogFooter)) {
+        return false;
+    }
+
+    MeterLogFooter footer;
+    std::memcpy(&footer, m_file.data() + size - sizeof(footer), sizeof(footer));
+    const std::uint64_t indexBytes = static_cast<std::uint64_t>(footer.chunkCount) * sizeof(MeterLogIndexEntry);
+    if (std::memcmp(footer.magic, "OMMI", 4) != 0 || footer.indexOffset < sizeof(MeterLogHeader) ||
+        footer.indexOffset + indexBytes + sizeof(footer) != size) {
+        return false;
+    }
+
+    m_index.resize(footer.chunkCount);
+    if (!m_index.empty()) {
+        std::memcpy(m_index.data(), m_file.data() + footer.indexOffset, static_cast<std::size_t>(indexBytes));
+    }
+    for (const MeterLogIndexEntry& entry : m_index) {
+        if (entry.offset < sizeof(MeterLogHeader) || entry.offset + sizeof(MeterLogChunkHeader) > footer.indexOffset) {
+            m_index.clear();
+            return false;
+        }
+    }
+    m_complete = true;
+    return true;
+}
+
+void MeterLogReader::scanChunks() {
+    // No footer: the chunks written before the writer stopped are still whole
+    const std::size_t size = m_file.size();
+    std::uint64_t offset = sizeof(MeterLogHeader);
+    while (offset + sizeof(MeterLogChunkHeader) <= size) {
+        MeterLogChunkHeader chunk;
+        std::memcpy(&chunk, m_file.data() + offset, sizeof(chunk));
+        std::uint64_t payload = 0;
+        for (const std::uint32_t bytes : chunk.columnBytes) {
+            payload += bytes;
+        }
+        if (std::memcmp(chunk.magic, "OMMC", 4) != 0 || chunk.entryCount == 0 ||
+            chunk.entryCount > m_header.chunkEntries || offset + sizeof(chunk) + payload > size) {
+            break;
+        }
+        m_index.push_back({offset, chunk.firstMs, chunk.lastMs, chunk.entryCount, 0});
+        offset += sizeof(chunk) + payload;
+    }
+    m_complete = false;
+}
+
+std::uint64_t MeterLogReader::entryCount() const noexcept {
+    std::uint64_t count = 0;
+    for (const MeterLogIndexEntry& entry : m_index) {
+        count += entry.entryCount;
+    }
+    return count;
+}
+
+std::size_t MeterLogReader::findChunk(std::uint64_t timeMs) const noexcept {
+    const auto it = std::partition_point(m_index.begin(), m_index.end(),
+                                         [timeMs](const MeterLogIndexEntry& entry) { return entry.lastMs < timeMs; });
+    return static_cast<std::size_t>(it - m_index.begin());
+}
+
+bool MeterLogReader::readChunk(std::size_t index, std::vector<MeterLogEntry>& entries) const {
+    entries.clear();
+    if (index >= m_index.size()) {
+        return false;
+    }
+
+    const std::uint64_t offset = m_index[index].offset;
+    MeterLogChunkHeader chunk;
+    std::memcpy(&chunk, m_file.data() + offset, sizeof(chunk));
+    std::uint64_t payload = 0;
+    for (const std::uint32_t bytes : chunk.columnBytes) {
+        payload += bytes;
+    }
+    if (std::memcmp(chunk.magic, "OMMC", 4) != 0 || chunk.entryCount == 0 ||
+        chunk.entryCount > m_header.chunkEntries || offset + sizeof(chunk) + payload > m_file.size()) {
+        return false;
+    }
+
+    entries.resize(chunk.entryCount);
+    const std::uint8_t* column = m_file.data() + offset + sizeof(chunk);
+    {
+        RunDecoder decoder(column, chunk.columnBytes[0]);
+        std::uint64_t previous = chunk.firstMs;
+        std::int64_t previousDelta = 0;
+        for (MeterLogEntry& entry : entries) {
+            std::int64_t dod = 0;
+            if (!decoder.next(dod)) {
+                entries.clear();
+                return false;
+            }
+            previousDelta += dod;
+            previous += static_cast<std::uint64_t>(previousDelta);
+            entry.timestampMs = previous;
+        }
+        if (!decoder.finished()) {
+            entries.clear();
+            return false;
+        }
+    }
+    column += chunk.columnBytes[0];
+
+    const double step = dbStep();
+    for (std::size_t c = 1; c < kColumnCount; ++c) {
+        RunDecoder decoder(column, chunk.columnBytes[c]);
+        std::int64_t code = 0;
+        for (MeterLogEntry& entry : entries) {
+            std::int64_t delta = 0;
+            if (!decoder.next(delta)) {
+                entries.clear();
+                return false;
+            }
+            code += delta;
+            if (code < m_header.floorCode || code > m_header.ceilingCode) {
+                entries.clear();
+                return false;
+            }
+            levelColumn(entry, c) = fromCode(code, step, m_header);
+        }
+        if (!decoder.finished()) {
+            entries.clear();
+            return false;
+        }
+        column += chunk.columnBytes[c];
+    }
+    return true;
+}
+
+long long MeterLogReader::readRange(std::uint64_t fromMs, std::uint64_t toMs,
+                                    const std::function<void(const MeterLogEntry&)>& visit) const {
+    long long visited = 0;
+    std::vector<MeterLogEntry> entries;
+    for (std::size_t i = findChunk(fromMs); i < m_index.size() && m_index[i].firstMs < toMs; ++i) {
+        if (!readChunk(i, entries)) {
+            return -1;
+        }
+        for (const MeterLogEntry& entry : entries) {
+            if (entry.timestampMs >= fromMs && entry.timestampMs < toMs) {
+                visit(entry);
+                ++visited;
+            }
+        }
+    }
+    return visited;
+}
+
+} // namespace openmeters::common
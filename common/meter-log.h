@@ -0,0 +1,279 @@
+#pragma once
+
+#include "mapped-file.h"
+#include "meter-values.h"
+#include "output-file.h"
+#include "resource-monitor.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace openmeters::common {
+
+/**
+ * One meter reading as stored in a meter log. Levels are linear, as in
+ * MeterSnapshot, but were quantized to the log's dB step when written.
+ */
+struct MeterLogEntry {
+    std::uint64_t timestampMs = 0; // As given to the writer (MeterLogger uses ms since the epoch)
+    PeakValue peak;
+    RmsValue rms;
+};
+
+/**
+ * On-disk meter log (.ommeter), little-endian:
+ *
+ *   MeterLogHeader
+ *   repeated: MeterLogChunkHeader, followed by its columns back to back
+ *   MeterLogIndexEntry per chunk, then MeterLogFooter (written by close())
+ *
+ * A chunk holds up to chunkEntries entries, stored column by column:
+ * timestamps as delta-of-delta, then peak left/right and RMS left/right
+ * as dB codes (dB / step, rounded; floorCode means silence) delta-coded
+ * against the previous entry. Each value is zigzagged and written as a
+ * varint tagged in its low bit: 0 for a literal, 1 for a run of that many
+ * zeros. Steady timestamps and steady levels therefore cost next to
+ * nothing, and each chunk decodes on its own.
+ *
+ * A file without a footer (the writer crashed) is still read by walking
+ * the chunk headers; only the entries not yet flushed are lost.
+ */
+struct MeterLogHeader {
+    char magic[4] = {'O', 'M', 'M', 'L'};
+    std::uint32_t version = 1;
+    std::uint32_t intervalMs = 0;    // Aggregation interval (0: every snapshot)
+    std::uint32_t stepMilliDb = 0;   // Quantization step, 1/1000 dB
+    std::int32_t floorCode = 0;      // Code of silence (lowest code)
+    std::int32_t ceilingCode = 0;    // Highest code
+    std::uint32_t chunkEntries = 0;  // Entries per full chunk
+    std::uint32_t reserved = 0;
+};
+
+struct MeterLogChunkHeader {
+    char magic[4] = {'O', 'M', 'M', 'C'};
+    std::uint32_t entryCount = 0;
+    std::uint64_t firstMs = 0;
+    std::uint64_t lastMs = 0;
+    std::uint32_t columnBytes[5] = {}; // Timestamps, peak L/R, RMS L/R
+    std::uint32_t reserved = 0;
+};
+
+struct MeterLogIndexEntry {
+    std::uint64_t offset = 0; // Of the chunk header
+    std::uint64_t firstMs = 0;
+    std::uint64_t lastMs = 0;
+    std::uint32_t entryCount = 0;
+    std::uint32_t reserved = 0;
+};
+
+struct MeterLogFooter {
+    std::uint64_t indexOffset = 0;
+    std::uint32_t chunkCount = 0;
+    char magic[4] = {'O', 'M', 'M', 'I'};
+};
+
+static_assert(sizeof(MeterLogHeader) == 32, "meter log header layout");
+static_assert(sizeof(MeterLogChunkHeader) == 48, "meter log chunk layout");
+static_assert(sizeof(MeterLogIndexEntry) == 32, "meter log index layout");
+static_assert(sizeof(MeterLogFooter) == 16, "meter log footer layout");
+
+/**
+ * Streaming writer for meter logs.
+ *
+ * Entries are buffered until a chunk is full (or flush() is called), then
+ * encoded and written with one call, so memory stays at one chunk of
+ * entries plus its encoding whatever the length of the log. With an
+ * interval, snapshots are first aggregated per interval (peak maximum,
+ * RMS power mean) and stamped with the interval start.
+ *
+ * Thread safety: Not thread-safe. Blocking I/O; never call from a
+ * real-time thread.
+ */
+class MeterLogWriter {
+public:
+    static constexpr std::uint32_t kChunkEntries = 4096;
+    static constexpr double kFloorDb = -150.0;  // Quieter levels log as silence
+    static constexpr double kCeilingDb = 40.0;  // Louder levels are clamped
+
+    /**
+     * @param tag Subsystem the chunk buffers are accounted to
+     */
+    explicit MeterLogWriter(MemoryTag tag = MemoryTag::Other);
+    ~MeterLogWriter();
+
+    // Non-copyable, non-movable
+    MeterLogWriter(const MeterLogWriter&) = delete;
+    MeterLogWriter& operator=(const MeterLogWriter&) = delete;
+    MeterLogWriter(MeterLogWriter&&) = delete;
+    MeterLogWriter& operator=(MeterLogWriter&&) = delete;
+
+    /**
+     * Create (or truncate) a log file.
+     *
+     * @param path Log file path
+     * @param intervalMs Aggregation interval for add() (0 keeps every snapshot)
+     * @param dbStep Quantization step in dB (0.001 to 10)
+     * @return true if the file was created, false otherwise
+     */
+    bool open(const std::string& path, std::uint32_t intervalMs = 0, double dbStep = 0.1);
+
+    /**
+     * Add a snapshot, aggregated into the current interval.
+     *
+     * @return false if a chunk had to be written and the write failed
+     */
+    bool add(const MeterSnapshot& snapshot);
+
+    /**
+     * Append an entry as is (bypasses interval aggregation).
+     * Timestamps must stay below 2^61 ms.
+     *
+     * @return false if not open, the timestamp is out of range or a chunk
+     *         write failed
+     */
+    bool append(const MeterLogEntry& entry);
+
+    /**
+     * Write buffered entries as a (possibly short) chunk. An interval still
+     * being aggregated stays pending.
+     *
+     * @return true if written (or nothing to write), false on an I/O error
+     */
+    bool flush();
+
+    /**
+     * flush(), then write the file back to the storage device so the
+     * chunks written so far survive a power loss.
+     *
+     * @return true if synced, false on an I/O error
+     */
+    bool sync();
+
+    /**
+     * Write the pending interval, the last chunk, the index and the footer,
+     * then close the file.
+     *
+     * @return true if the log is complete, false if any write failed
+     */
+    bool close();
+
+    [[nodiscard]] bool isOpen() const noexcept { return m_file.isOpen(); }
+
+    /**
+     * Entries written or buffered so far.
+     */
+    [[nodiscard]] std::uint64_t entryCount() const noexcept { return m_entryCount; }
+
+    /**
+     * File size so far (chunks written; excludes buffered entries).
+     */
+    [[nodiscard]] std::uint64_t bytesWritten() const noexcept { return m_offset; }
+
+private:
+    bool appendPending();
+    std::size_t bufferBytes() const noexcept;
+
+    MemoryTag m_tag = MemoryTag::Other;
+    OutputFile m_file;
+    MeterLogHeader m_header;
+    double m_dbStep = 0.1;
+    std::uint64_t m_offset = 0;
+    std::uint64_t m_entryCount = 0;
+    bool m_failed = false;
+
+    std::vector<MeterLogEntry> m_entries;  // Current chunk (capacity kChunkEntries)
+    std::vector<std::uint8_t> m_encoded;   // Encoding scratch (worst case reserved)
+    std::vector<MeterLogIndexEntry> m_index;
+
+    // Interval being aggregated by add()
+    bool m_pending = false;
+    std::uint64_t m_pendingInterval = 0;
+    MeterLogEntry m_pendingEntry;
+    double m_pendingEnergy[2] = {0.0, 0.0};
+    std::uint32_t m_pendingCount = 0;
+};
+
+/**
+ * Reads a meter log through a memory mapping.
+ *
+ * open() takes the chunk index from the footer, or rebuilds it by walking
+ * the chunks when the writer did not finish (the file is then reported
+ * incomplete). Chunks are decoded on demand; findChunk() seeks by time
+ * with a binary search over the index, which assumes timestamps never
+ * go backwards.
+ *
+ * Thread safety: Not thread-safe.
+ */
+class MeterLogReader {
+public:
+    MeterLogReader() = default;
+
+    // Non-copyable, non-movable
+    MeterLogReader(const MeterLogReader&) = delete;
+    MeterLogReader& operator=(const MeterLogReader&) = delete;
+    MeterLogReader(MeterLogReader&&) = delete;
+    MeterLogReader& operator=(MeterLogReader&&) = delete;
+
+    /**
+     * Map a log file and load its index.
+     *
+     * @return true if the file is a meter log, false otherwise
+     */
+    bool open(const std::string& path);
+
+    void close();
+
+    [[nodiscard]] bool isOpen() const noexcept { return m_file.isOpen(); }
+
+    /**
+     * False if the log has no footer (its writer did not close it).
+     */
+    [[nodiscard]] bool isComplete() const noexcept { return m_complete; }
+
+    [[nodiscard]] const MeterLogHeader& header() const noexcept { return m_header; }
+    [[nodiscard]] double dbStep() const noexcept { return m_header.stepMilliDb / 1000.0; }
+
+    [[nodiscard]] std::size_t chunkCount() const noexcept { return m_index.size(); }
+    [[nodiscard]] const MeterLogIndexEntry& chunk(std::size_t index) const noexcept { return m_index[index]; }
+
+    /**
+     * Total entries in all chunks.
+     */
+    [[nodiscard]] std::uint64_t entryCount() const noexcept;
+
+    /**
+     * First chunk whose last entry is at or after timeMs (chunkCount() if none).
+     */
+    [[nodiscard]] std::size_t findChunk(std::uint64_t timeMs) const noexcept;
+
+    /**
+     * Decode one chunk.
+     *
+     * @param index Chunk index
+     * @param entries Replaced with the chunk's entries
+     * @return true if decoded, false if the index is out of range or the
+     *         chunk is corrupt
+     */
+    bool readChunk(std::size_t index, std::vector<MeterLogEntry>& entries) const;
+
+    /**
+     * Visit the entries in [fromMs, toMs), in file order.
+     *
+     * @return Entries visited, or -1 if a chunk is corrupt
+     */
+    long long readRange(std::uint64_t fromMs, std::uint64_t toMs,
+                        const std::function<void(const MeterLogEntry&)>& visit) const;
+
+private:
+    bool loadIndex();
+    void scanChunks();
+
+    MappedFile m_file;
+    MeterLogHeader m_header;
+    std::vector<MeterLogIndexEntry> m_index;
+    bool m_complete = false;
+};
+
+} // namespace openmeters::common
@@ -56,13 +56,66 @@ struct RmsValue {
  */
 struct MeterSnapshot {
     PeakValue peak;
+    
+    /**
+     * Ballistic meter reading (digital peak, PPM or VU as configured),
+     * computed sample by sample; draw it as is.
+     */
+    PeakValue level;
+    
+    /**
+     * Peak hold: the highest recent reading, held for
+     * AppConfig::meterHoldMs, then falling by AppConfig::meterDecayRate
+     * per display update.
+     */
+    PeakValue peakHold;
+    
     RmsValue rms;
     
     /**
      * Timestamp in milliseconds (relative to engine start).
-     * TODO: Implement proper timing system.
      */
     std::uint64_t timestampMs = 0;
+    
+    /**
+     * When the packet behind these values was captured by the device
+     * (monotonicNanos(); WASAPI's device timestamp where given); renderers subtract it from the present time to
+     * get capture-to-display latency. Zero if unknown.
+     */
+    std::uint64_t captureTimeNs = 0;
+    
+    /**
+     * The input has been digitally silent for AppConfig::idleAfterSeconds:
+     * snapshots arrive at AppConfig::idleUpdateRate only, and renderers may
+     * slow down to match. Cleared by the first packet with signal.
+     */
+    bool idle = false;
+};
+
+/**
+ * An over: a run of consecutive samples at or above the over threshold
+ * (AppConfig::overThresholdDb) on one channel.
+ */
+struct OverEvent {
+    /**
+     * Frame index of the first sample of the run, counted from the start
+     * of the stream; locates the over in a recording of the same stream.
+     */
+    std::uint64_t position = 0;
+    
+    /**
+     * When that frame was read from the device (monotonicNanos()).
+     * Zero if unknown.
+     */
+    std::uint64_t captureTimeNs = 0;
+    
+    ChannelIndex channel = 0;
+    
+    /**
+     * Samples in the run when it was reported (the configured run length;
+     * the run may continue).
+     */
+    std::uint32_t samples = 0;
 };
 
 } // namespace openmeters::common
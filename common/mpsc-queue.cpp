@@ -0,0 +1,125 @@
+#include "mpsc-queue.h"
+#include <algorithm>
+#include <cstring>
+
+namespace openmeters::common {
+
+MpscRecordQueue::~MpscRecordQueue() {
+    ResourceMonitor::trackRelease(m_tag, capacity() * sizeof(Cell));
+}
+
+bool MpscRecordQueue::reserve(std::size_t cellCount) {
+    std::size_t capacity = 1;
+    while (capacity < cellCount) {
+        capacity <<= 1;
+    }
+
+    ResourceMonitor::trackRelease(m_tag, this->capacity() * sizeof(Cell));
+    m_cells = std::make_unique<Cell[]>(capacity);
+    ResourceMonitor::trackAllocation(m_tag, capacity * sizeof(Cell));
+    m_mask = capacity - 1;
+
+    // A cell is free for the producer at position p when its sequence is p
+    for (std::size_t i = 0; i < capacity; ++i) {
+        m_cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    m_enqueuePos.store(0);
+    m_dequeuePos = 0;
+    return true;
+}
+
+bool MpscRecordQueue::push(const void* first, std::size_t firstBytes, const void* second, std::size_t secondBytes) noexcept {
+    const std::size_t total = firstBytes + secondBytes;
+    const std::size_t cellCount = std::max<std::size_t>(1, (total + kCellPayload - 1) / kCellPayload);
+    if (!m_cells || total > kMaxRecordBytes || cellCount > capacity()) {
+        return false;
+    }
+
+    // Claim cellCount consecutive cells. Cells at or past the enqueue
+    // position only change when the consumer frees them, so once all are
+    // seen free a successful CAS makes them ours.
+    std::size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+    for (;;) {
+        bool stale = false;
+        for (std::size_t i = 0; i < cellCount; ++i) {
+            const std::size_t seq = m_cells[(pos + i) & m_mask].sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::ptrdiff_t>(seq - (pos + i));
+            if (diff < 0) {
+                return false; // Not yet consumed: queue full
+            }
+            if (diff > 0) {
+                stale = true; // Another producer claimed it
+                break;
+            }
+        }
+        if (stale) {
+            pos = m_enqueuePos.load(std::memory_order_relaxed);
+            continue;
+        }
+        if (m_enqueuePos.compare_exchange_weak(pos, pos + cellCount, std::memory_order_relaxed)) {
+            break;
+        }
+    }
+
+    Cell& head = m_cells[pos & m_mask];
+    head.bytes = static_cast<std::uint32_t>(total);
+    head.cells = static_cast<std::uint32_t>(cellCount);
+
+    // Scatter both parts across the claimed cells
+    const std::uint8_t* parts[2] = {static_cast<const std::uint8_t*>(first), static_cast<const std::uint8_t*>(second)};
+    const std::size_t sizes[2] = {firstBytes, secondBytes};
+    std::size_t offset = 0;
+    for (int part = 0; part < 2; ++part) {
+        std::size_t copied = 0;
+        while (copied < sizes[part]) {
+            Cell& cell = m_cells[(pos + offset / kCellPayload) & m_mask];
+            const std::size_t within = offset % kCellPayload;
+            const std::size_t chunk = std::min(sizes[part] - copied, kCellPayload - within);
+            std::memcpy(cell.data + within, parts[part] + copied, chunk);
+            copied += chunk;
+            offset += chunk;
+        }
+    }
+
+    // Publish continuation cells before the head so the consumer sees whole records
+    for (std::size_t i = cellCount; i-- > 0;) {
+        m_cells[(pos + i) & m_mask].sequence.store(pos + i + 1, std::memory_order_release);
+    }
+    return true;
+}
+
+std::size_t MpscRecordQueue::pop(void* dest, std::size_t maxBytes) noexcept {
+    if (!m_cells) {
+        return 0;
+    }
+
+    const std::size_t pos = m_dequeuePos;
+    Cell& head = m_cells[pos & m_mask];
+    if (head.sequence.load(std::memory_order_acquire) != pos + 1) {
+        return 0; // Empty, or the producer is still copying
+    }
+
+    const std::size_t total = head.bytes;
+    const std::size_t cellCount = head.cells;
+    for (std::size_t i = 1; i < cellCount; ++i) {
+        if (m_cells[(pos + i) & m_mask].sequence.load(std::memory_order_acquire) != pos + i + 1) {
+            return 0;
+        }
+    }
+
+    auto* out = static_cast<std::uint8_t*>(dest);
+    const std::size_t bytes = std::min(total, maxBytes);
+    for (std::size_t offset = 0; offset < bytes; offset += kCellPayload) {
+        const Cell& cell = m_cells[(pos + offset / kCellPayload) & m_mask];
+        std::memcpy(out + offset, cell.data, std::min(kCellPayload, bytes - offset));
+    }
+
+    // Hand the cells back to producers for the next lap
+    for (std::size_t i = 0; i < cellCount; ++i) {
+        m_cells[(pos + i) & m_mask].sequence.store(pos + i + m_mask + 1, std::memory_order_release);
+    }
+    m_dequeuePos = pos + cellCount;
+    return total;
+}
+
+} // namespace openmeters::common
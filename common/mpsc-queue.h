@@ -0,0 +1,103 @@
+#pragma once
+
+#include "resource-monitor.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace openmeters::common {
+
+/**
+ * Bounded multi-producer/single-consumer queue of variable-size records.
+ *
+ * Storage is a ring of fixed-size cells, each with a sequence number
+ * (Vyukov's bounded queue). A record occupies one or more consecutive
+ * cells; a producer claims all of them with a single CAS on the enqueue
+ * position, so records from different threads never interleave. A push
+ * either stores the whole record or fails when the ring is full.
+ *
+ * Thread safety: Any number of threads call push() concurrently; one
+ * consumer thread calls pop(). reserve() must happen before either starts.
+ * push() never locks or allocates.
+ */
+class MpscRecordQueue {
+public:
+    /**
+     * Record bytes carried by one cell.
+     */
+    static constexpr std::size_t kCellPayload = 112;
+
+    /**
+     * Largest record accepted by push().
+     */
+    static constexpr std::size_t kMaxRecordBytes = kCellPayload * 32;
+
+    MpscRecordQueue() = default;
+
+    /**
+     * @param tag Subsystem the queue storage is accounted to
+     */
+    explicit MpscRecordQueue(MemoryTag tag) : m_tag(tag) {}
+
+    ~MpscRecordQueue();
+
+    // Non-copyable, non-movable
+    MpscRecordQueue(const MpscRecordQueue&) = delete;
+    MpscRecordQueue& operator=(const MpscRecordQueue&) = delete;
+    MpscRecordQueue(MpscRecordQueue&&) = delete;
+    MpscRecordQueue& operator=(MpscRecordQueue&&) = delete;
+
+    /**
+     * Allocate cells (rounded up to a power of two). Not real-time safe.
+     *
+     * @param cellCount Minimum number of cells
+     * @return true if storage was allocated, false otherwise
+     */
+    bool reserve(std::size_t cellCount);
+
+    /**
+     * Append a record made of two parts (e.g. header and payload).
+     *
+     * @return true if stored, false if the queue was full or the record
+     *         is larger than kMaxRecordBytes
+     *
+     * Thread: Any producer
+     */
+    bool push(const void* first, std::size_t firstBytes, const void* second = nullptr, std::size_t secondBytes = 0) noexcept;
+
+    /**
+     * Remove the oldest complete record.
+     *
+     * @param dest Receives the record (truncated to maxBytes)
+     * @param maxBytes Size of dest; kMaxRecordBytes never truncates
+     * @return Size of the record, or 0 if none is ready
+     *
+     * Thread: Consumer
+     */
+    std::size_t pop(void* dest, std::size_t maxBytes) noexcept;
+
+    /**
+     * Number of cells.
+     */
+    [[nodiscard]] std::size_t capacity() const noexcept { return m_cells ? m_mask + 1 : 0; }
+
+private:
+    struct alignas(64) Cell {
+        std::atomic<std::size_t> sequence{0};
+        std::uint32_t bytes = 0; // Record size (first cell only)
+        std::uint32_t cells = 0; // Cells in the record (first cell only)
+        std::uint8_t data[kCellPayload];
+    };
+    static_assert(sizeof(Cell) == 128, "Cell should span two cache lines");
+
+    MemoryTag m_tag = MemoryTag::Other;
+    std::unique_ptr<Cell[]> m_cells;
+    std::size_t m_mask = 0;
+
+    // Producers contend on the enqueue position; the consumer owns the dequeue position
+    alignas(64) std::atomic<std::size_t> m_enqueuePos{0};
+    alignas(64) std::size_t m_dequeuePos = 0;
+};
+
+} // namespace openmeters::common
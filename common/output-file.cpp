@@ -0,0 +1,135 @@
+#include "output-file.h"
+#include <algorithm>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace openmeters::common {
+
+OutputFile::~OutputFile() {
+    close();
+}
+
+#ifdef _WIN32
+
+bool OutputFile::create(const std::string& path) {
+    close();
+
+    HANDLE file = CreateFileA(
+        path.c_str(),
+        GENERIC_WRITE,
+        FILE_SHARE_READ,
+        nullptr,
+        CREATE_ALWAYS,
+        FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+        nullptr
+    );
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    m_handle = file;
+    return true;
+}
+
+bool OutputFile::writeAt(std::uint64_t offset, const void* data, std::size_t bytes) noexcept {
+    if (!m_handle) {
+        return false;
+    }
+
+    const auto* p = static_cast<const std::uint8_t*>(data);
+    while (bytes != 0) {
+        // WriteFile takes a DWORD count; an OVERLAPPED offset works on synchronous handles too
+        OVERLAPPED overlapped{};
+        overlapped.Offset = static_cast<DWORD>(offset & 0xFFFFFFFFu);
+        overlapped.OffsetHigh = static_cast<DWORD>(offset >> 32);
+        const DWORD request = static_cast<DWORD>(std::min<std::size_t>(bytes, 1u << 30));
+        DWORD written = 0;
+        if (!WriteFile(static_cast<HANDLE>(m_handle), p, request, &written, &overlapped) || written == 0) {
+            return false;
+        }
+        p += written;
+        offset += written;
+        bytes -= written;
+    }
+    return true;
+}
+
+bool OutputFile::sync() noexcept {
+    return m_handle && FlushFileBuffers(static_cast<HANDLE>(m_handle));
+}
+
+void OutputFile::close() {
+    if (m_handle) {
+        CloseHandle(static_cast<HANDLE>(m_handle));
+        m_handle = nullptr;
+    }
+}
+
+bool OutputFile::isOpen() const noexcept {
+    return m_handle != nullptr;
+}
+
+#else
+
+bool OutputFile::create(const std::string& path) {
+    close();
+
+    const int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        return false;
+    }
+    m_fd = fd;
+    return true;
+}
+
+bool OutputFile::writeAt(std::uint64_t offset, const void* data, std::size_t bytes) noexcept {
+    if (m_fd < 0) {
+        return false;
+    }
+
+    const auto* p = static_cast<const std::uint8_t*>(data);
+    while (bytes != 0) {
+        const ssize_t written = ::pwrite(m_fd, p, bytes, static_cast<off_t>(offset));
+        if (written < 0 && errno == EINTR) {
+            continue;
+        }
+        if (written <= 0) {
+            return false;
+        }
+        p += written;
+        offset += static_cast<std::uint64_t>(written);
+        bytes -= static_cast<std::size_t>(written);
+    }
+    return true;
+}
+
+bool OutputFile::sync() noexcept {
+    if (m_fd < 0) {
+        return false;
+    }
+#ifdef __APPLE__
+    return ::fsync(m_fd) == 0;
+#else
+    return ::fdatasync(m_fd) == 0;
+#endif
+}
+
+void OutputFile::close() {
+    if (m_fd >= 0) {
+        ::close(m_fd);
+        m_fd = -1;
+    }
+}
+
+bool OutputFile::isOpen() const noexcept {
+    return m_fd >= 0;
+}
+
+#endif
+
+} // namespace openmeters::common
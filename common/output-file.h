@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace openmeters::common {
+
+/**
+ * Output file written at explicit offsets (pwrite / WriteFile with an
+ * offset). Bypasses stream buffering, so callers that already assemble
+ * large blocks hand them to the OS in one call, and a header can be
+ * patched in place without seeking.
+ *
+ * Thread safety: Not thread-safe. Blocking I/O; never call from a
+ * real-time thread.
+ */
+class OutputFile {
+public:
+    OutputFile() = default;
+    ~OutputFile();
+
+    // Non-copyable, non-movable
+    OutputFile(const OutputFile&) = delete;
+    OutputFile& operator=(const OutputFile&) = delete;
+    OutputFile(OutputFile&&) = delete;
+    OutputFile& operator=(OutputFile&&) = delete;
+
+    /**
+     * Create (or truncate) a file for writing.
+     *
+     * @param path Path to the file
+     * @return true if the file was created, false otherwise
+     */
+    bool create(const std::string& path);
+
+    /**
+     * Write bytes at an offset, retrying short writes.
+     *
+     * @return true if every byte was written, false on an I/O error
+     */
+    bool writeAt(std::uint64_t offset, const void* data, std::size_t bytes) noexcept;
+
+    /**
+     * Write what the OS holds for the file back to the storage device
+     * (fdatasync / FlushFileBuffers), so it survives a power loss.
+     *
+     * @return true if synced, false if not open or on an I/O error
+     */
+    bool sync() noexcept;
+
+    /**
+     * Close the file (contents are left to the OS to write back).
+     */
+    void close();
+
+    /**
+     * Check if a file is currently open.
+     */
+    [[nodiscard]] bool isOpen() const noexcept;
+
+private:
+#ifdef _WIN32
+    void* m_handle = nullptr;
+#else
+    int m_fd = -1;
+#endif
+};
+
+} // namespace openmeters::common
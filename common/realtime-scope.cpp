@@ -0,0 +1,101 @@
+#include "realtime-scope.h"
+#include "rt-check.h"
+
+// The RT sanitizer interposes the allocators itself and reports instead of asserting
+#if defined(OPENMETERS_RT_CHECK) && defined(OPENMETERS_ALLOC_CHECK)
+#undef OPENMETERS_ALLOC_CHECK
+#endif
+
+#ifdef OPENMETERS_ALLOC_CHECK
+#include <cassert>
+#include <cstdlib>
+#include <new>
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+#endif
+
+namespace openmeters::common {
+
+namespace {
+
+thread_local int t_realtimeDepth = 0;
+
+} // namespace
+
+RealtimeScope::RealtimeScope() noexcept {
+    if constexpr (rtCheckEnabled()) {
+        rtCheckInstall();
+    }
+    ++t_realtimeDepth;
+}
+
+RealtimeScope::~RealtimeScope() {
+    --t_realtimeDepth;
+}
+
+bool isRealtimeThread() noexcept {
+    return t_realtimeDepth > 0;
+}
+
+} // namespace openmeters::common
+
+#ifdef OPENMETERS_ALLOC_CHECK
+
+// Debug-only replacement of the global allocation functions. Every other
+// operator new form (array, nothrow) forwards to these by default.
+
+namespace {
+
+void* alignedAllocate(std::size_t size, std::size_t alignment) {
+#ifdef _WIN32
+    return _aligned_malloc(size, alignment);
+#else
+    const std::size_t rounded = (size + alignment - 1) & ~(alignment - 1);
+    return std::aligned_alloc(alignment, rounded);
+#endif
+}
+
+void alignedFree(void* ptr) {
+#ifdef _WIN32
+    _aligned_free(ptr);
+#else
+    std::free(ptr);
+#endif
+}
+
+} // namespace
+
+void* operator new(std::size_t size) {
+    assert(!openmeters::common::isRealtimeThread() && "heap allocation inside RealtimeScope");
+    if (void* ptr = std::malloc(size ? size : 1)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    assert(!openmeters::common::isRealtimeThread() && "heap allocation inside RealtimeScope");
+    if (void* ptr = alignedAllocate(size ? size : 1, static_cast<std::size_t>(alignment))) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::align_val_t) noexcept {
+    alignedFree(ptr);
+}
+
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept {
+    alignedFree(ptr);
+}
+
+#endif // OPENMETERS_ALLOC_CHECK
@@ -0,0 +1,35 @@
+#pragma once
+
+namespace openmeters::common {
+
+/**
+ * Marks the current thread as real-time for the lifetime of the scope.
+ * Capture threads, analysis threads and audio callback invocations run
+ * inside a RealtimeScope. Scopes nest.
+ *
+ * When built with OPENMETERS_ALLOC_CHECK (on by default in Debug builds),
+ * global operator new asserts if it is called while a scope is active, so
+ * hidden heap allocations on the audio path fail loudly during development.
+ * OPENMETERS_RT_CHECK builds additionally catch malloc and mutex locks
+ * (see rt-check.h).
+ *
+ * Thread safety: Per-thread state; no synchronization needed.
+ */
+class RealtimeScope {
+public:
+    RealtimeScope() noexcept;
+    ~RealtimeScope();
+
+    // Non-copyable, non-movable
+    RealtimeScope(const RealtimeScope&) = delete;
+    RealtimeScope& operator=(const RealtimeScope&) = delete;
+    RealtimeScope(RealtimeScope&&) = delete;
+    RealtimeScope& operator=(RealtimeScope&&) = delete;
+};
+
+/**
+ * Check whether the current thread is inside a RealtimeScope.
+ */
+[[nodiscard]] bool isRealtimeThread() noexcept;
+
+} // namespace openmeters::common
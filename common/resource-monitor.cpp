@@ -0,0 +1,267 @@
+#include "resource-monitor.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#if defined(_WIN32)
+#include <windows.h>
+#elif defined(__linux__)
+#include <pthread.h>
+#include <time.h>
+#endif
+
+namespace openmeters::common {
+
+namespace {
+
+constexpr std::size_t kRoleCount = static_cast<std::size_t>(ThreadRole::Count);
+constexpr std::size_t kTagCount = static_cast<std::size_t>(MemoryTag::Count);
+constexpr auto kMinSampleInterval = std::chrono::milliseconds(100);
+
+struct ThreadEntry {
+    ThreadRole role = ThreadRole::Capture;
+    std::uint64_t baseNs = 0; // Thread CPU time when registered under role
+#if defined(_WIN32)
+    HANDLE handle = nullptr;
+#elif defined(__linux__)
+    clockid_t clock{};
+#endif
+};
+
+struct RoleState {
+    std::uint64_t retiredNs = 0;   // CPU of threads that left the role
+    std::uint64_t lastTotalNs = 0; // Role total at the previous sample
+    double averagePercent = 0.0;
+    bool hasAverage = false;
+};
+
+struct Registry {
+    std::mutex mutex;
+    std::vector<std::unique_ptr<ThreadEntry>> threads;
+    std::array<RoleState, kRoleCount> roles{};
+    std::chrono::steady_clock::time_point lastSample = std::chrono::steady_clock::now();
+    ResourceUsage lastUsage;
+};
+
+Registry& registry() {
+    static Registry instance;
+    return instance;
+}
+
+std::atomic<std::uint64_t> s_memoryBytes[kTagCount];
+std::atomic<std::uint64_t> s_memoryPeak[kTagCount];
+
+#if defined(_WIN32)
+std::uint64_t fileTimeNs(const FILETIME& time) {
+    const std::uint64_t ticks = (static_cast<std::uint64_t>(time.dwHighDateTime) << 32) | time.dwLowDateTime;
+    return ticks * 100; // 100 ns units
+}
+
+std::uint64_t threadCpuNs(HANDLE handle) {
+    FILETIME creation, exit, kernel, user;
+    if (!GetThreadTimes(handle, &creation, &exit, &kernel, &user)) {
+        return 0;
+    }
+    return fileTimeNs(kernel) + fileTimeNs(user);
+}
+#elif defined(__linux__)
+std::uint64_t threadCpuNs(clockid_t clock) {
+    timespec ts{};
+    if (clock_gettime(clock, &ts) != 0) {
+        return 0;
+    }
+    return static_cast<std::uint64_t>(ts.tv_sec) * 1000000000ull + static_cast<std::uint64_t>(ts.tv_nsec);
+}
+#endif
+
+// CPU time of a registered thread (reader holds the registry mutex, so the
+// thread cannot have retired its entry yet)
+std::uint64_t entryCpuNs(const ThreadEntry& entry) {
+#if defined(_WIN32)
+    return threadCpuNs(entry.handle);
+#elif defined(__linux__)
+    return threadCpuNs(entry.clock);
+#else
+    (void)entry;
+    return 0; // No per-thread CPU clock on this platform
+#endif
+}
+
+// Moves the entry's CPU time into its role's retired total
+void retire(Registry& reg, ThreadEntry& entry) {
+    const std::uint64_t now = entryCpuNs(entry);
+    reg.roles[static_cast<std::size_t>(entry.role)].retiredNs += now > entry.baseNs ? now - entry.baseNs : 0;
+    entry.baseNs = now;
+}
+
+// Unregisters the thread when it exits
+struct ThreadHandle {
+    ThreadEntry* entry = nullptr;
+
+    ~ThreadHandle() {
+        if (!entry) {
+            return;
+        }
+        Registry& reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        retire(reg, *entry);
+#if defined(_WIN32)
+        CloseHandle(entry->handle);
+#endif
+        reg.threads.erase(std::remove_if(reg.threads.begin(), reg.threads.end(), [this](const auto& candidate) {
+            return candidate.get() == entry;
+        }), reg.threads.end());
+    }
+};
+thread_local ThreadHandle t_handle;
+
+void formatBytes(char* buffer, std::size_t size, std::uint64_t bytes) {
+    if (bytes >= 1024 * 1024) {
+        std::snprintf(buffer, size, "%.1f MB", static_cast<double>(bytes) / (1024.0 * 1024.0));
+    } else {
+        std::snprintf(buffer, size, "%.0f KB", static_cast<double>(bytes) / 1024.0);
+    }
+}
+
+} // namespace
+
+const char* threadRoleName(ThreadRole role) noexcept {
+    switch (role) {
+        case ThreadRole::Capture:  return "capture";
+        case ThreadRole::Analysis: return "analysis";
+        case ThreadRole::Ui:       return "ui";
+        case ThreadRole::Logger:   return "logger";
+        default:                   return "?";
+    }
+}
+
+const char* memoryTagName(MemoryTag tag) noexcept {
+    switch (tag) {
+        case MemoryTag::Audio:    return "audio";
+        case MemoryTag::Analysis: return "analysis";
+        case MemoryTag::Ui:       return "ui";
+        case MemoryTag::Logging:  return "logging";
+        case MemoryTag::Tracing:  return "tracing";
+        case MemoryTag::Other:    return "other";
+        default:                  return "?";
+    }
+}
+
+void ResourceMonitor::registerCurrentThread(ThreadRole role) {
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+
+    if (t_handle.entry) {
+        // Re-registration moves the thread to another role from now on
+        retire(reg, *t_handle.entry);
+        t_handle.entry->role = role;
+        return;
+    }
+
+    auto entry = std::make_unique<ThreadEntry>();
+    entry->role = role;
+#if defined(_WIN32)
+    entry->handle = OpenThread(THREAD_QUERY_LIMITED_INFORMATION, FALSE, GetCurrentThreadId());
+    if (!entry->handle) {
+        return;
+    }
+#elif defined(__linux__)
+    if (pthread_getcpuclockid(pthread_self(), &entry->clock) != 0) {
+        return;
+    }
+#endif
+    entry->baseNs = entryCpuNs(*entry);
+    t_handle.entry = entry.get();
+    reg.threads.push_back(std::move(entry));
+}
+
+void ResourceMonitor::trackAllocation(MemoryTag tag, std::size_t bytes) noexcept {
+    const auto index = static_cast<std::size_t>(tag);
+    const std::uint64_t now = s_memoryBytes[index].fetch_add(bytes, std::memory_order_relaxed) + bytes;
+    std::uint64_t peak = s_memoryPeak[index].load(std::memory_order_relaxed);
+    while (now > peak && !s_memoryPeak[index].compare_exchange_weak(peak, now, std::memory_order_relaxed)) {
+    }
+}
+
+void ResourceMonitor::trackRelease(MemoryTag tag, std::size_t bytes) noexcept {
+    s_memoryBytes[static_cast<std::size_t>(tag)].fetch_sub(bytes, std::memory_order_relaxed);
+}
+
+ResourceUsage ResourceMonitor::sample() {
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+
+    const auto now = std::chrono::steady_clock::now();
+    const auto elapsed = now - reg.lastSample;
+    if (elapsed >= kMinSampleInterval) {
+        const double seconds = std::chrono::duration<double>(elapsed).count();
+        const double alpha = 1.0 - std::exp(-seconds / kAverageWindowSeconds);
+
+        std::array<std::uint64_t, kRoleCount> totals{};
+        std::array<std::uint32_t, kRoleCount> live{};
+        for (std::size_t i = 0; i < kRoleCount; ++i) {
+            totals[i] = reg.roles[i].retiredNs;
+        }
+        for (const auto& entry : reg.threads) {
+            const auto index = static_cast<std::size_t>(entry->role);
+            const std::uint64_t cpu = entryCpuNs(*entry);
+            totals[index] += cpu > entry->baseNs ? cpu - entry->baseNs : 0;
+            ++live[index];
+        }
+
+        for (std::size_t i = 0; i < kRoleCount; ++i) {
+            RoleState& state = reg.roles[i];
+            const std::uint64_t delta = totals[i] > state.lastTotalNs ? totals[i] - state.lastTotalNs : 0;
+            const double percent = static_cast<double>(delta) / (seconds * 1e9) * 100.0;
+            state.averagePercent = state.hasAverage ? state.averagePercent + alpha * (percent - state.averagePercent) : percent;
+            state.hasAverage = true;
+            state.lastTotalNs = totals[i];
+
+            ThreadRoleUsage& usage = reg.lastUsage.threads[i];
+            usage.cpuPercent = state.averagePercent;
+            usage.cpuSeconds = static_cast<double>(totals[i]) / 1e9;
+            usage.threads = live[i];
+        }
+        reg.lastSample = now;
+    }
+
+    ResourceUsage usage = reg.lastUsage;
+    for (std::size_t i = 0; i < kTagCount; ++i) {
+        usage.memory[i].bytes = s_memoryBytes[i].load(std::memory_order_relaxed);
+        usage.memory[i].peakBytes = s_memoryPeak[i].load(std::memory_order_relaxed);
+    }
+    return usage;
+}
+
+std::string ResourceMonitor::format(const ResourceUsage& usage) {
+    std::string text = "cpu";
+    char buffer[64];
+    for (std::size_t i = 0; i < kRoleCount; ++i) {
+        const ThreadRoleUsage& role = usage.threads[i];
+        if (role.threads == 0 && role.cpuSeconds == 0.0) {
+            continue;
+        }
+        std::snprintf(buffer, sizeof(buffer), " %s %.2f%%", threadRoleName(static_cast<ThreadRole>(i)), role.cpuPercent);
+        text += buffer;
+    }
+
+    text += " | mem";
+    for (std::size_t i = 0; i < kTagCount; ++i) {
+        if (usage.memory[i].bytes == 0) {
+            continue;
+        }
+        formatBytes(buffer, sizeof(buffer), usage.memory[i].bytes);
+        text += " ";
+        text += memoryTagName(static_cast<MemoryTag>(i));
+        text += " ";
+        text += buffer;
+    }
+    return text;
+}
+
+} // namespace openmeters::common
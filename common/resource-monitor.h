@@ -0,0 +1,125 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace openmeters::common {
+
+/**
+ * Subsystems whose threads are CPU-accounted.
+ */
+enum class ThreadRole {
+    Capture,  // Audio source threads (metering runs inline here)
+    Analysis, // Batch analysis workers (library scanner pool)
+    Ui,       // Window / render loop
+    Logger,   // Logging, stats and trace/recording writers
+    Count
+};
+
+/**
+ * Subsystems whose long-lived buffers (arenas, rings) are memory-accounted.
+ */
+enum class MemoryTag {
+    Audio,    // Per-packet capture arenas
+    Analysis, // Analyzer state and scratch
+    Ui,
+    Logging,
+    Tracing,  // Trace zone rings, capture trace rings
+    Other,
+    Count
+};
+
+/**
+ * Display name of a role / tag ("capture", "audio", ...).
+ */
+[[nodiscard]] const char* threadRoleName(ThreadRole role) noexcept;
+[[nodiscard]] const char* memoryTagName(MemoryTag tag) noexcept;
+
+/**
+ * CPU use of all threads registered under one role.
+ */
+struct ThreadRoleUsage {
+    double cpuPercent = 0.0;    // Rolling average, percent of one core
+    double cpuSeconds = 0.0;    // Total since start (including exited threads)
+    std::uint32_t threads = 0;  // Live threads
+};
+
+/**
+ * Bytes held by one memory tag.
+ */
+struct MemoryTagUsage {
+    std::uint64_t bytes = 0;
+    std::uint64_t peakBytes = 0;
+};
+
+/**
+ * Per-role CPU and per-tag memory, indexed by the enum values.
+ */
+struct ResourceUsage {
+    std::array<ThreadRoleUsage, static_cast<std::size_t>(ThreadRole::Count)> threads{};
+    std::array<MemoryTagUsage, static_cast<std::size_t>(MemoryTag::Count)> memory{};
+
+    [[nodiscard]] const ThreadRoleUsage& thread(ThreadRole role) const noexcept {
+        return threads[static_cast<std::size_t>(role)];
+    }
+
+    [[nodiscard]] const MemoryTagUsage& tag(MemoryTag memoryTag) const noexcept {
+        return memory[static_cast<std::size_t>(memoryTag)];
+    }
+};
+
+/**
+ * Process self-accounting.
+ *
+ * Threads register under a role; sample() reads each thread's CPU clock
+ * (pthread_getcpuclockid on Linux, GetThreadTimes on Windows) and keeps
+ * an exponentially weighted rolling average per role. Arenas and rings
+ * report their reservations under a memory tag.
+ *
+ * Thread safety: All functions are thread-safe. trackAllocation and
+ * trackRelease are lock-free; registerCurrentThread and sample are not
+ * real-time safe.
+ */
+class ResourceMonitor {
+public:
+    /**
+     * Time constant of the rolling CPU average.
+     */
+    static constexpr double kAverageWindowSeconds = 10.0;
+
+    /**
+     * Account the calling thread's CPU time to role until it exits.
+     * Real-time threads call this before entering their RealtimeScope.
+     *
+     * @param role Subsystem the thread works for
+     */
+    static void registerCurrentThread(ThreadRole role);
+
+    /**
+     * Count long-lived bytes reserved under a tag.
+     */
+    static void trackAllocation(MemoryTag tag, std::size_t bytes) noexcept;
+
+    /**
+     * Count bytes returned under a tag.
+     */
+    static void trackRelease(MemoryTag tag, std::size_t bytes) noexcept;
+
+    /**
+     * Read CPU clocks, update the rolling averages and return current usage.
+     * Calls less than 100 ms apart reuse the previous averages.
+     */
+    static ResourceUsage sample();
+
+    /**
+     * Format usage as a log fragment ("cpu capture 0.4% ... | mem audio 96 KB ...").
+     */
+    [[nodiscard]] static std::string format(const ResourceUsage& usage);
+
+private:
+    ResourceMonitor() = delete;
+};
+
+} // namespace openmeters::common
@@ -0,0 +1,231 @@
+#include "rt-check.h"
+#include "realtime-scope.h"
+
+#ifdef OPENMETERS_RT_CHECK
+
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <dlfcn.h>
+#include <execinfo.h>
+#include <pthread.h>
+#include <unistd.h>
+
+// glibc's underlying allocator entry points; the interposers forward here
+extern "C" {
+void* __libc_malloc(std::size_t size);
+void* __libc_calloc(std::size_t count, std::size_t size);
+void* __libc_realloc(void* ptr, std::size_t size);
+void* __libc_memalign(std::size_t alignment, std::size_t size);
+void __libc_free(void* ptr);
+}
+
+namespace openmeters::common {
+
+namespace {
+
+constexpr std::uint64_t kMaxReports = 16; // Stack traces printed; later violations are only counted
+constexpr int kMaxFrames = 32;
+
+using MutexLockFn = int (*)(pthread_mutex_t*);
+
+std::atomic<std::uint64_t> s_violations{0};
+std::atomic<bool> s_installed{false};
+std::atomic<MutexLockFn> s_realMutexLock{nullptr};
+std::atomic<MutexLockFn> s_realMutexTrylock{nullptr};
+
+// Set while reporting so the reporter's own allocations are not flagged
+thread_local bool t_reporting = false;
+
+void writeStderr(const char* text) noexcept {
+    const ssize_t written = ::write(STDERR_FILENO, text, std::strlen(text));
+    (void)written;
+}
+
+MutexLockFn resolve(std::atomic<MutexLockFn>& cache, const char* name) noexcept {
+    MutexLockFn fn = cache.load(std::memory_order_acquire);
+    if (!fn) {
+        fn = reinterpret_cast<MutexLockFn>(dlsym(RTLD_NEXT, name));
+        cache.store(fn, std::memory_order_release);
+    }
+    return fn;
+}
+
+MutexLockFn realMutexLock() noexcept {
+    return resolve(s_realMutexLock, "pthread_mutex_lock");
+}
+
+MutexLockFn realMutexTrylock() noexcept {
+    return resolve(s_realMutexTrylock, "pthread_mutex_trylock");
+}
+
+// Arguments posix_memalign accepts: a power of two, a multiple of sizeof(void*)
+bool validAlignment(std::size_t alignment) noexcept {
+    return alignment != 0 && (alignment & (alignment - 1)) == 0 && alignment % sizeof(void*) == 0;
+}
+
+void checkRealtime(const char* what) noexcept {
+    if (t_reporting || !isRealtimeThread()) {
+        return;
+    }
+
+    t_reporting = true;
+    const std::uint64_t count = s_violations.fetch_add(1, std::memory_order_relaxed) + 1;
+    if (count <= kMaxReports) {
+        writeStderr("[rt-check] ");
+        writeStderr(what);
+        writeStderr(" called on a real-time thread\n");
+
+        // backtrace_symbols_fd writes straight to the fd without allocating
+        void* frames[kMaxFrames];
+        const int frameCount = backtrace(frames, kMaxFrames);
+        backtrace_symbols_fd(frames, frameCount, STDERR_FILENO);
+    }
+    t_reporting = false;
+}
+
+} // namespace
+
+void rtCheckInstall() noexcept {
+    if (s_installed.exchange(true)) {
+        return;
+    }
+
+    // These may allocate on first use, so do it outside any real-time scope
+    (void)realMutexLock();
+    (void)realMutexTrylock();
+    void* frame[1];
+    (void)backtrace(frame, 1);
+}
+
+std::uint64_t rtViolationCount() noexcept {
+    return s_violations.load(std::memory_order_relaxed);
+}
+
+void resetRtViolations() noexcept {
+    s_violations.store(0, std::memory_order_relaxed);
+}
+
+} // namespace openmeters::common
+
+using openmeters::common::checkRealtime;
+
+// C++ allocation
+
+void* operator new(std::size_t size) {
+    checkRealtime("operator new");
+    if (void* ptr = __libc_malloc(size ? size : 1)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    checkRealtime("operator new");
+    if (void* ptr = __libc_memalign(static_cast<std::size_t>(alignment), size ? size : 1)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept {
+    if (ptr) {
+        checkRealtime("operator delete");
+    }
+    __libc_free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    operator delete(ptr);
+}
+
+void operator delete(void* ptr, std::align_val_t) noexcept {
+    operator delete(ptr);
+}
+
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept {
+    operator delete(ptr);
+}
+
+// C allocation
+
+extern "C" void* malloc(std::size_t size) noexcept {
+    checkRealtime("malloc");
+    return __libc_malloc(size);
+}
+
+extern "C" void* calloc(std::size_t count, std::size_t size) noexcept {
+    checkRealtime("calloc");
+    return __libc_calloc(count, size);
+}
+
+extern "C" void* realloc(void* ptr, std::size_t size) noexcept {
+    checkRealtime("realloc");
+    return __libc_realloc(ptr, size);
+}
+
+// Aligned allocation (aligned operator new in libstdc++ and most aligned
+// containers end up in one of these)
+
+extern "C" void* aligned_alloc(std::size_t alignment, std::size_t size) noexcept {
+    checkRealtime("aligned_alloc");
+    return __libc_memalign(alignment, size);
+}
+
+extern "C" int posix_memalign(void** ptr, std::size_t alignment, std::size_t size) noexcept {
+    checkRealtime("posix_memalign");
+    if (!openmeters::common::validAlignment(alignment)) {
+        return EINVAL;
+    }
+    void* block = __libc_memalign(alignment, size);
+    if (!block) {
+        return ENOMEM;
+    }
+    *ptr = block;
+    return 0;
+}
+
+extern "C" void* memalign(std::size_t alignment, std::size_t size) noexcept {
+    checkRealtime("memalign");
+    return __libc_memalign(alignment, size);
+}
+
+extern "C" void free(void* ptr) noexcept {
+    if (ptr) {
+        checkRealtime("free");
+    }
+    __libc_free(ptr);
+}
+
+// Locks
+
+extern "C" int pthread_mutex_lock(pthread_mutex_t* mutex) noexcept {
+    checkRealtime("pthread_mutex_lock");
+    return openmeters::common::realMutexLock()(mutex);
+}
+
+extern "C" int pthread_mutex_trylock(pthread_mutex_t* mutex) noexcept {
+    checkRealtime("pthread_mutex_trylock");
+    return openmeters::common::realMutexTrylock()(mutex);
+}
+
+#else
+
+namespace openmeters::common {
+
+void rtCheckInstall() noexcept {
+}
+
+std::uint64_t rtViolationCount() noexcept {
+    return 0;
+}
+
+void resetRtViolations() noexcept {
+}
+
+} // namespace openmeters::common
+
+#endif // OPENMETERS_RT_CHECK
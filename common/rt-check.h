@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstdint>
+
+namespace openmeters::common {
+
+/**
+ * Real-time safety sanitizer (OPENMETERS_RT_CHECK builds, Linux/glibc).
+ *
+ * When enabled, operator new/delete, malloc/calloc/realloc/free, the
+ * aligned allocators (aligned_alloc, posix_memalign, memalign) and
+ * pthread_mutex_lock/trylock are interposed. Any such call made while the current
+ * thread is inside a RealtimeScope (capture threads, analysis threads and
+ * IAudioDataCallback invocations) counts as a violation and is reported to
+ * stderr with a stack trace. The test runner fails if any violation was
+ * recorded.
+ *
+ * In normal builds these functions compile to no-ops and report zero.
+ *
+ * Thread safety: All functions are thread-safe.
+ */
+
+/**
+ * Check whether this binary was built with OPENMETERS_RT_CHECK.
+ */
+[[nodiscard]] constexpr bool rtCheckEnabled() noexcept {
+#ifdef OPENMETERS_RT_CHECK
+    return true;
+#else
+    return false;
+#endif
+}
+
+/**
+ * Resolve interposed symbols and warm up stack trace support.
+ * Called automatically when a RealtimeScope is entered; safe to call repeatedly.
+ */
+void rtCheckInstall() noexcept;
+
+/**
+ * Number of violations recorded since start (or the last reset).
+ */
+[[nodiscard]] std::uint64_t rtViolationCount() noexcept;
+
+/**
+ * Clear the violation counter (tests that provoke violations on purpose).
+ */
+void resetRtViolations() noexcept;
+
+} // namespace openmeters::common
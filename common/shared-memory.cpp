@@ -0,0 +1,164 @@
+#include "shared-memory.h"
+#include "logger.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace openmeters::common {
+
+namespace {
+
+bool isValidName(const std::string& name) {
+    return !name.empty() && name.size() < 200 && std::all_of(name.begin(), name.end(), [](char c) {
+        return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') ||
+               c == '-' || c == '_' || c == '.';
+    });
+}
+
+void logInUse(const std::string& name) {
+    LOG_ERROR("Shared memory segment \"{}\" is in use by another running writer; choose another name", name);
+}
+
+} // namespace
+
+SharedMemory::~SharedMemory() {
+    close();
+}
+
+#ifdef _WIN32
+
+bool SharedMemory::create(const std::string& name, std::size_t size, StaleCheck isStale) {
+    close();
+    if (size == 0 || !isValidName(name)) {
+        return false;
+    }
+
+    const auto size64 = static_cast<std::uint64_t>(size);
+    const std::string path = "Local\\" + name;
+    m_mappingHandle = CreateFileMappingA(
+        INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE,
+        static_cast<DWORD>(size64 >> 32), static_cast<DWORD>(size64 & 0xFFFFFFFFu), path.c_str()
+    );
+    if (!m_mappingHandle) {
+        return false;
+    }
+    const bool existed = GetLastError() == ERROR_ALREADY_EXISTS;
+
+    m_data = static_cast<std::uint8_t*>(MapViewOfFile(m_mappingHandle, FILE_MAP_WRITE, 0, 0, 0));
+    if (!m_data) {
+        close();
+        return false;
+    }
+
+    if (existed) {
+        // The mapping keeps its original size; only a stale one that is
+        // large enough can be taken over
+        MEMORY_BASIC_INFORMATION info = {};
+        const std::size_t existing = VirtualQuery(m_data, &info, sizeof(info)) ? info.RegionSize : 0;
+        if (existing < size || !isStale || !isStale(m_data, size)) {
+            close();
+            logInUse(name);
+            return false;
+        }
+    }
+
+    m_size = size;
+    m_name = name;
+    std::memset(m_data, 0, m_size);
+    return true;
+}
+
+void SharedMemory::close() {
+    if (m_data) {
+        UnmapViewOfFile(m_data);
+        m_data = nullptr;
+    }
+    if (m_mappingHandle) {
+        CloseHandle(m_mappingHandle);
+        m_mappingHandle = nullptr;
+    }
+    m_size = 0;
+    m_name.clear();
+}
+
+#else
+
+bool SharedMemory::create(const std::string& name, std::size_t size, StaleCheck isStale) {
+    close();
+    if (size == 0 || !isValidName(name)) {
+        return false;
+    }
+
+    const std::string path = "/" + name;
+    int fd = shm_open(path.c_str(), O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC, 0644);
+    if (fd < 0 && errno == EEXIST) {
+        // Left by a crashed run, or owned by another instance: take over
+        // only the former (readers still mapping it resume)
+        fd = shm_open(path.c_str(), O_RDWR | O_CLOEXEC, 0);
+        if (fd >= 0 && !existingIsStale(fd, isStale)) {
+            ::close(fd);
+            logInUse(name);
+            return false;
+        }
+    }
+    if (fd < 0) {
+        return false;
+    }
+    if (ftruncate(fd, static_cast<off_t>(size)) != 0) {
+        ::close(fd);
+        return false;
+    }
+
+    void* mapping = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        return false;
+    }
+
+    m_data = static_cast<std::uint8_t*>(mapping);
+    m_size = size;
+    m_name = name;
+    std::memset(m_data, 0, m_size); // Also faults every page in
+    return true;
+}
+
+bool SharedMemory::existingIsStale(int fd, StaleCheck isStale) {
+    struct stat info = {};
+    if (!isStale || fstat(fd, &info) != 0) {
+        return false;
+    }
+    const auto size = static_cast<std::size_t>(info.st_size);
+    if (size == 0) {
+        return isStale(nullptr, 0);
+    }
+    void* mapping = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    if (mapping == MAP_FAILED) {
+        return false;
+    }
+    const bool stale = isStale(static_cast<const std::uint8_t*>(mapping), size);
+    munmap(mapping, size);
+    return stale;
+}
+
+void SharedMemory::close() {
+    if (m_data) {
+        munmap(m_data, m_size);
+        shm_unlink(("/" + m_name).c_str());
+        m_data = nullptr;
+    }
+    m_size = 0;
+    m_name.clear();
+}
+
+#endif
+
+} // namespace openmeters::common
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace openmeters::common {
+
+/**
+ * Named shared memory segment created by this process for others to map:
+ * a POSIX shared memory object ("/<name>") or a Windows pagefile-backed
+ * file mapping ("Local\<name>"). The segment is zero-filled and its pages
+ * are touched up front, so the first store from a real-time thread does
+ * not fault.
+ *
+ * A segment of the same name that already exists belongs to another
+ * writer: create() fails unless the caller's check finds it stale (its
+ * writer gone), so two processes never write one segment.
+ *
+ * close() removes the name (POSIX) or drops our handle (Windows); readers
+ * that still have it mapped keep their view until they unmap it.
+ *
+ * Thread safety: Not thread-safe. The mapped bytes may be written and
+ * read concurrently under a protocol of the caller's choosing.
+ */
+class SharedMemory {
+public:
+    /**
+     * Decides from an existing segment's contents (size bytes, possibly
+     * fewer than requested) whether it may be taken over.
+     */
+    using StaleCheck = bool (*)(const std::uint8_t* data, std::size_t size);
+
+    SharedMemory() = default;
+    ~SharedMemory();
+
+    // Non-copyable, non-movable
+    SharedMemory(const SharedMemory&) = delete;
+    SharedMemory& operator=(const SharedMemory&) = delete;
+    SharedMemory(SharedMemory&&) = delete;
+    SharedMemory& operator=(SharedMemory&&) = delete;
+
+    /**
+     * Create (or take over a stale) segment and map it for writing.
+     *
+     * @param name Segment name without prefix (letters, digits, '-', '_', '.')
+     * @param size Segment size in bytes (must be non-zero)
+     * @param isStale Check for an existing segment (nullptr: never take over)
+     * @return true if the segment was created and mapped, false otherwise
+     *         (also when the name is in use by a live writer)
+     */
+    bool create(const std::string& name, std::size_t size, StaleCheck isStale = nullptr);
+
+    /**
+     * Unmap the segment and remove its name.
+     */
+    void close();
+
+    [[nodiscard]] std::uint8_t* data() noexcept { return m_data; }
+    [[nodiscard]] std::size_t size() const noexcept { return m_size; }
+    [[nodiscard]] bool isOpen() const noexcept { return m_data != nullptr; }
+    [[nodiscard]] const std::string& name() const noexcept { return m_name; }
+
+private:
+#ifndef _WIN32
+    /**
+     * Map an existing segment read-only and run the caller's check on it.
+     */
+    static bool existingIsStale(int fd, StaleCheck isStale);
+#endif
+
+    std::uint8_t* m_data = nullptr;
+    std::size_t m_size = 0;
+    std::string m_name;
+
+#ifdef _WIN32
+    void* m_mappingHandle = nullptr;
+#endif
+};
+
+} // namespace openmeters::common
@@ -0,0 +1,84 @@
+#include "spsc-ring.h"
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <new>
+
+namespace openmeters::common {
+
+SpscByteRing::~SpscByteRing() {
+    ResourceMonitor::trackRelease(m_tag, m_buffer.size());
+}
+
+bool SpscByteRing::reserve(std::size_t capacityBytes) {
+    if (capacityBytes > std::numeric_limits<std::size_t>::max() / 2 + 1) {
+        return false; // No power of two that large
+    }
+    std::size_t capacity = 1;
+    while (capacity < capacityBytes) {
+        capacity <<= 1;
+    }
+
+    // Allocate first so a failure leaves the ring as it was
+    std::vector<std::uint8_t> buffer;
+    try {
+        buffer.assign(capacity, 0);
+    } catch (const std::bad_alloc&) {
+        return false;
+    }
+    ResourceMonitor::trackRelease(m_tag, m_buffer.size());
+    m_buffer = std::move(buffer);
+    ResourceMonitor::trackAllocation(m_tag, m_buffer.size());
+    m_mask = capacity - 1;
+    m_writePos.store(0);
+    m_readPos.store(0);
+    return true;
+}
+
+bool SpscByteRing::write(const void* first, std::size_t firstBytes, const void* second, std::size_t secondBytes) noexcept {
+    const std::size_t total = firstBytes + secondBytes;
+    const std::size_t writePos = m_writePos.load(std::memory_order_relaxed);
+    const std::size_t readPos = m_readPos.load(std::memory_order_acquire);
+    if (m_buffer.empty() || total > m_buffer.size() - (writePos - readPos)) {
+        return false;
+    }
+
+    copyIn(writePos, first, firstBytes);
+    if (secondBytes != 0) {
+        copyIn(writePos + firstBytes, second, secondBytes);
+    }
+    m_writePos.store(writePos + total, std::memory_order_release);
+    return true;
+}
+
+std::size_t SpscByteRing::read(void* dest, std::size_t maxBytes) noexcept {
+    const std::size_t readPos = m_readPos.load(std::memory_order_relaxed);
+    const std::size_t writePos = m_writePos.load(std::memory_order_acquire);
+    const std::size_t bytes = std::min(maxBytes, writePos - readPos);
+    if (bytes == 0) {
+        return 0;
+    }
+
+    const std::size_t start = readPos & m_mask;
+    const std::size_t firstChunk = std::min(bytes, m_buffer.size() - start);
+    auto* out = static_cast<std::uint8_t*>(dest);
+    std::memcpy(out, m_buffer.data() + start, firstChunk);
+    std::memcpy(out + firstChunk, m_buffer.data(), bytes - firstChunk);
+
+    m_readPos.store(readPos + bytes, std::memory_order_release);
+    return bytes;
+}
+
+std::size_t SpscByteRing::readable() const noexcept {
+    return m_writePos.load(std::memory_order_acquire) - m_readPos.load(std::memory_order_acquire);
+}
+
+void SpscByteRing::copyIn(std::size_t position, const void* source, std::size_t bytes) noexcept {
+    const std::size_t start = position & m_mask;
+    const std::size_t firstChunk = std::min(bytes, m_buffer.size() - start);
+    const auto* in = static_cast<const std::uint8_t*>(source);
+    std::memcpy(m_buffer.data() + start, in, firstChunk);
+    std::memcpy(m_buffer.data(), in + firstChunk, bytes - firstChunk);
+}
+
+} // namespace openmeters::common
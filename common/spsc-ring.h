@@ -0,0 +1,86 @@
+#pragma once
+
+#include "resource-monitor.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace openmeters::common {
+
+/**
+ * Single-producer/single-consumer byte ring.
+ * Used to hand variable-size records from a real-time thread to a worker
+ * (e.g. a file writer) without locks or allocation on the producer side.
+ * A record written with write() is either stored whole or not at all, so
+ * the byte stream stays well-framed.
+ *
+ * Thread safety: One producer thread calls write(); one consumer thread
+ * calls read(). reserve() must happen before either starts.
+ */
+class SpscByteRing {
+public:
+    SpscByteRing() = default;
+
+    /**
+     * @param tag Subsystem the ring storage is accounted to
+     */
+    explicit SpscByteRing(MemoryTag tag) : m_tag(tag) {}
+
+    ~SpscByteRing();
+
+    // Non-copyable, non-movable
+    SpscByteRing(const SpscByteRing&) = delete;
+    SpscByteRing& operator=(const SpscByteRing&) = delete;
+    SpscByteRing(SpscByteRing&&) = delete;
+    SpscByteRing& operator=(SpscByteRing&&) = delete;
+
+    /**
+     * Allocate storage (rounded up to a power of two). Not real-time safe.
+     *
+     * @param capacityBytes Minimum capacity in bytes
+     * @return true if storage was allocated, false otherwise
+     */
+    bool reserve(std::size_t capacityBytes);
+
+    /**
+     * Append a record made of two parts (e.g. header and payload).
+     *
+     * @return true if written, false if there was not enough free space
+     *
+     * Thread: Producer
+     */
+    bool write(const void* first, std::size_t firstBytes, const void* second = nullptr, std::size_t secondBytes = 0) noexcept;
+
+    /**
+     * Move up to maxBytes of buffered data into dest.
+     *
+     * @return Number of bytes copied
+     *
+     * Thread: Consumer
+     */
+    std::size_t read(void* dest, std::size_t maxBytes) noexcept;
+
+    /**
+     * Bytes currently buffered (approximate when called concurrently).
+     */
+    [[nodiscard]] std::size_t readable() const noexcept;
+
+    /**
+     * Ring size in bytes.
+     */
+    [[nodiscard]] std::size_t capacity() const noexcept { return m_buffer.size(); }
+
+private:
+    void copyIn(std::size_t position, const void* source, std::size_t bytes) noexcept;
+
+    MemoryTag m_tag = MemoryTag::Other;
+    std::vector<std::uint8_t> m_buffer;
+    std::size_t m_mask = 0;
+
+    // Monotonic positions; separate cache lines avoid producer/consumer false sharing
+    alignas(64) std::atomic<std::size_t> m_writePos{0};
+    alignas(64) std::atomic<std::size_t> m_readPos{0};
+};
+
+} // namespace openmeters::common
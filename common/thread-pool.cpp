@@ -0,0 +1,138 @@
+#include "thread-pool.h"
+#include "resource-monitor.h"
+
+namespace openmeters::common {
+
+namespace {
+
+// Identifies the pool/worker the current thread belongs to (if any)
+thread_local const ThreadPool* t_currentPool = nullptr;
+thread_local std::size_t t_workerIndex = 0;
+
+} // namespace
+
+ThreadPool::ThreadPool(std::size_t threadCount) {
+    if (threadCount == 0) {
+        threadCount = std::thread::hardware_concurrency();
+        if (threadCount == 0) {
+            threadCount = 2;
+        }
+    }
+
+    m_workers.reserve(threadCount);
+    for (std::size_t i = 0; i < threadCount; ++i) {
+        m_workers.push_back(std::make_unique<Worker>());
+    }
+
+    // Start threads only after every worker exists (stealers scan all of them)
+    for (std::size_t i = 0; i < threadCount; ++i) {
+        m_workers[i]->thread = std::thread(&ThreadPool::workerLoop, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    waitIdle();
+
+    {
+        std::lock_guard<std::mutex> lock(m_wakeMutex);
+        m_stopping.store(true);
+    }
+    m_wakeCv.notify_all();
+
+    for (auto& worker : m_workers) {
+        if (worker->thread.joinable()) {
+            worker->thread.join();
+        }
+    }
+}
+
+void ThreadPool::submit(Task task) {
+    if (!task) {
+        return;
+    }
+
+    // Workers keep their own subtasks; external submitters round-robin
+    std::size_t target;
+    if (t_currentPool == this) {
+        target = t_workerIndex;
+    } else {
+        target = m_nextWorker.fetch_add(1, std::memory_order_relaxed) % m_workers.size();
+    }
+
+    m_pending.fetch_add(1);
+    m_queued.fetch_add(1);
+    {
+        Worker& worker = *m_workers[target];
+        std::lock_guard<std::mutex> lock(worker.mutex);
+        worker.tasks.push_back(std::move(task));
+    }
+
+    {
+        // Pairs with the predicate check in workerLoop to avoid lost wakeups
+        std::lock_guard<std::mutex> lock(m_wakeMutex);
+    }
+    m_wakeCv.notify_one();
+}
+
+void ThreadPool::waitIdle() {
+    std::unique_lock<std::mutex> lock(m_wakeMutex);
+    m_idleCv.wait(lock, [this] { return m_pending.load() == 0; });
+}
+
+bool ThreadPool::popLocal(std::size_t index, Task& task) {
+    Worker& worker = *m_workers[index];
+    std::lock_guard<std::mutex> lock(worker.mutex);
+    if (worker.tasks.empty()) {
+        return false;
+    }
+    task = std::move(worker.tasks.back());
+    worker.tasks.pop_back();
+    return true;
+}
+
+bool ThreadPool::steal(std::size_t thiefIndex, Task& task) {
+    const std::size_t count = m_workers.size();
+    for (std::size_t offset = 1; offset < count; ++offset) {
+        Worker& victim = *m_workers[(thiefIndex + offset) % count];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+void ThreadPool::workerLoop(std::size_t index) {
+    ResourceMonitor::registerCurrentThread(ThreadRole::Analysis);
+    t_currentPool = this;
+    t_workerIndex = index;
+
+    while (true) {
+        Task task;
+        if (popLocal(index, task) || steal(index, task)) {
+            m_queued.fetch_sub(1);
+            task();
+            task = nullptr; // Release captures before signalling completion
+
+            if (m_pending.fetch_sub(1) == 1) {
+                std::lock_guard<std::mutex> lock(m_wakeMutex);
+                m_idleCv.notify_all();
+            }
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(m_wakeMutex);
+        m_wakeCv.wait(lock, [this] {
+            return m_stopping.load() || m_queued.load() > 0;
+        });
+        if (m_stopping.load() && m_queued.load() == 0) {
+            break;
+        }
+    }
+
+    t_currentPool = nullptr;
+}
+
+} // namespace openmeters::common
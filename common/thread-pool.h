@@ -0,0 +1,86 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace openmeters::common {
+
+/**
+ * Work-stealing thread pool for batch (non-real-time) work.
+ * Each worker owns a task deque. Workers pop their own newest task first
+ * and steal the oldest task from other workers when idle. Tasks submitted
+ * from a worker thread go to that worker's deque, so recursive work (e.g.
+ * directory walks) stays local until someone else runs dry.
+ *
+ * Workers are CPU-accounted as ThreadRole::Analysis.
+ *
+ * Thread safety: All public operations are thread-safe.
+ * Not for use on the audio thread (tasks are std::function and may allocate).
+ */
+class ThreadPool {
+public:
+    using Task = std::function<void()>;
+
+    /**
+     * Create the pool and start workers.
+     *
+     * @param threadCount Number of workers (0 = hardware concurrency)
+     */
+    explicit ThreadPool(std::size_t threadCount = 0);
+    ~ThreadPool();
+
+    // Non-copyable, non-movable
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    ThreadPool(ThreadPool&&) = delete;
+    ThreadPool& operator=(ThreadPool&&) = delete;
+
+    /**
+     * Queue a task for execution.
+     *
+     * @param task Task to run (must not throw)
+     */
+    void submit(Task task);
+
+    /**
+     * Block until every submitted task (including tasks submitted by
+     * running tasks) has finished.
+     */
+    void waitIdle();
+
+    /**
+     * Number of worker threads.
+     */
+    [[nodiscard]] std::size_t threadCount() const noexcept { return m_workers.size(); }
+
+private:
+    struct Worker {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+        std::thread thread;
+    };
+
+    void workerLoop(std::size_t index);
+    bool popLocal(std::size_t index, Task& task);
+    bool steal(std::size_t thiefIndex, Task& task);
+
+    std::vector<std::unique_ptr<Worker>> m_workers;
+
+    std::mutex m_wakeMutex;
+    std::condition_variable m_wakeCv;
+    std::condition_variable m_idleCv;
+
+    std::atomic<std::size_t> m_queued{0};   // Tasks waiting in deques
+    std::atomic<std::size_t> m_pending{0};  // Queued + running tasks
+    std::atomic<std::size_t> m_nextWorker{0};
+    std::atomic<bool> m_stopping{false};
+};
+
+} // namespace openmeters::common
@@ -0,0 +1,230 @@
+#include "trace.h"
+#include "realtime-scope.h"
+#include "resource-monitor.h"
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace openmeters::common::trace {
+
+namespace detail {
+std::atomic<bool> g_enabled{false};
+}
+
+namespace {
+
+constexpr ZoneId kMaxZones = 4096;
+constexpr auto kMinCalibration = std::chrono::milliseconds(10);
+
+struct Record {
+    std::uint64_t start;
+    std::uint32_t duration; // Ticks, saturated
+    ZoneId zone;
+};
+static_assert(sizeof(Record) == 16, "trace record layout");
+
+struct ThreadBuffer {
+    std::string name;
+    std::uint32_t tid = 0;
+    std::unique_ptr<Record[]> records;
+    std::atomic<std::uint64_t> head{0}; // Total records written (monotonic)
+    bool inUse = false;                 // Owned by a live thread (registry mutex)
+};
+
+// Zone names by ID; written once per TRACE_ZONE site, read at export
+std::atomic<const char*> s_zoneNames[kMaxZones];
+std::atomic<ZoneId> s_zoneCount{0};
+
+// Tick calibration reference (taken at the first enable)
+std::atomic<bool> s_calibrated{false};
+std::uint64_t s_originTicks = 0;
+std::chrono::steady_clock::time_point s_originTime;
+
+std::mutex s_registryMutex;
+
+// The calling thread's buffer. Trivially destructible, so the hot path
+// reads it directly instead of through a TLS init wrapper.
+thread_local ThreadBuffer* t_buffer = nullptr;
+
+// Hands the buffer back for reuse when the thread exits; its records stay
+// exportable until another thread takes the buffer over
+struct ThreadHandle {
+    ThreadBuffer* buffer = nullptr;
+
+    ~ThreadHandle() {
+        if (buffer) {
+            std::lock_guard<std::mutex> lock(s_registryMutex);
+            buffer->inUse = false;
+        }
+    }
+};
+thread_local ThreadHandle t_handle;
+
+std::vector<std::unique_ptr<ThreadBuffer>>& registry() {
+    // Buffers live until exit so zones from finished threads can still be exported
+    static std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+    return buffers;
+}
+
+// Slow path of record(): a thread that never registered gets a default name
+ThreadBuffer* registerOnFirstZone() noexcept {
+    if (isRealtimeThread()) {
+        return nullptr; // Would allocate; real-time threads register up front
+    }
+    try {
+        registerThread("thread");
+    } catch (...) {
+        return nullptr;
+    }
+    return t_buffer;
+}
+
+void writeEscaped(std::ostream& out, const char* text) {
+    for (const char* c = text; *c; ++c) {
+        if (*c == '"' || *c == '\\') {
+            out << '\\';
+        }
+        out << *c;
+    }
+}
+
+} // namespace
+
+ZoneId internZone(const char* name) noexcept {
+    const ZoneId id = s_zoneCount.fetch_add(1, std::memory_order_relaxed);
+    if (id >= kMaxZones) {
+        return kMaxZones - 1; // Out of IDs: share the last slot
+    }
+    s_zoneNames[id].store(name, std::memory_order_release);
+    return id;
+}
+
+void registerThread(const std::string& name) {
+    std::lock_guard<std::mutex> lock(s_registryMutex);
+    if (t_buffer) {
+        t_buffer->name = name;
+        return;
+    }
+
+    // Reuse the ring of a finished thread (preferably one with the same name)
+    ThreadBuffer* reuse = nullptr;
+    for (const auto& buffer : registry()) {
+        if (!buffer->inUse && (!reuse || buffer->name == name)) {
+            reuse = buffer.get();
+        }
+    }
+
+    if (!reuse) {
+        auto buffer = std::make_unique<ThreadBuffer>();
+        buffer->tid = static_cast<std::uint32_t>(registry().size() + 1);
+        buffer->records = std::make_unique<Record[]>(kRecordsPerThread);
+        ResourceMonitor::trackAllocation(MemoryTag::Tracing, kRecordsPerThread * sizeof(Record));
+        reuse = buffer.get();
+        registry().push_back(std::move(buffer));
+    }
+
+    // The old records belong to the finished thread, not this one
+    reuse->head.store(0, std::memory_order_relaxed);
+    reuse->name = name;
+    reuse->inUse = true;
+    t_handle.buffer = reuse;
+    t_buffer = reuse;
+}
+
+void enable() noexcept {
+    if (!s_calibrated.exchange(true)) {
+        s_originTime = std::chrono::steady_clock::now();
+        s_originTicks = now();
+    }
+    detail::g_enabled.store(true, std::memory_order_release);
+}
+
+void disable() noexcept {
+    detail::g_enabled.store(false, std::memory_order_release);
+}
+
+void clear() noexcept {
+    std::lock_guard<std::mutex> lock(s_registryMutex);
+    for (const auto& buffer : registry()) {
+        buffer->head.store(0, std::memory_order_relaxed);
+    }
+}
+
+void record(ZoneId zone, std::uint64_t start, std::uint64_t end) noexcept {
+    ThreadBuffer* buffer = t_buffer;
+    if (!buffer) {
+        buffer = registerOnFirstZone();
+        if (!buffer) {
+            return;
+        }
+    }
+
+    const std::uint64_t head = buffer->head.load(std::memory_order_relaxed);
+    Record& slot = buffer->records[head & (kRecordsPerThread - 1)];
+    slot.start = start;
+    slot.duration = static_cast<std::uint32_t>(std::min<std::uint64_t>(end - start, std::numeric_limits<std::uint32_t>::max()));
+    slot.zone = zone;
+    buffer->head.store(head + 1, std::memory_order_release);
+}
+
+long long exportChromeTrace(const std::string& path) {
+    if (!s_calibrated.load()) {
+        return 0; // Never enabled
+    }
+
+    // Ticks per microsecond, measured against steady_clock since the first enable
+    auto elapsed = std::chrono::steady_clock::now() - s_originTime;
+    if (elapsed < kMinCalibration) {
+        std::this_thread::sleep_for(kMinCalibration - elapsed);
+    }
+    const std::uint64_t ticks = now() - s_originTicks;
+    elapsed = std::chrono::steady_clock::now() - s_originTime;
+    const double elapsedUs = std::chrono::duration<double, std::micro>(elapsed).count();
+    const double ticksPerUs = elapsedUs > 0.0 ? static_cast<double>(ticks) / elapsedUs : 1000.0;
+
+    std::ofstream out(path, std::ios::trunc);
+    if (!out.is_open()) {
+        return -1;
+    }
+    out << std::fixed << std::setprecision(3);
+    out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n";
+
+    long long events = 0;
+    bool first = true;
+    const ZoneId zoneCount = std::min(s_zoneCount.load(), kMaxZones);
+
+    std::lock_guard<std::mutex> lock(s_registryMutex);
+    for (const auto& buffer : registry()) {
+        out << (first ? "" : ",\n")
+            << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->tid
+            << ",\"args\":{\"name\":\"";
+        writeEscaped(out, buffer->name.c_str());
+        out << "\"}}";
+        first = false;
+
+        const std::uint64_t head = buffer->head.load(std::memory_order_acquire);
+        const std::uint64_t count = std::min<std::uint64_t>(head, kRecordsPerThread);
+        for (std::uint64_t i = head - count; i < head; ++i) {
+            const Record& rec = buffer->records[i & (kRecordsPerThread - 1)];
+            const char* name = rec.zone < zoneCount ? s_zoneNames[rec.zone].load(std::memory_order_acquire) : nullptr;
+            const double ts = (static_cast<double>(rec.start) - static_cast<double>(s_originTicks)) / ticksPerUs;
+
+            out << ",\n{\"name\":\"";
+            writeEscaped(out, name ? name : "?");
+            out << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->tid
+                << ",\"ts\":" << ts
+                << ",\"dur\":" << static_cast<double>(rec.duration) / ticksPerUs << "}";
+            ++events;
+        }
+    }
+
+    out << "\n]}\n";
+    return out ? events : -1;
+}
+
+} // namespace openmeters::common::trace
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "format-convert.h"
+#include "../../common/audio-format.h"
+#include "../../common/buffer-pool.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace openmeters::core::audio {
+
+/**
+ * One captured packet in the device's native sample format.
+ * Lets consumers that can work on integer PCM (e.g. meters) skip the
+ * float conversion entirely.
+ * Blocks taken from scratch (planar copies, analysis buffers) are valid
+ * until the callback returns; the arena is reset for every packet.
+ *
+ * A silent packet (AUDCLNT_BUFFERFLAGS_SILENT) carries no samples: data is
+ * null and silent is set, so analyzers can advance their state in closed
+ * form. Callbacks that decline it get zeros through onAudioData.
+ */
+struct AudioBlock {
+    const void* data = nullptr;                         // Interleaved samples
+    SampleFormat sampleFormat = SampleFormat::Float32;  // Encoding of data
+    std::size_t frameCount = 0;                         // Frames (samples per channel)
+    common::AudioFormat format;                         // Rate and channel layout
+    common::BufferPool* scratch = nullptr;              // Per-packet scratch arena (may be null)
+    std::uint64_t captureTimeNs = 0;                    // common::monotonicNanos() when captured by the device
+    bool silent = false;                                // Every sample is zero (data is null)
+    
+    /**
+     * Total number of samples (frames * channels).
+     */
+    [[nodiscard]] std::size_t sampleCount() const noexcept {
+        return frameCount * format.samplesPerFrame();
+    }
+};
+
+} // namespace openmeters::core::audio
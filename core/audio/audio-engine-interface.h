@@ -1,5 +1,8 @@
 #pragma once
 
+#include "audio-block.h"
+#include "engine-stats.h"
+#include <cstdint>
 #include "../../common/audio-format.h"
 #include "../../common/meter-values.h"
 
@@ -37,6 +40,24 @@ public:
      * Thread: Audio capture thread (real-time priority)
      */
     virtual void onMeterData(const common::MeterSnapshot& snapshot) = 0;
+    
+    /**
+     * Called with each packet in its native sample format, before onAudioData.
+     * Return true if the block was fully handled: onAudioData is then skipped
+     * for this callback, and the packet is only converted to float if another
+     * callback still needs it. Silent blocks (block.silent) have no data;
+     * a callback that returns false for one receives zeros.
+     * 
+     * @param block Packet in native format
+     * @return true if handled natively, false to receive float data via onAudioData
+     * 
+     * Thread: Audio capture thread (real-time priority)
+     * Ownership: Block data is valid only during this call
+     */
+    virtual bool onAudioBlock(const AudioBlock& block) {
+        (void)block;
+        return false;
+    }
 };
 
 /**
@@ -77,7 +98,8 @@ public:
     
     /**
      * Register a callback for audio data.
-     * Multiple callbacks can be registered.
+     * Multiple callbacks can be registered. Each receives the captured
+     * packets (onAudioBlock/onAudioData) and the meter snapshots.
      * 
      * @param callback Callback interface (must remain valid until unregistered)
      */
@@ -103,6 +125,50 @@ public:
      * @return true if capturing, false otherwise
      */
     [[nodiscard]] virtual bool isCapturing() const = 0;
+    
+    /**
+     * Get packet/frame counts, device glitches and timing percentiles
+     * since initialize().
+     * 
+     * @return Statistics snapshot
+     * 
+     * Thread safety: Callable from any thread while capturing.
+     */
+    [[nodiscard]] virtual EngineStats getStats() const = 0;
+    
+    /**
+     * Report that a snapshot reached the screen. Adds the time since its
+     * capture to the display latency histogram in the stats.
+     * 
+     * @param captureTimeNs MeterSnapshot::captureTimeNs of the presented snapshot
+     * 
+     * Thread safety: Callable from any thread (typically the render thread
+     * right after Present).
+     */
+    virtual void recordDisplayLatency(std::uint64_t captureTimeNs) = 0;
+    
+    /**
+     * Copy the overs (clips) detected since cursor. Every reader keeps its
+     * own cursor and sees every over; events older than the ring's
+     * capacity are lost. Positions count frames metered since the engine
+     * last started, so they match an AudioHistory registered before that
+     * start.
+     * 
+     * @param cursor Next event to read (start at 0); advanced past the events read
+     * @param events Receives up to maxEvents events, oldest first
+     * @param maxEvents Size of events
+     * @param lost If not null, receives the number of events that were
+     *        overwritten before this reader got to them
+     * @return Number of events copied
+     * 
+     * Thread safety: Callable from any thread; never blocks the capture thread.
+     */
+    virtual std::size_t readOverEvents(
+        std::uint64_t& cursor,
+        common::OverEvent* events,
+        std::size_t maxEvents,
+        std::uint64_t* lost
+    ) const = 0;
 };
 
 } // namespace openmeters::core::audio
@@ -1,14 +1,39 @@
 #include "audio-engine.h"
+#include "../../common/config.h"
+#include "../../common/logger.h"
+#include "../../common/resource-monitor.h"
+#include "../../common/trace.h"
+#include <algorithm>
 
 #ifdef _WIN32
-
-#include <algorithm>
+#include "wasapi-capture.h"
+#endif
 
 namespace openmeters::core::audio {
 
+namespace {
+
+// Overs kept for readers that fall behind (the UI drains every frame, the
+// logger once per stats interval)
+constexpr std::size_t kOverEventCapacity = 1024;
+
+// Overs logged one by one per stats interval; the rest are counted
+constexpr std::size_t kOverLogLimit = 16;
+
+} // namespace
+
+#ifdef _WIN32
 AudioEngine::AudioEngine()
-    : m_meteringCallback(this)
+    : AudioEngine(std::make_unique<WasapiCapture>())
+{
+}
+#endif
+
+AudioEngine::AudioEngine(std::unique_ptr<IAudioSource> source)
+    : m_source(std::move(source))
+    , m_meteringCallback(this)
 {
+    m_overEvents.reserve(kOverEventCapacity);
 }
 
 AudioEngine::~AudioEngine() {
@@ -16,76 +41,172 @@ AudioEngine::~AudioEngine() {
 }
 
 bool AudioEngine::initialize() {
-    if (!m_capture.initialize()) {
+    if (!m_source || !m_source->initialize()) {
         return false;
     }
     
     // Register internal metering callback
-    m_capture.registerCallback(&m_meteringCallback);
+    m_source->registerCallback(&m_meteringCallback);
+    
+    m_stats.reset();
+    m_source->setStatsCollector(&m_stats);
     
     return true;
 }
 
 bool AudioEngine::start() {
+    if (!m_source) {
+        return false;
+    }
+    
+    // Each start is a new stream for the over positions (and for any
+    // history registered before it)
+    if (!m_source->isCapturing()) {
+        m_meteringCallback.restart();
+    }
+    
     m_startTime = std::chrono::steady_clock::now();
-    return m_capture.start();
+    if (!m_source->start()) {
+        return false;
+    }
+    
+    if (m_statsLogInterval.count() > 0 && !m_statsLogThread.joinable()) {
+        m_statsLogStop = false;
+        m_statsLogThread = std::thread(&AudioEngine::statsLogThread, this);
+    }
+    return true;
 }
 
 void AudioEngine::stop() {
-    m_capture.stop();
+    stopStatsLog();
+    if (m_source) {
+        m_source->stop();
+    }
 }
 
 void AudioEngine::shutdown() {
     stop();
     
+    if (!m_source) {
+        return;
+    }
+    
     // Unregister internal callback
-    m_capture.unregisterCallback(&m_meteringCallback);
+    m_source->unregisterCallback(&m_meteringCallback);
+    m_source->setStatsCollector(nullptr);
     
     // Clear external callbacks
-    {
-        std::lock_guard<std::mutex> lock(m_callbackMutex);
-        m_callbacks.clear();
-    }
+    m_callbacks.clear();
     
-    m_capture.shutdown();
+    m_source->shutdown();
 }
 
 void AudioEngine::registerCallback(IAudioDataCallback* callback) {
-    if (!callback) {
-        return;
+    // Snapshots come from the metering callback; audio straight from the
+    // source, in the same packets the meters see
+    m_callbacks.add(callback);
+    if (m_source) {
+        m_source->registerCallback(callback);
     }
-    
-    std::lock_guard<std::mutex> lock(m_callbackMutex);
-    m_callbacks.push_back(callback);
 }
 
 void AudioEngine::unregisterCallback(IAudioDataCallback* callback) {
-    if (!callback) {
-        return;
+    if (m_source) {
+        m_source->unregisterCallback(callback);
     }
-    
-    std::lock_guard<std::mutex> lock(m_callbackMutex);
-    m_callbacks.erase(
-        std::remove(m_callbacks.begin(), m_callbacks.end(), callback),
-        m_callbacks.end()
-    );
+    m_callbacks.remove(callback);
 }
 
 common::AudioFormat AudioEngine::getFormat() const {
-    return m_capture.getFormat();
+    return m_source ? m_source->getFormat() : common::AudioFormat{};
 }
 
 bool AudioEngine::isCapturing() const {
-    return m_capture.isCapturing();
+    return m_source && m_source->isCapturing();
 }
 
-void AudioEngine::forwardMeterData(const common::MeterSnapshot& snapshot) {
-    std::lock_guard<std::mutex> lock(m_callbackMutex);
-    for (IAudioDataCallback* callback : m_callbacks) {
-        if (callback) {
-            callback->onMeterData(snapshot);
+EngineStats AudioEngine::getStats() const {
+    EngineStats stats = m_stats.snapshot();
+    stats.resources = common::ResourceMonitor::sample();
+    return stats;
+}
+
+void AudioEngine::recordDisplayLatency(std::uint64_t captureTimeNs) {
+    const std::uint64_t now = common::monotonicNanos();
+    if (captureTimeNs != 0 && now >= captureTimeNs) {
+        m_stats.recordDuration(StatsCollector::Timing::DisplayLatency, now - captureTimeNs);
+    }
+}
+
+std::size_t AudioEngine::readOverEvents(
+    std::uint64_t& cursor,
+    common::OverEvent* events,
+    std::size_t maxEvents,
+    std::uint64_t* lost
+) const {
+    return m_overEvents.read(cursor, events, maxEvents, lost);
+}
+
+void AudioEngine::setStatsLogInterval(std::chrono::seconds interval) {
+    m_statsLogInterval = interval;
+}
+
+void AudioEngine::statsLogThread() {
+    common::ResourceMonitor::registerCurrentThread(common::ThreadRole::Logger);
+    
+    EngineStats previous = m_stats.snapshot();
+    std::uint64_t overCursor = m_overEvents.writeIndex();
+    
+    std::unique_lock<std::mutex> lock(m_statsLogMutex);
+    while (!m_statsLogWake.wait_for(lock, m_statsLogInterval, [this] { return m_statsLogStop; })) {
+        logOvers(overCursor);
+        
+        const EngineStats stats = m_stats.snapshot();
+        const bool glitched = stats.discontinuities != previous.discontinuities ||
+                              stats.getBufferFailures != previous.getBufferFailures ||
+                              stats.droppedPackets != previous.droppedPackets;
+        if (glitched) {
+            LOG_WARNING(formatEngineStats(stats));
+        } else {
+            LOG_INFO(formatEngineStats(stats));
         }
+        previous = stats;
+    }
+}
+
+void AudioEngine::logOvers(std::uint64_t& cursor) {
+    const common::SampleRate rate = getFormat().sampleRate;
+    common::OverEvent events[kOverLogLimit];
+    std::uint64_t lost = 0;
+    const std::size_t count = m_overEvents.read(cursor, events, kOverLogLimit, &lost);
+    for (std::size_t i = 0; i < count; ++i) {
+        LOG_WARNING("Over on channel {} at frame {} ({:.3f} s)", events[i].channel, events[i].position,
+                    rate > 0 ? static_cast<double>(events[i].position) / rate : 0.0);
+    }
+    
+    // Count the rest without reading them
+    const std::uint64_t end = m_overEvents.writeIndex();
+    const std::uint64_t more = lost + (end > cursor ? end - cursor : 0);
+    cursor = std::max(cursor, end);
+    if (more > 0) {
+        LOG_WARNING("{} more overs not logged", more);
+    }
+}
+
+void AudioEngine::stopStatsLog() {
+    if (!m_statsLogThread.joinable()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_statsLogMutex);
+        m_statsLogStop = true;
     }
+    m_statsLogWake.notify_all();
+    m_statsLogThread.join();
+}
+
+void AudioEngine::forwardMeterData(const common::MeterSnapshot& snapshot) {
+    m_callbacks.dispatchMeterData(snapshot);
 }
 
 // MeteringCallback implementation
@@ -93,6 +214,7 @@ void AudioEngine::forwardMeterData(const common::MeterSnapshot& snapshot) {
 AudioEngine::MeteringCallback::MeteringCallback(AudioEngine* engine)
     : m_engine(engine)
 {
+    m_overDetector.setEventSink(&engine->m_overEvents);
 }
 
 void AudioEngine::MeteringCallback::onAudioData(
@@ -104,13 +226,153 @@ void AudioEngine::MeteringCallback::onAudioData(
         return;
     }
     
-    // Compute peak and RMS
-    const auto peak = m_peakMeter.process(buffer, frameCount, format);
-    const auto rms = m_rmsMeter.process(buffer, frameCount, format);
+    TRACE_ZONE("metering");
+    
+    meter(buffer, frameCount, format);
+}
+
+bool AudioEngine::MeteringCallback::onAudioBlock(const AudioBlock& block) {
+    // onAudioData for the same packet (after conversion) follows on this thread
+    m_captureTimeNs = block.captureTimeNs;
+    
+    if (block.silent && block.frameCount != 0) {
+        TRACE_ZONE("metering");
+        meterSilence(block.frameCount, block.format);
+        return true;
+    }
+    if (!block.data || block.frameCount == 0) {
+        return true; // Nothing to meter
+    }
+    
+    TRACE_ZONE("metering");
+    
+    // Meter directly on the device buffer for the common formats
+    switch (block.sampleFormat) {
+        case SampleFormat::Int16:
+            meter(static_cast<const std::int16_t*>(block.data), block.frameCount, block.format);
+            return true;
+        case SampleFormat::Int32:
+            meter(static_cast<const std::int32_t*>(block.data), block.frameCount, block.format);
+            return true;
+        case SampleFormat::Float32:
+            meter(static_cast<const float*>(block.data), block.frameCount, block.format);
+            return true;
+        default:
+            return false; // Needs conversion (packed 24-bit, float64)
+    }
+}
+
+void AudioEngine::MeteringCallback::restart() noexcept {
+    m_overDetector.reset();
+}
+
+void AudioEngine::MeteringCallback::refreshSettings(const common::AudioFormat& format) {
+    // Settings are checked per packet (lock-free), so edits and reloads
+    // apply without restarting capture
+    if (common::ConfigManager::version() != m_configVersion) {
+        const common::ConfigManager::ReadGuard guard;
+        const common::AppConfig& config = guard.config();
+        meters::BallisticsSettings settings;
+        settings.type = meters::parseBallisticsType(config.meterBallistics);
+        settings.attackMs = config.meterAttackMs;
+        settings.releaseDbPerSecond = config.meterReleaseDbPerSecond;
+        settings.holdMs = config.meterHoldMs;
+        settings.holdDecay = config.meterDecayRate;
+        settings.updateRate = config.meterUpdateRate;
+        m_ballistics.configure(settings, format.sampleRate);
+        m_rms.configure(config.rmsWindowMs, format.sampleRate);
+        meters::OverSettings overs;
+        overs.thresholdDb = config.overThresholdDb;
+        overs.runLength = static_cast<std::uint32_t>(std::max(1, config.overSampleCount));
+        m_overDetector.configure(overs);
+        m_idleAfterSeconds = std::max(0.0f, config.idleAfterSeconds);
+        m_idleUpdateRate = std::max(0.1f, config.idleUpdateRate);
+        m_configVersion = guard.snapshot().version;
+    }
+}
+
+template <typename Sample>
+void AudioEngine::MeteringCallback::meter(
+    const Sample* samples,
+    std::size_t frameCount,
+    const common::AudioFormat& format
+) {
+    refreshSettings(format);
+    
+    // Digital silence that was not flagged as such: the peak scan has read
+    // every sample, so the other meters skip their per-sample passes
+    common::PeakValue peak;
+    bool quiet = false;
+    {
+        const ScopedStatsTimer timer(&m_engine->m_stats, StatsCollector::Timing::PeakMeter);
+        peak = m_peakMeter.process(samples, frameCount, format);
+        quiet = peak.left == 0.0f && peak.right == 0.0f;
+        if (quiet) {
+            m_ballistics.processSilence(frameCount, format);
+            m_overDetector.processSilence(frameCount);
+        } else {
+            m_ballistics.process(samples, frameCount, format);
+            m_overDetector.process(samples, frameCount, format, m_captureTimeNs);
+        }
+    }
+    {
+        const ScopedStatsTimer timer(&m_engine->m_stats, StatsCollector::Timing::RmsMeter);
+        if (quiet) {
+            m_rms.processSilence(frameCount, format);
+        } else {
+            m_rms.process(samples, frameCount, format);
+        }
+    }
+    
+    publish(peak, m_rms.value(), frameCount, format, quiet);
+}
+
+void AudioEngine::MeteringCallback::meterSilence(std::size_t frameCount, const common::AudioFormat& format) {
+    if (!format.isValid()) {
+        return;
+    }
+    refreshSettings(format);
+    
+    // Timed like sample packets so the stats stay comparable
+    {
+        const ScopedStatsTimer timer(&m_engine->m_stats, StatsCollector::Timing::PeakMeter);
+        m_ballistics.processSilence(frameCount, format);
+        m_overDetector.processSilence(frameCount);
+    }
+    {
+        const ScopedStatsTimer timer(&m_engine->m_stats, StatsCollector::Timing::RmsMeter);
+        m_rms.processSilence(frameCount, format);
+    }
+    
+    publish(common::PeakValue{}, m_rms.value(), frameCount, format, true);
+}
+
+void AudioEngine::MeteringCallback::publish(
+    const common::PeakValue& peak,
+    const common::RmsValue& rms,
+    std::size_t frameCount,
+    const common::AudioFormat& format,
+    bool quiet
+) {
+    // Idle once the input has been silent long enough; then forward only
+    // every idleUpdateRate-th of a second so consumers and the UI go quiet
+    m_quietFrames = quiet ? m_quietFrames + frameCount : 0;
+    const bool idle = m_idleAfterSeconds > 0.0f &&
+        m_quietFrames >= static_cast<std::uint64_t>(static_cast<double>(m_idleAfterSeconds) * format.sampleRate);
+    m_framesSincePublish += frameCount;
+    if (idle && m_idle &&
+        m_framesSincePublish < static_cast<std::uint64_t>(format.sampleRate / m_idleUpdateRate)) {
+        return;
+    }
+    m_idle = idle;
+    m_framesSincePublish = 0;
     
     // Create snapshot
     common::MeterSnapshot snapshot;
+    snapshot.idle = idle;
     snapshot.peak = peak;
+    snapshot.level = m_ballistics.level();
+    snapshot.peakHold = m_ballistics.hold();
     snapshot.rms = rms;
     // Calculate timestamp relative to start time
     auto now = std::chrono::steady_clock::now();
@@ -119,6 +381,7 @@ void AudioEngine::MeteringCallback::onAudioData(
     ).count();
     
     snapshot.timestampMs = static_cast<long long>(elapsed);
+    snapshot.captureTimeNs = m_captureTimeNs;
     
     // Forward to engine callbacks
     m_engine->forwardMeterData(snapshot);
@@ -131,8 +394,3 @@ void AudioEngine::MeteringCallback::onMeterData(const common::MeterSnapshot& sna
 
 } // namespace openmeters::core::audio
 
-#else
-// Non-Windows platforms: This file should not be compiled
-#error "Audio engine implementation is Windows-only. This file should not be compiled on non-Windows systems."
-#endif // _WIN32
-
@@ -1,30 +1,44 @@
 #pragma once
 
 #include "audio-engine-interface.h"
+#include "audio-source.h"
+#include "callback-dispatcher.h"
+#include "../../core/meters/ballistics.h"
+#include "../../core/meters/over-detector.h"
 #include "../../core/meters/peak-meter.h"
-#include "../../core/meters/rms-meter.h"
-#include <vector>
-#include <mutex>
+#include "../../core/meters/sliding-rms.h"
 #include <chrono>
-
-#ifdef _WIN32
-#include "wasapi-capture.h"
-#else
-#error "Audio engine is Windows-only. This file should not be compiled on non-Windows systems."
-#endif
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
 
 namespace openmeters::core::audio {
 
 /**
  * Audio engine implementation.
- * Integrates WASAPI capture with peak/RMS metering and exposes data via callbacks.
+ * Integrates an audio source (WASAPI loopback by default) with peak/RMS
+ * metering and exposes data via callbacks.
  * 
  * Thread safety: Thread-safe for public operations.
- * Audio callbacks run on WASAPI capture thread.
+ * Audio callbacks run on the source's capture thread.
  */
 class AudioEngine : public IAudioEngine {
 public:
+#ifdef _WIN32
+    /**
+     * Engine capturing the default render device via WASAPI loopback.
+     */
     AudioEngine();
+#endif
+    
+    /**
+     * Engine metering an arbitrary source (synthetic signal, file, ...).
+     * 
+     * @param source Audio source (must not be null)
+     */
+    explicit AudioEngine(std::unique_ptr<IAudioSource> source);
+    
     ~AudioEngine() override;
     
     // Non-copyable, non-movable
@@ -43,11 +57,28 @@ public:
     
     [[nodiscard]] common::AudioFormat getFormat() const override;
     [[nodiscard]] bool isCapturing() const override;
+    [[nodiscard]] EngineStats getStats() const override;
+    void recordDisplayLatency(std::uint64_t captureTimeNs) override;
+    std::size_t readOverEvents(
+        std::uint64_t& cursor,
+        common::OverEvent* events,
+        std::size_t maxEvents,
+        std::uint64_t* lost
+    ) const override;
+    
+    /**
+     * Log a stats summary periodically while capturing (warning level when
+     * discontinuities, GetBuffer failures or drops occurred since the last
+     * summary). Takes effect at the next start().
+     * 
+     * @param interval Time between summaries (zero disables)
+     */
+    void setStatsLogInterval(std::chrono::seconds interval);
 
 private:
     /**
      * Internal callback implementation.
-     * Receives audio data from WASAPI capture and computes meters.
+     * Receives audio data from the source and computes meters.
      */
     class MeteringCallback : public IAudioDataCallback {
     public:
@@ -61,10 +92,58 @@ private:
         
         void onMeterData(const common::MeterSnapshot& snapshot) override;
         
+        /**
+         * Meters int16/int32/float32 packets in place (no float copy) and
+         * silent packets without samples. Other formats fall back to
+         * onAudioData.
+         */
+        bool onAudioBlock(const AudioBlock& block) override;
+        
+        /**
+         * Begin a new stream: over positions count from zero again.
+         * Call only while the source is stopped.
+         */
+        void restart() noexcept;
+        
     private:
+        /**
+         * Apply config changes to the meters (once per config version).
+         */
+        void refreshSettings(const common::AudioFormat& format);
+        
+        /**
+         * Run both analyzers on interleaved samples (timed into the engine
+         * stats) and publish the result. A packet that scans as all zeros
+         * finishes on the silence path.
+         */
+        template <typename Sample>
+        void meter(const Sample* samples, std::size_t frameCount, const common::AudioFormat& format);
+        
+        /**
+         * Advance the analyzers over silence in closed form and publish.
+         */
+        void meterSilence(std::size_t frameCount, const common::AudioFormat& format);
+        
+        /**
+         * Build a snapshot and forward it to the engine callbacks. Once the
+         * input has been quiet (digital silence) for idleAfterSeconds, only
+         * idleUpdateRate snapshots per second are forwarded.
+         */
+        void publish(const common::PeakValue& peak, const common::RmsValue& rms,
+                     std::size_t frameCount, const common::AudioFormat& format, bool quiet);
+        
         AudioEngine* m_engine;
+        std::uint64_t m_captureTimeNs = 0; // Of the packet being metered
+        std::uint64_t m_configVersion = ~std::uint64_t{0}; // Config snapshot the meters were set from
+        float m_idleAfterSeconds = 0.0f;   // From the config (0 = never idle)
+        float m_idleUpdateRate = 1.0f;
+        std::uint64_t m_quietFrames = 0;   // Consecutive digitally silent frames
+        std::uint64_t m_framesSincePublish = 0;
+        bool m_idle = false;
+        meters::Ballistics m_ballistics;
+        meters::OverDetector m_overDetector;
         meters::PeakMeter m_peakMeter;
-        meters::RmsMeter m_rmsMeter;
+        meters::SlidingRms m_rms;
     };
     
     /**
@@ -72,12 +151,37 @@ private:
      */
     void forwardMeterData(const common::MeterSnapshot& snapshot);
     
-    WasapiCapture m_capture;
+    /**
+     * Periodic stats logging thread.
+     */
+    void statsLogThread();
+    
+    /**
+     * Log the overs since cursor (the first few one by one, then a count).
+     */
+    void logOvers(std::uint64_t& cursor);
+    
+    /**
+     * Stop and join the stats logging thread.
+     */
+    void stopStatsLog();
+    
+    std::unique_ptr<IAudioSource> m_source;
+    
+    // Overs from the metering callback, read by the UI, logger and exporters
+    common::EventRing<common::OverEvent> m_overEvents{common::MemoryTag::Analysis};
     MeteringCallback m_meteringCallback;
     
-    std::mutex m_callbackMutex;
-    std::vector<IAudioDataCallback*> m_callbacks;
+    CallbackDispatcher m_callbacks;
     std::chrono::steady_clock::time_point m_startTime;
+    
+    // Engine statistics (updated lock-free from the source thread)
+    StatsCollector m_stats;
+    std::chrono::seconds m_statsLogInterval{0};
+    std::thread m_statsLogThread;
+    std::mutex m_statsLogMutex;
+    std::condition_variable m_statsLogWake;
+    bool m_statsLogStop = false;
 };
 
 } // namespace openmeters::core::audio
@@ -0,0 +1,221 @@
+#include "audio-history.h"
+#include "wav-writer.h"
+#include "../../common/logger.h"
+#include "../../common/resource-monitor.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <vector>
+
+namespace openmeters::core::audio {
+
+namespace {
+
+// How often a dump waiting for future audio checks the write position
+constexpr auto kDumpPollInterval = std::chrono::milliseconds(20);
+
+// Extra wait for future audio beyond its duration (capture may lag)
+constexpr auto kDumpWaitSlack = std::chrono::seconds(2);
+
+} // namespace
+
+AudioHistory::~AudioHistory() {
+    stopDumpThread();
+    if (m_samples) {
+        common::ResourceMonitor::trackRelease(common::MemoryTag::Audio,
+                                              m_capacityFrames * m_format.samplesPerFrame() * sizeof(float));
+    }
+}
+
+bool AudioHistory::reserve(double seconds, const common::AudioFormat& format) {
+    if (m_samples || !format.isValid() || seconds <= 0.0) {
+        return false;
+    }
+
+    m_format = format;
+    m_capacityFrames = std::max<std::size_t>(1, static_cast<std::size_t>(seconds * format.sampleRate + 0.5));
+    const std::size_t samples = m_capacityFrames * format.samplesPerFrame();
+    m_samples = std::make_unique<float[]>(samples);
+    common::ResourceMonitor::trackAllocation(common::MemoryTag::Audio, samples * sizeof(float));
+
+    m_dumpStop = false;
+    m_dumpThread = std::thread(&AudioHistory::dumpThread, this);
+    return true;
+}
+
+void AudioHistory::onAudioData(const float* buffer, std::size_t frameCount, const common::AudioFormat& format) {
+    if (!buffer || frameCount == 0) {
+        return;
+    }
+    if (!m_samples || format.sampleRate != m_format.sampleRate || format.channelCount != m_format.channelCount) {
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    // Announce the frames about to be overwritten before touching them
+    const std::uint64_t end = m_written.load(std::memory_order_relaxed) + frameCount;
+    m_reserved.store(end, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    // A packet longer than the history only leaves its tail
+    const std::size_t channels = m_format.samplesPerFrame();
+    const std::size_t frames = std::min(frameCount, m_capacityFrames);
+    const float* source = buffer + (frameCount - frames) * channels;
+    const std::size_t slot = static_cast<std::size_t>((end - frames) % m_capacityFrames);
+    const std::size_t first = std::min(frames, m_capacityFrames - slot);
+    std::memcpy(m_samples.get() + slot * channels, source, first * channels * sizeof(float));
+    std::memcpy(m_samples.get(), source + first * channels, (frames - first) * channels * sizeof(float));
+
+    m_written.store(end, std::memory_order_release);
+}
+
+void AudioHistory::onMeterData(const common::MeterSnapshot& snapshot) {
+    (void)snapshot;
+}
+
+std::size_t AudioHistory::copy(std::uint64_t startFrame, std::size_t frameCount, float* dest, std::uint64_t* copiedStart) const noexcept {
+    const std::uint64_t written = m_written.load(std::memory_order_acquire);
+    const std::uint64_t oldest = written > m_capacityFrames ? written - m_capacityFrames : 0;
+    std::uint64_t begin = std::max(startFrame, oldest);
+    const std::uint64_t end = std::min<std::uint64_t>(startFrame + frameCount, written);
+    if (copiedStart) {
+        *copiedStart = begin;
+    }
+    if (!m_samples || !dest || begin >= end) {
+        return 0;
+    }
+
+    const std::size_t channels = m_format.samplesPerFrame();
+    const std::size_t frames = static_cast<std::size_t>(end - begin);
+    const std::size_t slot = static_cast<std::size_t>(begin % m_capacityFrames);
+    const std::size_t first = std::min(frames, m_capacityFrames - slot);
+    std::memcpy(dest, m_samples.get() + slot * channels, first * channels * sizeof(float));
+    std::memcpy(dest + first * channels, m_samples.get(), (frames - first) * channels * sizeof(float));
+
+    // Frames the writer may have reached while we copied are not trustworthy
+    std::atomic_thread_fence(std::memory_order_acquire);
+    const std::uint64_t reserved = m_reserved.load(std::memory_order_relaxed);
+    const std::uint64_t safe = reserved > m_capacityFrames ? reserved - m_capacityFrames : 0;
+    if (safe > begin) {
+        if (safe >= end) {
+            return 0;
+        }
+        const std::size_t overwritten = static_cast<std::size_t>(safe - begin);
+        std::memmove(dest, dest + overwritten * channels, (frames - overwritten) * channels * sizeof(float));
+        begin = safe;
+        if (copiedStart) {
+            *copiedStart = begin;
+        }
+    }
+    return static_cast<std::size_t>(end - begin);
+}
+
+bool AudioHistory::requestDump(const std::string& path, std::uint64_t startFrame, std::size_t frameCount) {
+    if (!m_samples || frameCount == 0) {
+        return false;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_dumpMutex);
+        m_dumps.push_back({path, startFrame, std::min(frameCount, m_capacityFrames)});
+    }
+    m_dumpWake.notify_all();
+    return true;
+}
+
+bool AudioHistory::requestDumpLast(const std::string& path, double seconds) {
+    const std::uint64_t end = position();
+    const auto frames = static_cast<std::uint64_t>(std::max(0.0, seconds) * m_format.sampleRate + 0.5);
+    const std::uint64_t start = end > frames ? end - frames : 0;
+    return requestDump(path, start, static_cast<std::size_t>(end - start));
+}
+
+void AudioHistory::endStream() {
+    {
+        std::lock_guard<std::mutex> lock(m_dumpMutex);
+        m_streamEnded = true;
+    }
+    m_dumpWake.notify_all();
+}
+
+void AudioHistory::waitForDumps() {
+    std::unique_lock<std::mutex> lock(m_dumpMutex);
+    m_dumpIdle.wait(lock, [this] { return m_dumps.empty() && !m_dumping; });
+}
+
+void AudioHistory::dumpThread() {
+    std::unique_lock<std::mutex> lock(m_dumpMutex);
+    while (true) {
+        m_dumpWake.wait(lock, [this] { return m_dumpStop || !m_dumps.empty(); });
+        if (m_dumps.empty()) {
+            break; // Stopping with nothing left to write
+        }
+        const DumpRequest request = std::move(m_dumps.front());
+        m_dumps.pop_front();
+        m_dumping = true;
+
+        lock.unlock();
+        writeDump(request);
+        lock.lock();
+
+        m_dumping = false;
+        m_dumpIdle.notify_all();
+    }
+}
+
+bool AudioHistory::writeDump(const DumpRequest& request) {
+    // Wait for a range that ends in the future, unless shutting down or
+    // no more audio is coming
+    const std::uint64_t end = request.startFrame + request.frameCount;
+    const std::uint64_t missing = end > position() ? end - position() : 0;
+    const auto deadline = std::chrono::steady_clock::now() + kDumpWaitSlack +
+                          std::chrono::milliseconds(missing * 1000 / m_format.sampleRate);
+    {
+        std::unique_lock<std::mutex> lock(m_dumpMutex);
+        while (position() < end && !m_dumpStop && !m_streamEnded && std::chrono::steady_clock::now() < deadline) {
+            m_dumpWake.wait_for(lock, kDumpPollInterval);
+        }
+    }
+
+    std::vector<float> samples(request.frameCount * m_format.samplesPerFrame());
+    std::uint64_t copiedStart = 0;
+    const std::size_t frames = copy(request.startFrame, request.frameCount, samples.data(), &copiedStart);
+    if (frames == 0) {
+        LOG_WARNING("History dump {}: range is no longer (or not yet) held", request.path);
+        return false;
+    }
+    if (copiedStart != request.startFrame) {
+        LOG_WARNING("History dump {}: first {} frame(s) were no longer held", request.path,
+                    copiedStart - request.startFrame);
+    }
+
+    std::error_code error;
+    const std::filesystem::path parent = std::filesystem::path(request.path).parent_path();
+    if (!parent.empty()) {
+        std::filesystem::create_directories(parent, error);
+    }
+
+    WavWriter writer;
+    if (!writer.open(request.path, m_format) || !writer.write(samples.data(), frames) || !writer.close()) {
+        LOG_ERROR("Failed to write history dump: {}", request.path);
+        return false;
+    }
+    m_dumpsWritten.fetch_add(1, std::memory_order_relaxed);
+    LOG_INFO("Wrote {:.2f} s of history (frames {}-{}) to {}", static_cast<double>(frames) / m_format.sampleRate,
+             copiedStart, copiedStart + frames, request.path);
+    return true;
+}
+
+void AudioHistory::stopDumpThread() {
+    if (!m_dumpThread.joinable()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_dumpMutex);
+        m_dumpStop = true;
+    }
+    m_dumpWake.notify_all();
+    m_dumpThread.join();
+}
+
+} // namespace openmeters::core::audio
@@ -0,0 +1,153 @@
+#pragma once
+
+#include "audio-engine-interface.h"
+#include "../../common/audio-format.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace openmeters::core::audio {
+
+/**
+ * Look-back history: the last N seconds of captured audio (float32, after
+ * format conversion), kept so an over or alarm can be listened to later.
+ *
+ * Register it as an engine callback. The capture thread copies each
+ * packet into a preallocated circular buffer (one or two memcpys) and
+ * publishes the new end position; nothing else happens there. Readers
+ * copy any range still in the buffer without blocking the writer: they
+ * check afterwards which frames the writer may have overwritten
+ * meanwhile and drop those, so a copy never returns torn audio.
+ *
+ * Positions count frames received since reserve(). Registered before the
+ * engine starts, they match OverEvent::position until it is restarted.
+ *
+ * Dumps to WAV run on a background thread. A dump whose range ends in the
+ * future waits for the audio to arrive, so "2 s before and after this
+ * over" can be requested the moment the over is seen. Once the engine has
+ * stopped, endStream() makes such dumps write what is held instead.
+ *
+ * Thread safety: reserve() from a control thread before registering;
+ * onAudioData from the capture thread; copy() and requestDump*() from
+ * any thread.
+ */
+class AudioHistory : public IAudioDataCallback {
+public:
+    AudioHistory() = default;
+    ~AudioHistory() override;
+
+    // Non-copyable, non-movable
+    AudioHistory(const AudioHistory&) = delete;
+    AudioHistory& operator=(const AudioHistory&) = delete;
+    AudioHistory(AudioHistory&&) = delete;
+    AudioHistory& operator=(AudioHistory&&) = delete;
+
+    /**
+     * Allocate the buffer and start the dump thread. Not real-time safe.
+     * Packets in any other format are dropped (and counted).
+     *
+     * @param seconds Length of the history
+     * @param format Rate and channel layout of the captured stream
+     * @return true if storage was allocated, false otherwise
+     */
+    bool reserve(double seconds, const common::AudioFormat& format);
+
+    void onAudioData(const float* buffer, std::size_t frameCount, const common::AudioFormat& format) override;
+    void onMeterData(const common::MeterSnapshot& snapshot) override;
+
+    /**
+     * Copy a range of frames out of the history.
+     *
+     * @param startFrame Position of the first frame wanted
+     * @param frameCount Frames wanted
+     * @param dest Receives up to frameCount interleaved frames
+     * @param copiedStart Receives the position of the first frame copied
+     *        (later than startFrame if the start is no longer held)
+     * @return Number of frames copied (frames not yet captured are not included)
+     *
+     * Thread: Any; never blocks the capture thread
+     */
+    std::size_t copy(std::uint64_t startFrame, std::size_t frameCount, float* dest, std::uint64_t* copiedStart) const noexcept;
+
+    /**
+     * Queue a WAV dump of a range.
+     *
+     * @param path Output file (parent directories are created)
+     * @param startFrame Position of the first frame
+     * @param frameCount Frames to write (at most capacityFrames())
+     * @return true if queued, false if not reserved
+     */
+    bool requestDump(const std::string& path, std::uint64_t startFrame, std::size_t frameCount);
+
+    /**
+     * Queue a WAV dump of the last seconds captured.
+     */
+    bool requestDumpLast(const std::string& path, double seconds);
+
+    /**
+     * No more audio will arrive (the engine stopped): pending and later
+     * dumps write the frames already held without waiting for the rest.
+     */
+    void endStream();
+
+    /**
+     * Block until every queued dump has been written.
+     */
+    void waitForDumps();
+
+    /**
+     * Frames received so far (the position of the next frame).
+     */
+    [[nodiscard]] std::uint64_t position() const noexcept { return m_written.load(std::memory_order_acquire); }
+
+    [[nodiscard]] std::size_t capacityFrames() const noexcept { return m_capacityFrames; }
+    [[nodiscard]] const common::AudioFormat& format() const noexcept { return m_format; }
+
+    /**
+     * Packets dropped because their format did not match reserve().
+     */
+    [[nodiscard]] std::uint64_t droppedPackets() const noexcept { return m_dropped.load(std::memory_order_relaxed); }
+
+    /**
+     * Dumps written successfully.
+     */
+    [[nodiscard]] std::uint64_t dumpsWritten() const noexcept { return m_dumpsWritten.load(std::memory_order_relaxed); }
+
+private:
+    struct DumpRequest {
+        std::string path;
+        std::uint64_t startFrame = 0;
+        std::size_t frameCount = 0;
+    };
+
+    void dumpThread();
+    bool writeDump(const DumpRequest& request);
+    void stopDumpThread();
+
+    common::AudioFormat m_format;
+    std::unique_ptr<float[]> m_samples;
+    std::size_t m_capacityFrames = 0;
+
+    // m_reserved is raised before a packet is copied in, m_written after:
+    // frames below m_reserved - capacity may be overwritten at any moment
+    std::atomic<std::uint64_t> m_reserved{0};
+    std::atomic<std::uint64_t> m_written{0};
+    std::atomic<std::uint64_t> m_dropped{0};
+    std::atomic<std::uint64_t> m_dumpsWritten{0};
+
+    std::thread m_dumpThread;
+    std::mutex m_dumpMutex;
+    std::condition_variable m_dumpWake;
+    std::condition_variable m_dumpIdle;
+    std::deque<DumpRequest> m_dumps;
+    bool m_dumping = false;
+    bool m_dumpStop = false;
+    bool m_streamEnded = false;
+};
+
+} // namespace openmeters::core::audio
@@ -0,0 +1,132 @@
+#include "audio-recorder.h"
+#include "../../common/logger.h"
+#include "../../common/resource-monitor.h"
+#include <chrono>
+#include <filesystem>
+#include <vector>
+
+namespace openmeters::core::audio {
+
+namespace {
+
+// Largest read from the ring per conversion pass
+constexpr std::size_t kReadChunkBytes = 256 * 1024;
+constexpr auto kWriterPollInterval = std::chrono::milliseconds(5);
+
+} // namespace
+
+AudioRecorder::~AudioRecorder() {
+    stop();
+}
+
+bool AudioRecorder::reserve(double bufferSeconds, const common::AudioFormat& format) {
+    if (m_frameBytes != 0 || !format.isValid() || bufferSeconds <= 0.0) {
+        return false;
+    }
+    m_format = format;
+    m_frameBytes = format.samplesPerFrame() * sizeof(float);
+    return m_ring.reserve(static_cast<std::size_t>(bufferSeconds * format.sampleRate) * m_frameBytes);
+}
+
+bool AudioRecorder::start(const std::string& path, SampleFormat sampleFormat) {
+    if (m_frameBytes == 0 || m_thread.joinable()) {
+        return false;
+    }
+
+    std::error_code error;
+    const std::filesystem::path parent = std::filesystem::path(path).parent_path();
+    if (!parent.empty()) {
+        std::filesystem::create_directories(parent, error);
+    }
+    if (!m_writer.open(path, m_format, sampleFormat)) {
+        LOG_ERROR("Failed to start recording: {}", path);
+        return false;
+    }
+
+    m_path = path;
+    m_framesWritten.store(0);
+    m_droppedFrames.store(0);
+    m_writeFailed.store(false);
+    m_stopping.store(false);
+    m_thread = std::thread(&AudioRecorder::writerThread, this);
+    m_recording.store(true);
+
+    LOG_INFO("Recording to {}", path);
+    return true;
+}
+
+void AudioRecorder::stop() {
+    if (!m_thread.joinable()) {
+        return;
+    }
+
+    // Once no callback is inside onAudioData, nothing more enters the ring
+    m_recording.store(false);
+    while (m_producers.load() != 0) {
+        std::this_thread::yield();
+    }
+    m_stopping.store(true);
+    m_thread.join();
+
+    const bool complete = m_writer.close() && !m_writeFailed.load();
+    const std::uint64_t frames = m_framesWritten.load();
+    if (!complete) {
+        LOG_ERROR("Recording {} is incomplete (disk write failed)", m_path);
+    }
+    if (const auto dropped = m_droppedFrames.load(); dropped != 0) {
+        LOG_WARNING("Recording {} dropped {} frame(s)", m_path, dropped);
+    }
+    LOG_INFO("Recorded {:.1f} s to {}", static_cast<double>(frames) / m_format.sampleRate, m_path);
+}
+
+void AudioRecorder::onAudioData(const float* buffer, std::size_t frameCount, const common::AudioFormat& format) {
+    if (!buffer || frameCount == 0) {
+        return;
+    }
+
+    // Announce ourselves before checking the flag so stop() can wait us out
+    m_producers.fetch_add(1);
+    if (m_recording.load()) {
+        const bool matches = format.sampleRate == m_format.sampleRate && format.channelCount == m_format.channelCount;
+        if (!matches || !m_ring.write(buffer, frameCount * m_frameBytes)) {
+            m_droppedFrames.fetch_add(frameCount, std::memory_order_relaxed);
+        }
+    }
+    m_producers.fetch_sub(1, std::memory_order_release);
+}
+
+void AudioRecorder::onMeterData(const common::MeterSnapshot& snapshot) {
+    (void)snapshot;
+}
+
+void AudioRecorder::writerThread() {
+    common::ResourceMonitor::registerCurrentThread(common::ThreadRole::Logger);
+
+    // Packets enter the ring whole, so reading whole frames keeps samples aligned
+    std::vector<float> chunk(kReadChunkBytes / m_frameBytes * m_format.samplesPerFrame());
+    const std::size_t chunkBytes = chunk.size() * sizeof(float);
+
+    for (;;) {
+        // Read the stop flag first so the final drain sees every packet
+        const bool stopping = m_stopping.load();
+        const std::size_t bytes = m_ring.read(chunk.data(), chunkBytes);
+        if (bytes != 0) {
+            const std::size_t frames = bytes / m_frameBytes;
+            // After a failure keep draining so capture does not start dropping
+            if (!m_writeFailed.load(std::memory_order_relaxed)) {
+                if (m_writer.write(chunk.data(), frames)) {
+                    m_framesWritten.fetch_add(frames, std::memory_order_relaxed);
+                } else {
+                    m_writeFailed.store(true);
+                }
+            }
+            continue;
+        }
+        if (stopping) {
+            break;
+        }
+        std::this_thread::sleep_for(kWriterPollInterval);
+    }
+}
+
+} // namespace openmeters::core::audio
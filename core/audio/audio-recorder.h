@@ -0,0 +1,102 @@
+#pragma once
+
+#include "audio-engine-interface.h"
+#include "format-convert.h"
+#include "wav-writer.h"
+#include "../../common/audio-format.h"
+#include "../../common/spsc-ring.h"
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
+
+namespace openmeters::core::audio {
+
+/**
+ * Records the captured stream to a WAV file (RF64 past 4 GB), as 32-bit
+ * float or converted to 24/16-bit integer.
+ *
+ * Register it as an engine callback; it ignores audio until start(). The
+ * capture thread only copies each packet into a preallocated ring. A
+ * writer thread drains the ring, converts and writes 1 MB blocks through
+ * WavWriter, so disk stalls shorter than the ring never reach capture.
+ * If the ring does fill, whole packets are dropped and counted rather
+ * than blocking.
+ *
+ * Thread safety: reserve(), start() and stop() from one control thread;
+ * onAudioData from the capture thread.
+ */
+class AudioRecorder : public IAudioDataCallback {
+public:
+    AudioRecorder() = default;
+    ~AudioRecorder() override;
+
+    // Non-copyable, non-movable
+    AudioRecorder(const AudioRecorder&) = delete;
+    AudioRecorder& operator=(const AudioRecorder&) = delete;
+    AudioRecorder(AudioRecorder&&) = delete;
+    AudioRecorder& operator=(AudioRecorder&&) = delete;
+
+    /**
+     * Allocate the ring between capture and disk. Not real-time safe.
+     *
+     * @param bufferSeconds Longest disk stall absorbed without dropping audio
+     * @param format Rate and channel layout of the captured stream
+     * @return true if storage was allocated, false otherwise
+     */
+    bool reserve(double bufferSeconds, const common::AudioFormat& format);
+
+    /**
+     * Create the file and start recording.
+     *
+     * @param path Output file (parent directories are created)
+     * @param sampleFormat Float32, Int24Packed or Int16
+     * @return true if recording, false if not reserved, already recording
+     *         or the file could not be created
+     */
+    bool start(const std::string& path, SampleFormat sampleFormat = SampleFormat::Float32);
+
+    /**
+     * Write out buffered audio and close the file.
+     */
+    void stop();
+
+    void onAudioData(const float* buffer, std::size_t frameCount, const common::AudioFormat& format) override;
+    void onMeterData(const common::MeterSnapshot& snapshot) override;
+
+    [[nodiscard]] bool isRecording() const noexcept { return m_recording.load(std::memory_order_relaxed); }
+    [[nodiscard]] const std::string& path() const noexcept { return m_path; }
+    [[nodiscard]] const common::AudioFormat& format() const noexcept { return m_format; }
+
+    /**
+     * Frames written to the current (or last) file.
+     */
+    [[nodiscard]] std::uint64_t framesWritten() const noexcept { return m_framesWritten.load(std::memory_order_relaxed); }
+
+    /**
+     * Frames lost in the current (or last) recording: ring full or
+     * packets in another format.
+     */
+    [[nodiscard]] std::uint64_t droppedFrames() const noexcept { return m_droppedFrames.load(std::memory_order_relaxed); }
+
+private:
+    void writerThread();
+
+    common::AudioFormat m_format;
+    common::SpscByteRing m_ring{common::MemoryTag::Audio};
+    std::size_t m_frameBytes = 0;
+
+    std::thread m_thread;
+    std::string m_path;
+    std::atomic<bool> m_recording{false};
+    std::atomic<bool> m_stopping{false};
+    std::atomic<int> m_producers{0}; // Capture callbacks inside onAudioData
+    std::atomic<std::uint64_t> m_framesWritten{0};
+    std::atomic<std::uint64_t> m_droppedFrames{0};
+    std::atomic<bool> m_writeFailed{false};
+
+    // Opened by start(), then owned by the writer thread until stop() joins it
+    WavWriter m_writer;
+};
+
+} // namespace openmeters::core::audio
@@ -0,0 +1,80 @@
+#pragma once
+
+#include "audio-engine-interface.h"
+#include "engine-stats.h"
+#include "../../common/audio-format.h"
+
+namespace openmeters::core::audio {
+
+/**
+ * Producer of captured audio packets (WASAPI loopback, synthetic signal, ...).
+ * Sources deliver packets to registered callbacks on their own real-time
+ * thread; AudioEngine is written against this interface so metering runs
+ * the same way with any source.
+ */
+class IAudioSource {
+public:
+    virtual ~IAudioSource() = default;
+
+    /**
+     * Prepare the source (open device, allocate buffers).
+     *
+     * @return true if initialization succeeded, false otherwise
+     */
+    virtual bool initialize() = 0;
+
+    /**
+     * Start delivering packets.
+     *
+     * @return true if start succeeded, false otherwise
+     */
+    virtual bool start() = 0;
+
+    /**
+     * Stop delivering packets and join the source thread.
+     */
+    virtual void stop() = 0;
+
+    /**
+     * Stop and release all resources.
+     */
+    virtual void shutdown() = 0;
+
+    /**
+     * Get the format of delivered packets.
+     *
+     * @return Audio format descriptor
+     */
+    [[nodiscard]] virtual common::AudioFormat getFormat() const = 0;
+
+    /**
+     * Check if the source is currently delivering packets.
+     *
+     * @return true if capturing, false otherwise
+     */
+    [[nodiscard]] virtual bool isCapturing() const = 0;
+
+    /**
+     * Register a callback for audio data.
+     *
+     * @param callback Callback interface (must remain valid until unregistered)
+     */
+    virtual void registerCallback(IAudioDataCallback* callback) = 0;
+
+    /**
+     * Unregister a callback. Returns after any in-flight delivery has finished.
+     *
+     * @param callback Callback to remove
+     */
+    virtual void unregisterCallback(IAudioDataCallback* callback) = 0;
+
+    /**
+     * Attach a collector for packet counts, device errors and delivery
+     * timings. Call while stopped; the collector must outlive capture.
+     *
+     * @param stats Collector, or nullptr to stop collecting
+     */
+    virtual void setStatsCollector(StatsCollector* stats) = 0;
+};
+
+} // namespace openmeters::core::audio
@@ -0,0 +1,173 @@
+#include "callback-dispatcher.h"
+#include "format-convert.h"
+#include "../../common/realtime-scope.h"
+#include "../../common/trace.h"
+#include <algorithm>
+#include <memory>
+#include <thread>
+
+namespace openmeters::core::audio {
+
+class CallbackDispatcher::ReadGuard {
+public:
+    explicit ReadGuard(CallbackDispatcher& dispatcher) noexcept
+        : m_dispatcher(dispatcher)
+    {
+        // seq_cst pairs with the swap in publish(): a reader that still sees
+        // the old list is guaranteed to be counted when the writer checks
+        m_dispatcher.m_activeReaders.fetch_add(1);
+        m_list = m_dispatcher.m_list.load();
+    }
+
+    ~ReadGuard() {
+        m_dispatcher.m_activeReaders.fetch_sub(1, std::memory_order_release);
+    }
+
+    ReadGuard(const ReadGuard&) = delete;
+    ReadGuard& operator=(const ReadGuard&) = delete;
+
+    [[nodiscard]] const CallbackList* list() const noexcept { return m_list; }
+
+private:
+    CallbackDispatcher& m_dispatcher;
+    const CallbackList* m_list = nullptr;
+};
+
+CallbackDispatcher::~CallbackDispatcher() {
+    delete m_list.load();
+}
+
+void CallbackDispatcher::add(IAudioDataCallback* callback) {
+    if (!callback) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(m_writeMutex);
+    const CallbackList* current = m_list.load();
+    auto next = current ? std::make_unique<CallbackList>(*current) : std::make_unique<CallbackList>();
+    if (std::find(next->begin(), next->end(), callback) != next->end()) {
+        return;
+    }
+    next->push_back(callback);
+    publish(next.release());
+}
+
+void CallbackDispatcher::remove(IAudioDataCallback* callback) {
+    if (!callback) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(m_writeMutex);
+    const CallbackList* current = m_list.load();
+    if (!current) {
+        return;
+    }
+    auto next = std::make_unique<CallbackList>(*current);
+    next->erase(std::remove(next->begin(), next->end(), callback), next->end());
+    publish(next.release());
+}
+
+void CallbackDispatcher::clear() {
+    std::lock_guard<std::mutex> lock(m_writeMutex);
+    publish(nullptr);
+}
+
+bool CallbackDispatcher::empty() const noexcept {
+    const CallbackList* current = m_list.load(std::memory_order_acquire);
+    return !current || current->empty();
+}
+
+void CallbackDispatcher::setStatsCollector(StatsCollector* stats) noexcept {
+    m_stats.store(stats, std::memory_order_release);
+}
+
+void CallbackDispatcher::publish(CallbackList* next) {
+    const CallbackList* previous = m_list.exchange(next);
+
+    // Wait for dispatches that may still hold the previous list. Dispatch is
+    // bounded (one packet), so this spin is short.
+    while (m_activeReaders.load() != 0) {
+        std::this_thread::yield();
+    }
+    delete previous;
+}
+
+bool CallbackDispatcher::dispatchBlock(const AudioBlock& block, common::BufferPool& pool) noexcept {
+    TRACE_ZONE("fanOut");
+    const common::RealtimeScope realtimeScope;
+    const ReadGuard guard(*this);
+    const CallbackList* callbacks = guard.list();
+    if (!callbacks) {
+        return true;
+    }
+
+    StatsCollector* stats = m_stats.load(std::memory_order_acquire);
+    const ScopedStatsTimer fanOutTimer(stats, StatsCollector::Timing::FanOut);
+
+    AudioBlock delivered = block;
+    delivered.scratch = &pool;
+
+    const std::size_t totalSamples = block.sampleCount();
+    const float* floatData = block.sampleFormat == SampleFormat::Float32 && !block.silent
+        ? static_cast<const float*>(block.data)
+        : nullptr;
+
+    bool floatDropped = false;
+    for (IAudioDataCallback* callback : *callbacks) {
+        const std::uint64_t callbackStart = stats ? StatsCollector::now() : 0;
+        if (callback->onAudioBlock(delivered)) {
+            if (stats) {
+                stats->recordDuration(StatsCollector::Timing::Callback, StatsCollector::now() - callbackStart);
+            }
+            continue;
+        }
+        if (floatDropped) {
+            continue; // No float copy this packet; later callbacks still get the block
+        }
+
+        std::uint64_t conversionNs = 0;
+        if (!floatData) {
+            // Convert to float32 once, only when a consumer needs it
+            TRACE_ZONE("convertToFloat32");
+            const std::uint64_t conversionStart = stats ? StatsCollector::now() : 0;
+            float* converted = pool.acquireArray<float>(totalSamples);
+            if (!converted) {
+                if (stats) {
+                    stats->recordDroppedPacket();
+                }
+                floatDropped = true; // Arena exhausted by callback scratch; drop the float path
+                continue;
+            }
+            if (block.silent) {
+                std::fill(converted, converted + totalSamples, 0.0f);
+            } else {
+                convertToFloat32(block.data, block.sampleFormat, converted, totalSamples);
+            }
+            floatData = converted;
+            if (stats) {
+                conversionNs = StatsCollector::now() - conversionStart;
+                stats->recordDuration(StatsCollector::Timing::Conversion, conversionNs);
+            }
+        }
+
+        callback->onAudioData(floatData, block.frameCount, block.format);
+        if (stats) {
+            // Conversion is shared by all float consumers; keep it out of the callback time
+            stats->recordDuration(StatsCollector::Timing::Callback, StatsCollector::now() - callbackStart - conversionNs);
+        }
+    }
+    return !floatDropped;
+}
+
+void CallbackDispatcher::dispatchMeterData(const common::MeterSnapshot& snapshot) noexcept {
+    TRACE_ZONE("publishMeters");
+    const common::RealtimeScope realtimeScope;
+    const ReadGuard guard(*this);
+    if (const CallbackList* callbacks = guard.list()) {
+        for (IAudioDataCallback* callback : *callbacks) {
+            callback->onMeterData(snapshot);
+        }
+    }
+}
+
+} // namespace openmeters::core::audio
@@ -0,0 +1,103 @@
+#pragma once
+
+#include "audio-engine-interface.h"
+#include "engine-stats.h"
+#include "../../common/buffer-pool.h"
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+namespace openmeters::core::audio {
+
+/**
+ * Lock-free fan-out of audio packets and meter snapshots to callbacks.
+ *
+ * Registration builds a new immutable callback list and publishes it with
+ * an atomic pointer swap, then waits for in-flight deliveries to drain
+ * before freeing the old list. The real-time side only bumps a reader
+ * count and loads the pointer: no locks, no allocation.
+ *
+ * Thread safety: add/remove/clear from control threads (serialized
+ * internally, never from inside a callback); dispatch functions from one
+ * or more real-time threads.
+ */
+class CallbackDispatcher {
+public:
+    CallbackDispatcher() = default;
+    ~CallbackDispatcher();
+
+    // Non-copyable, non-movable
+    CallbackDispatcher(const CallbackDispatcher&) = delete;
+    CallbackDispatcher& operator=(const CallbackDispatcher&) = delete;
+    CallbackDispatcher(CallbackDispatcher&&) = delete;
+    CallbackDispatcher& operator=(CallbackDispatcher&&) = delete;
+
+    /**
+     * Add a callback (ignored if null or already registered).
+     */
+    void add(IAudioDataCallback* callback);
+
+    /**
+     * Remove a callback. Returns once no dispatch can still reach it.
+     */
+    void remove(IAudioDataCallback* callback);
+
+    /**
+     * Remove all callbacks.
+     */
+    void clear();
+
+    /**
+     * Check whether any callback is registered.
+     */
+    [[nodiscard]] bool empty() const noexcept;
+
+    /**
+     * Time fan-out, float conversion and each callback into a collector
+     * (nullptr disables timing).
+     */
+    void setStatsCollector(StatsCollector* stats) noexcept;
+
+    /**
+     * Deliver a packet. Each callback first gets onAudioBlock; callbacks that
+     * decline receive onAudioData with a float32 copy converted once into
+     * pool (or the block itself if it is already float32). For a silent
+     * block the copy is zero-filled, and only if some callback declines.
+     * If the pool cannot hold the copy, the declining callbacks miss this
+     * packet (counted as dropped); every callback is still offered the block.
+     *
+     * @param block Packet in native format (block.scratch is set to pool)
+     * @param pool Per-packet arena; must have room for one float32 copy
+     * @return false if a float copy was needed and the pool was exhausted
+     *
+     * Thread: Real-time source thread
+     */
+    bool dispatchBlock(const AudioBlock& block, common::BufferPool& pool) noexcept;
+
+    /**
+     * Deliver a meter snapshot via onMeterData.
+     *
+     * Thread: Real-time source thread
+     */
+    void dispatchMeterData(const common::MeterSnapshot& snapshot) noexcept;
+
+private:
+    using CallbackList = std::vector<IAudioDataCallback*>;
+
+    /**
+     * Publish a new list and free the previous one once readers drain.
+     */
+    void publish(CallbackList* next);
+
+    /**
+     * RAII reader registration around one dispatch.
+     */
+    class ReadGuard;
+
+    std::mutex m_writeMutex;                         // Serializes writers only
+    std::atomic<const CallbackList*> m_list{nullptr};
+    std::atomic<int> m_activeReaders{0};
+    std::atomic<StatsCollector*> m_stats{nullptr};
+};
+
+} // namespace openmeters::core::audio
@@ -0,0 +1,187 @@
+#include "capture-trace.h"
+#include "../../common/logger.h"
+#include "../../common/resource-monitor.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+
+namespace openmeters::core::audio {
+
+namespace {
+
+constexpr std::size_t kWriteChunkBytes = 64 * 1024;
+constexpr auto kWriterPollInterval = std::chrono::milliseconds(5);
+
+} // namespace
+
+// CaptureTraceWriter
+
+CaptureTraceWriter::~CaptureTraceWriter() {
+    close();
+}
+
+bool CaptureTraceWriter::open(const std::string& path, SampleFormat sampleFormat,
+                              const common::AudioFormat& format, std::size_t ringBytes) {
+    close();
+
+    if (bytesPerSample(sampleFormat) == 0 || !format.isValid()) {
+        return false;
+    }
+
+    m_file.open(path, std::ios::binary | std::ios::trunc);
+    if (!m_file.is_open()) {
+        LOG_ERROR("Failed to create capture trace: {}", path);
+        return false;
+    }
+
+    CaptureTraceHeader header;
+    header.sampleFormat = static_cast<std::uint32_t>(sampleFormat);
+    header.sampleRate = format.sampleRate;
+    header.channelCount = format.channelCount;
+    m_file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    if (!m_ring.reserve(ringBytes)) {
+        LOG_ERROR("Failed to allocate a {} byte capture trace buffer", ringBytes);
+        m_file.close();
+        std::error_code error;
+        std::filesystem::remove(path, error);
+        return false;
+    }
+    m_bytesPerFrame = bytesPerSample(sampleFormat) * format.samplesPerFrame();
+    m_dropped.store(0);
+    m_stopping.store(false);
+    m_thread = std::thread(&CaptureTraceWriter::writerThread, this);
+    m_open = true;
+
+    LOG_INFO("Recording capture trace to {}", path);
+    return true;
+}
+
+void CaptureTraceWriter::close() {
+    if (!m_open) {
+        return;
+    }
+
+    m_stopping.store(true);
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+    m_file.close();
+    m_open = false;
+
+    if (const auto dropped = m_dropped.load(); dropped != 0) {
+        LOG_WARNING("Capture trace dropped {} packet(s)", dropped);
+    }
+}
+
+bool CaptureTraceWriter::recordPacket(const CapturePacketInfo& info, const void* data) noexcept {
+    if (!m_open) {
+        return false;
+    }
+
+    CaptureTraceRecord record;
+    record.arrivalNs = info.arrivalNs;
+    record.devicePosition = info.devicePosition;
+    record.qpcPosition = info.qpcPosition;
+    record.frameCount = info.frameCount;
+    record.flags = info.flags;
+
+    const bool silent = (info.flags & CaptureFlags::Silent) != 0 || !data;
+    record.dataBytes = silent ? 0 : static_cast<std::uint32_t>(info.frameCount * m_bytesPerFrame);
+
+    if (!m_ring.write(&record, sizeof(record), data, record.dataBytes)) {
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    return true;
+}
+
+std::uint64_t CaptureTraceWriter::droppedPackets() const noexcept {
+    return m_dropped.load(std::memory_order_relaxed);
+}
+
+void CaptureTraceWriter::writerThread() {
+    common::ResourceMonitor::registerCurrentThread(common::ThreadRole::Logger);
+    std::vector<char> chunk(kWriteChunkBytes);
+
+    for (;;) {
+        // Read the stop flag first so the final drain sees every record
+        const bool stopping = m_stopping.load();
+        const std::size_t bytes = m_ring.read(chunk.data(), chunk.size());
+        if (bytes != 0) {
+            m_file.write(chunk.data(), static_cast<std::streamsize>(bytes));
+            continue;
+        }
+        if (stopping) {
+            break;
+        }
+        std::this_thread::sleep_for(kWriterPollInterval);
+    }
+    m_file.flush();
+}
+
+// CaptureTraceReader
+
+bool CaptureTraceReader::open(const std::string& path) {
+    m_packets.clear();
+    m_maxFrameCount = 0;
+
+    if (!m_file.open(path)) {
+        LOG_ERROR("Failed to open capture trace: {}", path);
+        return false;
+    }
+
+    const std::uint8_t* bytes = m_file.data();
+    const std::size_t size = m_file.size();
+
+    CaptureTraceHeader header;
+    if (size < sizeof(header)) {
+        LOG_ERROR("Capture trace too short: {}", path);
+        return false;
+    }
+    std::memcpy(&header, bytes, sizeof(header));
+    if (std::memcmp(header.magic, "OMCT", 4) != 0 || header.version != 1) {
+        LOG_ERROR("Not a capture trace (or unsupported version): {}", path);
+        return false;
+    }
+
+    m_sampleFormat = static_cast<SampleFormat>(header.sampleFormat);
+    m_format.sampleRate = header.sampleRate;
+    m_format.channelCount = static_cast<common::ChannelCount>(header.channelCount);
+    const std::size_t bytesPerFrame = bytesPerSample(m_sampleFormat) * m_format.samplesPerFrame();
+    if (bytesPerFrame == 0 || !m_format.isValid()) {
+        LOG_ERROR("Capture trace has an unsupported format: {}", path);
+        return false;
+    }
+
+    std::size_t offset = sizeof(header);
+    while (offset + sizeof(CaptureTraceRecord) <= size) {
+        CaptureTraceRecord record;
+        std::memcpy(&record, bytes + offset, sizeof(record));
+        offset += sizeof(record);
+
+        const bool silent = record.dataBytes == 0;
+        if (offset + record.dataBytes > size ||
+            (!silent && record.dataBytes != record.frameCount * bytesPerFrame)) {
+            LOG_WARNING("Capture trace truncated after {} packet(s)", m_packets.size());
+            break;
+        }
+
+        Packet packet;
+        packet.info.arrivalNs = record.arrivalNs;
+        packet.info.devicePosition = record.devicePosition;
+        packet.info.qpcPosition = record.qpcPosition;
+        packet.info.frameCount = record.frameCount;
+        packet.info.flags = record.flags | (silent ? CaptureFlags::Silent : 0);
+        packet.data = silent ? nullptr : bytes + offset;
+        m_packets.push_back(packet);
+
+        m_maxFrameCount = std::max(m_maxFrameCount, record.frameCount);
+        offset += record.dataBytes;
+    }
+
+    return true;
+}
+
+} // namespace openmeters::core::audio
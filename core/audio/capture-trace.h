@@ -0,0 +1,171 @@
+#pragma once
+
+#include "format-convert.h"
+#include "../../common/audio-format.h"
+#include "../../common/mapped-file.h"
+#include "../../common/spsc-ring.h"
+#include <atomic>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace openmeters::core::audio {
+
+/**
+ * Packet flags recorded in a capture trace.
+ * Values match AUDCLNT_BUFFERFLAGS_* so WASAPI flags are stored as-is.
+ */
+namespace CaptureFlags {
+    constexpr std::uint32_t DataDiscontinuity = 0x1;
+    constexpr std::uint32_t Silent = 0x2;
+    constexpr std::uint32_t TimestampError = 0x4;
+}
+
+/**
+ * Timing and layout of one captured packet.
+ */
+struct CapturePacketInfo {
+    std::uint64_t arrivalNs = 0;       // Arrival time relative to capture start
+    std::uint64_t devicePosition = 0;  // Device position in frames (GetBuffer)
+    std::uint64_t qpcPosition = 0;     // Performance counter at capture, 100 ns units (GetBuffer)
+    std::uint32_t frameCount = 0;      // Frames in the packet
+    std::uint32_t flags = 0;           // CaptureFlags
+};
+
+/**
+ * On-disk capture trace (.omtrace), little-endian:
+ *
+ *   CaptureTraceHeader
+ *   repeated: CaptureTraceRecord, followed by dataBytes of interleaved
+ *             samples in the header's sample format (0 for silent packets)
+ */
+struct CaptureTraceHeader {
+    char magic[4] = {'O', 'M', 'C', 'T'};
+    std::uint32_t version = 1;
+    std::uint32_t sampleFormat = 0;  // SampleFormat
+    std::uint32_t sampleRate = 0;
+    std::uint32_t channelCount = 0;
+    std::uint32_t reserved = 0;
+};
+
+struct CaptureTraceRecord {
+    std::uint64_t arrivalNs = 0;
+    std::uint64_t devicePosition = 0;
+    std::uint64_t qpcPosition = 0;
+    std::uint32_t frameCount = 0;
+    std::uint32_t flags = 0;
+    std::uint32_t dataBytes = 0;
+    std::uint32_t reserved = 0;
+};
+
+static_assert(sizeof(CaptureTraceHeader) == 24, "trace header layout");
+static_assert(sizeof(CaptureTraceRecord) == 40, "trace record layout");
+
+/**
+ * Records packets from the capture thread to a trace file.
+ * recordPacket() only copies into a preallocated ring; a background
+ * thread writes the ring to disk. If the writer falls behind, packets are
+ * dropped (and counted) rather than blocking capture.
+ *
+ * Thread safety: open/close from a control thread; recordPacket from the
+ * single capture thread while open.
+ */
+class CaptureTraceWriter {
+public:
+    CaptureTraceWriter() = default;
+    ~CaptureTraceWriter();
+
+    // Non-copyable, non-movable
+    CaptureTraceWriter(const CaptureTraceWriter&) = delete;
+    CaptureTraceWriter& operator=(const CaptureTraceWriter&) = delete;
+    CaptureTraceWriter(CaptureTraceWriter&&) = delete;
+    CaptureTraceWriter& operator=(CaptureTraceWriter&&) = delete;
+
+    /**
+     * Create the trace file and start the writer thread.
+     *
+     * @param path Output file
+     * @param sampleFormat Encoding of recorded packets
+     * @param format Rate and channel layout
+     * @param ringBytes Buffering between capture and disk (default ~4 MB)
+     * @return true if the file was created and the buffer allocated,
+     *         false otherwise (no file is left behind)
+     */
+    bool open(const std::string& path, SampleFormat sampleFormat, const common::AudioFormat& format,
+              std::size_t ringBytes = 4u << 20);
+
+    /**
+     * Flush buffered packets and close the file.
+     */
+    void close();
+
+    /**
+     * Append one packet. Never blocks or allocates.
+     *
+     * @param info Packet timing and flags
+     * @param data Packet samples (ignored for silent packets)
+     * @return true if buffered, false if dropped (ring full or not open)
+     *
+     * Thread: Capture thread
+     */
+    bool recordPacket(const CapturePacketInfo& info, const void* data) noexcept;
+
+    [[nodiscard]] bool isOpen() const noexcept { return m_open; }
+
+    /**
+     * Packets dropped because the ring was full.
+     */
+    [[nodiscard]] std::uint64_t droppedPackets() const noexcept;
+
+private:
+    void writerThread();
+
+    std::ofstream m_file;
+    common::SpscByteRing m_ring{common::MemoryTag::Tracing};
+    std::thread m_thread;
+    std::atomic<bool> m_stopping{false};
+    std::atomic<std::uint64_t> m_dropped{0};
+    std::size_t m_bytesPerFrame = 0;
+    bool m_open = false;
+};
+
+/**
+ * Read-only view of a trace file (memory-mapped; packet data is not copied).
+ *
+ * Thread safety: Immutable after open(); safe to read from any thread.
+ */
+class CaptureTraceReader {
+public:
+    struct Packet {
+        CapturePacketInfo info;
+        const void* data = nullptr;  // nullptr for silent packets
+    };
+
+    /**
+     * Map a trace file and index its packets.
+     *
+     * @param path Trace file
+     * @return true if the file is a valid trace, false otherwise
+     */
+    bool open(const std::string& path);
+
+    [[nodiscard]] SampleFormat sampleFormat() const noexcept { return m_sampleFormat; }
+    [[nodiscard]] const common::AudioFormat& format() const noexcept { return m_format; }
+    [[nodiscard]] const std::vector<Packet>& packets() const noexcept { return m_packets; }
+
+    /**
+     * Largest packet in frames (for sizing replay buffers).
+     */
+    [[nodiscard]] std::uint32_t maxFrameCount() const noexcept { return m_maxFrameCount; }
+
+private:
+    common::MappedFile m_file;
+    SampleFormat m_sampleFormat = SampleFormat::Unknown;
+    common::AudioFormat m_format;
+    std::vector<Packet> m_packets;
+    std::uint32_t m_maxFrameCount = 0;
+};
+
+} // namespace openmeters::core::audio
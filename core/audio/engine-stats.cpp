@@ -0,0 +1,111 @@
+#include "engine-stats.h"
+#include "capture-trace.h"
+#include <cstdio>
+
+namespace openmeters::core::audio {
+
+namespace {
+
+std::string formatTiming(const char* name, const common::LatencyHistogram::Summary& summary) {
+    if (summary.count == 0) {
+        return {};
+    }
+    char buffer[160];
+    std::snprintf(buffer, sizeof(buffer), " | %s us p50 %.1f p99 %.1f p99.9 %.1f max %.1f",
+        name,
+        static_cast<double>(summary.p50) / 1000.0,
+        static_cast<double>(summary.p99) / 1000.0,
+        static_cast<double>(summary.p999) / 1000.0,
+        static_cast<double>(summary.max) / 1000.0);
+    return buffer;
+}
+
+std::string formatErrorCode(std::uint32_t error) {
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), " (last 0x%08X)", error);
+    return buffer;
+}
+
+} // namespace
+
+std::string formatEngineStats(const EngineStats& stats) {
+    std::string line = "Engine stats: " + std::to_string(stats.packets) + " packets, " +
+        std::to_string(stats.frames) + " frames, " +
+        std::to_string(stats.discontinuities) + " discontinuities, " +
+        std::to_string(stats.getBufferFailures) + " GetBuffer failures" +
+        (stats.getBufferFailures != 0 ? formatErrorCode(stats.lastGetBufferError) : std::string()) + ", " +
+        std::to_string(stats.droppedPackets) + " dropped, " +
+        std::to_string(stats.silentPackets) + " silent, " +
+        std::to_string(stats.timestampErrors) + " timestamp errors";
+    line += formatTiming("fan-out", stats.fanOut);
+    line += formatTiming("conversion", stats.conversion);
+    line += formatTiming("callback", stats.callback);
+    line += formatTiming("peak", stats.peakMeter);
+    line += formatTiming("rms", stats.rmsMeter);
+    line += formatTiming("display", stats.display);
+    line += " | " + common::ResourceMonitor::format(stats.resources);
+    return line;
+}
+
+void StatsCollector::recordPacket(std::size_t frameCount, std::uint32_t flags) noexcept {
+    m_packets.fetch_add(1, std::memory_order_relaxed);
+    m_frames.fetch_add(frameCount, std::memory_order_relaxed);
+    if (flags & CaptureFlags::DataDiscontinuity) {
+        m_discontinuities.fetch_add(1, std::memory_order_relaxed);
+    }
+    if (flags & CaptureFlags::Silent) {
+        m_silentPackets.fetch_add(1, std::memory_order_relaxed);
+    }
+    if (flags & CaptureFlags::TimestampError) {
+        m_timestampErrors.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void StatsCollector::recordGetBufferFailure(std::uint32_t error) noexcept {
+    m_lastGetBufferError.store(error, std::memory_order_relaxed);
+    m_getBufferFailures.fetch_add(1, std::memory_order_relaxed);
+}
+
+void StatsCollector::recordDroppedPacket() noexcept {
+    m_droppedPackets.fetch_add(1, std::memory_order_relaxed);
+}
+
+void StatsCollector::recordDuration(Timing timing, std::uint64_t nanoseconds) noexcept {
+    m_timings[static_cast<std::size_t>(timing)].record(nanoseconds);
+}
+
+EngineStats StatsCollector::snapshot() const noexcept {
+    EngineStats stats;
+    stats.packets = m_packets.load(std::memory_order_relaxed);
+    stats.frames = m_frames.load(std::memory_order_relaxed);
+    stats.discontinuities = m_discontinuities.load(std::memory_order_relaxed);
+    stats.silentPackets = m_silentPackets.load(std::memory_order_relaxed);
+    stats.timestampErrors = m_timestampErrors.load(std::memory_order_relaxed);
+    stats.getBufferFailures = m_getBufferFailures.load(std::memory_order_relaxed);
+    stats.lastGetBufferError = m_lastGetBufferError.load(std::memory_order_relaxed);
+    stats.droppedPackets = m_droppedPackets.load(std::memory_order_relaxed);
+
+    stats.fanOut = m_timings[static_cast<std::size_t>(Timing::FanOut)].summarize();
+    stats.conversion = m_timings[static_cast<std::size_t>(Timing::Conversion)].summarize();
+    stats.callback = m_timings[static_cast<std::size_t>(Timing::Callback)].summarize();
+    stats.peakMeter = m_timings[static_cast<std::size_t>(Timing::PeakMeter)].summarize();
+    stats.rmsMeter = m_timings[static_cast<std::size_t>(Timing::RmsMeter)].summarize();
+    stats.display = m_timings[static_cast<std::size_t>(Timing::DisplayLatency)].summarize();
+    return stats;
+}
+
+void StatsCollector::reset() noexcept {
+    m_packets.store(0, std::memory_order_relaxed);
+    m_frames.store(0, std::memory_order_relaxed);
+    m_discontinuities.store(0, std::memory_order_relaxed);
+    m_silentPackets.store(0, std::memory_order_relaxed);
+    m_timestampErrors.store(0, std::memory_order_relaxed);
+    m_getBufferFailures.store(0, std::memory_order_relaxed);
+    m_lastGetBufferError.store(0, std::memory_order_relaxed);
+    m_droppedPackets.store(0, std::memory_order_relaxed);
+    for (auto& histogram : m_timings) {
+        histogram.reset();
+    }
+}
+
+} // namespace openmeters::core::audio
@@ -0,0 +1,156 @@
+#pragma once
+
+#include "../../common/clock.h"
+#include "../../common/latency-histogram.h"
+#include "../../common/resource-monitor.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace openmeters::core::audio {
+
+/**
+ * Snapshot of engine counters and timing summaries (durations in ns).
+ */
+struct EngineStats {
+    std::uint64_t packets = 0;           // Packets delivered by the source
+    std::uint64_t frames = 0;            // Frames in those packets
+    std::uint64_t discontinuities = 0;   // Packets flagged as a data discontinuity (glitch)
+    std::uint64_t silentPackets = 0;     // Packets flagged silent by the device
+    std::uint64_t timestampErrors = 0;   // Packets with an unreliable device timestamp
+    std::uint64_t getBufferFailures = 0; // Failed reads from the device
+    std::uint32_t lastGetBufferError = 0; // Error code of the latest failed read (HRESULT)
+    std::uint64_t droppedPackets = 0;    // Packets not fully delivered (scratch arena exhausted)
+
+    common::LatencyHistogram::Summary fanOut;     // Whole packet delivery to all callbacks
+    common::LatencyHistogram::Summary conversion; // Native to float32 conversion
+    common::LatencyHistogram::Summary callback;   // Each callback invocation
+    common::LatencyHistogram::Summary peakMeter;  // Peak analyzer per packet
+    common::LatencyHistogram::Summary rmsMeter;   // RMS analyzer per packet
+    common::LatencyHistogram::Summary display;    // Capture to on-screen presentation
+    
+    common::ResourceUsage resources;              // CPU per thread role, memory per tag
+};
+
+/**
+ * Format stats as a single log line.
+ */
+[[nodiscard]] std::string formatEngineStats(const EngineStats& stats);
+
+/**
+ * Lock-free collector behind EngineStats.
+ *
+ * Sources count packets and device errors, the callback dispatcher times
+ * fan-out, conversion and callbacks, the engine times its analyzers and
+ * the renderer reports capture-to-display latency.
+ * Every update is a few relaxed atomic operations with no allocation.
+ *
+ * Thread safety: record functions from real-time threads; snapshot() and
+ * reset() from any thread.
+ */
+class StatsCollector {
+public:
+    /**
+     * Timed stages (durations in ns).
+     */
+    enum class Timing {
+        FanOut,
+        Conversion,
+        Callback,
+        PeakMeter,
+        RmsMeter,
+        DisplayLatency,
+        Count
+    };
+
+    StatsCollector() = default;
+
+    // Non-copyable, non-movable
+    StatsCollector(const StatsCollector&) = delete;
+    StatsCollector& operator=(const StatsCollector&) = delete;
+    StatsCollector(StatsCollector&&) = delete;
+    StatsCollector& operator=(StatsCollector&&) = delete;
+
+    /**
+     * Count one packet read from the source.
+     *
+     * @param frameCount Frames in the packet
+     * @param flags CaptureFlags bits reported with the packet
+     */
+    void recordPacket(std::size_t frameCount, std::uint32_t flags) noexcept;
+
+    /**
+     * Count a failed device read. The stats summary reports the count and
+     * the latest error code, so the capture thread never logs it.
+     */
+    void recordGetBufferFailure(std::uint32_t error = 0) noexcept;
+
+    /**
+     * Count a packet that could not be delivered to every callback.
+     */
+    void recordDroppedPacket() noexcept;
+
+    /**
+     * Record a stage duration.
+     */
+    void recordDuration(Timing timing, std::uint64_t nanoseconds) noexcept;
+
+    /**
+     * Read all counters and summarize the histograms.
+     */
+    [[nodiscard]] EngineStats snapshot() const noexcept;
+
+    /**
+     * Zero all counters and histograms.
+     */
+    void reset() noexcept;
+
+    /**
+     * Monotonic clock for durations, in nanoseconds.
+     */
+    [[nodiscard]] static std::uint64_t now() noexcept {
+        return common::monotonicNanos();
+    }
+
+private:
+    std::atomic<std::uint64_t> m_packets{0};
+    std::atomic<std::uint64_t> m_frames{0};
+    std::atomic<std::uint64_t> m_discontinuities{0};
+    std::atomic<std::uint64_t> m_silentPackets{0};
+    std::atomic<std::uint64_t> m_timestampErrors{0};
+    std::atomic<std::uint64_t> m_getBufferFailures{0};
+    std::atomic<std::uint32_t> m_lastGetBufferError{0};
+    std::atomic<std::uint64_t> m_droppedPackets{0};
+
+    common::LatencyHistogram m_timings[static_cast<std::size_t>(Timing::Count)];
+};
+
+/**
+ * RAII timing of one stage; does nothing when the collector is null.
+ */
+class ScopedStatsTimer {
+public:
+    ScopedStatsTimer(StatsCollector* stats, StatsCollector::Timing timing) noexcept
+        : m_stats(stats)
+        , m_timing(timing)
+        , m_start(stats ? StatsCollector::now() : 0)
+    {
+    }
+
+    ~ScopedStatsTimer() {
+        if (m_stats) {
+            m_stats->recordDuration(m_timing, StatsCollector::now() - m_start);
+        }
+    }
+
+    ScopedStatsTimer(const ScopedStatsTimer&) = delete;
+    ScopedStatsTimer& operator=(const ScopedStatsTimer&) = delete;
+
+private:
+    StatsCollector* m_stats;
+    StatsCollector::Timing m_timing;
+    std::uint64_t m_start;
+};
+
+} // namespace openmeters::core::audio
@@ -0,0 +1,497 @@
+#include "format-convert.h"
+#include "../../common/cpu-features.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+
+#if defined(OPENMETERS_SIMD_X86)
+#include <immintrin.h>
+#endif
+
+namespace openmeters::core::audio {
+
+namespace {
+
+constexpr float kScale16 = 1.0f / 32768.0f;
+constexpr float kScale24 = 1.0f / 8388608.0f;
+constexpr float kScale32 = 1.0f / 2147483648.0f;
+
+// Largest float below 2^31 (2147483647 rounds up to 2^31 and would overflow)
+constexpr float kMaxInt32AsFloat = 2147483520.0f;
+
+inline std::int32_t readInt24(const std::uint8_t* p) noexcept {
+    const std::uint32_t raw = (static_cast<std::uint32_t>(p[0]) << 8) |
+                              (static_cast<std::uint32_t>(p[1]) << 16) |
+                              (static_cast<std::uint32_t>(p[2]) << 24);
+    return static_cast<std::int32_t>(raw) >> 8;
+}
+
+inline void writeInt24(std::uint8_t* p, std::int32_t value) noexcept {
+    const auto raw = static_cast<std::uint32_t>(value);
+    p[0] = static_cast<std::uint8_t>(raw);
+    p[1] = static_cast<std::uint8_t>(raw >> 8);
+    p[2] = static_cast<std::uint8_t>(raw >> 16);
+}
+
+// ---------------------------------------------------------------------------
+// Scalar kernels (reference implementation and SIMD tails)
+// ---------------------------------------------------------------------------
+
+void int16ToFloatScalar(const std::int16_t* src, float* dst, std::size_t n) noexcept {
+    for (std::size_t i = 0; i < n; ++i) {
+        dst[i] = static_cast<float>(src[i]) * kScale16;
+    }
+}
+
+void int24PackedToFloatScalar(const std::uint8_t* src, float* dst, std::size_t n) noexcept {
+    for (std::size_t i = 0; i < n; ++i) {
+        dst[i] = static_cast<float>(readInt24(src + i * 3)) * kScale24;
+    }
+}
+
+void int24In32ToFloatScalar(const std::int32_t* src, float* dst, std::size_t n) noexcept {
+    for (std::size_t i = 0; i < n; ++i) {
+        const std::int32_t value = static_cast<std::int32_t>(static_cast<std::uint32_t>(src[i]) << 8) >> 8;
+        dst[i] = static_cast<float>(value) * kScale24;
+    }
+}
+
+void int32ToFloatScalar(const std::int32_t* src, float* dst, std::size_t n) noexcept {
+    for (std::size_t i = 0; i < n; ++i) {
+        dst[i] = static_cast<float>(src[i]) * kScale32;
+    }
+}
+
+void float64ToFloatScalar(const double* src, float* dst, std::size_t n) noexcept {
+    for (std::size_t i = 0; i < n; ++i) {
+        dst[i] = static_cast<float>(src[i]);
+    }
+}
+
+inline float ditherValue(TpdfDither* dither) noexcept {
+    return dither ? dither->next() : 0.0f;
+}
+
+void floatToInt16Scalar(const float* src, std::int16_t* dst, std::size_t n, TpdfDither* dither) noexcept {
+    for (std::size_t i = 0; i < n; ++i) {
+        const float v = std::clamp(src[i] * 32768.0f + ditherValue(dither), -32768.0f, 32767.0f);
+        dst[i] = static_cast<std::int16_t>(std::lrintf(v));
+    }
+}
+
+void floatToInt24PackedScalar(const float* src, std::uint8_t* dst, std::size_t n, TpdfDither* dither) noexcept {
+    for (std::size_t i = 0; i < n; ++i) {
+        const float v = std::clamp(src[i] * 8388608.0f + ditherValue(dither), -8388608.0f, 8388607.0f);
+        writeInt24(dst + i * 3, static_cast<std::int32_t>(std::lrintf(v)));
+    }
+}
+
+void floatToInt24In32Scalar(const float* src, std::int32_t* dst, std::size_t n, TpdfDither* dither) noexcept {
+    for (std::size_t i = 0; i < n; ++i) {
+        const float v = std::clamp(src[i] * 8388608.0f + ditherValue(dither), -8388608.0f, 8388607.0f);
+        dst[i] = static_cast<std::int32_t>(std::lrintf(v));
+    }
+}
+
+void floatToInt32Scalar(const float* src, std::int32_t* dst, std::size_t n, TpdfDither* dither) noexcept {
+    for (std::size_t i = 0; i < n; ++i) {
+        // float32 carries 24 bits of precision; dither still decorrelates the LSB
+        const float v = std::clamp(src[i] * 2147483648.0f + ditherValue(dither), -2147483648.0f, kMaxInt32AsFloat);
+        dst[i] = static_cast<std::int32_t>(std::lrintf(v));
+    }
+}
+
+void floatToFloat64Scalar(const float* src, double* dst, std::size_t n) noexcept {
+    for (std::size_t i = 0; i < n; ++i) {
+        dst[i] = static_cast<double>(src[i]);
+    }
+}
+
+#if defined(OPENMETERS_SIMD_X86)
+
+// ---------------------------------------------------------------------------
+// SSE2 kernels (baseline on x86-64)
+// ---------------------------------------------------------------------------
+
+void int16ToFloatSse2(const std::int16_t* src, float* dst, std::size_t n) noexcept {
+    const __m128 scale = _mm_set1_ps(kScale16);
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        // Duplicate each int16 into both halves, then arithmetic shift sign-extends
+        const __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16);
+        const __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16);
+        _mm_storeu_ps(dst + i, _mm_mul_ps(_mm_cvtepi32_ps(lo), scale));
+        _mm_storeu_ps(dst + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(hi), scale));
+    }
+    int16ToFloatScalar(src + i, dst + i, n - i);
+}
+
+template <bool kLow24>
+void int32ToFloatSse2(const std::int32_t* src, float* dst, std::size_t n) noexcept {
+    const __m128 scale = _mm_set1_ps(kScale32);
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i + 4));
+        if constexpr (kLow24) {
+            // Move the 24-bit value to the top; the container then reads as int32
+            a = _mm_slli_epi32(a, 8);
+            b = _mm_slli_epi32(b, 8);
+        }
+        _mm_storeu_ps(dst + i, _mm_mul_ps(_mm_cvtepi32_ps(a), scale));
+        _mm_storeu_ps(dst + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(b), scale));
+    }
+    if constexpr (kLow24) {
+        int24In32ToFloatScalar(src + i, dst + i, n - i);
+    } else {
+        int32ToFloatScalar(src + i, dst + i, n - i);
+    }
+}
+
+void float64ToFloatSse2(const double* src, float* dst, std::size_t n) noexcept {
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        const __m128 a = _mm_cvtpd_ps(_mm_loadu_pd(src + i));
+        const __m128 b = _mm_cvtpd_ps(_mm_loadu_pd(src + i + 2));
+        _mm_storeu_ps(dst + i, _mm_movelh_ps(a, b));
+    }
+    float64ToFloatScalar(src + i, dst + i, n - i);
+}
+
+void floatToInt16Sse2(const float* src, std::int16_t* dst, std::size_t n) noexcept {
+    const __m128 scale = _mm_set1_ps(32768.0f);
+    const __m128 lo = _mm_set1_ps(-32768.0f);
+    const __m128 hi = _mm_set1_ps(32767.0f);
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const __m128 a = _mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_loadu_ps(src + i), scale), lo), hi);
+        const __m128 b = _mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_loadu_ps(src + i + 4), scale), lo), hi);
+        const __m128i packed = _mm_packs_epi32(_mm_cvtps_epi32(a), _mm_cvtps_epi32(b));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), packed);
+    }
+    floatToInt16Scalar(src + i, dst + i, n - i, nullptr);
+}
+
+void floatToInt24PackedSse2(const float* src, std::uint8_t* dst, std::size_t n) noexcept {
+    // No byte shuffle in SSE2: squeeze pairs of 24-bit values into 48 bits of
+    // each 64-bit lane, then close the 2-byte gap between the lanes
+    const __m128 scale = _mm_set1_ps(8388608.0f);
+    const __m128 lo = _mm_set1_ps(-8388608.0f);
+    const __m128 hi = _mm_set1_ps(8388607.0f);
+    const __m128i evenMask = _mm_set_epi32(0, 0x00FFFFFF, 0, 0x00FFFFFF);
+    const __m128i oddMask = _mm_set_epi32(0x00FFFFFF, 0, 0x00FFFFFF, 0);
+    const __m128i lowSixBytes = _mm_set_epi32(0, 0, 0x0000FFFF, -1);
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        const __m128 v = _mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_loadu_ps(src + i), scale), lo), hi);
+        const __m128i x = _mm_cvtps_epi32(v);
+        const __m128i pairs = _mm_or_si128(_mm_and_si128(x, evenMask), _mm_srli_epi64(_mm_and_si128(x, oddMask), 8));
+        const __m128i packed = _mm_or_si128(_mm_and_si128(pairs, lowSixBytes),
+                                            _mm_andnot_si128(lowSixBytes, _mm_srli_si128(pairs, 2)));
+        std::uint8_t* out = dst + i * 3;
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(out), packed);
+        const std::int32_t tail = _mm_cvtsi128_si32(_mm_srli_si128(packed, 8));
+        std::memcpy(out + 8, &tail, 4);
+    }
+    floatToInt24PackedScalar(src + i, dst + i * 3, n - i, nullptr);
+}
+
+void floatToInt24In32Sse2(const float* src, std::int32_t* dst, std::size_t n) noexcept {
+    const __m128 scale = _mm_set1_ps(8388608.0f);
+    const __m128 lo = _mm_set1_ps(-8388608.0f);
+    const __m128 hi = _mm_set1_ps(8388607.0f);
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        const __m128 v = _mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_loadu_ps(src + i), scale), lo), hi);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_cvtps_epi32(v));
+    }
+    floatToInt24In32Scalar(src + i, dst + i, n - i, nullptr);
+}
+
+void floatToInt32Sse2(const float* src, std::int32_t* dst, std::size_t n) noexcept {
+    const __m128 scale = _mm_set1_ps(2147483648.0f);
+    const __m128 lo = _mm_set1_ps(-2147483648.0f);
+    const __m128 hi = _mm_set1_ps(kMaxInt32AsFloat);
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        const __m128 v = _mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_loadu_ps(src + i), scale), lo), hi);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_cvtps_epi32(v));
+    }
+    floatToInt32Scalar(src + i, dst + i, n - i, nullptr);
+}
+
+void floatToFloat64Sse2(const float* src, double* dst, std::size_t n) noexcept {
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        const __m128 v = _mm_loadu_ps(src + i);
+        _mm_storeu_pd(dst + i, _mm_cvtps_pd(v));
+        _mm_storeu_pd(dst + i + 2, _mm_cvtps_pd(_mm_movehl_ps(v, v)));
+    }
+    floatToFloat64Scalar(src + i, dst + i, n - i);
+}
+
+// ---------------------------------------------------------------------------
+// AVX2 kernels (selected at runtime)
+// ---------------------------------------------------------------------------
+
+OPENMETERS_TARGET_AVX2
+void int16ToFloatAvx2(const std::int16_t* src, float* dst, std::size_t n) noexcept {
+    const __m256 scale = _mm256_set1_ps(kScale16);
+    std::size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i + 8));
+        _mm256_storeu_ps(dst + i, _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(a)), scale));
+        _mm256_storeu_ps(dst + i + 8, _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(b)), scale));
+    }
+    int16ToFloatScalar(src + i, dst + i, n - i);
+}
+
+OPENMETERS_TARGET_AVX2
+void int24PackedToFloatAvx2(const std::uint8_t* src, float* dst, std::size_t n) noexcept {
+    // Per 128-bit lane: four 3-byte samples -> top three bytes of four int32s
+    const __m256i shuffle = _mm256_setr_epi8(
+        -1, 0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11,
+        -1, 0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11
+    );
+    const __m256 scale = _mm256_set1_ps(kScale32);
+    std::size_t i = 0;
+    // Each iteration reads 28 bytes for 24 bytes of samples; keep the overread in bounds
+    for (; i + 10 <= n; i += 8) {
+        const std::uint8_t* p = src + i * 3;
+        const __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        const __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 12));
+        __m256i v = _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+        v = _mm256_shuffle_epi8(v, shuffle);
+        _mm256_storeu_ps(dst + i, _mm256_mul_ps(_mm256_cvtepi32_ps(v), scale));
+    }
+    int24PackedToFloatScalar(src + i * 3, dst + i, n - i);
+}
+
+template <bool kLow24>
+OPENMETERS_TARGET_AVX2
+void int32ToFloatAvx2(const std::int32_t* src, float* dst, std::size_t n) noexcept {
+    const __m256 scale = _mm256_set1_ps(kScale32);
+    std::size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+        __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i + 8));
+        if constexpr (kLow24) {
+            a = _mm256_slli_epi32(a, 8);
+            b = _mm256_slli_epi32(b, 8);
+        }
+        _mm256_storeu_ps(dst + i, _mm256_mul_ps(_mm256_cvtepi32_ps(a), scale));
+        _mm256_storeu_ps(dst + i + 8, _mm256_mul_ps(_mm256_cvtepi32_ps(b), scale));
+    }
+    if constexpr (kLow24) {
+        int24In32ToFloatScalar(src + i, dst + i, n - i);
+    } else {
+        int32ToFloatScalar(src + i, dst + i, n - i);
+    }
+}
+
+OPENMETERS_TARGET_AVX2
+void float64ToFloatAvx2(const double* src, float* dst, std::size_t n) noexcept {
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const __m128 a = _mm256_cvtpd_ps(_mm256_loadu_pd(src + i));
+        const __m128 b = _mm256_cvtpd_ps(_mm256_loadu_pd(src + i + 4));
+        _mm256_storeu_ps(dst + i, _mm256_set_m128(b, a));
+    }
+    float64ToFloatScalar(src + i, dst + i, n - i);
+}
+
+#endif // OPENMETERS_SIMD_X86
+
+/**
+ * Forward conversion kernels for one instruction set.
+ * Reverse conversions only use SSE2; they run on writer threads, not the capture path.
+ */
+struct ConvertKernels {
+    void (*int16ToFloat)(const std::int16_t*, float*, std::size_t) noexcept;
+    void (*int24PackedToFloat)(const std::uint8_t*, float*, std::size_t) noexcept;
+    void (*int24In32ToFloat)(const std::int32_t*, float*, std::size_t) noexcept;
+    void (*int32ToFloat)(const std::int32_t*, float*, std::size_t) noexcept;
+    void (*float64ToFloat)(const double*, float*, std::size_t) noexcept;
+    bool sse2Reverse;
+};
+
+constexpr ConvertKernels kScalarKernels = {
+    int16ToFloatScalar,
+    int24PackedToFloatScalar,
+    int24In32ToFloatScalar,
+    int32ToFloatScalar,
+    float64ToFloatScalar,
+    false
+};
+
+#if defined(OPENMETERS_SIMD_X86)
+constexpr ConvertKernels kSse2Kernels = {
+    int16ToFloatSse2,
+    int24PackedToFloatScalar, // Needs a byte shuffle (SSSE3+); scalar is already load-bound
+    int32ToFloatSse2<true>,
+    int32ToFloatSse2<false>,
+    float64ToFloatSse2,
+    true
+};
+
+constexpr ConvertKernels kAvx2Kernels = {
+    int16ToFloatAvx2,
+    int24PackedToFloatAvx2,
+    int32ToFloatAvx2<true>,
+    int32ToFloatAvx2<false>,
+    float64ToFloatAvx2,
+    true
+};
+#endif
+
+SimdLevel detectSimdLevel() noexcept {
+#if defined(OPENMETERS_SIMD_X86)
+    return common::cpuSupportsAvx2() ? SimdLevel::Avx2 : SimdLevel::Sse2;
+#else
+    return SimdLevel::Scalar;
+#endif
+}
+
+const ConvertKernels* kernelsFor(SimdLevel level) noexcept {
+#if defined(OPENMETERS_SIMD_X86)
+    switch (level) {
+        case SimdLevel::Avx2: return &kAvx2Kernels;
+        case SimdLevel::Sse2: return &kSse2Kernels;
+        default:              return &kScalarKernels;
+    }
+#else
+    (void)level;
+    return &kScalarKernels;
+#endif
+}
+
+const SimdLevel g_detectedLevel = detectSimdLevel();
+std::atomic<const ConvertKernels*> g_kernels{kernelsFor(g_detectedLevel)};
+std::atomic<SimdLevel> g_activeLevel{g_detectedLevel};
+
+} // namespace
+
+SimdLevel supportedSimdLevel() noexcept {
+    return g_detectedLevel;
+}
+
+SimdLevel activeSimdLevel() noexcept {
+    return g_activeLevel.load(std::memory_order_relaxed);
+}
+
+void setSimdLevel(SimdLevel level) noexcept {
+    const SimdLevel clamped = std::min(level, g_detectedLevel);
+    g_activeLevel.store(clamped, std::memory_order_relaxed);
+    g_kernels.store(kernelsFor(clamped), std::memory_order_relaxed);
+}
+
+void convertToFloat32(
+    const void* source,
+    SampleFormat format,
+    float* dest,
+    std::size_t sampleCount
+) noexcept {
+    if (!source || !dest || sampleCount == 0) {
+        return;
+    }
+
+    const ConvertKernels& k = *g_kernels.load(std::memory_order_relaxed);
+
+    switch (format) {
+        case SampleFormat::Int16:
+            k.int16ToFloat(static_cast<const std::int16_t*>(source), dest, sampleCount);
+            break;
+        case SampleFormat::Int24Packed:
+            k.int24PackedToFloat(static_cast<const std::uint8_t*>(source), dest, sampleCount);
+            break;
+        case SampleFormat::Int24In32:
+            k.int24In32ToFloat(static_cast<const std::int32_t*>(source), dest, sampleCount);
+            break;
+        case SampleFormat::Int32:
+            k.int32ToFloat(static_cast<const std::int32_t*>(source), dest, sampleCount);
+            break;
+        case SampleFormat::Float32:
+            std::memcpy(dest, source, sampleCount * sizeof(float));
+            break;
+        case SampleFormat::Float64:
+            k.float64ToFloat(static_cast<const double*>(source), dest, sampleCount);
+            break;
+        default:
+            // Unsupported format - fill with zeros
+            std::fill(dest, dest + sampleCount, 0.0f);
+            break;
+    }
+}
+
+void convertFromFloat32(
+    const float* source,
+    void* dest,
+    SampleFormat format,
+    std::size_t sampleCount,
+    TpdfDither* dither
+) noexcept {
+    if (!source || !dest || sampleCount == 0) {
+        return;
+    }
+
+    // Dither draws one random value per sample in order, so it stays scalar
+    const bool simd = !dither && g_kernels.load(std::memory_order_relaxed)->sse2Reverse;
+
+    switch (format) {
+        case SampleFormat::Int16:
+#if defined(OPENMETERS_SIMD_X86)
+            if (simd) {
+                floatToInt16Sse2(source, static_cast<std::int16_t*>(dest), sampleCount);
+                break;
+            }
+#endif
+            floatToInt16Scalar(source, static_cast<std::int16_t*>(dest), sampleCount, dither);
+            break;
+        case SampleFormat::Int24Packed:
+#if defined(OPENMETERS_SIMD_X86)
+            if (simd) {
+                floatToInt24PackedSse2(source, static_cast<std::uint8_t*>(dest), sampleCount);
+                break;
+            }
+#endif
+            floatToInt24PackedScalar(source, static_cast<std::uint8_t*>(dest), sampleCount, dither);
+            break;
+        case SampleFormat::Int24In32:
+#if defined(OPENMETERS_SIMD_X86)
+            if (simd) {
+                floatToInt24In32Sse2(source, static_cast<std::int32_t*>(dest), sampleCount);
+                break;
+            }
+#endif
+            floatToInt24In32Scalar(source, static_cast<std::int32_t*>(dest), sampleCount, dither);
+            break;
+        case SampleFormat::Int32:
+#if defined(OPENMETERS_SIMD_X86)
+            if (simd) {
+                floatToInt32Sse2(source, static_cast<std::int32_t*>(dest), sampleCount);
+                break;
+            }
+#endif
+            floatToInt32Scalar(source, static_cast<std::int32_t*>(dest), sampleCount, dither);
+            break;
+        case SampleFormat::Float32:
+            std::memcpy(dest, source, sampleCount * sizeof(float));
+            break;
+        case SampleFormat::Float64:
+#if defined(OPENMETERS_SIMD_X86)
+            if (simd) {
+                floatToFloat64Sse2(source, static_cast<double*>(dest), sampleCount);
+                break;
+            }
+#endif
+            floatToFloat64Scalar(source, static_cast<double*>(dest), sampleCount);
+            break;
+        default:
+            break;
+    }
+}
+
+} // namespace openmeters::core::audio
@@ -0,0 +1,129 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace openmeters::core::audio {
+
+/**
+ * Interleaved PCM sample encodings understood by the converters.
+ * All integer formats are little-endian and signed.
+ */
+enum class SampleFormat {
+    Unknown,
+    Int16,       // 16-bit integer
+    Int24Packed, // 24-bit integer, 3 bytes per sample
+    Int24In32,   // 24-bit integer in the low bits of a 32-bit container (sign-extended)
+    Int32,       // 32-bit integer (also 24-in-32 left-justified, as WASAPI delivers it)
+    Float32,     // IEEE float, [-1.0, 1.0]
+    Float64      // IEEE double, [-1.0, 1.0]
+};
+
+/**
+ * Size of one sample in bytes (0 for Unknown).
+ */
+[[nodiscard]] constexpr std::size_t bytesPerSample(SampleFormat format) noexcept {
+    switch (format) {
+        case SampleFormat::Int16:       return 2;
+        case SampleFormat::Int24Packed: return 3;
+        case SampleFormat::Int24In32:   return 4;
+        case SampleFormat::Int32:       return 4;
+        case SampleFormat::Float32:     return 4;
+        case SampleFormat::Float64:     return 8;
+        default:                        return 0;
+    }
+}
+
+/**
+ * Instruction set used by the converters, ordered by capability.
+ */
+enum class SimdLevel {
+    Scalar,
+    Sse2,
+    Avx2
+};
+
+/**
+ * Best instruction set supported by this CPU (detected once at startup).
+ */
+[[nodiscard]] SimdLevel supportedSimdLevel() noexcept;
+
+/**
+ * Instruction set currently used by the converters.
+ */
+[[nodiscard]] SimdLevel activeSimdLevel() noexcept;
+
+/**
+ * Restrict the converters to an instruction set (clamped to what the CPU supports).
+ * Intended for tests and benchmarks comparing kernels.
+ */
+void setSimdLevel(SimdLevel level) noexcept;
+
+/**
+ * Triangular-PDF dither generator (±1 LSB peak).
+ * Sum of two independent uniform variables from a xorshift generator.
+ *
+ * Thread safety: Not thread-safe. Use one instance per stream.
+ */
+class TpdfDither {
+public:
+    explicit TpdfDither(std::uint32_t seed = 0x9E3779B9u) noexcept
+        : m_state(seed ? seed : 1u) {}
+
+    /**
+     * Next dither value in LSB units, range (-1.0, 1.0).
+     */
+    float next() noexcept {
+        return uniform() - uniform();
+    }
+
+private:
+    float uniform() noexcept {
+        m_state ^= m_state << 13;
+        m_state ^= m_state >> 17;
+        m_state ^= m_state << 5;
+        return static_cast<float>(m_state >> 8) * (1.0f / 16777216.0f);
+    }
+
+    std::uint32_t m_state;
+};
+
+/**
+ * Convert interleaved samples to float32 in [-1.0, 1.0].
+ * Uses AVX2 or SSE2 kernels when the CPU supports them.
+ *
+ * @param source Source samples (any alignment)
+ * @param format Source sample format
+ * @param dest Destination float buffer (any alignment)
+ * @param sampleCount Number of samples (frames * channels)
+ *
+ * Thread safety: Reentrant. Real-time safe (no allocation, no locks).
+ */
+void convertToFloat32(
+    const void* source,
+    SampleFormat format,
+    float* dest,
+    std::size_t sampleCount
+) noexcept;
+
+/**
+ * Convert float32 samples to another format.
+ * Values are clipped to full scale and rounded to nearest.
+ *
+ * @param source Source float samples
+ * @param dest Destination buffer (any alignment)
+ * @param format Destination sample format
+ * @param sampleCount Number of samples (frames * channels)
+ * @param dither Optional TPDF dither for integer targets (nullptr = none)
+ *
+ * Thread safety: Reentrant. Real-time safe (no allocation, no locks).
+ */
+void convertFromFloat32(
+    const float* source,
+    void* dest,
+    SampleFormat format,
+    std::size_t sampleCount,
+    TpdfDither* dither = nullptr
+) noexcept;
+
+} // namespace openmeters::core::audio
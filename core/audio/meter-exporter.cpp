@@ -0,0 +1,136 @@
+#include "meter-exporter.h"
+#include "../../common/logger.h"
+#include <atomic>
+#include <cstring>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <cerrno>
+#include <signal.h>
+#include <unistd.h>
+#endif
+
+namespace openmeters::core::audio {
+
+namespace {
+
+static_assert(sizeof(om_meter_frame) == 48, "shared frame layout");
+static_assert(sizeof(om_shm_segment) == 64, "shared header layout");
+static_assert(sizeof(om_shm_slot) == 64, "seqlock slot fills one cache line");
+
+std::uint64_t processId() noexcept {
+#ifdef _WIN32
+    return GetCurrentProcessId();
+#else
+    return static_cast<std::uint64_t>(getpid());
+#endif
+}
+
+bool isProcessAlive(std::uint64_t pid) noexcept {
+#ifdef _WIN32
+    HANDLE process = OpenProcess(SYNCHRONIZE, FALSE, static_cast<DWORD>(pid));
+    if (!process) {
+        return GetLastError() == ERROR_ACCESS_DENIED; // Exists, but not ours to open
+    }
+    const bool running = WaitForSingleObject(process, 0) == WAIT_TIMEOUT;
+    CloseHandle(process);
+    return running;
+#else
+    return kill(static_cast<pid_t>(pid), 0) == 0 || errno == EPERM;
+#endif
+}
+
+// An existing segment may be taken over only if it is ours and its writer
+// died without removing it. Anything else (another live instance, a
+// segment still being set up, a foreign object) is left alone.
+bool isStaleSegment(const std::uint8_t* data, std::size_t size) {
+    if (size < sizeof(om_shm_segment)) {
+        return false;
+    }
+    om_shm_segment header;
+    std::memcpy(&header, data, sizeof(header));
+    return header.magic == OM_SHM_MAGIC && header.writer_pid != 0 && !isProcessAlive(header.writer_pid);
+}
+
+} // namespace
+
+MeterExporter::~MeterExporter() {
+    close();
+}
+
+bool MeterExporter::open(const std::string& name, const common::AudioFormat& format) {
+    close();
+    constexpr std::size_t kSegmentBytes = sizeof(om_shm_segment) + sizeof(om_shm_slot);
+    if (!m_memory.create(name, kSegmentBytes, isStaleSegment)) {
+        LOG_ERROR("Failed to create shared memory segment for meter export: {}", name);
+        return false;
+    }
+
+    m_segment = reinterpret_cast<om_shm_segment*>(m_memory.data());
+    m_slot = reinterpret_cast<om_shm_slot*>(m_memory.data() + sizeof(om_shm_segment));
+    m_sequence = 0;
+
+    m_segment->version = OM_SHM_VERSION;
+    m_segment->segment_size = static_cast<std::uint32_t>(kSegmentBytes);
+    m_segment->frame_offset = sizeof(om_shm_segment);
+    m_segment->frame_size = sizeof(om_meter_frame);
+    m_segment->sample_rate = format.sampleRate;
+    m_segment->channel_count = format.channelCount;
+    m_segment->writer_pid = processId();
+    m_segment->flags = OM_SHM_FLAG_LIVE;
+    // Readers check the magic first, so it goes in once the rest is set
+    std::atomic_ref<std::uint32_t>(m_segment->magic).store(OM_SHM_MAGIC, std::memory_order_release);
+
+    LOG_INFO("Publishing meters in shared memory \"{}\"", name);
+    return true;
+}
+
+void MeterExporter::close() {
+    if (!m_segment) {
+        return;
+    }
+    std::atomic_ref<std::uint32_t>(m_segment->flags).store(0, std::memory_order_release);
+    m_memory.close();
+    m_segment = nullptr;
+    m_slot = nullptr;
+}
+
+void MeterExporter::onAudioData(const float* buffer, std::size_t frameCount, const common::AudioFormat& format) {
+    (void)buffer;
+    (void)frameCount;
+    (void)format;
+}
+
+bool MeterExporter::onAudioBlock(const AudioBlock& block) {
+    (void)block;
+    return true;
+}
+
+void MeterExporter::onMeterData(const common::MeterSnapshot& snapshot) {
+    if (!m_slot) {
+        return;
+    }
+
+    om_meter_frame frame;
+    frame.timestamp_ms = snapshot.timestampMs;
+    frame.capture_time_ns = snapshot.captureTimeNs;
+    frame.peak[0] = snapshot.peak.left;
+    frame.peak[1] = snapshot.peak.right;
+    frame.level[0] = snapshot.level.left;
+    frame.level[1] = snapshot.level.right;
+    frame.peak_hold[0] = snapshot.peakHold.left;
+    frame.peak_hold[1] = snapshot.peakHold.right;
+    frame.rms[0] = snapshot.rms.left;
+    frame.rms[1] = snapshot.rms.right;
+
+    // Seqlock: odd while the frame is being replaced
+    std::atomic_ref<std::uint64_t> sequence(m_slot->sequence);
+    sequence.store(m_sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    std::memcpy(&m_slot->frame, &frame, sizeof(frame));
+    m_sequence += 2;
+    sequence.store(m_sequence, std::memory_order_release);
+}
+
+} // namespace openmeters::core::audio
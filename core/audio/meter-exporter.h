@@ -0,0 +1,75 @@
+#pragma once
+
+#include "audio-engine-interface.h"
+#include "../../client/openmeters-shm.h"
+#include "../../common/audio-format.h"
+#include "../../common/shared-memory.h"
+#include <cstdint>
+#include <string>
+
+namespace openmeters::core::audio {
+
+/**
+ * Publishes the newest meter snapshot in shared memory for other
+ * processes (playout automation, loggers, remote displays), which read it
+ * with the C library in client/openmeters-shm.h.
+ *
+ * Register it as an engine callback. onMeterData writes the snapshot into
+ * a one-cache-line seqlock slot: two stores to the sequence counter around
+ * a 48-byte copy, with no lock, no system call and nothing readers can
+ * delay. Readers poll without a system call and retry if they raced the
+ * write.
+ *
+ * Thread safety: open() and close() from a control thread while not
+ * registered; onMeterData from the single source thread.
+ */
+class MeterExporter : public IAudioDataCallback {
+public:
+    MeterExporter() = default;
+    ~MeterExporter() override;
+
+    // Non-copyable, non-movable
+    MeterExporter(const MeterExporter&) = delete;
+    MeterExporter& operator=(const MeterExporter&) = delete;
+    MeterExporter(MeterExporter&&) = delete;
+    MeterExporter& operator=(MeterExporter&&) = delete;
+
+    /**
+     * Create the shared memory segment. Not real-time safe.
+     *
+     * @param name Segment name (readers pass the same name to om_shm_open)
+     * @param format Stream format advertised in the segment header
+     * @return true if the segment was created, false otherwise
+     */
+    bool open(const std::string& name, const common::AudioFormat& format);
+
+    /**
+     * Mark the segment stopped for readers and remove it.
+     */
+    void close();
+
+    void onAudioData(const float* buffer, std::size_t frameCount, const common::AudioFormat& format) override;
+    void onMeterData(const common::MeterSnapshot& snapshot) override;
+
+    /**
+     * Takes no audio: every block counts as handled, so none is
+     * converted to float for this callback.
+     */
+    bool onAudioBlock(const AudioBlock& block) override;
+
+    [[nodiscard]] bool isOpen() const noexcept { return m_slot != nullptr; }
+
+    /**
+     * Snapshots published since open() (read from the source thread, or
+     * once unregistered).
+     */
+    [[nodiscard]] std::uint64_t published() const noexcept { return m_sequence / 2; }
+
+private:
+    common::SharedMemory m_memory;
+    om_shm_segment* m_segment = nullptr;
+    om_shm_slot* m_slot = nullptr;
+    std::uint64_t m_sequence = 0; // Written only by the source thread
+};
+
+} // namespace openmeters::core::audio
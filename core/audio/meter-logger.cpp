@@ -0,0 +1,148 @@
+#include "meter-logger.h"
+#include "../../common/clock.h"
+#include "../../common/logger.h"
+#include "../../common/resource-monitor.h"
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <vector>
+
+namespace openmeters::core::audio {
+
+namespace {
+
+// About 40 s of snapshots at the usual 10 ms packet size
+constexpr std::size_t kRingSnapshots = 4096;
+constexpr std::size_t kReadBatch = 256;
+constexpr auto kWriterPollInterval = std::chrono::milliseconds(100);
+
+std::int64_t epochMillis() noexcept {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+} // namespace
+
+MeterLogger::~MeterLogger() {
+    stop();
+}
+
+bool MeterLogger::start(const std::string& path, std::uint32_t intervalMs, std::uint32_t flushSeconds) {
+    if (m_thread.joinable()) {
+        return false;
+    }
+    if (m_ring.capacity() == 0 && !m_ring.reserve(kRingSnapshots)) {
+        return false;
+    }
+
+    std::error_code error;
+    const std::filesystem::path parent = std::filesystem::path(path).parent_path();
+    if (!parent.empty()) {
+        std::filesystem::create_directories(parent, error);
+    }
+    if (!m_writer.open(path, intervalMs)) {
+        LOG_ERROR("Failed to start meter log: {}", path);
+        return false;
+    }
+
+    m_path = path;
+    m_flushInterval = std::chrono::seconds(std::max<std::uint32_t>(1, flushSeconds));
+    m_cursor = m_ring.writeIndex(); // Skip snapshots from a previous log
+    m_snapshotsLogged.store(0);
+    m_droppedSnapshots.store(0);
+    m_writeFailed.store(false);
+    m_stopping.store(false);
+    m_thread = std::thread(&MeterLogger::writerThread, this);
+    m_logging.store(true);
+
+    LOG_INFO("Logging meters to {} ({} ms interval)", path, intervalMs);
+    return true;
+}
+
+void MeterLogger::stop() {
+    if (!m_thread.joinable()) {
+        return;
+    }
+
+    m_logging.store(false);
+    m_stopping.store(true);
+    m_thread.join();
+
+    const bool complete = m_writer.close() && !m_writeFailed.load();
+    if (!complete) {
+        LOG_ERROR("Meter log {} is incomplete (disk write failed)", m_path);
+    }
+    if (const auto dropped = m_droppedSnapshots.load(); dropped != 0) {
+        LOG_WARNING("Meter log {} dropped {} snapshot(s)", m_path, dropped);
+    }
+    LOG_INFO("Logged {} meter snapshot(s) to {}", m_snapshotsLogged.load(), m_path);
+}
+
+void MeterLogger::onAudioData(const float* buffer, std::size_t frameCount, const common::AudioFormat& format) {
+    (void)buffer;
+    (void)frameCount;
+    (void)format;
+}
+
+bool MeterLogger::onAudioBlock(const AudioBlock& block) {
+    (void)block;
+    return true;
+}
+
+void MeterLogger::onMeterData(const common::MeterSnapshot& snapshot) {
+    if (m_logging.load(std::memory_order_relaxed)) {
+        m_ring.push(snapshot);
+    }
+}
+
+void MeterLogger::writerThread() {
+    common::ResourceMonitor::registerCurrentThread(common::ThreadRole::Logger);
+
+    // Capture times are monotonic; shift them onto the wall clock once
+    const std::int64_t epochOffsetMs = epochMillis() - static_cast<std::int64_t>(common::monotonicNanos() / 1000000);
+    std::vector<common::MeterSnapshot> batch(kReadBatch);
+    auto lastFlush = std::chrono::steady_clock::now();
+    bool unsynced = false;
+
+    for (;;) {
+        // Read the stop flag first so the final drain sees every snapshot
+        const bool stopping = m_stopping.load();
+        std::uint64_t lost = 0;
+        const std::size_t count = m_ring.read(m_cursor, batch.data(), batch.size(), &lost);
+        if (lost != 0) {
+            m_droppedSnapshots.fetch_add(lost, std::memory_order_relaxed);
+        }
+
+        for (std::size_t i = 0; i < count; ++i) {
+            common::MeterSnapshot snapshot = batch[i];
+            snapshot.timestampMs = static_cast<std::uint64_t>(snapshot.captureTimeNs != 0
+                ? epochOffsetMs + static_cast<std::int64_t>(snapshot.captureTimeNs / 1000000)
+                : epochMillis());
+            if (!m_writer.add(snapshot)) {
+                m_writeFailed.store(true);
+            }
+        }
+        m_snapshotsLogged.fetch_add(count, std::memory_order_relaxed);
+        unsynced = unsynced || count != 0;
+
+        // Idle feeds add nothing, so skip the disk round trip
+        const auto now = std::chrono::steady_clock::now();
+        if (unsynced && now - lastFlush >= m_flushInterval) {
+            if (!m_writer.sync()) {
+                m_writeFailed.store(true);
+            }
+            unsynced = false;
+            lastFlush = now;
+        }
+
+        if (count == batch.size()) {
+            continue;
+        }
+        if (stopping) {
+            break;
+        }
+        std::this_thread::sleep_for(kWriterPollInterval);
+    }
+}
+
+} // namespace openmeters::core::audio
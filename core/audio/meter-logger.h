@@ -0,0 +1,98 @@
+#pragma once
+
+#include "audio-engine-interface.h"
+#include "../../common/event-ring.h"
+#include "../../common/meter-log.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <thread>
+
+namespace openmeters::core::audio {
+
+/**
+ * Archives meter snapshots to a meter log (.ommeter, see MeterLogWriter)
+ * for long-running, unattended metering.
+ *
+ * Register it as an engine callback; it ignores snapshots until start().
+ * The source thread only pushes each snapshot into a preallocated event
+ * ring. A writer thread drains the ring, stamps each snapshot with wall
+ * clock time (ms since the epoch, from its capture time) and aggregates
+ * it into the log's interval. Buffered entries are written and synced to
+ * disk every flushSeconds (a short chunk each time), so a crash or power
+ * loss loses at most that much of the log.
+ *
+ * Thread safety: start() and stop() from one control thread;
+ * onMeterData from the source thread.
+ */
+class MeterLogger : public IAudioDataCallback {
+public:
+    MeterLogger() = default;
+    ~MeterLogger() override;
+
+    // Non-copyable, non-movable
+    MeterLogger(const MeterLogger&) = delete;
+    MeterLogger& operator=(const MeterLogger&) = delete;
+    MeterLogger(MeterLogger&&) = delete;
+    MeterLogger& operator=(MeterLogger&&) = delete;
+
+    /**
+     * Create the log and start logging. Not real-time safe.
+     *
+     * @param path Log file (parent directories are created)
+     * @param intervalMs Snapshots are aggregated per interval (0 keeps every one)
+     * @param flushSeconds Longest stretch of the log a crash can lose
+     *        (at least 1)
+     * @return true if logging, false if already logging or the file could
+     *         not be created
+     */
+    bool start(const std::string& path, std::uint32_t intervalMs = 1000, std::uint32_t flushSeconds = 5);
+
+    /**
+     * Log buffered snapshots and complete the file.
+     */
+    void stop();
+
+    void onAudioData(const float* buffer, std::size_t frameCount, const common::AudioFormat& format) override;
+    void onMeterData(const common::MeterSnapshot& snapshot) override;
+
+    /**
+     * Takes no audio: every block counts as handled, so none is
+     * converted to float for this callback.
+     */
+    bool onAudioBlock(const AudioBlock& block) override;
+
+    [[nodiscard]] bool isLogging() const noexcept { return m_logging.load(std::memory_order_relaxed); }
+    [[nodiscard]] const std::string& path() const noexcept { return m_path; }
+
+    /**
+     * Snapshots logged in the current (or last) log.
+     */
+    [[nodiscard]] std::uint64_t snapshotsLogged() const noexcept { return m_snapshotsLogged.load(std::memory_order_relaxed); }
+
+    /**
+     * Snapshots overwritten in the ring before the writer thread read them.
+     */
+    [[nodiscard]] std::uint64_t droppedSnapshots() const noexcept { return m_droppedSnapshots.load(std::memory_order_relaxed); }
+
+private:
+    void writerThread();
+
+    common::EventRing<common::MeterSnapshot> m_ring{common::MemoryTag::Analysis};
+    std::uint64_t m_cursor = 0;
+    std::chrono::seconds m_flushInterval{5};
+
+    std::thread m_thread;
+    std::string m_path;
+    std::atomic<bool> m_logging{false};
+    std::atomic<bool> m_stopping{false};
+    std::atomic<std::uint64_t> m_snapshotsLogged{0};
+    std::atomic<std::uint64_t> m_droppedSnapshots{0};
+    std::atomic<bool> m_writeFailed{false};
+
+    // Opened by start(), then owned by the writer thread until stop() joins it
+    common::MeterLogWriter m_writer{common::MemoryTag::Analysis};
+};
+
+} // namespace openmeters::core::audio
@@ -0,0 +1,184 @@
+#include "replay-source.h"
+#include "../../common/clock.h"
+#include "../../common/logger.h"
+#include "../../common/realtime-scope.h"
+#include "../../common/resource-monitor.h"
+#include "../../common/trace.h"
+#include <algorithm>
+#include <chrono>
+
+namespace openmeters::core::audio {
+
+namespace {
+
+// Float conversion plus callback scratch per packet (matches WasapiCapture)
+constexpr std::size_t kPacketArenaBlocks = 4;
+
+} // namespace
+
+ReplaySource::ReplaySource(const ReplaySourceConfig& config)
+    : m_config(config)
+{
+}
+
+ReplaySource::~ReplaySource() {
+    shutdown();
+}
+
+bool ReplaySource::initialize() {
+    if (m_initialized) {
+        return true;
+    }
+
+    if (!m_reader.open(m_config.tracePath)) {
+        return false;
+    }
+    if (m_reader.packets().empty()) {
+        LOG_ERROR("Capture trace contains no packets: {}", m_config.tracePath);
+        return false;
+    }
+
+    const std::size_t maxSamples = static_cast<std::size_t>(m_reader.maxFrameCount()) * m_reader.format().samplesPerFrame();
+    if (!m_bufferPool.reserve(kPacketArenaBlocks * (maxSamples * sizeof(float) + common::BufferPool::kDefaultAlignment))) {
+        return false;
+    }
+
+    m_initialized = true;
+    return true;
+}
+
+bool ReplaySource::start() {
+    if (m_running.load()) {
+        return true; // Already running
+    }
+
+    if (!m_initialized) {
+        return false;
+    }
+
+    // Join a thread that reached the end of the trace on its own
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+
+    m_packetsDelivered.store(0);
+    m_maxLatenessNs.store(0);
+    m_running.store(true);
+    m_thread = std::thread(&ReplaySource::run, this);
+    return true;
+}
+
+void ReplaySource::stop() {
+    m_running.store(false);
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+}
+
+void ReplaySource::shutdown() {
+    stop();
+    m_dispatcher.clear();
+    m_bufferPool.release();
+    m_initialized = false;
+}
+
+common::AudioFormat ReplaySource::getFormat() const {
+    return m_reader.format();
+}
+
+bool ReplaySource::isCapturing() const {
+    return m_running.load();
+}
+
+void ReplaySource::registerCallback(IAudioDataCallback* callback) {
+    m_dispatcher.add(callback);
+}
+
+void ReplaySource::unregisterCallback(IAudioDataCallback* callback) {
+    m_dispatcher.remove(callback);
+}
+
+void ReplaySource::setStatsCollector(StatsCollector* stats) {
+    m_stats = stats;
+    m_dispatcher.setStatsCollector(stats);
+}
+
+std::uint64_t ReplaySource::packetsDelivered() const noexcept {
+    return m_packetsDelivered.load(std::memory_order_relaxed);
+}
+
+std::uint64_t ReplaySource::maxLatenessNs() const noexcept {
+    return m_maxLatenessNs.load(std::memory_order_relaxed);
+}
+
+void ReplaySource::run() {
+    common::trace::registerThread("replay");
+    common::ResourceMonitor::registerCurrentThread(common::ThreadRole::Capture);
+
+    // Same contract as a capture thread: no heap allocation, no locks
+    const common::RealtimeScope realtimeScope;
+
+    const auto& packets = m_reader.packets();
+    const bool paced = m_config.speed > 0.0;
+
+    do {
+        const auto startTime = std::chrono::steady_clock::now();
+        const std::uint64_t firstArrival = packets.front().info.arrivalNs;
+
+        for (const auto& packet : packets) {
+            if (!m_running.load(std::memory_order_relaxed)) {
+                return;
+            }
+
+            if (paced) {
+                const auto offset = std::chrono::nanoseconds(static_cast<std::int64_t>(
+                    static_cast<double>(packet.info.arrivalNs - firstArrival) / m_config.speed
+                ));
+                const auto due = startTime + offset;
+                std::this_thread::sleep_until(due);
+
+                const auto lateness = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now() - due
+                ).count();
+                if (lateness > 0 && static_cast<std::uint64_t>(lateness) > m_maxLatenessNs.load(std::memory_order_relaxed)) {
+                    m_maxLatenessNs.store(static_cast<std::uint64_t>(lateness), std::memory_order_relaxed);
+                }
+            }
+
+            deliver(packet);
+            m_packetsDelivered.fetch_add(1, std::memory_order_relaxed);
+        }
+    } while (m_config.loop && m_running.load(std::memory_order_relaxed));
+
+    m_running.store(false);
+}
+
+void ReplaySource::deliver(const CaptureTraceReader::Packet& packet) noexcept {
+    if (packet.info.frameCount == 0) {
+        return;
+    }
+
+    // Recorded device flags replay into the stats like live capture
+    if (m_stats) {
+        m_stats->recordPacket(packet.info.frameCount, packet.info.flags);
+    }
+
+    m_bufferPool.reset();
+
+    AudioBlock block;
+    block.data = packet.data;
+    block.sampleFormat = m_reader.sampleFormat();
+    block.frameCount = packet.info.frameCount;
+    block.format = m_reader.format();
+    block.captureTimeNs = common::monotonicNanos(); // Replayed "arrival"
+
+    // Silent packets carry no data, exactly like AUDCLNT_BUFFERFLAGS_SILENT
+    if (!packet.data) {
+        block.sampleFormat = SampleFormat::Float32;
+        block.silent = true;
+    }
+
+    m_dispatcher.dispatchBlock(block, m_bufferPool);
+}
+
+} // namespace openmeters::core::audio
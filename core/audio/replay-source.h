@@ -0,0 +1,96 @@
+#pragma once
+
+#include "audio-source.h"
+#include "callback-dispatcher.h"
+#include "capture-trace.h"
+#include "../../common/buffer-pool.h"
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
+
+namespace openmeters::core::audio {
+
+/**
+ * Replay settings.
+ */
+struct ReplaySourceConfig {
+    std::string tracePath;   // Capture trace recorded with CaptureTraceWriter
+    double speed = 1.0;      // 1.0 = recorded timing, 4.0 = four times faster, 0 = no pacing
+    bool loop = false;       // Restart from the first packet at the end of the trace
+};
+
+/**
+ * Drives callbacks with a recorded capture trace: same packet sizes, flags,
+ * gaps and (scaled) arrival times as the original WASAPI session, so
+ * end-to-end latency and CPU cost can be measured deterministically on
+ * machines without an audio device.
+ *
+ * Thread safety: start/stop/shutdown from one control thread.
+ * Callbacks run on the replay thread.
+ */
+class ReplaySource : public IAudioSource {
+public:
+    explicit ReplaySource(const ReplaySourceConfig& config);
+    ~ReplaySource() override;
+
+    // Non-copyable, non-movable
+    ReplaySource(const ReplaySource&) = delete;
+    ReplaySource& operator=(const ReplaySource&) = delete;
+    ReplaySource(ReplaySource&&) = delete;
+    ReplaySource& operator=(ReplaySource&&) = delete;
+
+    bool initialize() override;
+    bool start() override;
+    void stop() override;
+    void shutdown() override;
+
+    [[nodiscard]] common::AudioFormat getFormat() const override;
+    [[nodiscard]] bool isCapturing() const override;
+
+    void registerCallback(IAudioDataCallback* callback) override;
+    void unregisterCallback(IAudioDataCallback* callback) override;
+    void setStatsCollector(StatsCollector* stats) override;
+
+    /**
+     * Packets delivered since start().
+     */
+    [[nodiscard]] std::uint64_t packetsDelivered() const noexcept;
+
+    /**
+     * Worst delay between a packet's scheduled replay time and its delivery
+     * (paced replay only), in nanoseconds.
+     */
+    [[nodiscard]] std::uint64_t maxLatenessNs() const noexcept;
+
+    /**
+     * Packets in the loaded trace.
+     */
+    [[nodiscard]] std::size_t packetCount() const noexcept { return m_reader.packets().size(); }
+
+private:
+    /**
+     * Replay thread: wait for each packet's arrival time, then dispatch it.
+     */
+    void run();
+
+    /**
+     * Deliver one recorded packet to the callbacks.
+     */
+    void deliver(const CaptureTraceReader::Packet& packet) noexcept;
+
+    ReplaySourceConfig m_config;
+    CaptureTraceReader m_reader;
+    bool m_initialized = false;
+
+    std::thread m_thread;
+    std::atomic<bool> m_running{false};
+    std::atomic<std::uint64_t> m_packetsDelivered{0};
+    std::atomic<std::uint64_t> m_maxLatenessNs{0};
+
+    common::BufferPool m_bufferPool{common::MemoryTag::Audio};
+    CallbackDispatcher m_dispatcher;
+    StatsCollector* m_stats = nullptr;
+};
+
+} // namespace openmeters::core::audio
@@ -0,0 +1,510 @@
+#include "stream-source.h"
+#include "../../common/clock.h"
+#include "../../common/logger.h"
+#include "../../common/realtime-scope.h"
+#include "../../common/resource-monitor.h"
+#include "../../common/trace.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace openmeters::core::audio {
+
+namespace {
+
+// Float conversion plus callback scratch per packet (matches WasapiCapture)
+constexpr std::size_t kPacketArenaBlocks = 4;
+
+// Longest a blocked read waits before checking for stop()
+constexpr int kPollIntervalMs = 250;
+
+constexpr std::uint16_t kFormatPcm = 1;
+constexpr std::uint16_t kFormatIeeeFloat = 3;
+constexpr std::uint16_t kFormatExtensible = 0xFFFE;
+constexpr std::uint32_t kUnknownSize32 = 0xFFFFFFFFu;
+
+std::uint16_t readU16(const std::uint8_t* p) noexcept {
+    return static_cast<std::uint16_t>(p[0] | (p[1] << 8));
+}
+
+std::uint32_t readU32(const std::uint8_t* p) noexcept {
+    return static_cast<std::uint32_t>(p[0]) | (static_cast<std::uint32_t>(p[1]) << 8) |
+           (static_cast<std::uint32_t>(p[2]) << 16) | (static_cast<std::uint32_t>(p[3]) << 24);
+}
+
+std::uint64_t readU64(const std::uint8_t* p) noexcept {
+    return static_cast<std::uint64_t>(readU32(p)) | (static_cast<std::uint64_t>(readU32(p + 4)) << 32);
+}
+
+/**
+ * Sample encoding of a WAV fmt chunk (Unknown if unsupported).
+ */
+SampleFormat wavSampleFormat(std::uint16_t tag, std::uint16_t bits, std::uint16_t blockAlign, std::uint16_t channels) noexcept {
+    if (channels == 0 || blockAlign % channels != 0) {
+        return SampleFormat::Unknown;
+    }
+    const std::size_t container = blockAlign / channels;
+    if (tag == kFormatPcm) {
+        if (bits == 16 && container == 2) return SampleFormat::Int16;
+        if (bits == 24 && container == 3) return SampleFormat::Int24Packed;
+        if (bits > 16 && bits <= 32 && container == 4) return SampleFormat::Int32; // Includes 24-in-32, left-justified
+    } else if (tag == kFormatIeeeFloat) {
+        if (bits == 32 && container == 4) return SampleFormat::Float32;
+        if (bits == 64 && container == 8) return SampleFormat::Float64;
+    }
+    return SampleFormat::Unknown;
+}
+
+} // namespace
+
+StreamSource::StreamSource(const StreamSourceConfig& config)
+    : m_config(config)
+{
+}
+
+StreamSource::~StreamSource() {
+    shutdown();
+}
+
+bool StreamSource::initialize() {
+    if (m_initialized) {
+        return true;
+    }
+
+    if (m_config.path.empty() || m_config.framesPerBlock == 0) {
+        return false;
+    }
+
+    if (!openStream()) {
+        LOG_ERROR("Failed to open audio stream: {}", m_config.path);
+        return false;
+    }
+
+    m_format = m_config.format;
+    m_sampleFormat = m_config.sampleFormat;
+    m_dataOffset = 0;
+    m_dataBytes = 0;
+    if (m_kind == StreamKind::File && !readWavHeader()) {
+        closeStream();
+        return false;
+    }
+
+    if (!m_format.isValid() || bytesPerSample(m_sampleFormat) == 0) {
+        LOG_ERROR("Unsupported stream format ({} Hz, {} channel(s)): {}",
+                  m_format.sampleRate, m_format.channelCount, m_config.path);
+        closeStream();
+        return false;
+    }
+
+    const std::size_t samples = m_config.framesPerBlock * m_format.samplesPerFrame();
+    m_block.assign(samples * bytesPerSample(m_sampleFormat), 0);
+    m_blockFill = 0;
+    m_dataRemaining = m_dataBytes;
+    if (!m_bufferPool.reserve(kPacketArenaBlocks * (samples * sizeof(float) + common::BufferPool::kDefaultAlignment))) {
+        closeStream();
+        return false;
+    }
+
+    m_initialized = true;
+    return true;
+}
+
+bool StreamSource::start() {
+    if (m_running.load()) {
+        return true; // Already running
+    }
+
+    if (!m_initialized) {
+        return false;
+    }
+
+    // Join a thread that finished on its own (end of stream)
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+
+    m_blocksDelivered.store(0);
+    m_running.store(true);
+#ifdef _WIN32
+    m_threadExited.store(false);
+#endif
+    m_thread = std::thread(&StreamSource::run, this);
+    return true;
+}
+
+void StreamSource::stop() {
+    m_running.store(false);
+#ifdef _WIN32
+    // Pipe reads block without a timeout: cancel them until the thread notices
+    while (m_thread.joinable() && !m_threadExited.load()) {
+        CancelIoEx(m_handle, nullptr);
+        Sleep(10);
+    }
+#endif
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+}
+
+void StreamSource::shutdown() {
+    stop();
+    closeStream();
+    m_dispatcher.clear();
+    m_bufferPool.release();
+    m_initialized = false;
+}
+
+common::AudioFormat StreamSource::getFormat() const {
+    return m_format;
+}
+
+bool StreamSource::isCapturing() const {
+    return m_running.load();
+}
+
+void StreamSource::registerCallback(IAudioDataCallback* callback) {
+    m_dispatcher.add(callback);
+}
+
+void StreamSource::unregisterCallback(IAudioDataCallback* callback) {
+    m_dispatcher.remove(callback);
+}
+
+void StreamSource::setStatsCollector(StatsCollector* stats) {
+    m_stats = stats;
+    m_dispatcher.setStatsCollector(stats);
+}
+
+std::uint64_t StreamSource::blocksDelivered() const noexcept {
+    return m_blocksDelivered.load(std::memory_order_relaxed);
+}
+
+std::uint64_t StreamSource::reconnects() const noexcept {
+    return m_reconnects.load(std::memory_order_relaxed);
+}
+
+void StreamSource::run() {
+    common::trace::registerThread("stream");
+    common::ResourceMonitor::registerCurrentThread(common::ThreadRole::Capture);
+
+    // Same contract as a capture thread: no heap allocation, no locks
+    const common::RealtimeScope realtimeScope;
+
+    const std::size_t frameBytes = bytesPerSample(m_sampleFormat) * m_format.samplesPerFrame();
+    const bool paced = m_kind == StreamKind::File && m_config.paced;
+    const double secondsPerFrame = 1.0 / static_cast<double>(m_format.sampleRate);
+    auto deadline = std::chrono::steady_clock::now();
+
+    AudioBlock block;
+    block.sampleFormat = m_sampleFormat;
+    block.format = m_format;
+    block.data = m_block.data();
+
+    const auto deliver = [&](std::size_t frames) noexcept {
+        block.frameCount = frames;
+        block.captureTimeNs = common::monotonicNanos();
+        if (m_stats) {
+            m_stats->recordPacket(frames, 0);
+        }
+        m_bufferPool.reset();
+        m_dispatcher.dispatchBlock(block, m_bufferPool);
+        m_blocksDelivered.fetch_add(1, std::memory_order_relaxed);
+
+        if (paced) {
+            deadline += std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                std::chrono::duration<double>(static_cast<double>(frames) * secondsPerFrame)
+            );
+            std::this_thread::sleep_until(deadline);
+        }
+    };
+
+    bool receivedData = false; // Since the stream was (re)opened or rewound
+    while (m_running.load(std::memory_order_relaxed)) {
+        std::size_t wanted = m_block.size() - m_blockFill;
+        if (m_dataBytes != 0) {
+            wanted = static_cast<std::size_t>(std::min<std::uint64_t>(wanted, m_dataRemaining));
+        }
+
+        const std::ptrdiff_t got = wanted == 0 ? 0 : readSome(m_block.data() + m_blockFill, wanted);
+        if (got == kReadIdle) {
+            continue;
+        }
+        if (got == kReadError) {
+            m_running.store(false);
+            break;
+        }
+
+        if (got == 0) {
+            // Deliver the whole frames of a partial block; a torn frame is dropped
+            const std::size_t frames = m_blockFill / frameBytes;
+            m_blockFill = 0;
+            if (frames > 0) {
+                deliver(frames);
+            }
+            if (!handleEndOfStream(receivedData)) {
+                m_running.store(false);
+                break;
+            }
+            receivedData = false;
+            if (m_kind != StreamKind::File) {
+                deadline = std::chrono::steady_clock::now();
+            }
+            continue;
+        }
+
+        receivedData = true;
+        m_blockFill += static_cast<std::size_t>(got);
+        if (m_dataBytes != 0) {
+            m_dataRemaining -= static_cast<std::uint64_t>(got);
+        }
+        if (m_blockFill == m_block.size()) {
+            m_blockFill = 0;
+            deliver(m_config.framesPerBlock);
+        }
+    }
+
+#ifdef _WIN32
+    m_threadExited.store(true);
+#endif
+}
+
+bool StreamSource::handleEndOfStream(bool receivedData) noexcept {
+    switch (m_kind) {
+        case StreamKind::File:
+            // An empty file would loop without delivering anything
+            if (!m_config.loop || !receivedData || !rewind()) {
+                return false;
+            }
+            m_dataRemaining = m_dataBytes;
+            return true;
+
+        case StreamKind::Fifo:
+            m_reconnects.fetch_add(1, std::memory_order_relaxed);
+            while (m_running.load(std::memory_order_relaxed)) {
+                // Where a reopened FIFO reports end of stream again right away,
+                // this keeps an absent writer from spinning the thread
+                if (!receivedData) {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(kPollIntervalMs));
+                }
+                if (openStream()) {
+                    return true;
+                }
+                receivedData = false;
+            }
+            return false;
+
+        case StreamKind::Pipe:
+        default:
+            return false;
+    }
+}
+
+bool StreamSource::readWavHeader() {
+    std::uint64_t position = 0;
+    const auto readExact = [&](std::uint8_t* dest, std::size_t size) {
+        std::size_t done = 0;
+        while (done < size) {
+            const std::ptrdiff_t got = readSome(dest + done, size - done);
+            if (got <= 0) {
+                return false;
+            }
+            done += static_cast<std::size_t>(got);
+        }
+        position += size;
+        return true;
+    };
+    const auto skip = [&](std::uint64_t size) {
+        std::uint8_t scratch[256];
+        while (size > 0) {
+            const auto step = static_cast<std::size_t>(std::min<std::uint64_t>(size, sizeof(scratch)));
+            if (!readExact(scratch, step)) {
+                return false;
+            }
+            size -= step;
+        }
+        return true;
+    };
+
+    std::uint8_t riff[12];
+    const bool isRiff = readExact(riff, sizeof(riff)) &&
+                        (std::memcmp(riff, "RIFF", 4) == 0 || std::memcmp(riff, "RF64", 4) == 0) &&
+                        std::memcmp(riff + 8, "WAVE", 4) == 0;
+    if (!isRiff) {
+        return rewind(); // Raw PCM from the first byte
+    }
+
+    const bool rf64 = std::memcmp(riff, "RF64", 4) == 0;
+    std::uint64_t ds64DataBytes = 0;
+    bool haveFormat = false;
+    for (;;) {
+        std::uint8_t chunk[8];
+        if (!readExact(chunk, sizeof(chunk))) {
+            LOG_ERROR("WAV file has no data chunk: {}", m_config.path);
+            return false;
+        }
+        const std::uint32_t size = readU32(chunk + 4);
+
+        if (std::memcmp(chunk, "fmt ", 4) == 0) {
+            std::uint8_t fmt[40] = {};
+            const std::size_t used = std::min<std::size_t>(size, sizeof(fmt));
+            if (size < 16 || !readExact(fmt, used) || !skip(size - used + (size & 1))) {
+                return false;
+            }
+            std::uint16_t tag = readU16(fmt);
+            if (tag == kFormatExtensible && size >= 40) {
+                tag = readU16(fmt + 24); // First two bytes of the SubFormat GUID
+            }
+            m_format.channelCount = readU16(fmt + 2);
+            m_format.sampleRate = readU32(fmt + 4);
+            m_sampleFormat = wavSampleFormat(tag, readU16(fmt + 14), readU16(fmt + 12), readU16(fmt + 2));
+            if (m_sampleFormat == SampleFormat::Unknown) {
+                LOG_ERROR("Unsupported WAV sample format (tag {}, {} bits): {}", tag, readU16(fmt + 14), m_config.path);
+                return false;
+            }
+            haveFormat = true;
+        } else if (std::memcmp(chunk, "ds64", 4) == 0) {
+            std::uint8_t ds64[16] = {};
+            const std::size_t used = std::min<std::size_t>(size, sizeof(ds64));
+            if (!readExact(ds64, used) || !skip(size - used + (size & 1))) {
+                return false;
+            }
+            ds64DataBytes = readU64(ds64 + 8);
+        } else if (std::memcmp(chunk, "data", 4) == 0) {
+            if (!haveFormat) {
+                LOG_ERROR("WAV data chunk before fmt chunk: {}", m_config.path);
+                return false;
+            }
+            m_dataOffset = position;
+            // An unfinished recording has no size yet: read to the end of the file
+            m_dataBytes = (rf64 && size == kUnknownSize32) ? ds64DataBytes : (size == kUnknownSize32 ? 0 : size);
+            return true;
+        } else if (!skip(static_cast<std::uint64_t>(size) + (size & 1))) {
+            return false;
+        }
+    }
+}
+
+#ifdef _WIN32
+
+bool StreamSource::openStream() {
+    const bool isStdin = m_config.path == "-";
+    HANDLE handle = isStdin ? GetStdHandle(STD_INPUT_HANDLE)
+                            : CreateFileA(m_config.path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE,
+                                          nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (handle == INVALID_HANDLE_VALUE || handle == nullptr) {
+        return false;
+    }
+
+    closeStream();
+    m_handle = handle;
+    m_ownsHandle = !isStdin;
+
+    switch (GetFileType(m_handle)) {
+        case FILE_TYPE_DISK: m_kind = StreamKind::File; break;
+        case FILE_TYPE_PIPE: m_kind = m_ownsHandle ? StreamKind::Fifo : StreamKind::Pipe; break;
+        default:             m_kind = StreamKind::Pipe; break;
+    }
+    return true;
+}
+
+void StreamSource::closeStream() noexcept {
+    if (m_handle && m_ownsHandle) {
+        CloseHandle(m_handle);
+    }
+    m_handle = nullptr;
+}
+
+std::ptrdiff_t StreamSource::readSome(std::uint8_t* dest, std::size_t size) noexcept {
+    DWORD got = 0;
+    if (!ReadFile(m_handle, dest, static_cast<DWORD>(std::min<std::size_t>(size, 1u << 30)), &got, nullptr)) {
+        const DWORD error = GetLastError();
+        if (error == ERROR_BROKEN_PIPE || error == ERROR_HANDLE_EOF) {
+            return 0;
+        }
+        return error == ERROR_OPERATION_ABORTED ? kReadIdle : kReadError;
+    }
+    return static_cast<std::ptrdiff_t>(got);
+}
+
+bool StreamSource::rewind() noexcept {
+    LARGE_INTEGER offset;
+    offset.QuadPart = static_cast<LONGLONG>(m_dataOffset);
+    return SetFilePointerEx(m_handle, offset, nullptr, FILE_BEGIN) != 0;
+}
+
+#else
+
+bool StreamSource::openStream() {
+    int fd = STDIN_FILENO;
+    if (m_config.path != "-") {
+        // Non-blocking, so opening a FIFO does not wait for a writer
+        fd = ::open(m_config.path.c_str(), O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+        if (fd < 0) {
+            return false;
+        }
+    }
+
+    // A FIFO is reopened before the old descriptor is closed: with no reader
+    // at all the kernel would discard what a new writer already wrote
+    closeStream();
+    m_fd = fd;
+    m_ownsFd = fd != STDIN_FILENO;
+
+    struct stat info {};
+    if (fstat(m_fd, &info) != 0) {
+        closeStream();
+        return false;
+    }
+    if (S_ISREG(info.st_mode)) {
+        m_kind = StreamKind::File;
+    } else if (S_ISFIFO(info.st_mode) && m_ownsFd) {
+        m_kind = StreamKind::Fifo;
+    } else {
+        m_kind = StreamKind::Pipe;
+    }
+    return true;
+}
+
+void StreamSource::closeStream() noexcept {
+    if (m_fd >= 0 && m_ownsFd) {
+        ::close(m_fd);
+    }
+    m_fd = -1;
+}
+
+std::ptrdiff_t StreamSource::readSome(std::uint8_t* dest, std::size_t size) noexcept {
+    if (m_kind != StreamKind::File) {
+        pollfd descriptor{m_fd, POLLIN, 0};
+        const int ready = poll(&descriptor, 1, kPollIntervalMs);
+        if (ready == 0) {
+            return kReadIdle;
+        }
+        if (ready < 0) {
+            return errno == EINTR ? kReadIdle : kReadError;
+        }
+    }
+
+    const ssize_t got = ::read(m_fd, dest, size);
+    if (got < 0) {
+        return (errno == EINTR || errno == EAGAIN || errno == EWOULDBLOCK) ? kReadIdle : kReadError;
+    }
+    return static_cast<std::ptrdiff_t>(got);
+}
+
+bool StreamSource::rewind() noexcept {
+    return lseek(m_fd, static_cast<off_t>(m_dataOffset), SEEK_SET) == static_cast<off_t>(m_dataOffset);
+}
+
+#endif
+
+} // namespace openmeters::core::audio
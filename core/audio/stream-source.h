@@ -0,0 +1,169 @@
+#pragma once
+
+#include "audio-source.h"
+#include "callback-dispatcher.h"
+#include "format-convert.h"
+#include "../../common/buffer-pool.h"
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace openmeters::core::audio {
+
+/**
+ * Stream input settings.
+ */
+struct StreamSourceConfig {
+    std::string path;                                    // WAV or raw PCM file, FIFO (named pipe), or "-" for stdin
+    common::AudioFormat format;                          // Raw PCM only (WAV files carry their own)
+    SampleFormat sampleFormat = SampleFormat::Float32;   // Raw PCM only
+    std::size_t framesPerBlock = 480;                    // Packet size (10 ms at 48 kHz)
+    bool paced = true;                                   // Files at real-time rate; false = as fast as possible
+    bool loop = false;                                   // Files: start over at the end instead of stopping
+};
+
+/**
+ * Portable audio source reading interleaved PCM from a file or a pipe, for
+ * headless use where there is no capture device (servers, containers):
+ * a player or encoder writes into a FIFO, or a WAV file is metered at
+ * real-time rate.
+ *
+ * - Regular files: WAV (RIFF/RF64; PCM, float or extensible) or raw PCM in
+ *   the configured format, paced to the sample rate. At the end the source
+ *   loops or stops.
+ * - FIFOs and stdin: raw PCM only, delivered as fast as the writer
+ *   produces it. When the writer of a FIFO goes away the source waits for
+ *   the next one; stdin stops at end of input.
+ *
+ * While a pipe has no data the source thread blocks in the kernel (woken
+ * periodically to notice stop()), so an idle stream costs no CPU.
+ *
+ * Thread safety: start/stop/shutdown from one control thread.
+ * Callbacks run on the source thread.
+ */
+class StreamSource : public IAudioSource {
+public:
+    explicit StreamSource(const StreamSourceConfig& config);
+    ~StreamSource() override;
+
+    // Non-copyable, non-movable
+    StreamSource(const StreamSource&) = delete;
+    StreamSource& operator=(const StreamSource&) = delete;
+    StreamSource(StreamSource&&) = delete;
+    StreamSource& operator=(StreamSource&&) = delete;
+
+    /**
+     * Open the stream and read the WAV header, if any. Opening a FIFO does
+     * not wait for a writer.
+     */
+    bool initialize() override;
+    bool start() override;
+    void stop() override;
+    void shutdown() override;
+
+    [[nodiscard]] common::AudioFormat getFormat() const override;
+    [[nodiscard]] bool isCapturing() const override;
+
+    void registerCallback(IAudioDataCallback* callback) override;
+    void unregisterCallback(IAudioDataCallback* callback) override;
+    void setStatsCollector(StatsCollector* stats) override;
+
+    /**
+     * Sample encoding of delivered packets (from the WAV header or config).
+     */
+    [[nodiscard]] SampleFormat sampleFormat() const noexcept { return m_sampleFormat; }
+
+    /**
+     * Packets delivered since start().
+     */
+    [[nodiscard]] std::uint64_t blocksDelivered() const noexcept;
+
+    /**
+     * Times a FIFO writer went away and the source waited for a new one.
+     */
+    [[nodiscard]] std::uint64_t reconnects() const noexcept;
+
+private:
+    enum class StreamKind {
+        File,  // Seekable: paced, may loop
+        Fifo,  // Named pipe: reopened when the writer goes away
+        Pipe   // Stdin or an anonymous pipe: ends at end of input
+    };
+
+    // Result of readSome() besides a byte count
+    static constexpr std::ptrdiff_t kReadIdle = -1;  // Nothing yet (timeout); check m_running and retry
+    static constexpr std::ptrdiff_t kReadError = -2; // Unrecoverable
+
+    /**
+     * Source thread: fill a block, dispatch, pace.
+     */
+    void run();
+
+    /**
+     * Open m_config.path and classify it, replacing the current stream
+     * only once the new one is open.
+     */
+    bool openStream();
+
+    void closeStream() noexcept;
+
+    /**
+     * Parse a WAV header at the start of a regular file and position the
+     * stream at the first sample. Raw files are left at offset 0.
+     */
+    bool readWavHeader();
+
+    /**
+     * Read up to size bytes, waiting at most one poll interval.
+     *
+     * @return Bytes read, 0 at end of stream, kReadIdle or kReadError
+     */
+    std::ptrdiff_t readSome(std::uint8_t* dest, std::size_t size) noexcept;
+
+    /**
+     * Seek a file back to the first sample.
+     */
+    bool rewind() noexcept;
+
+    /**
+     * After end of stream: loop, reopen a FIFO, or stop.
+     *
+     * @return true to keep reading
+     */
+    bool handleEndOfStream(bool receivedData) noexcept;
+
+    StreamSourceConfig m_config;
+    common::AudioFormat m_format;
+    SampleFormat m_sampleFormat = SampleFormat::Unknown;
+    StreamKind m_kind = StreamKind::File;
+    std::uint64_t m_dataOffset = 0;     // First sample (after the WAV header)
+    std::uint64_t m_dataBytes = 0;      // Sample bytes per WAV data chunk (0 = to end of file)
+    std::uint64_t m_dataRemaining = 0;  // Left in the current pass (with m_dataBytes)
+    bool m_initialized = false;
+
+#ifdef _WIN32
+    void* m_handle = nullptr;
+    bool m_ownsHandle = false;
+    std::atomic<bool> m_threadExited{true}; // Lets stop() cancel blocking pipe reads until the thread is out
+#else
+    int m_fd = -1;
+    bool m_ownsFd = false;
+#endif
+
+    std::thread m_thread;
+    std::atomic<bool> m_running{false};
+    std::atomic<std::uint64_t> m_blocksDelivered{0};
+    std::atomic<std::uint64_t> m_reconnects{0};
+
+    // Preallocated at initialize(); the source thread never allocates
+    std::vector<std::uint8_t> m_block;
+    std::size_t m_blockFill = 0; // Bytes of m_block read so far (kept across stop/start)
+    common::BufferPool m_bufferPool{common::MemoryTag::Audio};
+
+    CallbackDispatcher m_dispatcher;
+    StatsCollector* m_stats = nullptr;
+};
+
+} // namespace openmeters::core::audio
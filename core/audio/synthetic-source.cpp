@@ -0,0 +1,173 @@
+#include "synthetic-source.h"
+#include "../../common/clock.h"
+#include "../../common/realtime-scope.h"
+#include "../../common/resource-monitor.h"
+#include "../../common/trace.h"
+#include <chrono>
+#include <cmath>
+
+namespace openmeters::core::audio {
+
+namespace {
+
+constexpr double kTwoPi = 6.283185307179586;
+
+// Float conversion plus callback scratch per packet (matches WasapiCapture)
+constexpr std::size_t kPacketArenaBlocks = 4;
+
+} // namespace
+
+SyntheticSource::SyntheticSource(const SyntheticSourceConfig& config)
+    : m_config(config)
+{
+}
+
+SyntheticSource::~SyntheticSource() {
+    shutdown();
+}
+
+bool SyntheticSource::initialize() {
+    if (m_initialized) {
+        return true;
+    }
+
+    if (!m_config.format.isValid() || m_config.framesPerBlock == 0 ||
+        bytesPerSample(m_config.sampleFormat) == 0) {
+        return false;
+    }
+
+    const std::size_t samples = m_config.framesPerBlock * m_config.format.samplesPerFrame();
+    m_floatBlock.assign(samples, 0.0f);
+    m_nativeBlock.assign(samples * bytesPerSample(m_config.sampleFormat), 0);
+    if (!m_bufferPool.reserve(kPacketArenaBlocks * (samples * sizeof(float) + common::BufferPool::kDefaultAlignment))) {
+        return false;
+    }
+
+    m_initialized = true;
+    return true;
+}
+
+bool SyntheticSource::start() {
+    if (m_running.load()) {
+        return true; // Already running
+    }
+
+    if (!m_initialized) {
+        return false;
+    }
+
+    // Join a thread that finished on its own (block limit reached)
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+
+    m_blocksDelivered.store(0);
+    m_running.store(true);
+    m_thread = std::thread(&SyntheticSource::run, this);
+    return true;
+}
+
+void SyntheticSource::stop() {
+    m_running.store(false);
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+}
+
+void SyntheticSource::shutdown() {
+    stop();
+    m_dispatcher.clear();
+    m_bufferPool.release();
+    m_initialized = false;
+}
+
+common::AudioFormat SyntheticSource::getFormat() const {
+    return m_config.format;
+}
+
+bool SyntheticSource::isCapturing() const {
+    return m_running.load();
+}
+
+void SyntheticSource::registerCallback(IAudioDataCallback* callback) {
+    m_dispatcher.add(callback);
+}
+
+void SyntheticSource::unregisterCallback(IAudioDataCallback* callback) {
+    m_dispatcher.remove(callback);
+}
+
+void SyntheticSource::setStatsCollector(StatsCollector* stats) {
+    m_stats = stats;
+    m_dispatcher.setStatsCollector(stats);
+}
+
+std::uint64_t SyntheticSource::blocksDelivered() const noexcept {
+    return m_blocksDelivered.load(std::memory_order_relaxed);
+}
+
+void SyntheticSource::run() {
+    common::trace::registerThread("synthetic");
+    common::ResourceMonitor::registerCurrentThread(common::ThreadRole::Capture);
+
+    // Same contract as a capture thread: no heap allocation, no locks
+    const common::RealtimeScope realtimeScope;
+
+    const auto blockPeriod = std::chrono::duration<double>(
+        static_cast<double>(m_config.framesPerBlock) / static_cast<double>(m_config.format.sampleRate)
+    );
+    auto deadline = std::chrono::steady_clock::now();
+
+    AudioBlock block;
+    block.sampleFormat = m_config.sampleFormat;
+    block.frameCount = m_config.framesPerBlock;
+    block.format = m_config.format;
+
+    while (m_running.load(std::memory_order_relaxed)) {
+        generateBlock();
+        block.captureTimeNs = common::monotonicNanos();
+
+        if (m_config.sampleFormat == SampleFormat::Float32) {
+            block.data = m_floatBlock.data();
+        } else {
+            convertFromFloat32(m_floatBlock.data(), m_nativeBlock.data(), m_config.sampleFormat, m_floatBlock.size());
+            block.data = m_nativeBlock.data();
+        }
+
+        if (m_stats) {
+            m_stats->recordPacket(block.frameCount, 0);
+        }
+
+        m_bufferPool.reset();
+        m_dispatcher.dispatchBlock(block, m_bufferPool);
+
+        const std::uint64_t delivered = m_blocksDelivered.fetch_add(1, std::memory_order_relaxed) + 1;
+        if (m_config.blockLimit != 0 && delivered >= m_config.blockLimit) {
+            m_running.store(false);
+            break;
+        }
+
+        if (m_config.paced) {
+            deadline += std::chrono::duration_cast<std::chrono::steady_clock::duration>(blockPeriod);
+            std::this_thread::sleep_until(deadline);
+        }
+    }
+}
+
+void SyntheticSource::generateBlock() noexcept {
+    const std::size_t channels = m_config.format.samplesPerFrame();
+    const double step = kTwoPi * m_config.frequencyHz / static_cast<double>(m_config.format.sampleRate);
+
+    for (std::size_t frame = 0; frame < m_config.framesPerBlock; ++frame) {
+        const float value = m_config.amplitude * static_cast<float>(std::sin(m_phase));
+        for (std::size_t ch = 0; ch < channels; ++ch) {
+            m_floatBlock[frame * channels + ch] = value;
+        }
+        m_phase += step;
+        if (m_phase >= kTwoPi) {
+            m_phase -= kTwoPi;
+        }
+    }
+}
+
+} // namespace openmeters::core::audio
@@ -0,0 +1,91 @@
+#pragma once
+
+#include "audio-source.h"
+#include "callback-dispatcher.h"
+#include "format-convert.h"
+#include "../../common/buffer-pool.h"
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace openmeters::core::audio {
+
+/**
+ * Synthetic signal settings.
+ */
+struct SyntheticSourceConfig {
+    common::AudioFormat format;                          // Rate and channel layout
+    SampleFormat sampleFormat = SampleFormat::Float32;   // Encoding of delivered packets
+    std::size_t framesPerBlock = 480;                    // Packet size (10 ms at 48 kHz)
+    double frequencyHz = 1000.0;                         // Sine frequency
+    float amplitude = 0.5f;                              // Peak amplitude (linear)
+    std::uint64_t blockLimit = 0;                        // Stop after N packets (0 = until stop())
+    bool paced = true;                                   // Real-time rate; false = as fast as possible
+};
+
+/**
+ * Portable audio source that generates a sine on its own real-time thread.
+ * Stands in for WASAPI on machines without an audio device (tests, CI,
+ * the RT sanitizer build) and delivers packets exactly like WasapiCapture.
+ *
+ * Thread safety: start/stop/shutdown from one control thread.
+ * Callbacks run on the source thread.
+ */
+class SyntheticSource : public IAudioSource {
+public:
+    explicit SyntheticSource(const SyntheticSourceConfig& config = {});
+    ~SyntheticSource() override;
+
+    // Non-copyable, non-movable
+    SyntheticSource(const SyntheticSource&) = delete;
+    SyntheticSource& operator=(const SyntheticSource&) = delete;
+    SyntheticSource(SyntheticSource&&) = delete;
+    SyntheticSource& operator=(SyntheticSource&&) = delete;
+
+    bool initialize() override;
+    bool start() override;
+    void stop() override;
+    void shutdown() override;
+
+    [[nodiscard]] common::AudioFormat getFormat() const override;
+    [[nodiscard]] bool isCapturing() const override;
+
+    void registerCallback(IAudioDataCallback* callback) override;
+    void unregisterCallback(IAudioDataCallback* callback) override;
+    void setStatsCollector(StatsCollector* stats) override;
+
+    /**
+     * Number of packets delivered since start().
+     */
+    [[nodiscard]] std::uint64_t blocksDelivered() const noexcept;
+
+private:
+    /**
+     * Source thread: generate, convert, dispatch, pace.
+     */
+    void run();
+
+    /**
+     * Fill m_floatBlock with the next block of the sine.
+     */
+    void generateBlock() noexcept;
+
+    SyntheticSourceConfig m_config;
+    bool m_initialized = false;
+
+    std::thread m_thread;
+    std::atomic<bool> m_running{false};
+    std::atomic<std::uint64_t> m_blocksDelivered{0};
+
+    // Preallocated at initialize(); the source thread never allocates
+    std::vector<float> m_floatBlock;
+    std::vector<std::uint8_t> m_nativeBlock;
+    common::BufferPool m_bufferPool{common::MemoryTag::Audio};
+    double m_phase = 0.0;
+
+    CallbackDispatcher m_dispatcher;
+    StatsCollector* m_stats = nullptr;
+};
+
+} // namespace openmeters::core::audio
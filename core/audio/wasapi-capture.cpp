@@ -3,11 +3,36 @@
 #ifdef _WIN32
 
 #include "../../common/types.h"
+#include "../../common/clock.h"
+#include "../../common/realtime-scope.h"
+#include "../../common/resource-monitor.h"
+#include "../../common/trace.h"
+#include <mmreg.h>
 #include <algorithm>
 #include <cmath>
 
 namespace openmeters::core::audio {
 
+// Capture traces store WASAPI packet flags unchanged
+static_assert(CaptureFlags::DataDiscontinuity == AUDCLNT_BUFFERFLAGS_DATA_DISCONTINUITY);
+static_assert(CaptureFlags::Silent == AUDCLNT_BUFFERFLAGS_SILENT);
+static_assert(CaptureFlags::TimestampError == AUDCLNT_BUFFERFLAGS_TIMESTAMP_ERROR);
+
+namespace {
+
+/**
+ * The performance counter now, in the 100 ns units of GetBuffer's
+ * qpcPosition (split so the multiply cannot overflow).
+ */
+std::uint64_t qpcNow100ns(std::uint64_t frequency) noexcept {
+    LARGE_INTEGER counter;
+    QueryPerformanceCounter(&counter);
+    const auto ticks = static_cast<std::uint64_t>(counter.QuadPart);
+    return ticks / frequency * 10000000 + ticks % frequency * 10000000 / frequency;
+}
+
+} // namespace
+
 WasapiCapture::WasapiCapture() = default;
 
 WasapiCapture::~WasapiCapture() {
@@ -69,9 +94,9 @@ bool WasapiCapture::initialize() {
         return false;
     }
     
-    // Validate format (must be PCM or float)
-    if (m_waveFormat->wFormatTag != WAVE_FORMAT_PCM &&
-        m_waveFormat->wFormatTag != WAVE_FORMAT_IEEE_FLOAT) {
+    // Validate format (PCM or float, plain or WAVE_FORMAT_EXTENSIBLE)
+    m_sampleFormat = resolveSampleFormat(m_waveFormat);
+    if (m_sampleFormat == SampleFormat::Unknown) {
         CoTaskMemFree(m_waveFormat);
         m_waveFormat = nullptr;
         releaseCom();
@@ -107,6 +132,19 @@ bool WasapiCapture::initialize() {
         return false;
     }
     
+    // Size the packet arena from the endpoint buffer: a packet never exceeds it
+    hr = m_audioClient->GetBufferSize(&m_maxFramesPerPacket);
+    if (FAILED(hr) || m_maxFramesPerPacket == 0) {
+        releaseCom();
+        return false;
+    }
+    
+    const std::size_t maxSamples = static_cast<std::size_t>(m_maxFramesPerPacket) * m_format.samplesPerFrame();
+    if (!m_bufferPool.reserve(kPacketArenaBlocks * (maxSamples * sizeof(float) + common::BufferPool::kDefaultAlignment))) {
+        releaseCom();
+        return false;
+    }
+    
     // Get capture client
     hr = m_audioClient->GetService(
         __uuidof(IAudioCaptureClient),
@@ -139,9 +177,15 @@ bool WasapiCapture::start() {
     // Reset stop event
     ResetEvent(m_stopEvent);
     
+    if (!m_tracePath.empty() && !m_traceWriter.open(m_tracePath, m_sampleFormat, m_format)) {
+        return false;
+    }
+    m_captureStart = std::chrono::steady_clock::now();
+    
     // Start audio client
     HRESULT hr = m_audioClient->Start();
     if (FAILED(hr)) {
+        m_traceWriter.close();
         return false;
     }
     
@@ -159,6 +203,7 @@ bool WasapiCapture::start() {
     if (!m_captureThread) {
         m_audioClient->Stop();
         m_capturing.store(false);
+        m_traceWriter.close();
         return false;
     }
     
@@ -191,6 +236,9 @@ void WasapiCapture::stop() {
         CloseHandle(m_captureThread);
         m_captureThread = nullptr;
     }
+    
+    // Capture thread has exited: flush the trace
+    m_traceWriter.close();
 }
 
 void WasapiCapture::shutdown() {
@@ -214,24 +262,20 @@ bool WasapiCapture::isCapturing() const {
 }
 
 void WasapiCapture::registerCallback(IAudioDataCallback* callback) {
-    if (!callback) {
-        return;
-    }
-    
-    std::lock_guard<std::mutex> lock(m_callbackMutex);
-    m_callbacks.push_back(callback);
+    m_dispatcher.add(callback);
 }
 
 void WasapiCapture::unregisterCallback(IAudioDataCallback* callback) {
-    if (!callback) {
-        return;
-    }
-    
-    std::lock_guard<std::mutex> lock(m_callbackMutex);
-    m_callbacks.erase(
-        std::remove(m_callbacks.begin(), m_callbacks.end(), callback),
-        m_callbacks.end()
-    );
+    m_dispatcher.remove(callback);
+}
+
+void WasapiCapture::setStatsCollector(StatsCollector* stats) {
+    m_stats = stats;
+    m_dispatcher.setStatsCollector(stats);
+}
+
+void WasapiCapture::setTraceRecording(const std::string& path) {
+    m_tracePath = path;
 }
 
 DWORD WINAPI WasapiCapture::captureThreadProc(LPVOID lpParam) {
@@ -243,9 +287,18 @@ DWORD WINAPI WasapiCapture::captureThreadProc(LPVOID lpParam) {
 }
 
 void WasapiCapture::captureThread() {
+    common::trace::registerThread("capture");
+    common::ResourceMonitor::registerCurrentThread(common::ThreadRole::Capture);
+    
+    // Everything below runs on the real-time path: no heap allocation
+    const common::RealtimeScope realtimeScope;
+    
     const HANDLE waitArray[] = { m_stopEvent };
     const DWORD waitCount = 1;
     
+    LARGE_INTEGER qpcFrequency;
+    QueryPerformanceFrequency(&qpcFrequency);
+    
     while (m_capturing.load()) {
         // Wait for data or stop signal (100ms timeout)
         DWORD waitResult = WaitForMultipleObjects(
@@ -267,22 +320,37 @@ void WasapiCapture::captureThread() {
         UINT64 devicePosition = 0;
         UINT64 qpcPosition = 0;
         
-        HRESULT hr = m_captureClient->GetBuffer(
-            &pData,
-            &numFramesAvailable,
-            &flags,
-            &devicePosition,
-            &qpcPosition
-        );
+        HRESULT hr;
+        {
+            TRACE_ZONE("GetBuffer");
+            hr = m_captureClient->GetBuffer(
+                &pData,
+                &numFramesAvailable,
+                &flags,
+                &devicePosition,
+                &qpcPosition
+            );
+        }
         
         if (FAILED(hr)) {
-            if (hr == AUDCLNT_E_BUFFER_ERROR) {
-                // Buffer lost, try to recover by releasing any partial buffer
-                // Note: GetBuffer failed, so we don't have a valid buffer to release
-                // Just continue and try again on next iteration
+            // No buffer was returned, so there is nothing to release; count
+            // the failure (AUDCLNT_E_BUFFER_ERROR etc.) for the stats log
+            // thread to report and retry next wakeup
+            if (m_stats) {
+                m_stats->recordGetBufferFailure(static_cast<std::uint32_t>(hr));
             }
             continue;
         }
+        // Date the packet when its first frame reached the endpoint buffer
+        // (qpcPosition), not when this poll got to it; the counter's age is
+        // carried over to the monotonicNanos() base
+        std::uint64_t captureTimeNs = common::monotonicNanos();
+        if (qpcPosition != 0 && !(flags & AUDCLNT_BUFFERFLAGS_TIMESTAMP_ERROR)) {
+            const std::uint64_t now = qpcNow100ns(static_cast<std::uint64_t>(qpcFrequency.QuadPart));
+            if (now > qpcPosition) {
+                captureTimeNs -= std::min(captureTimeNs, (now - qpcPosition) * 100);
+            }
+        }
         
         if (numFramesAvailable == 0) {
             // No data available, release buffer
@@ -290,9 +358,27 @@ void WasapiCapture::captureThread() {
             continue;
         }
         
+        // Discontinuities mark a glitch: the device dropped audio before
+        // this packet. Counted only; the stats log thread reports them
+        if (m_stats) {
+            m_stats->recordPacket(numFramesAvailable, flags);
+        }
+        
+        if (m_traceWriter.isOpen()) {
+            CapturePacketInfo info;
+            info.arrivalNs = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - m_captureStart
+            ).count());
+            info.devicePosition = devicePosition;
+            info.qpcPosition = qpcPosition;
+            info.frameCount = numFramesAvailable;
+            info.flags = flags;
+            m_traceWriter.recordPacket(info, pData);
+        }
+        
         // Process audio data
         if (pData) {
-            processAudioData(pData, numFramesAvailable, flags);
+            processAudioData(pData, numFramesAvailable, flags, captureTimeNs);
         }
         
         // Release buffer
@@ -300,78 +386,76 @@ void WasapiCapture::captureThread() {
     }
 }
 
-void WasapiCapture::processAudioData(BYTE* pData, UINT32 numFramesAvailable, DWORD flags) {
+void WasapiCapture::processAudioData(BYTE* pData, UINT32 numFramesAvailable, DWORD flags, std::uint64_t captureTimeNs) {
+    TRACE_ZONE("processAudioData");
+    
     if (!pData || numFramesAvailable == 0) {
         return;
     }
     
-    // Check for silence
+    // Blocks from the previous packet are no longer referenced
+    m_bufferPool.reset();
+    
+    AudioBlock block;
+    block.data = pData;
+    block.sampleFormat = m_sampleFormat;
+    block.frameCount = numFramesAvailable;
+    block.format = m_format;
+    block.captureTimeNs = captureTimeNs;
+    
+    // Device data is undefined for silence: pass the flag, not samples.
+    // Meters advance in closed form; the dispatcher zero-fills a float
+    // copy only for callbacks that want one.
     if (flags & AUDCLNT_BUFFERFLAGS_SILENT) {
-        // Process silence (zero buffer)
-        const std::size_t totalSamples = numFramesAvailable * m_format.samplesPerFrame();
-        m_floatBuffer.resize(totalSamples);
-        std::fill(m_floatBuffer.begin(), m_floatBuffer.end(), 0.0f);
-    } else {
-        // Convert to float32
-        const std::size_t totalSamples = numFramesAvailable * m_format.samplesPerFrame();
-        m_floatBuffer.resize(totalSamples);
-        convertToFloat32(pData, m_floatBuffer.data(), numFramesAvailable);
-    }
-    
-    // Call registered callbacks
-    std::lock_guard<std::mutex> lock(m_callbackMutex);
-    for (IAudioDataCallback* callback : m_callbacks) {
-        if (callback) {
-            callback->onAudioData(m_floatBuffer.data(), numFramesAvailable, m_format);
-        }
+        block.data = nullptr;
+        block.sampleFormat = SampleFormat::Float32;
+        block.silent = true;
     }
+    
+    // Offer the native packet to callbacks; float32 conversion happens lazily
+    m_dispatcher.dispatchBlock(block, m_bufferPool);
 }
 
-void WasapiCapture::convertToFloat32(const BYTE* pSource, float* pDest, UINT32 numFrames) {
-    if (!pSource || !pDest || !m_waveFormat || numFrames == 0) {
-        return;
+SampleFormat WasapiCapture::resolveSampleFormat(const WAVEFORMATEX* waveFormat) {
+    if (!waveFormat) {
+        return SampleFormat::Unknown;
     }
     
-    const UINT32 bytesPerFrame = m_waveFormat->nBlockAlign;
-    const UINT16 bitsPerSample = m_waveFormat->wBitsPerSample;
-    const UINT16 channels = m_waveFormat->nChannels;
-    
-    if (m_waveFormat->wFormatTag == WAVE_FORMAT_IEEE_FLOAT) {
-        // Already float32, just copy
-        const float* pFloatSource = reinterpret_cast<const float*>(pSource);
-        std::copy(pFloatSource, pFloatSource + (numFrames * channels), pDest);
-    } else if (m_waveFormat->wFormatTag == WAVE_FORMAT_PCM) {
-        // Convert from integer PCM to float32
-        if (bitsPerSample == 16) {
-            const std::int16_t* pInt16Source = reinterpret_cast<const std::int16_t*>(pSource);
-            const float scale = 1.0f / 32768.0f;
-            
-            for (UINT32 frame = 0; frame < numFrames; ++frame) {
-                for (UINT16 ch = 0; ch < channels; ++ch) {
-                    const std::size_t srcIdx = frame * channels + ch;
-                    const std::size_t destIdx = frame * channels + ch;
-                    pDest[destIdx] = static_cast<float>(pInt16Source[srcIdx]) * scale;
-                }
-            }
-        } else if (bitsPerSample == 32) {
-            const std::int32_t* pInt32Source = reinterpret_cast<const std::int32_t*>(pSource);
-            const float scale = 1.0f / 2147483648.0f;
-            
-            for (UINT32 frame = 0; frame < numFrames; ++frame) {
-                for (UINT16 ch = 0; ch < channels; ++ch) {
-                    const std::size_t srcIdx = frame * channels + ch;
-                    const std::size_t destIdx = frame * channels + ch;
-                    pDest[destIdx] = static_cast<float>(pInt32Source[srcIdx]) * scale;
-                }
-            }
-        } else {
-            // Unsupported bit depth - fill with zeros
-            std::fill(pDest, pDest + (numFrames * channels), 0.0f);
+    WORD formatTag = waveFormat->wFormatTag;
+    WORD validBits = waveFormat->wBitsPerSample;
+    
+    if (formatTag == WAVE_FORMAT_EXTENSIBLE && waveFormat->cbSize >= 22) {
+        const auto* extensible = reinterpret_cast<const WAVEFORMATEXTENSIBLE*>(waveFormat);
+        
+        // KSDATAFORMAT_SUBTYPE_* GUIDs embed the legacy format tag in Data1
+        static const GUID kSubtypeBase = {
+            0x00000000, 0x0000, 0x0010, {0x80, 0x00, 0x00, 0xaa, 0x00, 0x38, 0x9b, 0x71}
+        };
+        GUID base = extensible->SubFormat;
+        base.Data1 = 0;
+        if (!IsEqualGUID(base, kSubtypeBase)) {
+            return SampleFormat::Unknown;
+        }
+        
+        formatTag = static_cast<WORD>(extensible->SubFormat.Data1);
+        if (extensible->Samples.wValidBitsPerSample != 0) {
+            validBits = extensible->Samples.wValidBitsPerSample;
         }
-    } else {
-        // Unsupported format - fill with zeros
-        std::fill(pDest, pDest + (numFrames * channels), 0.0f);
     }
+    
+    const WORD containerBits = waveFormat->wBitsPerSample;
+    
+    if (formatTag == WAVE_FORMAT_IEEE_FLOAT) {
+        if (containerBits == 32) return SampleFormat::Float32;
+        if (containerBits == 64) return SampleFormat::Float64;
+    } else if (formatTag == WAVE_FORMAT_PCM) {
+        if (containerBits == 16) return SampleFormat::Int16;
+        if (containerBits == 24) return SampleFormat::Int24Packed;
+        // WASAPI left-justifies 24-in-32, so it reads as plain int32
+        if (containerBits == 32 && validBits <= 32) return SampleFormat::Int32;
+    }
+    
+    return SampleFormat::Unknown;
 }
 
 void WasapiCapture::releaseAudioClient() {
@@ -399,6 +483,9 @@ void WasapiCapture::releaseAudioClient() {
         CoTaskMemFree(m_waveFormat);
         m_waveFormat = nullptr;
     }
+    
+    m_bufferPool.release();
+    m_maxFramesPerPacket = 0;
 }
 
 void WasapiCapture::releaseCom() {
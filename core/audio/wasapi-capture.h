@@ -1,16 +1,20 @@
 #pragma once
 
-#include "audio-engine-interface.h"
+#include "audio-source.h"
+#include "callback-dispatcher.h"
+#include "capture-trace.h"
+#include "format-convert.h"
 #include "../../common/audio-format.h"
+#include "../../common/buffer-pool.h"
 
 #ifdef _WIN32
 
 #include <windows.h>
 #include <mmdeviceapi.h>
 #include <audioclient.h>
-#include <vector>
-#include <mutex>
 #include <atomic>
+#include <chrono>
+#include <string>
 
 namespace openmeters::core::audio {
 
@@ -21,10 +25,10 @@ namespace openmeters::core::audio {
  * Thread safety: Thread-safe for start/stop operations.
  * Audio callbacks run on WASAPI capture thread (real-time priority).
  */
-class WasapiCapture {
+class WasapiCapture : public IAudioSource {
 public:
     explicit WasapiCapture();
-    ~WasapiCapture();
+    ~WasapiCapture() override;
     
     // Non-copyable, non-movable
     WasapiCapture(const WasapiCapture&) = delete;
@@ -38,7 +42,7 @@ public:
      * 
      * @return true if initialization succeeded, false otherwise
      */
-    bool initialize();
+    bool initialize() override;
     
     /**
      * Start audio capture.
@@ -46,46 +50,63 @@ public:
      * 
      * @return true if start succeeded, false otherwise
      */
-    bool start();
+    bool start() override;
     
     /**
      * Stop audio capture.
      * Stops streaming and releases audio client.
      */
-    void stop();
+    void stop() override;
     
     /**
      * Shutdown and release all resources.
      */
-    void shutdown();
+    void shutdown() override;
     
     /**
      * Get the current audio format.
      * 
      * @return Audio format descriptor
      */
-    [[nodiscard]] common::AudioFormat getFormat() const;
+    [[nodiscard]] common::AudioFormat getFormat() const override;
     
     /**
      * Check if currently capturing.
      * 
      * @return true if capturing, false otherwise
      */
-    [[nodiscard]] bool isCapturing() const;
+    [[nodiscard]] bool isCapturing() const override;
     
     /**
      * Register a callback for audio data.
      * 
      * @param callback Callback interface (must remain valid until unregistered)
      */
-    void registerCallback(IAudioDataCallback* callback);
+    void registerCallback(IAudioDataCallback* callback) override;
     
     /**
      * Unregister a callback.
      * 
      * @param callback Callback to remove
      */
-    void unregisterCallback(IAudioDataCallback* callback);
+    void unregisterCallback(IAudioDataCallback* callback) override;
+    
+    /**
+     * Count packets, discontinuities and GetBuffer failures and time
+     * delivery into a collector.
+     * 
+     * @param stats Collector, or nullptr to stop collecting
+     */
+    void setStatsCollector(StatsCollector* stats) override;
+    
+    /**
+     * Record packet sizes, flags, device positions, arrival times and audio
+     * to a capture trace while capturing (for ReplaySource).
+     * Takes effect at the next start(); pass an empty path to disable.
+     * 
+     * @param path Trace file to write
+     */
+    void setTraceRecording(const std::string& path);
 
 private:
     /**
@@ -101,23 +122,25 @@ private:
     
     /**
      * Process captured audio data.
-     * Converts format and calls registered callbacks.
+     * Offers the native packet to each callback and converts to float32
+     * only for callbacks that do not handle the native format.
      * 
      * @param pData Pointer to audio data
      * @param numFramesAvailable Number of frames available
      * @param pFlags Flags from WASAPI
+     * @param captureTimeNs When the packet's first frame was captured
+     *        (GetBuffer's qpcPosition on the common::monotonicNanos() base;
+     *        the time GetBuffer returned if the device gave none)
      */
-    void processAudioData(BYTE* pData, UINT32 numFramesAvailable, DWORD flags);
+    void processAudioData(BYTE* pData, UINT32 numFramesAvailable, DWORD flags, std::uint64_t captureTimeNs);
     
     /**
-     * Convert audio samples to float32.
-     * Handles various WASAPI formats (int16, int32, float32).
+     * Map a WASAPI mix format (including WAVE_FORMAT_EXTENSIBLE) to a sample format.
      * 
-     * @param pSource Source buffer
-     * @param pDest Destination float buffer
-     * @param numFrames Number of frames to convert
+     * @param waveFormat Mix format from GetMixFormat
+     * @return Sample format, or SampleFormat::Unknown if unsupported
      */
-    void convertToFloat32(const BYTE* pSource, float* pDest, UINT32 numFrames);
+    static SampleFormat resolveSampleFormat(const WAVEFORMATEX* waveFormat);
     
     /**
      * Release audio client resources.
@@ -138,18 +161,32 @@ private:
     // Audio format
     WAVEFORMATEX* m_waveFormat = nullptr;
     common::AudioFormat m_format;
+    SampleFormat m_sampleFormat = SampleFormat::Unknown;
     
     // Capture state
     std::atomic<bool> m_capturing{false};
     HANDLE m_captureThread = nullptr;
     HANDLE m_stopEvent = nullptr;
     
-    // Callbacks (protected by mutex)
-    std::mutex m_callbackMutex;
-    std::vector<IAudioDataCallback*> m_callbacks;
+    // Callbacks (lock-free on the capture thread)
+    CallbackDispatcher m_dispatcher;
+    
+    // Engine statistics (set while stopped)
+    StatsCollector* m_stats = nullptr;
+    
+    // Packet-sized blocks reserved per packet: float conversion plus
+    // callback scratch (planar copies, analysis buffers)
+    static constexpr std::size_t kPacketArenaBlocks = 4;
+    
+    // Per-packet arena for conversion and callback scratch, sized from the
+    // endpoint buffer at initialize() so the capture thread never allocates
+    common::BufferPool m_bufferPool{common::MemoryTag::Audio};
+    UINT32 m_maxFramesPerPacket = 0;
     
-    // Conversion buffer (reused per capture)
-    std::vector<float> m_floatBuffer;
+    // Capture trace recording (configured before start)
+    std::string m_tracePath;
+    CaptureTraceWriter m_traceWriter;
+    std::chrono::steady_clock::time_point m_captureStart;
     
     // COM initialization flag
     bool m_comInitialized = false;
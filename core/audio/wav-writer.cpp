@@ -0,0 +1,234 @@
+#include "wav-writer.h"
+#include "../../common/logger.h"
+#include "../../common/resource-monitor.h"
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <new>
+
+namespace openmeters::core::audio {
+
+namespace {
+
+constexpr std::uint16_t kFormatPcm = 1;
+constexpr std::uint16_t kFormatIeeeFloat = 3;
+
+// Staging block alignment (page size; also suits unbuffered I/O)
+constexpr std::size_t kBlockAlignment = 4096;
+
+// Header layout: RIFF/RF64, JUNK/ds64, fmt, [fact], JUNK padding, data
+constexpr std::size_t kDs64Offset = 12;
+constexpr std::uint32_t kDs64Size = 28;
+constexpr std::size_t kFmtOffset = kDs64Offset + 8 + kDs64Size;
+constexpr std::uint32_t kFmtSize = 18;
+constexpr std::size_t kFactOffset = kFmtOffset + 8 + kFmtSize;
+constexpr std::size_t kDataChunkOffset = WavWriter::kDataOffset - 8;
+
+constexpr std::uint64_t kMax32 = std::numeric_limits<std::uint32_t>::max();
+
+void putTag(std::uint8_t* p, const char* tag) noexcept {
+    std::memcpy(p, tag, 4);
+}
+
+void putU16(std::uint8_t* p, std::uint16_t value) noexcept {
+    p[0] = static_cast<std::uint8_t>(value);
+    p[1] = static_cast<std::uint8_t>(value >> 8);
+}
+
+void putU32(std::uint8_t* p, std::uint32_t value) noexcept {
+    for (int i = 0; i < 4; ++i) {
+        p[i] = static_cast<std::uint8_t>(value >> (8 * i));
+    }
+}
+
+void putU64(std::uint8_t* p, std::uint64_t value) noexcept {
+    for (int i = 0; i < 8; ++i) {
+        p[i] = static_cast<std::uint8_t>(value >> (8 * i));
+    }
+}
+
+bool isWavSampleFormat(SampleFormat format) noexcept {
+    return format == SampleFormat::Float32 || format == SampleFormat::Int24Packed || format == SampleFormat::Int16;
+}
+
+} // namespace
+
+void WavWriter::AlignedDelete::operator()(std::uint8_t* block) const noexcept {
+    ::operator delete(block, std::align_val_t(kBlockAlignment));
+    common::ResourceMonitor::trackRelease(common::MemoryTag::Audio, kBlockBytes);
+}
+
+WavWriter::~WavWriter() {
+    close();
+}
+
+bool WavWriter::buildHeader(std::uint8_t* dest, const common::AudioFormat& format,
+                            SampleFormat sampleFormat, std::uint64_t frameCount) noexcept {
+    if (!isWavSampleFormat(sampleFormat) || !format.isValid()) {
+        return false;
+    }
+
+    const bool isFloat = sampleFormat == SampleFormat::Float32;
+    const auto blockAlign = static_cast<std::uint16_t>(bytesPerSample(sampleFormat) * format.samplesPerFrame());
+    const std::uint64_t dataSize = frameCount * blockAlign;
+    const std::uint64_t riffSize = kDataOffset - 8 + dataSize + (dataSize & 1); // Odd chunks get a pad byte
+    const bool rf64 = riffSize > kMax32;
+
+    std::memset(dest, 0, kDataOffset);
+    putTag(dest, rf64 ? "RF64" : "RIFF");
+    putU32(dest + 4, rf64 ? static_cast<std::uint32_t>(kMax32) : static_cast<std::uint32_t>(riffSize));
+    putTag(dest + 8, "WAVE");
+
+    // Reserved for ds64 so a growing file can switch to RF64 without moving data
+    putTag(dest + kDs64Offset, rf64 ? "ds64" : "JUNK");
+    putU32(dest + kDs64Offset + 4, kDs64Size);
+    if (rf64) {
+        putU64(dest + kDs64Offset + 8, riffSize);
+        putU64(dest + kDs64Offset + 16, dataSize);
+        putU64(dest + kDs64Offset + 24, frameCount);
+        // Table length (offset 32) stays 0
+    }
+
+    putTag(dest + kFmtOffset, "fmt ");
+    putU32(dest + kFmtOffset + 4, kFmtSize);
+    putU16(dest + kFmtOffset + 8, isFloat ? kFormatIeeeFloat : kFormatPcm);
+    putU16(dest + kFmtOffset + 10, format.channelCount);
+    putU32(dest + kFmtOffset + 12, format.sampleRate);
+    putU32(dest + kFmtOffset + 16, format.sampleRate * blockAlign);
+    putU16(dest + kFmtOffset + 20, blockAlign);
+    putU16(dest + kFmtOffset + 22, static_cast<std::uint16_t>(bytesPerSample(sampleFormat) * 8));
+    // Extension size (offset 24) stays 0
+
+    std::size_t junkOffset = kFactOffset;
+    if (isFloat) {
+        // Required for non-PCM formats
+        putTag(dest + kFactOffset, "fact");
+        putU32(dest + kFactOffset + 4, 4);
+        putU32(dest + kFactOffset + 8, static_cast<std::uint32_t>(std::min(frameCount, kMax32)));
+        junkOffset += 12;
+    }
+    putTag(dest + junkOffset, "JUNK");
+    putU32(dest + junkOffset + 4, static_cast<std::uint32_t>(kDataChunkOffset - junkOffset - 8));
+
+    putTag(dest + kDataChunkOffset, "data");
+    putU32(dest + kDataChunkOffset + 4, static_cast<std::uint32_t>(rf64 ? kMax32 : dataSize));
+    return true;
+}
+
+bool WavWriter::open(const std::string& path, const common::AudioFormat& format, SampleFormat sampleFormat) {
+    close();
+    if (!format.isValid() || !isWavSampleFormat(sampleFormat)) {
+        return false;
+    }
+
+    if (!m_block) {
+        auto* block = static_cast<std::uint8_t*>(::operator new(kBlockBytes, std::align_val_t(kBlockAlignment), std::nothrow));
+        if (!block) {
+            return false;
+        }
+        m_block.reset(block);
+        common::ResourceMonitor::trackAllocation(common::MemoryTag::Audio, kBlockBytes);
+    }
+
+    if (!m_file.create(path)) {
+        LOG_ERROR("Failed to create WAV file: {}", path);
+        return false;
+    }
+    m_format = format;
+    m_sampleFormat = sampleFormat;
+    m_frames = 0;
+    m_blockFill = 0;
+    m_fileOffset = kDataOffset;
+    m_failed = false;
+
+    // Provisional header (zero sizes) so an interrupted file is still recognisable
+    buildHeader(m_block.get(), m_format, m_sampleFormat, 0);
+    if (!m_file.writeAt(0, m_block.get(), kDataOffset)) {
+        LOG_ERROR("Failed to write WAV header: {}", path);
+        m_file.close();
+        return false;
+    }
+    return true;
+}
+
+bool WavWriter::write(const float* samples, std::size_t frameCount) {
+    if (!m_file.isOpen() || m_failed) {
+        return false;
+    }
+
+    const std::size_t sampleBytes = bytesPerSample(m_sampleFormat);
+    const std::size_t total = frameCount * m_format.samplesPerFrame();
+    std::uint8_t* block = m_block.get();
+    std::size_t done = 0;
+    while (done < total) {
+        // Convert straight into the block while whole samples fit
+        const std::size_t fit = std::min((kBlockBytes - m_blockFill) / sampleBytes, total - done);
+        convertFromFloat32(samples + done, block + m_blockFill, m_sampleFormat, fit);
+        m_blockFill += fit * sampleBytes;
+        done += fit;
+
+        const std::size_t room = kBlockBytes - m_blockFill;
+        if (room >= sampleBytes) {
+            continue; // Only possible once every sample is in
+        }
+
+        // Block full, or a 3-byte sample straddles its end
+        std::uint8_t straddling[8];
+        const bool split = room != 0 && done < total;
+        if (split) {
+            convertFromFloat32(samples + done, straddling, m_sampleFormat, 1);
+            std::memcpy(block + m_blockFill, straddling, room);
+            m_blockFill = kBlockBytes;
+            ++done;
+        }
+        if (m_blockFill == kBlockBytes && !flushBlock()) {
+            return false;
+        }
+        if (split) {
+            std::memcpy(block, straddling + room, sampleBytes - room);
+            m_blockFill = sampleBytes - room;
+        }
+    }
+
+    m_frames += frameCount;
+    return true;
+}
+
+bool WavWriter::flushBlock() {
+    if (m_blockFill == 0) {
+        return true;
+    }
+    if (!m_file.writeAt(m_fileOffset, m_block.get(), m_blockFill)) {
+        m_failed = true;
+        LOG_ERROR("Failed to write WAV data at offset {}", m_fileOffset);
+        return false;
+    }
+    m_fileOffset += m_blockFill;
+    m_blockFill = 0;
+    return true;
+}
+
+bool WavWriter::close() {
+    if (!m_file.isOpen()) {
+        return false;
+    }
+
+    bool ok = !m_failed;
+    if (ok) {
+        // RIFF chunks are word-aligned: an odd-sized data chunk gets a pad byte
+        const std::uint64_t dataSize = m_frames * bytesPerSample(m_sampleFormat) * m_format.samplesPerFrame();
+        if ((dataSize & 1) != 0) {
+            m_block.get()[m_blockFill++] = 0;
+        }
+        ok = flushBlock();
+    }
+    if (ok) {
+        buildHeader(m_block.get(), m_format, m_sampleFormat, m_frames);
+        ok = m_file.writeAt(0, m_block.get(), kDataOffset);
+    }
+    m_file.close();
+    m_blockFill = 0;
+    return ok;
+}
+
+} // namespace openmeters::core::audio
@@ -0,0 +1,104 @@
+#pragma once
+
+#include "format-convert.h"
+#include "../../common/audio-format.h"
+#include "../../common/output-file.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace openmeters::core::audio {
+
+/**
+ * Streaming WAV file writer (32-bit float, or 16/24-bit integer PCM).
+ *
+ * Samples are converted into an aligned 1 MB block and handed to the OS
+ * one full block per write. The header takes the first 4 KB (padded with
+ * a JUNK chunk), so audio starts on a page boundary and every full block
+ * lands on an aligned file offset. The header is written with zero sizes
+ * on open() and patched on close(); a file that outgrows 4 GB is closed
+ * as RF64 (EBU Tech 3306), its reserved JUNK chunk becoming the ds64
+ * chunk that holds the 64-bit sizes.
+ *
+ * Thread safety: Not thread-safe. Blocking file I/O; never call from a
+ * real-time thread.
+ */
+class WavWriter {
+public:
+    /**
+     * File offset of the first audio byte (size of the header).
+     */
+    static constexpr std::size_t kDataOffset = 4096;
+
+    /**
+     * Bytes staged per file write.
+     */
+    static constexpr std::size_t kBlockBytes = 1u << 20;
+
+    WavWriter() = default;
+    ~WavWriter();
+
+    // Non-copyable, non-movable
+    WavWriter(const WavWriter&) = delete;
+    WavWriter& operator=(const WavWriter&) = delete;
+    WavWriter(WavWriter&&) = delete;
+    WavWriter& operator=(WavWriter&&) = delete;
+
+    /**
+     * Create the file and write a provisional header.
+     *
+     * @param path Output file (replaced if it exists)
+     * @param format Rate and channel layout
+     * @param sampleFormat Float32, Int24Packed or Int16
+     * @return true if the file was created, false otherwise
+     */
+    bool open(const std::string& path, const common::AudioFormat& format,
+              SampleFormat sampleFormat = SampleFormat::Float32);
+
+    /**
+     * Convert and append interleaved float samples.
+     * Integer formats are clipped and rounded (no dither).
+     *
+     * @return true if buffered or written, false on an I/O error
+     */
+    bool write(const float* samples, std::size_t frameCount);
+
+    /**
+     * Write the last partial block, patch the header and close the file.
+     *
+     * @return true if the file is complete, false on an I/O error
+     */
+    bool close();
+
+    [[nodiscard]] bool isOpen() const noexcept { return m_file.isOpen(); }
+    [[nodiscard]] std::uint64_t framesWritten() const noexcept { return m_frames; }
+    [[nodiscard]] SampleFormat sampleFormat() const noexcept { return m_sampleFormat; }
+
+    /**
+     * Fill kDataOffset bytes with the header for a file of frameCount
+     * frames: RIFF, or RF64 if the sizes do not fit in 32 bits.
+     *
+     * @return false if sampleFormat cannot be stored in WAV
+     */
+    static bool buildHeader(std::uint8_t* dest, const common::AudioFormat& format,
+                            SampleFormat sampleFormat, std::uint64_t frameCount) noexcept;
+
+private:
+    struct AlignedDelete {
+        void operator()(std::uint8_t* block) const noexcept;
+    };
+
+    bool flushBlock();
+
+    common::OutputFile m_file;
+    common::AudioFormat m_format;
+    SampleFormat m_sampleFormat = SampleFormat::Float32;
+    std::uint64_t m_frames = 0;
+
+    std::unique_ptr<std::uint8_t, AlignedDelete> m_block;
+    std::size_t m_blockFill = 0;
+    std::uint64_t m_fileOffset = 0;
+    bool m_failed = false;
+};
+
+} // namespace openmeters::core::audio
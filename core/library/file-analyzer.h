@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <nlohmann/json.hpp>
+
+namespace openmeters::core::library {
+
+/**
+ * Interface for per-file analyzers used by the library scanner.
+ * An analyzer turns one media file into a JSON result (e.g. loudness,
+ * peak, duration). Results are cached by content hash plus analyzer
+ * name and version, so bump the version whenever the output changes.
+ *
+ * Thread safety: analyze() is called concurrently from pool workers and
+ * must be reentrant.
+ */
+class IFileAnalyzer {
+public:
+    virtual ~IFileAnalyzer() = default;
+
+    /**
+     * Stable analyzer name (part of the cache key).
+     */
+    [[nodiscard]] virtual std::string name() const = 0;
+
+    /**
+     * Analyzer version (part of the cache key).
+     */
+    [[nodiscard]] virtual std::uint32_t version() const = 0;
+
+    /**
+     * Check whether the analyzer handles a file.
+     *
+     * @param path Path to the candidate file
+     * @return true if the file should be scheduled for analysis
+     */
+    [[nodiscard]] virtual bool accepts(const std::string& path) const = 0;
+
+    /**
+     * Analyze one file.
+     *
+     * @param path Path to the file
+     * @param result Receives the analysis result
+     * @return true if analysis succeeded, false otherwise (result is not cached)
+     */
+    virtual bool analyze(const std::string& path, nlohmann::json& result) = 0;
+};
+
+} // namespace openmeters::core::library
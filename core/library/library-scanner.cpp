@@ -0,0 +1,198 @@
+#include "library-scanner.h"
+#include "../../common/content-hash.h"
+#include "../../common/logger.h"
+#include "../../common/thread-pool.h"
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <mutex>
+
+namespace openmeters::core::library {
+
+namespace fs = std::filesystem;
+
+namespace {
+
+/**
+ * Hash path, size and mtime (metadata mode).
+ */
+bool hashFileMetadata(const fs::path& path, std::uint64_t& outHash) {
+    std::error_code ec;
+    const auto size = fs::file_size(path, ec);
+    if (ec) {
+        return false;
+    }
+    const auto mtime = fs::last_write_time(path, ec);
+    if (ec) {
+        return false;
+    }
+
+    const std::string pathString = fs::absolute(path, ec).generic_string();
+    const std::uint64_t sizeValue = static_cast<std::uint64_t>(size);
+    const std::int64_t mtimeValue = static_cast<std::int64_t>(mtime.time_since_epoch().count());
+
+    common::ContentHasher hasher;
+    hasher.update(pathString.data(), pathString.size());
+    hasher.update(&sizeValue, sizeof(sizeValue));
+    hasher.update(&mtimeValue, sizeof(mtimeValue));
+    outHash = hasher.digest();
+    return true;
+}
+
+/**
+ * Shared state for one scan run.
+ */
+struct ScanContext {
+    ScanContext(
+        IFileAnalyzer& analyzerRef,
+        const ScanOptions& optionsRef,
+        const LibraryScanner::ResultCallback& onResultRef,
+        ScanCache& cacheRef,
+        common::ThreadPool& poolRef
+    )
+        : analyzer(analyzerRef)
+        , options(optionsRef)
+        , onResult(onResultRef)
+        , cache(cacheRef)
+        , pool(poolRef)
+    {
+    }
+
+    IFileAnalyzer& analyzer;
+    const ScanOptions& options;
+    const LibraryScanner::ResultCallback& onResult;
+    ScanCache& cache;
+    common::ThreadPool& pool;
+
+    std::atomic<std::size_t> filesFound{0};
+    std::atomic<std::size_t> analyzed{0};
+    std::atomic<std::size_t> cached{0};
+    std::atomic<std::size_t> failed{0};
+    std::mutex resultMutex;
+
+    void report(const ScanResult& result) {
+        if (onResult) {
+            std::lock_guard<std::mutex> lock(resultMutex);
+            onResult(result);
+        }
+    }
+
+    void scanFile(const fs::path& path) {
+        filesFound.fetch_add(1, std::memory_order_relaxed);
+
+        ScanResult result;
+        result.path = path.string();
+
+        std::uint64_t fileHash = 0;
+        const bool hashed = (options.hashMode == HashMode::Metadata)
+            ? hashFileMetadata(path, fileHash)
+            : common::hashFileContents(result.path, fileHash);
+        if (!hashed) {
+            failed.fetch_add(1, std::memory_order_relaxed);
+            report(result);
+            return;
+        }
+
+        const std::string key = ScanCache::makeKey(fileHash, analyzer.name(), analyzer.version());
+        if (cache.lookup(key, result.result)) {
+            result.fromCache = true;
+            result.success = true;
+            cached.fetch_add(1, std::memory_order_relaxed);
+            report(result);
+            return;
+        }
+
+        if (analyzer.analyze(result.path, result.result)) {
+            result.success = true;
+            cache.store(key, result.path, result.result);
+            analyzed.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            failed.fetch_add(1, std::memory_order_relaxed);
+        }
+        report(result);
+    }
+
+    void scanDirectory(const fs::path& dir) {
+        std::error_code ec;
+        fs::directory_iterator it(dir, fs::directory_options::skip_permission_denied, ec);
+        if (ec) {
+            LOG_WARNING("Cannot read directory: {}", dir.string());
+            return;
+        }
+
+        // Advancing can fail too (permissions changed mid-walk), so no range-for
+        for (; it != fs::directory_iterator(); it.increment(ec)) {
+            const fs::directory_entry& entry = *it;
+            std::error_code typeEc;
+            if (entry.is_directory(typeEc)) {
+                // Subdirectories are walked in parallel (idle workers steal them)
+                fs::path subdir = entry.path();
+                pool.submit([this, subdir] { scanDirectory(subdir); });
+            } else if (entry.is_regular_file(typeEc)) {
+                std::string file = entry.path().string();
+                if (analyzer.accepts(file)) {
+                    pool.submit([this, file] { scanFile(file); });
+                }
+            }
+        }
+        if (ec) {
+            LOG_WARNING("Stopped reading directory: {} ({})", dir.string(), ec.message());
+        }
+    }
+};
+
+} // namespace
+
+LibraryScanner::LibraryScanner(IFileAnalyzer& analyzer)
+    : m_analyzer(analyzer)
+{
+}
+
+ScanSummary LibraryScanner::scan(const ScanOptions& options, const ResultCallback& onResult) {
+    const auto startTime = std::chrono::steady_clock::now();
+
+    ScanCache cache;
+    if (!options.cachePath.empty()) {
+        cache.load(options.cachePath);
+    }
+
+    common::ThreadPool pool(options.threadCount);
+    ScanContext context(m_analyzer, options, onResult, cache, pool);
+
+    for (const std::string& root : options.roots) {
+        std::error_code ec;
+        const fs::path rootPath(root);
+        if (fs::is_directory(rootPath, ec)) {
+            pool.submit([&context, rootPath] { context.scanDirectory(rootPath); });
+        } else if (fs::is_regular_file(rootPath, ec) && m_analyzer.accepts(root)) {
+            pool.submit([&context, rootPath] { context.scanFile(rootPath); });
+        } else {
+            LOG_WARNING("Scan root not found: {}", root);
+        }
+    }
+
+    pool.waitIdle();
+
+    if (!options.cachePath.empty()) {
+        if (options.pruneCache) {
+            cache.pruneUnused();
+        }
+        cache.save(options.cachePath);
+    }
+
+    ScanSummary summary;
+    summary.filesFound = context.filesFound.load();
+    summary.analyzed = context.analyzed.load();
+    summary.cached = context.cached.load();
+    summary.failed = context.failed.load();
+    summary.elapsedSeconds = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - startTime
+    ).count();
+
+    LOG_INFO("Library scan complete: {} files, {} analyzed, {} cached, {} failed",
+             summary.filesFound, summary.analyzed, summary.cached, summary.failed);
+
+    return summary;
+}
+
+} // namespace openmeters::core::library
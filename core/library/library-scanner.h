@@ -0,0 +1,80 @@
+#pragma once
+
+#include "file-analyzer.h"
+#include "scan-cache.h"
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace openmeters::core::library {
+
+/**
+ * How files are identified in the result cache.
+ */
+enum class HashMode {
+    Content,  // Hash of the full file contents (robust, reads every byte)
+    Metadata  // Hash of path, size and modification time (opt-in, no reads)
+};
+
+/**
+ * Options for a library scan.
+ */
+struct ScanOptions {
+    std::vector<std::string> roots;   // Directories (or files) to scan
+    HashMode hashMode = HashMode::Content;
+    std::size_t threadCount = 0;      // 0 = hardware concurrency
+    std::string cachePath;            // Empty = no persistent cache
+    bool pruneCache = true;           // Drop entries for files no longer present
+};
+
+/**
+ * Result for a single scanned file.
+ */
+struct ScanResult {
+    std::string path;
+    bool fromCache = false;
+    bool success = false;
+    nlohmann::json result;
+};
+
+/**
+ * Totals for a completed scan.
+ */
+struct ScanSummary {
+    std::size_t filesFound = 0;
+    std::size_t analyzed = 0;
+    std::size_t cached = 0;
+    std::size_t failed = 0;
+    double elapsedSeconds = 0.0;
+};
+
+/**
+ * Incremental batch scanner for media libraries.
+ * Walks directory trees on a work-stealing pool, hashes each accepted file
+ * and only runs the analyzer when no cached result exists for the
+ * (hash, analyzer, version) key. Re-scans of an unchanged library are
+ * bounded by hashing cost (or stat cost in metadata mode).
+ *
+ * Thread safety: Not thread-safe. One scan at a time per scanner.
+ */
+class LibraryScanner {
+public:
+    using ResultCallback = std::function<void(const ScanResult&)>;
+
+    explicit LibraryScanner(IFileAnalyzer& analyzer);
+
+    /**
+     * Scan the configured roots.
+     *
+     * @param options Scan options
+     * @param onResult Optional per-file callback (serialized, called from pool workers)
+     * @return Scan totals
+     */
+    ScanSummary scan(const ScanOptions& options, const ResultCallback& onResult = {});
+
+private:
+    IFileAnalyzer& m_analyzer;
+};
+
+} // namespace openmeters::core::library
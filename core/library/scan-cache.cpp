@@ -0,0 +1,145 @@
+#include "scan-cache.h"
+#include "../../common/content-hash.h"
+#include "../../common/logger.h"
+#include <filesystem>
+#include <fstream>
+
+namespace openmeters::core::library {
+
+namespace {
+
+constexpr int kCacheFormatVersion = 1;
+
+} // namespace
+
+std::string ScanCache::makeKey(
+    std::uint64_t fileHash,
+    const std::string& analyzerName,
+    std::uint32_t analyzerVersion
+) {
+    return common::hashToHex(fileHash) + ":" + analyzerName + ":v" + std::to_string(analyzerVersion);
+}
+
+bool ScanCache::load(const std::string& cachePath) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_entries.clear();
+    m_used.clear();
+
+    if (!std::filesystem::exists(cachePath)) {
+        return true; // First run
+    }
+
+    std::ifstream file(cachePath);
+    if (!file.is_open()) {
+        LOG_ERROR("Failed to open scan cache: {}", cachePath);
+        return false;
+    }
+
+    try {
+        nlohmann::json j;
+        file >> j;
+
+        if (j.value("formatVersion", 0) != kCacheFormatVersion) {
+            LOG_INFO("Scan cache format changed, starting fresh: {}", cachePath);
+            return true;
+        }
+
+        for (const auto& [key, value] : j["entries"].items()) {
+            Entry entry;
+            entry.path = value.value("path", std::string());
+            entry.result = value["result"];
+            m_entries.emplace(key, std::move(entry));
+        }
+
+        LOG_INFO("Scan cache loaded: {} entries", m_entries.size());
+        return true;
+    } catch (const std::exception& e) {
+        LOG_ERROR("Failed to parse scan cache: {}", e.what());
+        m_entries.clear();
+        return false;
+    }
+}
+
+bool ScanCache::save(const std::string& cachePath) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    std::filesystem::path path(cachePath);
+    auto dir = path.parent_path();
+    std::error_code ec;
+    if (!dir.empty() && !std::filesystem::exists(dir, ec)) {
+        std::filesystem::create_directories(dir, ec);
+        if (ec) {
+            LOG_ERROR("Failed to create scan cache directory: {} ({})", dir.string(), ec.message());
+            return false;
+        }
+    }
+
+    // Write to a temp file first so a crash never leaves a truncated cache
+    const std::string tempPath = cachePath + ".tmp";
+
+    try {
+        nlohmann::json j;
+        j["formatVersion"] = kCacheFormatVersion;
+        nlohmann::json& entries = j["entries"];
+        entries = nlohmann::json::object();
+        for (const auto& [key, entry] : m_entries) {
+            entries[key] = {
+                {"path", entry.path},
+                {"result", entry.result}
+            };
+        }
+
+        {
+            std::ofstream file(tempPath, std::ios::trunc);
+            if (!file.is_open()) {
+                LOG_ERROR("Failed to create scan cache: {}", tempPath);
+                return false;
+            }
+            file << j.dump();
+        }
+
+        std::filesystem::rename(tempPath, cachePath);
+        return true;
+    } catch (const std::exception& e) {
+        LOG_ERROR("Failed to save scan cache: {}", e.what());
+        return false;
+    }
+}
+
+bool ScanCache::lookup(const std::string& key, nlohmann::json& result) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_entries.find(key);
+    if (it == m_entries.end()) {
+        return false;
+    }
+    m_used.insert(key);
+    result = it->second.result;
+    return true;
+}
+
+void ScanCache::store(const std::string& key, const std::string& path, nlohmann::json result) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_entries[key] = Entry{path, std::move(result)};
+    m_used.insert(key);
+}
+
+std::size_t ScanCache::pruneUnused() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::size_t removed = 0;
+    for (auto it = m_entries.begin(); it != m_entries.end();) {
+        if (m_used.count(it->first) == 0) {
+            it = m_entries.erase(it);
+            ++removed;
+        } else {
+            ++it;
+        }
+    }
+    return removed;
+}
+
+std::size_t ScanCache::size() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_entries.size();
+}
+
+} // namespace openmeters::core::library
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <nlohmann/json.hpp>
+
+namespace openmeters::core::library {
+
+/**
+ * On-disk cache of analysis results.
+ * The key combines the scanner's file hash with the analyzer name and
+ * version, so any analyzer change invalidates old results automatically.
+ * With content hashing (the default) renamed or moved files still hit;
+ * the metadata hash includes the path, so there a rename is a miss.
+ *
+ * Thread safety: lookup/store/size are thread-safe.
+ * load/save/pruneUnused must not run concurrently with a scan.
+ */
+class ScanCache {
+public:
+    /**
+     * Build a cache key.
+     *
+     * @param fileHash Content (or metadata) hash of the file
+     * @param analyzerName Analyzer name
+     * @param analyzerVersion Analyzer version
+     */
+    [[nodiscard]] static std::string makeKey(
+        std::uint64_t fileHash,
+        const std::string& analyzerName,
+        std::uint32_t analyzerVersion
+    );
+
+    /**
+     * Load entries from a cache file.
+     * A missing file is not an error (starts empty).
+     *
+     * @param cachePath Path to cache file (JSON)
+     * @return true if loaded or absent, false if the file is unreadable
+     */
+    bool load(const std::string& cachePath);
+
+    /**
+     * Save entries to a cache file (written to a temp file, then renamed).
+     *
+     * @param cachePath Path to cache file (JSON)
+     * @return true if saved successfully, false otherwise
+     */
+    bool save(const std::string& cachePath) const;
+
+    /**
+     * Look up a cached result and mark the entry as used.
+     *
+     * @param key Cache key from makeKey()
+     * @param result Receives the cached result on hit
+     * @return true on cache hit, false otherwise
+     */
+    bool lookup(const std::string& key, nlohmann::json& result);
+
+    /**
+     * Store a result and mark the entry as used.
+     *
+     * @param key Cache key from makeKey()
+     * @param path File path the result was computed from (informational)
+     * @param result Analysis result
+     */
+    void store(const std::string& key, const std::string& path, nlohmann::json result);
+
+    /**
+     * Drop entries that were not looked up or stored since load().
+     * Keeps the cache bounded to the current library contents.
+     *
+     * @return Number of entries removed
+     */
+    std::size_t pruneUnused();
+
+    /**
+     * Number of cached entries.
+     */
+    [[nodiscard]] std::size_t size() const;
+
+private:
+    struct Entry {
+        std::string path;
+        nlohmann::json result;
+    };
+
+    mutable std::mutex m_mutex;
+    std::unordered_map<std::string, Entry> m_entries;
+    std::unordered_set<std::string> m_used;
+};
+
+} // namespace openmeters::core::library
@@ -0,0 +1,260 @@
+#include "ballistics.h"
+#include "../../common/cpu-features.h"
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+
+#if defined(OPENMETERS_SIMD_X86)
+#include <immintrin.h>
+#endif
+
+namespace openmeters::core::meters {
+
+namespace {
+
+// IEC 60268-10 integration time: a burst that long reads 2 dB below the
+// steady reading. For a one-pole attack 1 - e^(-T/tau) = 10^(-2/20), so
+// tau = T / 1.5815.
+constexpr double kIntegrationRatio = 1.5814737534084538;
+
+// VU: a critically damped two-pole reaches 99 % at t/tau = 6.638, from
+// (1 + u) e^(-u) = 0.01
+constexpr double kVuRiseSeconds = 0.3;
+constexpr double kVuRiseRatio = 6.638352067993812;
+
+// A sine's rectified average (2/pi of the peak) read as its RMS (1/sqrt(2))
+constexpr float kVuSineScale = 1.1107207345f;
+
+// Readings below this are zeroed after each packet to avoid denormals
+constexpr float kDenormalFloor = 1e-20f;
+
+double onePoleCoefficient(double timeConstantSeconds, double sampleRate) {
+    return timeConstantSeconds > 0.0 ? 1.0 - std::exp(-1.0 / (timeConstantSeconds * sampleRate)) : 1.0;
+}
+
+} // namespace
+
+BallisticsType parseBallisticsType(std::string_view name) noexcept {
+    if (name == "ppm1") {
+        return BallisticsType::PpmType1;
+    }
+    if (name == "ppm2") {
+        return BallisticsType::PpmType2;
+    }
+    if (name == "vu") {
+        return BallisticsType::Vu;
+    }
+    return BallisticsType::DigitalPeak;
+}
+
+void Ballistics::configure(const BallisticsSettings& settings, common::SampleRate sampleRate) noexcept {
+    m_settings = settings;
+    m_sampleRate = sampleRate;
+    const double rate = sampleRate > 0 ? static_cast<double>(sampleRate) : 48000.0;
+
+    double integrationMs = settings.attackMs;
+    double releaseDbPerSecond = settings.releaseDbPerSecond;
+    switch (settings.type) {
+        case BallisticsType::PpmType1:
+            integrationMs = 5.0;
+            releaseDbPerSecond = 20.0 / 1.7;
+            break;
+        case BallisticsType::PpmType2:
+            integrationMs = 10.0;
+            releaseDbPerSecond = 24.0 / 2.8;
+            break;
+        default:
+            break;
+    }
+
+    if (settings.type == BallisticsType::Vu) {
+        m_attack = static_cast<float>(onePoleCoefficient(kVuRiseSeconds / kVuRiseRatio, rate));
+        m_release = 1.0f;
+        m_vuScale = kVuSineScale;
+    } else {
+        m_attack = static_cast<float>(onePoleCoefficient(std::max(0.0, integrationMs) / 1000.0 / kIntegrationRatio, rate));
+        m_release = static_cast<float>(std::pow(10.0, -std::max(0.0, releaseDbPerSecond) / (20.0 * rate)));
+        m_vuScale = 1.0f;
+    }
+}
+
+void Ballistics::process(const float* buffer, std::size_t frameCount, const common::AudioFormat& format) noexcept {
+    run(buffer, frameCount, format, 1.0f);
+}
+
+void Ballistics::process(const std::int16_t* buffer, std::size_t frameCount, const common::AudioFormat& format) noexcept {
+    run(buffer, frameCount, format, 1.0f / 32768.0f);
+}
+
+void Ballistics::process(const std::int32_t* buffer, std::size_t frameCount, const common::AudioFormat& format) noexcept {
+    run(buffer, frameCount, format, 1.0f / 2147483648.0f);
+}
+
+template <typename Sample>
+void Ballistics::run(
+    const Sample* buffer,
+    std::size_t frameCount,
+    const common::AudioFormat& format,
+    float scale
+) noexcept {
+    if (!buffer || frameCount == 0 || !format.isValid()) {
+        return;
+    }
+    if (format.sampleRate != m_sampleRate) {
+        configure(m_settings, format.sampleRate);
+    }
+
+    const std::size_t channels = format.samplesPerFrame();
+    const bool stereo = channels >= 2;
+    const bool vu = m_settings.type == BallisticsType::Vu;
+    alignas(16) float packetMax[4] = {};
+
+#if defined(OPENMETERS_SIMD_X86)
+    // VU runs two dependent stages per sample, so both channels in one
+    // vector pay off. The peak types are a single stage whose common case
+    // (falling) is one multiply; the scalar loop with a predicted branch
+    // beats the SIMD select there.
+    if (vu && m_simd) {
+        const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+        const __m128 attack = _mm_set1_ps(m_attack);
+        const __m128 gain = _mm_set1_ps(scale);
+        __m128 stage = _mm_load_ps(m_stage);
+        __m128 reading = _mm_load_ps(m_state);
+        __m128 maxReading = _mm_setzero_ps();
+        for (std::size_t i = 0; i < frameCount; ++i) {
+            // Rectified frame in lanes 0 (left) and 1 (right), built in registers
+            const Sample* s = buffer + i * channels;
+            const __m128 left = _mm_set_ss(static_cast<float>(s[0]));
+            const __m128 right = stereo ? _mm_set_ss(static_cast<float>(s[1])) : _mm_setzero_ps();
+            const __m128 x = _mm_and_ps(_mm_mul_ps(_mm_unpacklo_ps(left, right), gain), absMask);
+            stage = _mm_add_ps(stage, _mm_mul_ps(attack, _mm_sub_ps(x, stage)));
+            reading = _mm_add_ps(reading, _mm_mul_ps(attack, _mm_sub_ps(stage, reading)));
+            maxReading = _mm_max_ps(maxReading, reading);
+        }
+        _mm_store_ps(m_stage, stage);
+        _mm_store_ps(m_state, reading);
+        _mm_store_ps(packetMax, maxReading);
+        finishPacket(packetMax, frameCount, format);
+        return;
+    }
+#endif
+
+    for (std::size_t i = 0; i < frameCount; ++i) {
+        const Sample* s = buffer + i * channels;
+        const float frame[2] = {
+            static_cast<float>(s[0]) * scale,
+            stereo ? static_cast<float>(s[1]) * scale : 0.0f
+        };
+        for (std::size_t lane = 0; lane < 2; ++lane) {
+            const float x = std::abs(frame[lane]);
+            float& reading = m_state[lane];
+            if (vu) {
+                m_stage[lane] += m_attack * (x - m_stage[lane]);
+                reading += m_attack * (m_stage[lane] - reading);
+            } else if (x >= reading) {
+                reading += m_attack * (x - reading);
+            } else {
+                reading *= m_release;
+            }
+            packetMax[lane] = std::max(packetMax[lane], reading);
+        }
+    }
+
+    finishPacket(packetMax, frameCount, format);
+}
+
+void Ballistics::processSilence(std::size_t frameCount, const common::AudioFormat& format) noexcept {
+    if (frameCount == 0 || !format.isValid()) {
+        return;
+    }
+    if (format.sampleRate != m_sampleRate) {
+        configure(m_settings, format.sampleRate);
+    }
+
+    const double frames = static_cast<double>(frameCount);
+    alignas(16) float packetMax[4] = {};
+    for (std::size_t lane = 0; lane < 2; ++lane) {
+        const double reading = m_state[lane];
+        if (m_settings.type != BallisticsType::Vu) {
+            // Falling from the first sample on (a zero reading stays zero)
+            packetMax[lane] = static_cast<float>(reading * m_release);
+            m_state[lane] = static_cast<float>(reading * std::pow(static_cast<double>(m_release), frames));
+            continue;
+        }
+
+        // Both VU stages decay by keep per sample; after k samples
+        // stage = s0 keep^k and reading = keep^k (r0 + k a s0), which may
+        // still rise before it falls. Its maximum is at an end or next to
+        // the turning point k = -1 / ln(keep) - r0 / (a s0).
+        const double attack = m_attack;
+        const double keep = 1.0 - attack;
+        const double stage = m_stage[lane];
+        const auto readingAfter = [&](double k) noexcept {
+            return std::pow(keep, k) * (reading + k * attack * stage);
+        };
+        double peak = std::max(readingAfter(1.0), readingAfter(frames));
+        if (stage > 0.0 && keep > 0.0 && keep < 1.0) {
+            const double turn = -1.0 / std::log(keep) - reading / (attack * stage);
+            if (turn > 1.0 && turn < frames) {
+                peak = std::max({peak, readingAfter(std::floor(turn)), readingAfter(std::ceil(turn))});
+            }
+        }
+        packetMax[lane] = static_cast<float>(peak);
+        m_stage[lane] = static_cast<float>(stage * std::pow(keep, frames));
+        m_state[lane] = static_cast<float>(readingAfter(frames));
+    }
+
+    finishPacket(packetMax, frameCount, format);
+}
+
+void Ballistics::finishPacket(float* packetMax, std::size_t frameCount, const common::AudioFormat& format) noexcept {
+    const bool stereo = format.samplesPerFrame() >= 2;
+    for (std::size_t lane = 0; lane < 2; ++lane) {
+        if (m_state[lane] < kDenormalFloor) {
+            m_state[lane] = 0.0f;
+        }
+        if (m_stage[lane] < kDenormalFloor) {
+            m_stage[lane] = 0.0f;
+        }
+        packetMax[lane] *= m_vuScale;
+    }
+
+    m_level.left = std::clamp(m_state[0] * m_vuScale, 0.0f, 1.0f);
+    // Mono: use left value for right
+    m_level.right = stereo ? std::clamp(m_state[1] * m_vuScale, 0.0f, 1.0f) : m_level.left;
+    if (!stereo) {
+        packetMax[1] = packetMax[0];
+    }
+    updateHold(packetMax, frameCount, format);
+}
+
+void Ballistics::updateHold(const float* packetMax, std::size_t frameCount, const common::AudioFormat& format) noexcept {
+    const double seconds = static_cast<double>(frameCount) / format.sampleRate;
+    const float decay = static_cast<float>(std::pow(
+        std::clamp(static_cast<double>(m_settings.holdDecay), 0.0, 1.0),
+        seconds * std::max(1.0, static_cast<double>(m_settings.updateRate))));
+
+    float* holds[2] = {&m_hold.left, &m_hold.right};
+    for (std::size_t ch = 0; ch < 2; ++ch) {
+        float& hold = *holds[ch];
+        const float peak = std::clamp(packetMax[ch], 0.0f, 1.0f);
+        if (peak >= hold) {
+            hold = peak;
+            m_holdFrames[ch] = static_cast<std::int64_t>(std::max(0.0f, m_settings.holdMs) * format.sampleRate / 1000.0f);
+        } else if (m_holdFrames[ch] > 0) {
+            m_holdFrames[ch] -= static_cast<std::int64_t>(frameCount);
+        } else {
+            hold = std::max(peak, hold * decay);
+        }
+    }
+}
+
+void Ballistics::reset() noexcept {
+    std::fill(std::begin(m_state), std::end(m_state), 0.0f);
+    std::fill(std::begin(m_stage), std::end(m_stage), 0.0f);
+    std::fill(std::begin(m_holdFrames), std::end(m_holdFrames), 0);
+    m_level = {};
+    m_hold = {};
+}
+
+} // namespace openmeters::core::meters
@@ -0,0 +1,150 @@
+#pragma once
+
+#include "../../common/types.h"
+#include "../../common/audio-format.h"
+#include "../../common/meter-values.h"
+#include <string_view>
+
+namespace openmeters::core::meters {
+
+/**
+ * How a meter reading responds to the signal.
+ */
+enum class BallisticsType {
+    DigitalPeak, // Sample peak, configurable attack and release
+    PpmType1,    // IEC 60268-10 Type I (DIN): 5 ms integration, 20 dB return in 1.7 s
+    PpmType2,    // IEC 60268-10 Type II (BBC/EBU): 10 ms integration, 24 dB return in 2.8 s
+    Vu           // IEC 60268-17 VU: 300 ms rise, rectified average reading sine RMS
+};
+
+/**
+ * Parse a config name ("digital", "ppm1", "ppm2", "vu").
+ *
+ * @return The type, or DigitalPeak for unknown names
+ */
+[[nodiscard]] BallisticsType parseBallisticsType(std::string_view name) noexcept;
+
+/**
+ * Ballistics parameters.
+ */
+struct BallisticsSettings {
+    BallisticsType type = BallisticsType::DigitalPeak;
+    float attackMs = 0.0f;             // DigitalPeak integration time (0 = instant)
+    float releaseDbPerSecond = 20.0f;  // DigitalPeak fall rate
+    float holdMs = 1000.0f;            // Peak hold time before the hold starts falling
+    float holdDecay = 0.95f;           // Hold fall per display update once the hold time is over
+    float updateRate = 60.0f;          // Display updates per second (scales holdDecay)
+
+    bool operator==(const BallisticsSettings&) const = default;
+};
+
+/**
+ * Meter ballistics: turns raw samples into the reading a meter of the
+ * chosen type would show, plus a peak hold.
+ *
+ * Runs sample by sample in the audio domain, so the reading does not
+ * depend on the device period or the display frame rate; the UI draws
+ * the values as they are. Peak types rectify and follow the signal with a
+ * one-pole attack (integration time as defined by IEC 60268-10: a tone
+ * burst of that length reads 2 dB low) and a logarithmic (constant dB/s)
+ * release. VU is a critically damped two-pole average of the rectified
+ * signal (no overshoot; the standard allows 1.5 %). On x86-64 VU runs
+ * both channels together in SIMD lanes; the peak types stay scalar,
+ * which measures faster for their single-stage recurrence.
+ *
+ * Thread safety: Not thread-safe. Must be called from a single thread.
+ * Real-time safe (no allocation, no locks).
+ */
+class Ballistics {
+public:
+    /**
+     * Set parameters. Readings carry over, so a change applies smoothly
+     * without restarting capture.
+     *
+     * @param settings Ballistics parameters
+     * @param sampleRate Sample rate of the audio to be processed
+     */
+    void configure(const BallisticsSettings& settings, common::SampleRate sampleRate) noexcept;
+
+    /**
+     * Run a buffer through the ballistics.
+     *
+     * @param buffer Audio buffer (interleaved samples)
+     * @param frameCount Number of frames
+     * @param format Audio format descriptor (rate must match configure())
+     */
+    void process(const float* buffer, std::size_t frameCount, const common::AudioFormat& format) noexcept;
+
+    /**
+     * Run an int16 device buffer through the ballistics (full scale = 1.0).
+     */
+    void process(const std::int16_t* buffer, std::size_t frameCount, const common::AudioFormat& format) noexcept;
+
+    /**
+     * Run an int32 device buffer through the ballistics (full scale = 1.0).
+     */
+    void process(const std::int32_t* buffer, std::size_t frameCount, const common::AudioFormat& format) noexcept;
+
+    /**
+     * Advance the ballistics over frameCount frames of silence in closed
+     * form: the release (or the VU decay) is applied once for the whole
+     * packet instead of per sample. Matches process() on zeros up to
+     * rounding.
+     */
+    void processSilence(std::size_t frameCount, const common::AudioFormat& format) noexcept;
+
+    /**
+     * Meter reading after the last processed sample (linear).
+     */
+    [[nodiscard]] const common::PeakValue& level() const noexcept { return m_level; }
+
+    /**
+     * Peak hold (linear): the highest reading, held for holdMs, then falling.
+     */
+    [[nodiscard]] const common::PeakValue& hold() const noexcept { return m_hold; }
+
+    [[nodiscard]] const BallisticsSettings& settings() const noexcept { return m_settings; }
+
+    /**
+     * Clear the readings and holds.
+     */
+    void reset() noexcept;
+
+    /**
+     * Use the SIMD path where there is one (the default), or force the
+     * scalar loop. Intended for tests and benchmarks comparing the two.
+     */
+    void setSimd(bool enabled) noexcept { m_simd = enabled; }
+
+private:
+    template <typename Sample>
+    void run(const Sample* buffer, std::size_t frameCount, const common::AudioFormat& format, float scale) noexcept;
+
+    /**
+     * End of a packet: flush denormals, publish the level and update the
+     * holds from the packet's highest reading (unscaled, lanes 0 and 1).
+     */
+    void finishPacket(float* packetMax, std::size_t frameCount, const common::AudioFormat& format) noexcept;
+
+    /**
+     * Update the holds from the highest reading of a packet.
+     */
+    void updateHold(const float* packetMax, std::size_t frameCount, const common::AudioFormat& format) noexcept;
+
+    BallisticsSettings m_settings;
+    common::SampleRate m_sampleRate = 0;
+    float m_attack = 1.0f;  // Per-sample one-pole coefficient toward a rising input
+    float m_release = 1.0f; // Per-sample multiplier while the input is below the reading
+    float m_vuScale = 1.0f; // Rectified average to sine RMS
+    bool m_simd = true;
+
+    // Per channel (SIMD lanes; only the first two are used)
+    alignas(16) float m_state[4] = {};  // Reading (peak types) or second VU stage
+    alignas(16) float m_stage[4] = {};  // First VU stage
+    std::int64_t m_holdFrames[2] = {};  // Hold time left per channel
+
+    common::PeakValue m_level;
+    common::PeakValue m_hold;
+};
+
+} // namespace openmeters::core::meters
@@ -0,0 +1,321 @@
+#include "integer-kernels.h"
+#include "../../common/cpu-features.h"
+#include <algorithm>
+
+#if defined(OPENMETERS_SIMD_X86)
+#include <immintrin.h>
+#endif
+
+namespace openmeters::core::meters::kernels {
+
+namespace {
+
+// Scalar accumulation over samples [begin, end); begin must be frame-aligned.
+// Results are merged into the caller's arrays so SIMD bodies can hand off tails.
+
+void peakInt16Scalar(const std::int16_t* s, std::size_t begin, std::size_t end,
+                     std::size_t channels, std::uint32_t* peaks) noexcept {
+    for (std::size_t i = begin; i < end; i += channels) {
+        for (std::size_t ch = 0; ch < channels; ++ch) {
+            const std::int32_t v = s[i + ch];
+            const auto mag = static_cast<std::uint32_t>(v < 0 ? -v : v);
+            peaks[ch] = std::max(peaks[ch], mag);
+        }
+    }
+}
+
+void sumSquaresInt16Scalar(const std::int16_t* s, std::size_t begin, std::size_t end,
+                           std::size_t channels, std::uint64_t* sums) noexcept {
+    for (std::size_t i = begin; i < end; i += channels) {
+        for (std::size_t ch = 0; ch < channels; ++ch) {
+            const std::int32_t v = s[i + ch];
+            sums[ch] += static_cast<std::uint64_t>(v * v);
+        }
+    }
+}
+
+void peakInt32Scalar(const std::int32_t* s, std::size_t begin, std::size_t end,
+                     std::size_t channels, std::uint32_t* peaks) noexcept {
+    for (std::size_t i = begin; i < end; i += channels) {
+        for (std::size_t ch = 0; ch < channels; ++ch) {
+            const std::int64_t v = s[i + ch];
+            const auto mag = static_cast<std::uint32_t>(v < 0 ? -v : v);
+            peaks[ch] = std::max(peaks[ch], mag);
+        }
+    }
+}
+
+void sumSquaresInt32Scalar(const std::int32_t* s, std::size_t begin, std::size_t end,
+                           std::size_t channels, std::uint64_t* sums) noexcept {
+    for (std::size_t i = begin; i < end; i += channels) {
+        for (std::size_t ch = 0; ch < channels; ++ch) {
+            const std::int64_t v = s[i + ch] >> 8;
+            sums[ch] += static_cast<std::uint64_t>(v * v);
+        }
+    }
+}
+
+#if defined(OPENMETERS_SIMD_X86)
+
+/**
+ * Fold per-lane max/min into per-channel peaks (lane j belongs to channel j % channels).
+ */
+template <std::size_t kLanes, typename T>
+void foldPeaks(const T (&maxLanes)[kLanes], const T (&minLanes)[kLanes],
+               std::size_t channels, std::uint32_t* peaks) noexcept {
+    for (std::size_t lane = 0; lane < kLanes; ++lane) {
+        const std::int64_t hi = maxLanes[lane];
+        const std::int64_t lo = minLanes[lane];
+        const auto mag = static_cast<std::uint32_t>(std::max(hi, -lo));
+        std::uint32_t& peak = peaks[lane % channels];
+        peak = std::max(peak, mag);
+    }
+}
+
+void peakInt16Sse2(const std::int16_t* s, std::size_t n, std::size_t channels, std::uint32_t* peaks) noexcept {
+    __m128i vmax = _mm_setzero_si128();
+    __m128i vmin = _mm_setzero_si128();
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i));
+        vmax = _mm_max_epi16(vmax, v);
+        vmin = _mm_min_epi16(vmin, v);
+    }
+    alignas(16) std::int16_t maxLanes[8];
+    alignas(16) std::int16_t minLanes[8];
+    _mm_store_si128(reinterpret_cast<__m128i*>(maxLanes), vmax);
+    _mm_store_si128(reinterpret_cast<__m128i*>(minLanes), vmin);
+    foldPeaks(maxLanes, minLanes, channels, peaks);
+    peakInt16Scalar(s, i, n, channels, peaks);
+}
+
+void sumSquaresInt16Sse2(const std::int16_t* s, std::size_t n, std::size_t channels, std::uint64_t* sums) noexcept {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i evenMask = _mm_set1_epi32(0x0000FFFF);
+    __m128i acc0 = _mm_setzero_si128(); // Mono: all samples; stereo: left
+    __m128i acc1 = _mm_setzero_si128(); // Stereo: right
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i));
+        if (channels == 1) {
+            // x0^2 + x1^2 fits in uint32 (max 2^31); widen as unsigned
+            const __m128i sq = _mm_madd_epi16(v, v);
+            acc0 = _mm_add_epi64(acc0, _mm_unpacklo_epi32(sq, zero));
+            acc0 = _mm_add_epi64(acc0, _mm_unpackhi_epi32(sq, zero));
+        } else {
+            // Zeroing the odd (right) lane of one operand leaves L^2 per 32-bit lane
+            const __m128i left = _mm_madd_epi16(v, _mm_and_si128(v, evenMask));
+            const __m128i right = _mm_madd_epi16(v, _mm_andnot_si128(evenMask, v));
+            acc0 = _mm_add_epi64(acc0, _mm_unpacklo_epi32(left, zero));
+            acc0 = _mm_add_epi64(acc0, _mm_unpackhi_epi32(left, zero));
+            acc1 = _mm_add_epi64(acc1, _mm_unpacklo_epi32(right, zero));
+            acc1 = _mm_add_epi64(acc1, _mm_unpackhi_epi32(right, zero));
+        }
+    }
+    alignas(16) std::uint64_t lanes0[2];
+    alignas(16) std::uint64_t lanes1[2];
+    _mm_store_si128(reinterpret_cast<__m128i*>(lanes0), acc0);
+    _mm_store_si128(reinterpret_cast<__m128i*>(lanes1), acc1);
+    sums[0] += lanes0[0] + lanes0[1];
+    if (channels == 2) {
+        sums[1] += lanes1[0] + lanes1[1];
+    }
+    sumSquaresInt16Scalar(s, i, n, channels, sums);
+}
+
+OPENMETERS_TARGET_AVX2
+void peakInt16Avx2(const std::int16_t* s, std::size_t n, std::size_t channels, std::uint32_t* peaks) noexcept {
+    __m256i vmax = _mm256_setzero_si256();
+    __m256i vmin = _mm256_setzero_si256();
+    std::size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + i));
+        vmax = _mm256_max_epi16(vmax, v);
+        vmin = _mm256_min_epi16(vmin, v);
+    }
+    alignas(32) std::int16_t maxLanes[16];
+    alignas(32) std::int16_t minLanes[16];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(maxLanes), vmax);
+    _mm256_store_si256(reinterpret_cast<__m256i*>(minLanes), vmin);
+    foldPeaks(maxLanes, minLanes, channels, peaks);
+    peakInt16Scalar(s, i, n, channels, peaks);
+}
+
+OPENMETERS_TARGET_AVX2
+void sumSquaresInt16Avx2(const std::int16_t* s, std::size_t n, std::size_t channels, std::uint64_t* sums) noexcept {
+    const __m256i evenMask = _mm256_set1_epi32(0x0000FFFF);
+    __m256i acc0 = _mm256_setzero_si256();
+    __m256i acc1 = _mm256_setzero_si256();
+    std::size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + i));
+        if (channels == 1) {
+            const __m256i sq = _mm256_madd_epi16(v, v);
+            acc0 = _mm256_add_epi64(acc0, _mm256_cvtepu32_epi64(_mm256_castsi256_si128(sq)));
+            acc0 = _mm256_add_epi64(acc0, _mm256_cvtepu32_epi64(_mm256_extracti128_si256(sq, 1)));
+        } else {
+            const __m256i left = _mm256_madd_epi16(v, _mm256_and_si256(v, evenMask));
+            const __m256i right = _mm256_madd_epi16(v, _mm256_andnot_si256(evenMask, v));
+            acc0 = _mm256_add_epi64(acc0, _mm256_cvtepu32_epi64(_mm256_castsi256_si128(left)));
+            acc0 = _mm256_add_epi64(acc0, _mm256_cvtepu32_epi64(_mm256_extracti128_si256(left, 1)));
+            acc1 = _mm256_add_epi64(acc1, _mm256_cvtepu32_epi64(_mm256_castsi256_si128(right)));
+            acc1 = _mm256_add_epi64(acc1, _mm256_cvtepu32_epi64(_mm256_extracti128_si256(right, 1)));
+        }
+    }
+    alignas(32) std::uint64_t lanes0[4];
+    alignas(32) std::uint64_t lanes1[4];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes0), acc0);
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes1), acc1);
+    sums[0] += lanes0[0] + lanes0[1] + lanes0[2] + lanes0[3];
+    if (channels == 2) {
+        sums[1] += lanes1[0] + lanes1[1] + lanes1[2] + lanes1[3];
+    }
+    sumSquaresInt16Scalar(s, i, n, channels, sums);
+}
+
+OPENMETERS_TARGET_AVX2
+void peakInt32Avx2(const std::int32_t* s, std::size_t n, std::size_t channels, std::uint32_t* peaks) noexcept {
+    // Track max and min separately: |INT32_MIN| does not fit a signed lane
+    __m256i vmax = _mm256_setzero_si256();
+    __m256i vmin = _mm256_setzero_si256();
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + i));
+        vmax = _mm256_max_epi32(vmax, v);
+        vmin = _mm256_min_epi32(vmin, v);
+    }
+    alignas(32) std::int32_t maxLanes[8];
+    alignas(32) std::int32_t minLanes[8];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(maxLanes), vmax);
+    _mm256_store_si256(reinterpret_cast<__m256i*>(minLanes), vmin);
+    foldPeaks(maxLanes, minLanes, channels, peaks);
+    peakInt32Scalar(s, i, n, channels, peaks);
+}
+
+OPENMETERS_TARGET_AVX2
+void sumSquaresInt32Avx2(const std::int32_t* s, std::size_t n, std::size_t channels, std::uint64_t* sums) noexcept {
+    __m256i accEven = _mm256_setzero_si256(); // Lanes 0,2,4,6 (left / mono)
+    __m256i accOdd = _mm256_setzero_si256();  // Lanes 1,3,5,7 (right / mono)
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const __m256i v = _mm256_srai_epi32(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + i)), 8
+        );
+        // mul_epi32 multiplies the low (even) int32 of each 64-bit lane into int64
+        accEven = _mm256_add_epi64(accEven, _mm256_mul_epi32(v, v));
+        const __m256i odd = _mm256_srli_epi64(v, 32);
+        accOdd = _mm256_add_epi64(accOdd, _mm256_mul_epi32(odd, odd));
+    }
+    alignas(32) std::uint64_t even[4];
+    alignas(32) std::uint64_t odd[4];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(even), accEven);
+    _mm256_store_si256(reinterpret_cast<__m256i*>(odd), accOdd);
+    const std::uint64_t evenSum = even[0] + even[1] + even[2] + even[3];
+    const std::uint64_t oddSum = odd[0] + odd[1] + odd[2] + odd[3];
+    if (channels == 1) {
+        sums[0] += evenSum + oddSum;
+    } else {
+        sums[0] += evenSum;
+        sums[1] += oddSum;
+    }
+    sumSquaresInt32Scalar(s, i, n, channels, sums);
+}
+
+#endif // OPENMETERS_SIMD_X86
+
+inline bool simdChannels(std::size_t channels) noexcept {
+    return channels == 1 || channels == 2;
+}
+
+} // namespace
+
+void peakInt16(const std::int16_t* samples, std::size_t frameCount, std::size_t channels,
+               std::uint32_t* peaks) noexcept {
+    if (!peaks || channels == 0) {
+        return;
+    }
+    std::fill(peaks, peaks + channels, 0u);
+    if (!samples || frameCount == 0) {
+        return;
+    }
+
+    const std::size_t n = frameCount * channels;
+#if defined(OPENMETERS_SIMD_X86)
+    if (simdChannels(channels)) {
+        if (common::cpuSupportsAvx2()) {
+            peakInt16Avx2(samples, n, channels, peaks);
+        } else {
+            peakInt16Sse2(samples, n, channels, peaks);
+        }
+        return;
+    }
+#endif
+    peakInt16Scalar(samples, 0, n, channels, peaks);
+}
+
+void sumSquaresInt16(const std::int16_t* samples, std::size_t frameCount, std::size_t channels,
+                     std::uint64_t* sums) noexcept {
+    if (!sums || channels == 0) {
+        return;
+    }
+    std::fill(sums, sums + channels, 0u);
+    if (!samples || frameCount == 0) {
+        return;
+    }
+
+    const std::size_t n = frameCount * channels;
+#if defined(OPENMETERS_SIMD_X86)
+    if (simdChannels(channels)) {
+        if (common::cpuSupportsAvx2()) {
+            sumSquaresInt16Avx2(samples, n, channels, sums);
+        } else {
+            sumSquaresInt16Sse2(samples, n, channels, sums);
+        }
+        return;
+    }
+#endif
+    sumSquaresInt16Scalar(samples, 0, n, channels, sums);
+}
+
+void peakInt32(const std::int32_t* samples, std::size_t frameCount, std::size_t channels,
+               std::uint32_t* peaks) noexcept {
+    if (!peaks || channels == 0) {
+        return;
+    }
+    std::fill(peaks, peaks + channels, 0u);
+    if (!samples || frameCount == 0) {
+        return;
+    }
+
+    const std::size_t n = frameCount * channels;
+#if defined(OPENMETERS_SIMD_X86)
+    // SSE2 has no 32-bit min/max; below AVX2 the scalar loop is as fast
+    if (simdChannels(channels) && common::cpuSupportsAvx2()) {
+        peakInt32Avx2(samples, n, channels, peaks);
+        return;
+    }
+#endif
+    peakInt32Scalar(samples, 0, n, channels, peaks);
+}
+
+void sumSquaresInt32(const std::int32_t* samples, std::size_t frameCount, std::size_t channels,
+                     std::uint64_t* sums) noexcept {
+    if (!sums || channels == 0) {
+        return;
+    }
+    std::fill(sums, sums + channels, 0u);
+    if (!samples || frameCount == 0) {
+        return;
+    }
+
+    const std::size_t n = frameCount * channels;
+#if defined(OPENMETERS_SIMD_X86)
+    if (simdChannels(channels) && common::cpuSupportsAvx2()) {
+        sumSquaresInt32Avx2(samples, n, channels, sums);
+        return;
+    }
+#endif
+    sumSquaresInt32Scalar(samples, 0, n, channels, sums);
+}
+
+} // namespace openmeters::core::meters::kernels
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace openmeters::core::meters::kernels {
+
+/**
+ * Integer-domain metering kernels.
+ * Operate directly on interleaved device PCM so meter-only consumers never
+ * need a float copy of the packet. SIMD paths (SSE2/AVX2) cover mono and
+ * stereo; other channel counts use the scalar path.
+ *
+ * Thread safety: Reentrant. Real-time safe (no allocation, no locks).
+ */
+
+/**
+ * Maximum absolute sample value per channel.
+ *
+ * @param samples Interleaved int16 samples
+ * @param frameCount Number of frames
+ * @param channels Channel count
+ * @param peaks Receives |x|max per channel (0..32768), one entry per channel
+ */
+void peakInt16(
+    const std::int16_t* samples,
+    std::size_t frameCount,
+    std::size_t channels,
+    std::uint32_t* peaks
+) noexcept;
+
+/**
+ * Sum of squared samples per channel (exact, 64-bit accumulation).
+ *
+ * @param samples Interleaved int16 samples
+ * @param frameCount Number of frames
+ * @param channels Channel count
+ * @param sums Receives the sum of x^2 per channel, one entry per channel
+ */
+void sumSquaresInt16(
+    const std::int16_t* samples,
+    std::size_t frameCount,
+    std::size_t channels,
+    std::uint64_t* sums
+) noexcept;
+
+/**
+ * Maximum absolute sample value per channel.
+ *
+ * @param samples Interleaved int32 samples (includes left-justified 24-in-32)
+ * @param frameCount Number of frames
+ * @param channels Channel count
+ * @param peaks Receives |x|max per channel (0..2^31), one entry per channel
+ */
+void peakInt32(
+    const std::int32_t* samples,
+    std::size_t frameCount,
+    std::size_t channels,
+    std::uint32_t* peaks
+) noexcept;
+
+/**
+ * Sum of squared samples per channel at 24-bit precision.
+ * Squares (x >> 8), so full-scale input stays exact in 64 bits for up to
+ * 2^18 frames per call (far beyond any device period).
+ *
+ * @param samples Interleaved int32 samples
+ * @param frameCount Number of frames
+ * @param channels Channel count
+ * @param sums Receives the sum of (x >> 8)^2 per channel, one entry per channel
+ */
+void sumSquaresInt32(
+    const std::int32_t* samples,
+    std::size_t frameCount,
+    std::size_t channels,
+    std::uint64_t* sums
+) noexcept;
+
+} // namespace openmeters::core::meters::kernels
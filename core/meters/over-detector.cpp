@@ -0,0 +1,212 @@
+#include "over-detector.h"
+#include "../../common/cpu-features.h"
+#include <algorithm>
+#include <cmath>
+
+#if defined(OPENMETERS_SIMD_X86)
+#include <immintrin.h>
+#endif
+
+namespace openmeters::core::meters {
+
+namespace {
+
+// Samples compared per mask
+constexpr std::size_t kChunk = 8;
+
+} // namespace
+
+OverDetector::OverDetector() noexcept {
+    configure(OverSettings{});
+}
+
+void OverDetector::configure(const OverSettings& settings) noexcept {
+    m_settings = settings;
+    m_settings.runLength = std::max<std::uint32_t>(1, settings.runLength);
+    m_threshold = static_cast<float>(std::pow(10.0, settings.thresholdDb / 20.0));
+
+    // Integer thresholds: smallest magnitude that reaches the linear one
+    const double threshold = static_cast<double>(m_threshold);
+    m_thresholdInt16 = static_cast<std::int32_t>(std::clamp(std::ceil(threshold * 32768.0), 1.0, 32768.0));
+    m_thresholdInt32 = static_cast<std::int64_t>(std::clamp(std::ceil(threshold * 2147483648.0), 1.0, 2147483648.0));
+}
+
+void OverDetector::process(const float* buffer, std::size_t frameCount, const common::AudioFormat& format, std::uint64_t captureTimeNs) noexcept {
+    run(buffer, frameCount, format, captureTimeNs);
+}
+
+void OverDetector::process(const std::int16_t* buffer, std::size_t frameCount, const common::AudioFormat& format, std::uint64_t captureTimeNs) noexcept {
+    run(buffer, frameCount, format, captureTimeNs);
+}
+
+void OverDetector::process(const std::int32_t* buffer, std::size_t frameCount, const common::AudioFormat& format, std::uint64_t captureTimeNs) noexcept {
+    run(buffer, frameCount, format, captureTimeNs);
+}
+
+bool OverDetector::isOver(float sample) const noexcept {
+    return std::abs(sample) >= m_threshold;
+}
+
+bool OverDetector::isOver(std::int16_t sample) const noexcept {
+    return std::abs(static_cast<std::int32_t>(sample)) >= m_thresholdInt16;
+}
+
+bool OverDetector::isOver(std::int32_t sample) const noexcept {
+    return std::abs(static_cast<std::int64_t>(sample)) >= m_thresholdInt32;
+}
+
+#if defined(OPENMETERS_SIMD_X86)
+
+std::uint32_t OverDetector::overMask(const float* samples) const noexcept {
+    const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+    const __m128 threshold = _mm_set1_ps(m_threshold);
+    const __m128 a = _mm_and_ps(_mm_loadu_ps(samples), absMask);
+    const __m128 b = _mm_and_ps(_mm_loadu_ps(samples + 4), absMask);
+    return static_cast<std::uint32_t>(_mm_movemask_ps(_mm_cmpge_ps(a, threshold))) |
+           (static_cast<std::uint32_t>(_mm_movemask_ps(_mm_cmpge_ps(b, threshold))) << 4);
+}
+
+std::uint32_t OverDetector::overMask(const std::int16_t* samples) const noexcept {
+    // |x| >= t  <=>  x > t - 1 or x < -(t - 1); no abs, so -32768 is safe
+    const __m128i above = _mm_set1_epi16(static_cast<std::int16_t>(m_thresholdInt16 - 1));
+    const __m128i below = _mm_set1_epi16(static_cast<std::int16_t>(-(m_thresholdInt16 - 1)));
+    const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(samples));
+    const __m128i over = _mm_or_si128(_mm_cmpgt_epi16(x, above), _mm_cmplt_epi16(x, below));
+    return static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_packs_epi16(over, _mm_setzero_si128())));
+}
+
+std::uint32_t OverDetector::overMask(const std::int32_t* samples) const noexcept {
+    const __m128i above = _mm_set1_epi32(static_cast<std::int32_t>(m_thresholdInt32 - 1));
+    const __m128i below = _mm_set1_epi32(static_cast<std::int32_t>(-(m_thresholdInt32 - 1)));
+    const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(samples));
+    const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(samples + 4));
+    const __m128i overA = _mm_or_si128(_mm_cmpgt_epi32(a, above), _mm_cmplt_epi32(a, below));
+    const __m128i overB = _mm_or_si128(_mm_cmpgt_epi32(b, above), _mm_cmplt_epi32(b, below));
+    const __m128i packed = _mm_packs_epi32(overA, overB);
+    return static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_packs_epi16(packed, _mm_setzero_si128())));
+}
+
+#else
+
+std::uint32_t OverDetector::overMask(const float* samples) const noexcept {
+    std::uint32_t mask = 0;
+    for (std::size_t i = 0; i < kChunk; ++i) {
+        mask |= static_cast<std::uint32_t>(isOver(samples[i])) << i;
+    }
+    return mask;
+}
+
+std::uint32_t OverDetector::overMask(const std::int16_t* samples) const noexcept {
+    std::uint32_t mask = 0;
+    for (std::size_t i = 0; i < kChunk; ++i) {
+        mask |= static_cast<std::uint32_t>(isOver(samples[i])) << i;
+    }
+    return mask;
+}
+
+std::uint32_t OverDetector::overMask(const std::int32_t* samples) const noexcept {
+    std::uint32_t mask = 0;
+    for (std::size_t i = 0; i < kChunk; ++i) {
+        mask |= static_cast<std::uint32_t>(isOver(samples[i])) << i;
+    }
+    return mask;
+}
+
+#endif
+
+template <typename Sample>
+void OverDetector::run(
+    const Sample* buffer,
+    std::size_t frameCount,
+    const common::AudioFormat& format,
+    std::uint64_t captureTimeNs
+) noexcept {
+    if (!buffer || frameCount == 0 || !format.isValid()) {
+        return;
+    }
+
+    const std::size_t channels = format.samplesPerFrame();
+    const std::size_t total = frameCount * channels;
+    const std::uint64_t packetStart = m_position;
+    const auto stepSample = [&](std::size_t index, bool over) noexcept {
+        step(index % channels, over, packetStart + index / channels, packetStart, captureTimeNs, format.sampleRate);
+    };
+
+    std::size_t i = 0;
+    for (; i + kChunk <= total; i += kChunk) {
+        const std::uint32_t mask = overMask(buffer + i);
+        if (mask == 0) {
+            // Every channel has a sample below the threshold here
+            m_run[0] = 0;
+            m_run[1] = 0;
+            continue;
+        }
+        for (std::size_t k = 0; k < kChunk; ++k) {
+            stepSample(i + k, ((mask >> k) & 1u) != 0);
+        }
+    }
+    for (; i < total; ++i) {
+        stepSample(i, isOver(buffer[i]));
+    }
+
+    m_position += frameCount;
+}
+
+void OverDetector::processSilence(std::size_t frameCount) noexcept {
+    if (frameCount == 0) {
+        return;
+    }
+    m_run[0] = 0;
+    m_run[1] = 0;
+    m_position += frameCount;
+}
+
+void OverDetector::step(
+    std::size_t channel,
+    bool over,
+    std::uint64_t frame,
+    std::uint64_t packetStart,
+    std::uint64_t captureTimeNs,
+    common::SampleRate sampleRate
+) noexcept {
+    std::uint32_t& run = m_run[channel];
+    if (!over) {
+        run = 0;
+        return;
+    }
+    if (run == 0) {
+        m_runStart[channel] = frame;
+    }
+    if (run > m_settings.runLength) {
+        return; // Already reported; stop counting so the run cannot wrap
+    }
+    if (++run != m_settings.runLength) {
+        return;
+    }
+
+    ++m_overCount;
+    if (!m_events) {
+        return;
+    }
+    common::OverEvent event;
+    event.position = m_runStart[channel];
+    event.channel = channel;
+    event.samples = run;
+    if (captureTimeNs != 0) {
+        // The run may have started in an earlier packet
+        const auto offsetFrames = static_cast<std::int64_t>(event.position) - static_cast<std::int64_t>(packetStart);
+        event.captureTimeNs = captureTimeNs + static_cast<std::uint64_t>(offsetFrames * 1000000000LL / sampleRate);
+    }
+    m_events->push(event);
+}
+
+void OverDetector::reset() noexcept {
+    m_run[0] = 0;
+    m_run[1] = 0;
+    m_runStart[0] = 0;
+    m_runStart[1] = 0;
+    m_position = 0;
+    m_overCount = 0;
+}
+
+} // namespace openmeters::core::meters
@@ -0,0 +1,130 @@
+#pragma once
+
+#include "../../common/types.h"
+#include "../../common/audio-format.h"
+#include "../../common/event-ring.h"
+#include "../../common/meter-values.h"
+
+namespace openmeters::core::meters {
+
+/**
+ * Over detection parameters.
+ */
+struct OverSettings {
+    float thresholdDb = -0.01f;    // Sample level that counts toward an over (dBFS)
+    std::uint32_t runLength = 3;   // Consecutive samples at or above the threshold that make an over
+
+    bool operator==(const OverSettings&) const = default;
+};
+
+/**
+ * Over (clip) detector: reports each run of runLength consecutive samples
+ * at or above the threshold on a channel, the way a hardware over
+ * indicator counts consecutive full-scale samples.
+ *
+ * The scan compares eight samples at a time (SSE2) and only walks samples
+ * one by one where something is over, so clean audio costs a compare and
+ * a mask test per eight samples. Runs carry across packets. Each over is
+ * pushed to the event ring once, when its run reaches runLength, with the
+ * stream position of its first sample.
+ *
+ * Thread safety: Not thread-safe. Must be called from a single thread
+ * (the event ring may be read from any thread). Real-time safe (no
+ * allocation, no locks).
+ */
+class OverDetector {
+public:
+    /**
+     * Detector with the default settings.
+     */
+    OverDetector() noexcept;
+
+    /**
+     * Set parameters. Runs in progress carry over.
+     */
+    void configure(const OverSettings& settings) noexcept;
+
+    /**
+     * Ring the overs are pushed to (nullptr: only count them).
+     * Set before processing starts.
+     */
+    void setEventSink(common::EventRing<common::OverEvent>* events) noexcept { m_events = events; }
+
+    /**
+     * Scan a buffer for overs.
+     *
+     * @param buffer Audio buffer (interleaved samples)
+     * @param frameCount Number of frames
+     * @param format Audio format descriptor
+     * @param captureTimeNs When the buffer's first frame was read from the
+     *        device (monotonicNanos()), or zero if unknown
+     */
+    void process(const float* buffer, std::size_t frameCount, const common::AudioFormat& format, std::uint64_t captureTimeNs = 0) noexcept;
+
+    /**
+     * Scan an int16 device buffer (full scale = 1.0).
+     */
+    void process(const std::int16_t* buffer, std::size_t frameCount, const common::AudioFormat& format, std::uint64_t captureTimeNs = 0) noexcept;
+
+    /**
+     * Scan an int32 device buffer (full scale = 1.0).
+     */
+    void process(const std::int32_t* buffer, std::size_t frameCount, const common::AudioFormat& format, std::uint64_t captureTimeNs = 0) noexcept;
+
+    /**
+     * Skip frameCount frames of silence: no sample is over, so runs end
+     * and only the position advances.
+     */
+    void processSilence(std::size_t frameCount) noexcept;
+
+    /**
+     * Frames scanned since the last reset (the position of the next frame).
+     */
+    [[nodiscard]] std::uint64_t position() const noexcept { return m_position; }
+
+    /**
+     * Overs detected since the last reset, all channels.
+     */
+    [[nodiscard]] std::uint64_t overCount() const noexcept { return m_overCount; }
+
+    [[nodiscard]] const OverSettings& settings() const noexcept { return m_settings; }
+
+    /**
+     * Clear runs, the position and the count.
+     */
+    void reset() noexcept;
+
+private:
+    template <typename Sample>
+    void run(const Sample* buffer, std::size_t frameCount, const common::AudioFormat& format, std::uint64_t captureTimeNs) noexcept;
+
+    /**
+     * Bit i set if sample i of the eight at samples is over.
+     */
+    [[nodiscard]] std::uint32_t overMask(const float* samples) const noexcept;
+    [[nodiscard]] std::uint32_t overMask(const std::int16_t* samples) const noexcept;
+    [[nodiscard]] std::uint32_t overMask(const std::int32_t* samples) const noexcept;
+
+    [[nodiscard]] bool isOver(float sample) const noexcept;
+    [[nodiscard]] bool isOver(std::int16_t sample) const noexcept;
+    [[nodiscard]] bool isOver(std::int32_t sample) const noexcept;
+
+    /**
+     * Advance the run of one channel by one sample.
+     */
+    void step(std::size_t channel, bool over, std::uint64_t frame, std::uint64_t packetStart,
+              std::uint64_t captureTimeNs, common::SampleRate sampleRate) noexcept;
+
+    OverSettings m_settings;
+    float m_threshold = 1.0f;              // Linear
+    std::int32_t m_thresholdInt16 = 32768; // Smallest |x| that is over, int16 scale
+    std::int64_t m_thresholdInt32 = 2147483648LL; // Same, int32 scale
+
+    std::uint32_t m_run[2] = {};           // Consecutive over samples per channel
+    std::uint64_t m_runStart[2] = {};      // Position of each run's first sample
+    std::uint64_t m_position = 0;
+    std::uint64_t m_overCount = 0;
+    common::EventRing<common::OverEvent>* m_events = nullptr;
+};
+
+} // namespace openmeters::core::meters
@@ -1,4 +1,5 @@
 #include "peak-meter.h"
+#include "integer-kernels.h"
 #include <algorithm>
 #include <cmath>
 
@@ -46,6 +47,52 @@ common::PeakValue PeakMeter::process(
     return result;
 }
 
+namespace {
+
+common::PeakValue peakFromIntegers(
+    const std::uint32_t* peaks,
+    const common::AudioFormat& format,
+    float scale
+) noexcept {
+    common::PeakValue result;
+    result.left = std::clamp(static_cast<float>(peaks[0]) * scale, 0.0f, 1.0f);
+    // Mono: use left value for right
+    result.right = (format.channelCount >= 2)
+        ? std::clamp(static_cast<float>(peaks[1]) * scale, 0.0f, 1.0f)
+        : result.left;
+    return result;
+}
+
+} // namespace
+
+common::PeakValue PeakMeter::process(
+    const std::int16_t* buffer,
+    std::size_t frameCount,
+    const common::AudioFormat& format
+) const noexcept {
+    if (!buffer || frameCount == 0 || !format.isValid()) {
+        return common::PeakValue{0.0f, 0.0f};
+    }
+    
+    std::uint32_t peaks[2] = {0, 0};
+    kernels::peakInt16(buffer, frameCount, format.samplesPerFrame(), peaks);
+    return peakFromIntegers(peaks, format, 1.0f / 32768.0f);
+}
+
+common::PeakValue PeakMeter::process(
+    const std::int32_t* buffer,
+    std::size_t frameCount,
+    const common::AudioFormat& format
+) const noexcept {
+    if (!buffer || frameCount == 0 || !format.isValid()) {
+        return common::PeakValue{0.0f, 0.0f};
+    }
+    
+    std::uint32_t peaks[2] = {0, 0};
+    kernels::peakInt32(buffer, frameCount, format.samplesPerFrame(), peaks);
+    return peakFromIntegers(peaks, format, 1.0f / 2147483648.0f);
+}
+
 void PeakMeter::reset() noexcept {
     // No internal state to reset currently
 }
@@ -1,54 +1,134 @@
 #include "rms-meter.h"
+#include "integer-kernels.h"
 #include <algorithm>
 #include <cmath>
 
 namespace openmeters::core::meters {
 
+namespace {
+
+common::RmsValue rmsFromSums(const double* sums, std::size_t frameCount) noexcept {
+    const double frameCountDouble = static_cast<double>(frameCount);
+    common::RmsValue result;
+    result.left = std::clamp(static_cast<float>(std::sqrt(sums[0] / frameCountDouble)), 0.0f, 1.0f);
+    result.right = std::clamp(static_cast<float>(std::sqrt(sums[1] / frameCountDouble)), 0.0f, 1.0f);
+    return result;
+}
+
+void sumsFromIntegers(
+    const std::uint64_t* integerSums,
+    const common::AudioFormat& format,
+    double fullScale,
+    double* sums
+) noexcept {
+    const double scale = 1.0 / (fullScale * fullScale);
+    sums[0] = static_cast<double>(integerSums[0]) * scale;
+    // Mono: use left value for right
+    sums[1] = (format.channelCount >= 2) ? static_cast<double>(integerSums[1]) * scale : sums[0];
+}
+
+} // namespace
+
 common::RmsValue RmsMeter::process(
     const float* buffer,
     std::size_t frameCount,
     const common::AudioFormat& format
 ) const noexcept {
-    common::RmsValue result{0.0f, 0.0f};
+    if (!buffer || frameCount == 0 || !format.isValid()) {
+        return common::RmsValue{0.0f, 0.0f};
+    }
     
+    double sums[2];
+    sumSquares(buffer, frameCount, format, sums);
+    return rmsFromSums(sums, frameCount);
+}
+
+common::RmsValue RmsMeter::process(
+    const std::int16_t* buffer,
+    std::size_t frameCount,
+    const common::AudioFormat& format
+) const noexcept {
     if (!buffer || frameCount == 0 || !format.isValid()) {
-        return result;
+        return common::RmsValue{0.0f, 0.0f};
     }
     
-    const std::size_t samplesPerFrame = format.samplesPerFrame();
+    double sums[2];
+    sumSquares(buffer, frameCount, format, sums);
+    return rmsFromSums(sums, frameCount);
+}
+
+common::RmsValue RmsMeter::process(
+    const std::int32_t* buffer,
+    std::size_t frameCount,
+    const common::AudioFormat& format
+) const noexcept {
+    if (!buffer || frameCount == 0 || !format.isValid()) {
+        return common::RmsValue{0.0f, 0.0f};
+    }
     
-    // Accumulate sum of squares
-    double leftSumSquares = 0.0;
-    double rightSumSquares = 0.0;
+    double sums[2];
+    sumSquares(buffer, frameCount, format, sums);
+    return rmsFromSums(sums, frameCount);
+}
+
+void RmsMeter::sumSquares(
+    const float* buffer,
+    std::size_t frameCount,
+    const common::AudioFormat& format,
+    double* sums
+) const noexcept {
+    sums[0] = 0.0;
+    sums[1] = 0.0;
+    if (!buffer || !format.isValid()) {
+        return;
+    }
     
-    // Process each frame
+    const std::size_t samplesPerFrame = format.samplesPerFrame();
     for (std::size_t frame = 0; frame < frameCount; ++frame) {
         const std::size_t offset = frame * samplesPerFrame;
         
         // Left channel (channel 0)
         const float leftSample = buffer[offset];
-        leftSumSquares += static_cast<double>(leftSample * leftSample);
+        sums[0] += static_cast<double>(leftSample * leftSample);
         
         // Right channel (channel 1) - if stereo
         if (format.channelCount >= 2) {
             const float rightSample = buffer[offset + 1];
-            rightSumSquares += static_cast<double>(rightSample * rightSample);
-        } else {
-            // Mono: use left value for right
-            rightSumSquares = leftSumSquares;
+            sums[1] += static_cast<double>(rightSample * rightSample);
         }
     }
     
-    // Compute RMS: sqrt(sum of squares / count)
-    const double frameCountDouble = static_cast<double>(frameCount);
-    result.left = static_cast<float>(std::sqrt(leftSumSquares / frameCountDouble));
-    result.right = static_cast<float>(std::sqrt(rightSumSquares / frameCountDouble));
-    
-    // Clamp to [0.0, 1.0]
-    result.left = std::clamp(result.left, 0.0f, 1.0f);
-    result.right = std::clamp(result.right, 0.0f, 1.0f);
-    
-    return result;
+    // Mono: use left value for right
+    if (format.channelCount < 2) {
+        sums[1] = sums[0];
+    }
+}
+
+void RmsMeter::sumSquares(
+    const std::int16_t* buffer,
+    std::size_t frameCount,
+    const common::AudioFormat& format,
+    double* sums
+) const noexcept {
+    std::uint64_t integerSums[2] = {0, 0};
+    if (buffer && format.isValid()) {
+        kernels::sumSquaresInt16(buffer, frameCount, format.samplesPerFrame(), integerSums);
+    }
+    sumsFromIntegers(integerSums, format, 32768.0, sums);
+}
+
+void RmsMeter::sumSquares(
+    const std::int32_t* buffer,
+    std::size_t frameCount,
+    const common::AudioFormat& format,
+    double* sums
+) const noexcept {
+    // Kernel squares the top 24 bits, so full scale is 2^23
+    std::uint64_t integerSums[2] = {0, 0};
+    if (buffer && format.isValid()) {
+        kernels::sumSquaresInt32(buffer, frameCount, format.samplesPerFrame(), integerSums);
+    }
+    sumsFromIntegers(integerSums, format, 8388608.0, sums);
 }
 
 void RmsMeter::reset() noexcept {
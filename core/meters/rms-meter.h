@@ -28,6 +28,48 @@ public:
         const common::AudioFormat& format
     ) const noexcept;
     
+    /**
+     * Process an int16 device buffer without converting to float.
+     * 
+     * @param buffer Audio buffer (interleaved int16 samples)
+     * @param frameCount Number of frames
+     * @param format Audio format descriptor
+     * @return RMS values per channel (full scale = 1.0)
+     */
+    [[nodiscard]] common::RmsValue process(
+        const std::int16_t* buffer,
+        std::size_t frameCount,
+        const common::AudioFormat& format
+    ) const noexcept;
+    
+    /**
+     * Process an int32 device buffer without converting to float.
+     * Also covers 24-bit audio delivered left-justified in 32-bit containers.
+     * 
+     * @param buffer Audio buffer (interleaved int32 samples)
+     * @param frameCount Number of frames
+     * @param format Audio format descriptor
+     * @return RMS values per channel (full scale = 1.0)
+     */
+    [[nodiscard]] common::RmsValue process(
+        const std::int32_t* buffer,
+        std::size_t frameCount,
+        const common::AudioFormat& format
+    ) const noexcept;
+    
+    /**
+     * Sum of squared samples per channel (full scale = 1.0), the energy
+     * a block contributes to a longer RMS window.
+     * 
+     * @param buffer Audio buffer (interleaved samples)
+     * @param frameCount Number of frames
+     * @param format Audio format descriptor
+     * @param sums Receives left and right sums (mono: right = left)
+     */
+    void sumSquares(const float* buffer, std::size_t frameCount, const common::AudioFormat& format, double* sums) const noexcept;
+    void sumSquares(const std::int16_t* buffer, std::size_t frameCount, const common::AudioFormat& format, double* sums) const noexcept;
+    void sumSquares(const std::int32_t* buffer, std::size_t frameCount, const common::AudioFormat& format, double* sums) const noexcept;
+    
     /**
      * Reset the meter (clears any internal state).
      * Currently a no-op, but included for future extensibility.
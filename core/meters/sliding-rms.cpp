@@ -0,0 +1,132 @@
+#include "sliding-rms.h"
+#include <algorithm>
+#include <cmath>
+
+namespace openmeters::core::meters {
+
+void SlidingRms::CompensatedSum::add(double value) noexcept {
+    const double total = sum + value;
+    if (std::abs(sum) >= std::abs(value)) {
+        compensation += (sum - total) + value;
+    } else {
+        compensation += (value - total) + sum;
+    }
+    sum = total;
+}
+
+void SlidingRms::configure(float windowMs, common::SampleRate sampleRate) noexcept {
+    if (windowMs == m_windowMs && sampleRate == m_sampleRate) {
+        return;
+    }
+    m_windowMs = windowMs;
+    m_sampleRate = sampleRate;
+
+    // Smallest block size that fits the window in the ring, then as many
+    // whole blocks as come closest to the requested length
+    const double rate = sampleRate > 0 ? static_cast<double>(sampleRate) : 48000.0;
+    const std::size_t windowFrames = std::max<std::size_t>(
+        1, static_cast<std::size_t>(std::max(0.0f, windowMs) * rate / 1000.0 + 0.5));
+    m_blockFrames = (windowFrames + kMaxBlocks - 1) / kMaxBlocks;
+    m_blockCount = std::clamp<std::size_t>(
+        static_cast<std::size_t>(static_cast<double>(windowFrames) / m_blockFrames + 0.5), 1, kMaxBlocks);
+    reset();
+}
+
+void SlidingRms::process(const float* buffer, std::size_t frameCount, const common::AudioFormat& format) noexcept {
+    run(buffer, frameCount, format);
+}
+
+void SlidingRms::process(const std::int16_t* buffer, std::size_t frameCount, const common::AudioFormat& format) noexcept {
+    run(buffer, frameCount, format);
+}
+
+void SlidingRms::process(const std::int32_t* buffer, std::size_t frameCount, const common::AudioFormat& format) noexcept {
+    run(buffer, frameCount, format);
+}
+
+template <typename Sample>
+void SlidingRms::run(const Sample* buffer, std::size_t frameCount, const common::AudioFormat& format) noexcept {
+    if (!buffer || frameCount == 0 || !format.isValid()) {
+        return;
+    }
+    if (format.sampleRate != m_sampleRate) {
+        configure(m_windowMs, format.sampleRate);
+    }
+
+    // Split the packet at block boundaries
+    const std::size_t samplesPerFrame = format.samplesPerFrame();
+    std::size_t offset = 0;
+    while (offset < frameCount) {
+        const std::size_t count = std::min(frameCount - offset, m_blockFrames - m_partialFrames);
+        double sums[2];
+        m_meter.sumSquares(buffer + offset * samplesPerFrame, count, format, sums);
+        m_partial[0] += sums[0];
+        m_partial[1] += sums[1];
+        m_partialFrames += count;
+        offset += count;
+
+        if (m_partialFrames == m_blockFrames) {
+            pushBlock();
+        }
+    }
+}
+
+void SlidingRms::processSilence(std::size_t frameCount, const common::AudioFormat& format) noexcept {
+    if (frameCount == 0 || !format.isValid()) {
+        return;
+    }
+    if (format.sampleRate != m_sampleRate) {
+        configure(m_windowMs, format.sampleRate);
+    }
+
+    const std::size_t totalFrames = m_partialFrames + frameCount;
+    const std::size_t blocks = totalFrames / m_blockFrames;
+    if (blocks > m_blockCount) {
+        // Every block in the window is silent: exact zeros, no residue
+        const std::size_t filled = m_blockCount;
+        reset();
+        m_filled = filled;
+    } else {
+        for (std::size_t i = 0; i < blocks; ++i) {
+            pushBlock(); // The first completes the partial block, the rest are empty
+        }
+    }
+    m_partialFrames = totalFrames % m_blockFrames;
+}
+
+void SlidingRms::pushBlock() noexcept {
+    double* slot = m_blocks[m_next];
+    for (std::size_t ch = 0; ch < 2; ++ch) {
+        if (m_filled == m_blockCount) {
+            m_window[ch].add(-slot[ch]);
+        }
+        m_window[ch].add(m_partial[ch]);
+        slot[ch] = m_partial[ch];
+        m_partial[ch] = 0.0;
+    }
+    m_partialFrames = 0;
+    m_next = (m_next + 1) % m_blockCount;
+    m_filled = std::min(m_filled + 1, m_blockCount);
+
+    // Energies are never negative; clamp what is left of rounding
+    const double frames = static_cast<double>(m_filled * m_blockFrames);
+    m_value.left = std::clamp(static_cast<float>(std::sqrt(std::max(0.0, m_window[0].value()) / frames)), 0.0f, 1.0f);
+    m_value.right = std::clamp(static_cast<float>(std::sqrt(std::max(0.0, m_window[1].value()) / frames)), 0.0f, 1.0f);
+}
+
+void SlidingRms::reset() noexcept {
+    for (auto& block : m_blocks) {
+        block[0] = 0.0;
+        block[1] = 0.0;
+    }
+    m_next = 0;
+    m_filled = 0;
+    m_partial[0] = 0.0;
+    m_partial[1] = 0.0;
+    m_partialFrames = 0;
+    m_window[0] = {};
+    m_window[1] = {};
+    m_value = {};
+}
+
+} // namespace openmeters::core::meters
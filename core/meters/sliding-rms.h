@@ -0,0 +1,121 @@
+#pragma once
+
+#include "rms-meter.h"
+#include "../../common/types.h"
+#include "../../common/audio-format.h"
+#include "../../common/meter-values.h"
+
+namespace openmeters::core::meters {
+
+/**
+ * RMS over a fixed integration time (for example 50 ms, 300 ms or 3 s),
+ * independent of the device period.
+ *
+ * The window is split into up to kMaxBlocks equal blocks. Each block's
+ * energy (sum of squares) goes into a ring; running sums add the newest
+ * block and subtract the one leaving the window, so a reading costs O(1)
+ * per block whatever the window length. The running sums are compensated
+ * (Neumaier), so adding and removing energies for days does not leave a
+ * residue that would show up once the signal gets quiet.
+ *
+ * The reading covers the last complete blocks (the window is rounded to a
+ * whole number of blocks, within 1 % of the requested length), so it
+ * moves once per block and is the same for any packet size.
+ *
+ * Thread safety: Not thread-safe. Must be called from a single thread.
+ * Real-time safe (no allocation, no locks).
+ */
+class SlidingRms {
+public:
+    static constexpr std::size_t kMaxBlocks = 128;
+
+    /**
+     * Set the integration time. Clears the window if the time or the
+     * sample rate changed.
+     *
+     * @param windowMs Integration time in milliseconds
+     * @param sampleRate Sample rate of the audio to be processed
+     */
+    void configure(float windowMs, common::SampleRate sampleRate) noexcept;
+
+    /**
+     * Add a buffer to the window.
+     *
+     * @param buffer Audio buffer (interleaved samples)
+     * @param frameCount Number of frames
+     * @param format Audio format descriptor (rate must match configure())
+     */
+    void process(const float* buffer, std::size_t frameCount, const common::AudioFormat& format) noexcept;
+
+    /**
+     * Add an int16 device buffer to the window (full scale = 1.0).
+     */
+    void process(const std::int16_t* buffer, std::size_t frameCount, const common::AudioFormat& format) noexcept;
+
+    /**
+     * Add an int32 device buffer to the window (full scale = 1.0).
+     */
+    void process(const std::int32_t* buffer, std::size_t frameCount, const common::AudioFormat& format) noexcept;
+
+    /**
+     * Add frameCount frames of silence without touching samples: the
+     * blocks they complete are pushed as zero energy, and silence longer
+     * than the window clears it outright. Same reading as process() on zeros.
+     */
+    void processSilence(std::size_t frameCount, const common::AudioFormat& format) noexcept;
+
+    /**
+     * RMS over the window (over the blocks seen so far until it is full).
+     */
+    [[nodiscard]] const common::RmsValue& value() const noexcept { return m_value; }
+
+    [[nodiscard]] float windowMs() const noexcept { return m_windowMs; }
+
+    /**
+     * Frames the reading covers once the window is full.
+     */
+    [[nodiscard]] std::size_t windowFrames() const noexcept { return m_blockFrames * m_blockCount; }
+
+    /**
+     * Clear the window and the reading.
+     */
+    void reset() noexcept;
+
+private:
+    /**
+     * Sum that carries the rounding error of each addition (Neumaier).
+     */
+    struct CompensatedSum {
+        double sum = 0.0;
+        double compensation = 0.0;
+
+        void add(double value) noexcept;
+        [[nodiscard]] double value() const noexcept { return sum + compensation; }
+    };
+
+    template <typename Sample>
+    void run(const Sample* buffer, std::size_t frameCount, const common::AudioFormat& format) noexcept;
+
+    /**
+     * Move the finished block into the ring and update the reading.
+     */
+    void pushBlock() noexcept;
+
+    RmsMeter m_meter;
+    float m_windowMs = 300.0f;
+    common::SampleRate m_sampleRate = 0;
+    std::size_t m_blockFrames = 1;
+    std::size_t m_blockCount = 1;
+
+    double m_blocks[kMaxBlocks][2] = {}; // Energy per block and channel
+    std::size_t m_next = 0;              // Ring slot the next block goes to
+    std::size_t m_filled = 0;            // Complete blocks in the window
+
+    double m_partial[2] = {};            // Energy of the block being filled
+    std::size_t m_partialFrames = 0;
+
+    CompensatedSum m_window[2];
+    common::RmsValue m_value;
+};
+
+} // namespace openmeters::core::meters
@@ -0,0 +1,76 @@
+#!/usr/bin/env python3
+"""Compare two bench_openmeters JSON result files.
+
+Usage: compare_bench.py baseline.json current.json [--threshold 0.10] [--filter text]
+
+Cases are matched by name. A case regresses when its median time grows by
+more than the threshold (fraction). Exits with status 1 if any case
+regressed, so it can gate CI or a pre-merge check.
+"""
+
+import argparse
+import json
+import sys
+
+
+def load(path):
+    with open(path, encoding="utf-8") as f:
+        data = json.load(f)
+    return data.get("context", {}), {b["name"]: b for b in data.get("benchmarks", [])}
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("baseline")
+    parser.add_argument("current")
+    parser.add_argument("--threshold", type=float, default=0.10,
+                        help="relative slowdown that counts as a regression (default 0.10)")
+    parser.add_argument("--filter", default="", help="only compare cases whose name contains this text")
+    parser.add_argument("--all", action="store_true", help="print unchanged cases too")
+    args = parser.parse_args()
+
+    base_ctx, base = load(args.baseline)
+    curr_ctx, curr = load(args.current)
+
+    for key in ("compiler", "simdLevel", "buildType"):
+        if base_ctx.get(key) != curr_ctx.get(key):
+            print(f"warning: {key} differs: {base_ctx.get(key)} -> {curr_ctx.get(key)}")
+
+    regressions = []
+    improvements = []
+    rows = []
+    for name in sorted(base.keys() & curr.keys()):
+        if args.filter not in name:
+            continue
+        before = base[name]["nsPerOp"]
+        after = curr[name]["nsPerOp"]
+        if before <= 0:
+            continue
+        change = after / before - 1.0
+        rows.append((name, before, after, change))
+        if change > args.threshold:
+            regressions.append(name)
+        elif change < -args.threshold:
+            improvements.append(name)
+
+    flagged = set(regressions) | set(improvements)
+    for name, before, after, change in rows:
+        if not args.all and name not in flagged:
+            continue
+        marker = "REGRESSION" if name in regressions else ("improved" if name in improvements else "")
+        print(f"{name:<72} {before:12.1f} {after:12.1f} {change:+8.1%} {marker}")
+
+    missing = sorted(base.keys() - curr.keys())
+    added = sorted(curr.keys() - base.keys())
+    if missing:
+        print(f"{len(missing)} case(s) missing from current run")
+    if added:
+        print(f"{len(added)} new case(s) in current run")
+
+    print(f"{len(rows)} compared, {len(regressions)} regressed, {len(improvements)} improved "
+          f"(threshold {args.threshold:.0%})")
+    return 1 if regressions else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
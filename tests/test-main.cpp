@@ -0,0 +1,19 @@
+// Catch2 entry point (compiled once, linked into every test executable)
+#define CATCH_CONFIG_RUNNER
+#include <catch2/catch.hpp>
+#include "../../common/rt-check.h"
+#include <cstdio>
+
+int main(int argc, char* argv[]) {
+    const int result = Catch::Session().run(argc, argv);
+
+    // OPENMETERS_RT_CHECK builds: any allocation or lock on a real-time
+    // thread fails the run, even if every assertion passed
+    const auto violations = openmeters::common::rtViolationCount();
+    if (violations != 0) {
+        std::fprintf(stderr, "rt-check: %llu real-time violation(s)\n",
+                     static_cast<unsigned long long>(violations));
+        return result != 0 ? result : 1;
+    }
+    return result;
+}
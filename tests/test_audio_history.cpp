@@ -0,0 +1,293 @@
+#include <catch2/catch.hpp>
+#include "../../common/config.h"
+#include "../../core/audio/audio-engine.h"
+#include "../../core/audio/audio-history.h"
+#include "../../core/audio/synthetic-source.h"
+#include "../../core/audio/wav-writer.h"
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace openmeters;
+
+namespace {
+
+constexpr common::AudioFormat kStereo{48000, 2};
+
+// Stereo frames whose left sample is the frame position and right is its negation
+std::vector<float> rampFrames(std::uint64_t start, std::size_t frames) {
+    std::vector<float> samples(frames * 2);
+    for (std::size_t i = 0; i < frames; ++i) {
+        samples[i * 2] = static_cast<float>(start + i);
+        samples[i * 2 + 1] = -static_cast<float>(start + i);
+    }
+    return samples;
+}
+
+void feed(core::audio::AudioHistory& history, std::size_t frames) {
+    const std::vector<float> samples = rampFrames(history.position(), frames);
+    history.onAudioData(samples.data(), frames, kStereo);
+}
+
+bool isRamp(const float* samples, std::uint64_t start, std::size_t frames) {
+    for (std::size_t i = 0; i < frames; ++i) {
+        if (samples[i * 2] != static_cast<float>(start + i) || samples[i * 2 + 1] != -static_cast<float>(start + i)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::string readTag(std::ifstream& file) {
+    char tag[4] = {};
+    file.read(tag, 4);
+    return std::string(tag, 4);
+}
+
+} // namespace
+
+TEST_CASE("AudioHistory - copies ranges across the wrap", "[history]") {
+    core::audio::AudioHistory history;
+    REQUIRE(history.reserve(0.01, kStereo)); // 480 frames
+    REQUIRE(history.capacityFrames() == 480);
+
+    feed(history, 300);
+    feed(history, 300); // Wraps
+    REQUIRE(history.position() == 600);
+
+    std::vector<float> dest(480 * 2);
+    std::uint64_t copiedStart = 0;
+    REQUIRE(history.copy(400, 150, dest.data(), &copiedStart) == 150);
+    REQUIRE(copiedStart == 400);
+    REQUIRE(isRamp(dest.data(), 400, 150));
+
+    // Everything still held
+    REQUIRE(history.copy(120, 480, dest.data(), &copiedStart) == 480);
+    REQUIRE(isRamp(dest.data(), 120, 480));
+
+    // Frames not yet captured are left out
+    REQUIRE(history.copy(590, 50, dest.data(), &copiedStart) == 10);
+    REQUIRE(isRamp(dest.data(), 590, 10));
+}
+
+TEST_CASE("AudioHistory - overwritten frames are trimmed", "[history]") {
+    core::audio::AudioHistory history;
+    REQUIRE(history.reserve(0.01, kStereo));
+    feed(history, 1000);
+
+    std::vector<float> dest(480 * 2);
+    std::uint64_t copiedStart = 0;
+    REQUIRE(history.copy(0, 600, dest.data(), &copiedStart) == 80);
+    REQUIRE(copiedStart == 520);
+    REQUIRE(history.copy(0, 1000, dest.data(), &copiedStart) == 480);
+    REQUIRE(copiedStart == 520);
+    REQUIRE(isRamp(dest.data(), 520, 480));
+
+    REQUIRE(history.copy(0, 100, dest.data(), &copiedStart) == 0);
+
+    // A packet longer than the history keeps its tail
+    feed(history, 2000);
+    REQUIRE(history.copy(2000, 1000, dest.data(), &copiedStart) == 480);
+    REQUIRE(copiedStart == 2520);
+    REQUIRE(isRamp(dest.data(), 2520, 480));
+}
+
+TEST_CASE("AudioHistory - other formats are dropped", "[history]") {
+    core::audio::AudioHistory history;
+    REQUIRE(history.reserve(0.01, kStereo));
+
+    const std::vector<float> samples(100, 0.5f);
+    history.onAudioData(samples.data(), 100, common::AudioFormat{44100, 1});
+    REQUIRE(history.position() == 0);
+    REQUIRE(history.droppedPackets() == 1);
+
+    core::audio::AudioHistory unreserved;
+    unreserved.onAudioData(samples.data(), 50, kStereo);
+    REQUIRE(unreserved.droppedPackets() == 1);
+    REQUIRE_FALSE(unreserved.requestDumpLast("unused.wav", 1.0));
+}
+
+TEST_CASE("AudioHistory - dumps a range to WAV", "[history]") {
+    const std::filesystem::path dir = std::filesystem::temp_directory_path() / "openmeters_history_test";
+    std::filesystem::remove_all(dir);
+    const std::filesystem::path path = dir / "dump.wav";
+
+    core::audio::AudioHistory history;
+    REQUIRE(history.reserve(0.1, kStereo));
+    feed(history, 4800);
+
+    REQUIRE(history.requestDump(path.string(), 1000, 256));
+    history.waitForDumps();
+    REQUIRE(history.dumpsWritten() == 1);
+
+    // Header layout is covered by the WavWriter tests; audio starts after it
+    REQUIRE(std::filesystem::file_size(path) == core::audio::WavWriter::kDataOffset + 256 * 8);
+    std::ifstream file(path, std::ios::binary);
+    REQUIRE(file.is_open());
+    REQUIRE(readTag(file) == "RIFF");
+    file.seekg(core::audio::WavWriter::kDataOffset);
+
+    std::vector<float> samples(256 * 2);
+    file.read(reinterpret_cast<char*>(samples.data()), static_cast<std::streamsize>(samples.size() * sizeof(float)));
+    REQUIRE(file.gcount() == static_cast<std::streamsize>(samples.size() * sizeof(float)));
+    REQUIRE(isRamp(samples.data(), 1000, 256));
+
+    file.close();
+    std::filesystem::remove_all(dir);
+}
+
+TEST_CASE("AudioHistory - a dump of future audio waits for it", "[history]") {
+    const std::filesystem::path path = std::filesystem::temp_directory_path() / "openmeters_history_future.wav";
+    std::filesystem::remove(path);
+
+    core::audio::AudioHistory history;
+    REQUIRE(history.reserve(0.1, kStereo));
+    feed(history, 480);
+
+    // Ends 960 frames after the current position
+    REQUIRE(history.requestDump(path.string(), 0, 1440));
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    REQUIRE(history.dumpsWritten() == 0);
+
+    feed(history, 480);
+    feed(history, 480);
+    history.waitForDumps();
+    REQUIRE(history.dumpsWritten() == 1);
+    REQUIRE(std::filesystem::file_size(path) == core::audio::WavWriter::kDataOffset + 1440 * 8);
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("AudioHistory - after the stream ends, a future dump writes what is held", "[history]") {
+    const std::filesystem::path path = std::filesystem::temp_directory_path() / "openmeters_history_ended.wav";
+    std::filesystem::remove(path);
+
+    core::audio::AudioHistory history;
+    REQUIRE(history.reserve(1.0, kStereo));
+    feed(history, 480);
+
+    // Ends a second after the current position; without endStream() the
+    // dump would wait that long plus the slack
+    REQUIRE(history.requestDump(path.string(), 0, 48480));
+    const auto start = std::chrono::steady_clock::now();
+    history.endStream();
+    history.waitForDumps();
+    REQUIRE(std::chrono::steady_clock::now() - start < std::chrono::milliseconds(500));
+
+    REQUIRE(history.dumpsWritten() == 1);
+    REQUIRE(std::filesystem::file_size(path) == core::audio::WavWriter::kDataOffset + 480 * 8);
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("AudioHistory - concurrent copies never return torn audio", "[history]") {
+    core::audio::AudioHistory history;
+    REQUIRE(history.reserve(0.01, kStereo));
+
+    std::atomic<bool> done{false};
+    std::thread writer([&] {
+        // Frame positions stay exact in float up to 2^24
+        while (history.position() < (1u << 22)) {
+            feed(history, 97);
+        }
+        done = true;
+    });
+
+    std::vector<float> dest(480 * 2);
+    std::size_t copies = 0;
+    bool torn = false;
+    while (!done && !torn) {
+        // The oldest frames held are the next ones the writer overwrites
+        const std::uint64_t position = history.position();
+        const std::uint64_t start = position > 480 ? position - 480 : 0;
+        std::uint64_t copiedStart = 0;
+        const std::size_t frames = history.copy(start, 480, dest.data(), &copiedStart);
+        torn = !isRamp(dest.data(), copiedStart, frames);
+        copies += frames > 0;
+    }
+    writer.join();
+
+    REQUIRE_FALSE(torn);
+    REQUIRE(copies > 0);
+}
+
+TEST_CASE("AudioHistory - registered on the engine, holds the captured audio", "[history][audio]") {
+    core::audio::SyntheticSourceConfig source;
+    source.format = kStereo;
+    source.sampleFormat = core::audio::SampleFormat::Int16; // Metered without a float copy
+    source.blockLimit = 20;
+    source.paced = false;
+    core::audio::AudioEngine engine(std::make_unique<core::audio::SyntheticSource>(source));
+    REQUIRE(engine.initialize());
+
+    core::audio::AudioHistory history;
+    REQUIRE(history.reserve(1.0, kStereo));
+    engine.registerCallback(&history);
+    REQUIRE(engine.start());
+    while (engine.isCapturing()) {
+        std::this_thread::yield();
+    }
+    engine.stop();
+
+    REQUIRE(history.position() == 20 * source.framesPerBlock);
+    REQUIRE(history.droppedPackets() == 0);
+
+    engine.unregisterCallback(&history);
+    engine.shutdown();
+}
+
+TEST_CASE("AudioHistory - overs locate their audio after the engine restarts", "[history][audio]") {
+    common::ConfigManager::reset();
+    common::AppConfig config;
+    config.overThresholdDb = -1.0f;
+    config.overSampleCount = 1;
+    common::ConfigManager::publish(config);
+
+    core::audio::SyntheticSourceConfig source;
+    source.format = kStereo;
+    source.amplitude = 1.0f;
+    source.blockLimit = 20;
+    source.paced = false;
+    core::audio::AudioEngine engine(std::make_unique<core::audio::SyntheticSource>(source));
+    REQUIRE(engine.initialize());
+
+    const auto runToEnd = [&engine] {
+        REQUIRE(engine.start());
+        while (engine.isCapturing()) {
+            std::this_thread::yield();
+        }
+        engine.stop();
+    };
+
+    // A first run, then a new history for the second (as the daemon does
+    // when it re-applies its settings)
+    runToEnd();
+    common::OverEvent events[64];
+    std::uint64_t cursor = 0;
+    while (engine.readOverEvents(cursor, events, 64, nullptr) != 0) {
+    }
+
+    core::audio::AudioHistory history;
+    REQUIRE(history.reserve(1.0, kStereo));
+    engine.registerCallback(&history);
+    runToEnd();
+
+    const std::size_t count = engine.readOverEvents(cursor, events, 64, nullptr);
+    REQUIRE(count > 0);
+    for (std::size_t i = 0; i < count; ++i) {
+        REQUIRE(events[i].position < history.position());
+        float frame[2] = {};
+        std::uint64_t copiedStart = 0;
+        REQUIRE(history.copy(events[i].position, 1, frame, &copiedStart) == 1);
+        REQUIRE(copiedStart == events[i].position);
+        REQUIRE(std::abs(frame[0]) >= std::pow(10.0f, -1.0f / 20.0f));
+    }
+
+    engine.unregisterCallback(&history);
+    engine.shutdown();
+    common::ConfigManager::reset();
+}
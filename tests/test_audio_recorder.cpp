@@ -0,0 +1,227 @@
+#include <catch2/catch.hpp>
+#include "../../core/audio/audio-recorder.h"
+#include "../../core/audio/wav-writer.h"
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace openmeters;
+using core::audio::SampleFormat;
+using core::audio::WavWriter;
+
+namespace {
+
+constexpr common::AudioFormat kStereo{48000, 2};
+
+struct Chunk {
+    std::string tag;
+    std::size_t offset = 0; // Of the chunk payload
+    std::uint32_t size = 0;
+};
+
+std::uint32_t readU32(const std::uint8_t* p) {
+    return static_cast<std::uint32_t>(p[0]) | (static_cast<std::uint32_t>(p[1]) << 8) |
+           (static_cast<std::uint32_t>(p[2]) << 16) | (static_cast<std::uint32_t>(p[3]) << 24);
+}
+
+std::uint64_t readU64(const std::uint8_t* p) {
+    return static_cast<std::uint64_t>(readU32(p)) | (static_cast<std::uint64_t>(readU32(p + 4)) << 32);
+}
+
+std::vector<std::uint8_t> readFile(const std::filesystem::path& path) {
+    std::ifstream file(path, std::ios::binary);
+    return {std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+}
+
+// Chunks after "WAVE", up to and including "data"
+std::vector<Chunk> walkChunks(const std::uint8_t* bytes, std::size_t size) {
+    std::vector<Chunk> chunks;
+    std::size_t offset = 12;
+    while (offset + 8 <= size) {
+        Chunk chunk{std::string(reinterpret_cast<const char*>(bytes + offset), 4), offset + 8, readU32(bytes + offset + 4)};
+        chunks.push_back(chunk);
+        if (chunk.tag == "data") {
+            break;
+        }
+        offset = chunk.offset + chunk.size + (chunk.size & 1);
+    }
+    return chunks;
+}
+
+std::vector<float> sineSignal(std::size_t samples) {
+    std::vector<float> signal(samples);
+    for (std::size_t i = 0; i < samples; ++i) {
+        signal[i] = std::sin(static_cast<float>(i) * 0.013f) * 0.8f;
+    }
+    return signal;
+}
+
+std::filesystem::path tempPath(const char* name) {
+    return std::filesystem::temp_directory_path() / name;
+}
+
+} // namespace
+
+TEST_CASE("WavWriter - float header layout", "[wav]") {
+    const auto path = tempPath("openmeters_wav_float.wav");
+    const std::vector<float> samples = sineSignal(100 * 2);
+    {
+        WavWriter writer;
+        REQUIRE(writer.open(path.string(), kStereo));
+        REQUIRE(writer.write(samples.data(), 100));
+        REQUIRE(writer.close());
+    }
+
+    const std::vector<std::uint8_t> bytes = readFile(path);
+    REQUIRE(bytes.size() == WavWriter::kDataOffset + 100 * 8);
+    REQUIRE(std::memcmp(bytes.data(), "RIFF", 4) == 0);
+    REQUIRE(readU32(bytes.data() + 4) == bytes.size() - 8);
+    REQUIRE(std::memcmp(bytes.data() + 8, "WAVE", 4) == 0);
+
+    const std::vector<Chunk> chunks = walkChunks(bytes.data(), bytes.size());
+    REQUIRE(chunks.size() == 5);
+    REQUIRE(chunks[0].tag == "JUNK"); // Room for ds64
+    REQUIRE(chunks[0].size == 28);
+    REQUIRE(chunks[1].tag == "fmt ");
+    const std::uint8_t* fmt = bytes.data() + chunks[1].offset;
+    REQUIRE((fmt[0] | fmt[1] << 8) == 3); // IEEE float
+    REQUIRE((fmt[2] | fmt[3] << 8) == 2);
+    REQUIRE(readU32(fmt + 4) == 48000);
+    REQUIRE(readU32(fmt + 8) == 48000 * 8);
+    REQUIRE((fmt[12] | fmt[13] << 8) == 8);
+    REQUIRE((fmt[14] | fmt[15] << 8) == 32);
+    REQUIRE(chunks[2].tag == "fact");
+    REQUIRE(readU32(bytes.data() + chunks[2].offset) == 100);
+    REQUIRE(chunks[3].tag == "JUNK");
+    REQUIRE(chunks[4].tag == "data");
+    REQUIRE(chunks[4].offset == WavWriter::kDataOffset);
+    REQUIRE(chunks[4].size == 100 * 8);
+    REQUIRE(std::memcmp(bytes.data() + WavWriter::kDataOffset, samples.data(), 100 * 8) == 0);
+
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("WavWriter - 24-bit samples across block boundaries", "[wav]") {
+    const auto path = tempPath("openmeters_wav_int24.wav");
+    const common::AudioFormat mono{48000, 1};
+
+    // Over two blocks of 3-byte samples, in odd packet sizes, ending on an odd byte count
+    const std::size_t frames = 2 * WavWriter::kBlockBytes / 3 + 12345;
+    const std::vector<float> samples = sineSignal(frames);
+    {
+        WavWriter writer;
+        REQUIRE(writer.open(path.string(), mono, SampleFormat::Int24Packed));
+        for (std::size_t done = 0; done < frames;) {
+            const std::size_t packet = std::min<std::size_t>(997, frames - done);
+            REQUIRE(writer.write(samples.data() + done, packet));
+            done += packet;
+        }
+        REQUIRE(writer.framesWritten() == frames);
+        REQUIRE(writer.close());
+    }
+
+    std::vector<std::uint8_t> expected(frames * 3);
+    core::audio::convertFromFloat32(samples.data(), expected.data(), SampleFormat::Int24Packed, frames);
+
+    const std::vector<std::uint8_t> bytes = readFile(path);
+    REQUIRE(bytes.size() == WavWriter::kDataOffset + frames * 3 + 1); // Pad byte
+    REQUIRE(readU32(bytes.data() + 4) == bytes.size() - 8);
+    const std::vector<Chunk> chunks = walkChunks(bytes.data(), bytes.size());
+    REQUIRE(chunks.size() == 4); // No fact chunk for PCM
+    REQUIRE(chunks[1].tag == "fmt ");
+    REQUIRE((bytes[chunks[1].offset] | bytes[chunks[1].offset + 1] << 8) == 1);
+    REQUIRE((bytes[chunks[1].offset + 14] | bytes[chunks[1].offset + 15] << 8) == 24);
+    REQUIRE(chunks[3].size == frames * 3);
+    REQUIRE(std::memcmp(bytes.data() + WavWriter::kDataOffset, expected.data(), expected.size()) == 0);
+
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("WavWriter - headers switch to RF64 past 4 GB", "[wav]") {
+    std::vector<std::uint8_t> header(WavWriter::kDataOffset);
+
+    // Largest stereo float file that still fits a RIFF size field
+    const std::uint64_t riffFrames = (0xFFFFFFFFull - (WavWriter::kDataOffset - 8)) / 8;
+    REQUIRE(WavWriter::buildHeader(header.data(), kStereo, SampleFormat::Float32, riffFrames));
+    REQUIRE(std::memcmp(header.data(), "RIFF", 4) == 0);
+    REQUIRE(std::memcmp(header.data() + 12, "JUNK", 4) == 0);
+
+    const std::uint64_t frames = riffFrames + 1;
+    REQUIRE(WavWriter::buildHeader(header.data(), kStereo, SampleFormat::Float32, frames));
+    REQUIRE(std::memcmp(header.data(), "RF64", 4) == 0);
+    REQUIRE(readU32(header.data() + 4) == 0xFFFFFFFFu);
+    const std::vector<Chunk> chunks = walkChunks(header.data(), header.size());
+    REQUIRE(chunks[0].tag == "ds64");
+    REQUIRE(readU64(header.data() + chunks[0].offset) == WavWriter::kDataOffset - 8 + frames * 8);
+    REQUIRE(readU64(header.data() + chunks[0].offset + 8) == frames * 8);
+    REQUIRE(readU64(header.data() + chunks[0].offset + 16) == frames);
+    REQUIRE(chunks.back().tag == "data");
+    REQUIRE(chunks.back().size == 0xFFFFFFFFu);
+
+    REQUIRE_FALSE(WavWriter::buildHeader(header.data(), kStereo, SampleFormat::Float64, 0));
+}
+
+TEST_CASE("AudioRecorder - records packets between start and stop", "[recorder]") {
+    const std::filesystem::path dir = tempPath("openmeters_recorder_test");
+    std::filesystem::remove_all(dir);
+    const auto path = dir / "take.wav";
+
+    core::audio::AudioRecorder recorder;
+    REQUIRE_FALSE(recorder.start(path.string()));
+    REQUIRE(recorder.reserve(1.0, kStereo));
+
+    const std::vector<float> samples = sineSignal(48000 * 2);
+    recorder.onAudioData(samples.data(), 480, kStereo); // Not recording yet
+    REQUIRE(recorder.droppedFrames() == 0);
+
+    REQUIRE(recorder.start(path.string()));
+    REQUIRE(recorder.isRecording());
+    REQUIRE_FALSE(recorder.start(path.string()));
+
+    // Capture-sized packets from another thread, faster than real time
+    std::thread capture([&] {
+        for (std::size_t frame = 0; frame + 441 <= 48000; frame += 441) {
+            recorder.onAudioData(samples.data() + frame * 2, 441, kStereo);
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+        }
+    });
+    capture.join();
+    recorder.stop();
+    REQUIRE_FALSE(recorder.isRecording());
+    recorder.onAudioData(samples.data(), 480, kStereo); // Stopped
+
+    const std::size_t frames = 48000 / 441 * 441;
+    REQUIRE(recorder.framesWritten() == frames);
+    REQUIRE(recorder.droppedFrames() == 0);
+
+    const std::vector<std::uint8_t> bytes = readFile(path);
+    REQUIRE(bytes.size() == WavWriter::kDataOffset + frames * 8);
+    REQUIRE(std::memcmp(bytes.data() + WavWriter::kDataOffset, samples.data(), frames * 8) == 0);
+
+    std::filesystem::remove_all(dir);
+}
+
+TEST_CASE("AudioRecorder - drops whole packets it cannot buffer", "[recorder]") {
+    const auto path = tempPath("openmeters_recorder_drops.wav");
+
+    core::audio::AudioRecorder recorder;
+    REQUIRE(recorder.reserve(0.005, kStereo)); // 240 frames (ring rounds up to 256)
+    REQUIRE(recorder.start(path.string(), SampleFormat::Int16));
+
+    const std::vector<float> samples = sineSignal(480 * 2);
+    recorder.onAudioData(samples.data(), 480, kStereo);                  // Larger than the ring
+    recorder.onAudioData(samples.data(), 240, common::AudioFormat{44100, 2}); // Other format
+    recorder.onAudioData(samples.data(), 100, kStereo);
+    recorder.stop();
+
+    REQUIRE(recorder.droppedFrames() == 480 + 240);
+    REQUIRE(recorder.framesWritten() == 100);
+    REQUIRE(std::filesystem::file_size(path) == WavWriter::kDataOffset + 100 * 4);
+
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,266 @@
+#include <catch2/catch.hpp>
+#include "../../core/meters/ballistics.h"
+#include "../../common/audio-format.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+using namespace openmeters;
+
+namespace {
+
+constexpr common::SampleRate kRate = 48000;
+
+std::size_t frames(double seconds) {
+    return static_cast<std::size_t>(seconds * kRate + 0.5);
+}
+
+// Stereo buffer holding the same value in both channels
+std::vector<float> constant(float value, std::size_t frameCount) {
+    return std::vector<float>(frameCount * 2, value);
+}
+
+std::vector<float> sine(float amplitude, double frequency, std::size_t frameCount) {
+    std::vector<float> buffer(frameCount * 2);
+    for (std::size_t i = 0; i < frameCount; ++i) {
+        const float s = amplitude * static_cast<float>(std::sin(2.0 * 3.141592653589793 * frequency * i / kRate));
+        buffer[i * 2] = s;
+        buffer[i * 2 + 1] = s;
+    }
+    return buffer;
+}
+
+// Feed a stereo buffer in packets of the given size
+void feed(core::meters::Ballistics& meter, const std::vector<float>& buffer, std::size_t packet = 480) {
+    common::AudioFormat format;
+    format.sampleRate = kRate;
+    format.channelCount = 2;
+    const std::size_t total = buffer.size() / 2;
+    for (std::size_t start = 0; start < total; start += packet) {
+        meter.process(buffer.data() + start * 2, std::min(packet, total - start), format);
+    }
+}
+
+core::meters::Ballistics makeMeter(core::meters::BallisticsType type) {
+    core::meters::Ballistics meter;
+    core::meters::BallisticsSettings settings;
+    settings.type = type;
+    meter.configure(settings, kRate);
+    return meter;
+}
+
+double toDb(float value) {
+    return 20.0 * std::log10(value);
+}
+
+} // namespace
+
+TEST_CASE("Ballistics - digital peak", "[meters][ballistics]") {
+    auto meter = makeMeter(core::meters::BallisticsType::DigitalPeak);
+
+    SECTION("Instant attack") {
+        feed(meter, constant(0.5f, 1));
+        REQUIRE(meter.level().left == Approx(0.5f));
+        REQUIRE(meter.level().right == Approx(0.5f));
+    }
+
+    SECTION("Releases at the configured rate") {
+        feed(meter, constant(0.5f, 480));
+        feed(meter, constant(0.0f, frames(1.0)));
+        REQUIRE(toDb(meter.level().left) - toDb(0.5f) == Approx(-20.0).margin(0.05));
+    }
+
+    SECTION("Attack time integrates short bursts") {
+        core::meters::BallisticsSettings settings;
+        settings.attackMs = 5.0f;
+        meter.configure(settings, kRate);
+        feed(meter, constant(1.0f, frames(0.005)));
+        REQUIRE(toDb(meter.level().left) == Approx(-2.0).margin(0.05));
+    }
+}
+
+TEST_CASE("Ballistics - IEC 60268-10 PPM", "[meters][ballistics]") {
+    SECTION("Type I: 5 ms burst reads 2 dB low, returns 20 dB in 1.7 s") {
+        auto meter = makeMeter(core::meters::BallisticsType::PpmType1);
+        feed(meter, constant(1.0f, frames(0.005)));
+        REQUIRE(toDb(meter.level().left) == Approx(-2.0).margin(0.05));
+
+        feed(meter, constant(1.0f, frames(0.5)));
+        REQUIRE(meter.level().left == Approx(1.0f).margin(0.001));
+        feed(meter, constant(0.0f, frames(1.7)));
+        REQUIRE(toDb(meter.level().left) == Approx(-20.0).margin(0.05));
+    }
+
+    SECTION("Type II: 10 ms burst reads 2 dB low, returns 24 dB in 2.8 s") {
+        auto meter = makeMeter(core::meters::BallisticsType::PpmType2);
+        feed(meter, constant(1.0f, frames(0.010)));
+        REQUIRE(toDb(meter.level().left) == Approx(-2.0).margin(0.05));
+
+        feed(meter, constant(1.0f, frames(0.5)));
+        feed(meter, constant(0.0f, frames(2.8)));
+        REQUIRE(toDb(meter.level().left) == Approx(-24.0).margin(0.05));
+    }
+
+    SECTION("Steady sine reads its peak") {
+        auto meter = makeMeter(core::meters::BallisticsType::PpmType1);
+        feed(meter, sine(0.5f, 1000.0, frames(0.5)));
+        REQUIRE(toDb(meter.level().left) - toDb(0.5f) == Approx(0.0).margin(0.5));
+    }
+}
+
+TEST_CASE("Ballistics - IEC 60268-17 VU", "[meters][ballistics]") {
+    auto meter = makeMeter(core::meters::BallisticsType::Vu);
+
+    SECTION("Steady sine reads its RMS") {
+        feed(meter, sine(1.0f, 1000.0, frames(2.0)));
+        REQUIRE(meter.level().left == Approx(0.7071f).epsilon(0.01));
+    }
+
+    SECTION("Reaches 99 % of the steady reading in 300 ms") {
+        const float steady = 0.5f * 1.1107207f;
+        feed(meter, constant(0.5f, frames(0.3)));
+        REQUIRE(meter.level().left == Approx(0.99f * steady).epsilon(0.001));
+        feed(meter, constant(0.5f, frames(2.0)));
+        REQUIRE(meter.level().left == Approx(steady).epsilon(0.001));
+    }
+}
+
+TEST_CASE("Ballistics - peak hold", "[meters][ballistics]") {
+    core::meters::Ballistics meter;
+    core::meters::BallisticsSettings settings;
+    settings.releaseDbPerSecond = 100000.0f; // Reading gone within a packet
+    settings.holdMs = 100.0f;
+    settings.holdDecay = 0.5f;
+    settings.updateRate = 100.0f;            // One update per 10 ms packet
+    meter.configure(settings, kRate);
+
+    feed(meter, constant(0.8f, 480));
+    REQUIRE(meter.hold().left == Approx(0.8f));
+
+    // Held for 100 ms, then halved every 10 ms
+    feed(meter, constant(0.0f, frames(0.1)));
+    REQUIRE(meter.level().left < 0.001f);
+    REQUIRE(meter.hold().left == Approx(0.8f));
+    feed(meter, constant(0.0f, 480));
+    REQUIRE(meter.hold().left == Approx(0.4f));
+    feed(meter, constant(0.0f, 480));
+    REQUIRE(meter.hold().left == Approx(0.2f));
+
+    // A new peak restarts the hold
+    feed(meter, constant(0.3f, 480));
+    REQUIRE(meter.hold().left == Approx(0.3f));
+
+    meter.reset();
+    REQUIRE(meter.level().left == 0.0f);
+    REQUIRE(meter.hold().left == 0.0f);
+}
+
+TEST_CASE("Ballistics - independent of packet size", "[meters][ballistics]") {
+    const auto signal = sine(0.7f, 440.0, frames(0.25));
+    for (const auto type : {core::meters::BallisticsType::DigitalPeak, core::meters::BallisticsType::PpmType1,
+                            core::meters::BallisticsType::PpmType2, core::meters::BallisticsType::Vu}) {
+        auto large = makeMeter(type);
+        auto small = makeMeter(type);
+        feed(large, signal, 480);
+        feed(small, signal, 37);
+        REQUIRE(small.level().left == Approx(large.level().left).epsilon(1e-5));
+        REQUIRE(small.level().right == Approx(large.level().right).epsilon(1e-5));
+    }
+}
+
+TEST_CASE("Ballistics - silence without samples", "[meters][ballistics]") {
+    common::AudioFormat format;
+    format.sampleRate = kRate;
+    format.channelCount = 2;
+
+    // A VU cut off while still rising keeps rising into the silence
+    const auto signal = constant(0.5f, frames(0.05));
+    for (const auto type : {core::meters::BallisticsType::DigitalPeak, core::meters::BallisticsType::PpmType1,
+                            core::meters::BallisticsType::PpmType2, core::meters::BallisticsType::Vu}) {
+        auto zeros = makeMeter(type);
+        auto silent = makeMeter(type);
+        feed(zeros, signal);
+        feed(silent, signal);
+        for (int i = 0; i < 50; ++i) {
+            feed(zeros, constant(0.0f, 480));
+            silent.processSilence(480, format);
+            REQUIRE(silent.level().left == Approx(zeros.level().left).epsilon(1e-4));
+            REQUIRE(silent.level().right == Approx(zeros.level().right).epsilon(1e-4));
+            REQUIRE(silent.hold().left == Approx(zeros.hold().left).epsilon(1e-4));
+        }
+    }
+}
+
+TEST_CASE("Ballistics - integer input and mono", "[meters][ballistics]") {
+    common::AudioFormat stereo;
+    stereo.sampleRate = kRate;
+    stereo.channelCount = 2;
+
+    auto fromFloat = makeMeter(core::meters::BallisticsType::PpmType1);
+    auto fromInt16 = makeMeter(core::meters::BallisticsType::PpmType1);
+    auto fromInt32 = makeMeter(core::meters::BallisticsType::PpmType1);
+    std::vector<float> f(960);
+    std::vector<std::int16_t> i16(960);
+    std::vector<std::int32_t> i32(960);
+    for (std::size_t i = 0; i < f.size(); ++i) {
+        i16[i] = static_cast<std::int16_t>((i % 7) * 4000 - 12000);
+        f[i] = static_cast<float>(i16[i]) / 32768.0f;
+        i32[i] = static_cast<std::int32_t>(i16[i]) << 16;
+    }
+    fromFloat.process(f.data(), 480, stereo);
+    fromInt16.process(i16.data(), 480, stereo);
+    fromInt32.process(i32.data(), 480, stereo);
+    REQUIRE(fromInt16.level().left == Approx(fromFloat.level().left));
+    REQUIRE(fromInt32.level().right == Approx(fromFloat.level().right));
+
+    common::AudioFormat mono;
+    mono.sampleRate = kRate;
+    mono.channelCount = 1;
+    auto monoMeter = makeMeter(core::meters::BallisticsType::DigitalPeak);
+    monoMeter.process(f.data(), 960, mono);
+    REQUIRE(monoMeter.level().right == monoMeter.level().left);
+    REQUIRE(monoMeter.hold().right == monoMeter.hold().left);
+}
+
+TEST_CASE("Ballistics - reconfiguring keeps the reading", "[meters][ballistics]") {
+    auto meter = makeMeter(core::meters::BallisticsType::DigitalPeak);
+    feed(meter, constant(0.6f, 480));
+
+    core::meters::BallisticsSettings settings;
+    settings.type = core::meters::BallisticsType::PpmType2;
+    meter.configure(settings, kRate);
+    feed(meter, constant(0.0f, 1));
+    REQUIRE(meter.level().left == Approx(0.6f).epsilon(0.001));
+    REQUIRE(core::meters::parseBallisticsType("ppm2") == core::meters::BallisticsType::PpmType2);
+    REQUIRE(core::meters::parseBallisticsType("bogus") == core::meters::BallisticsType::DigitalPeak);
+}
+
+TEST_CASE("Ballistics - SIMD and scalar paths agree", "[meters][ballistics]") {
+    std::vector<float> buffer = sine(0.8f, 440.0, frames(0.5));
+    for (std::size_t i = 1; i < buffer.size(); i += 2) {
+        buffer[i] *= 0.25f; // Right channel quieter
+    }
+    common::AudioFormat mono;
+    mono.sampleRate = kRate;
+    mono.channelCount = 1;
+    std::vector<std::int16_t> i16(960);
+    for (std::size_t i = 0; i < i16.size(); ++i) {
+        i16[i] = static_cast<std::int16_t>((i % 11) * 3000 - 15000);
+    }
+
+    for (const auto type : {core::meters::BallisticsType::PpmType1, core::meters::BallisticsType::Vu}) {
+        auto simd = makeMeter(type);
+        auto scalar = makeMeter(type);
+        scalar.setSimd(false);
+        feed(simd, buffer);
+        feed(scalar, buffer);
+        REQUIRE(simd.level().left == Approx(scalar.level().left));
+        REQUIRE(simd.level().right == Approx(scalar.level().right));
+        REQUIRE(simd.hold().left == Approx(scalar.hold().left));
+
+        simd.process(i16.data(), i16.size(), mono);
+        scalar.process(i16.data(), i16.size(), mono);
+        REQUIRE(simd.level().left == Approx(scalar.level().left));
+        REQUIRE(simd.level().right == Approx(scalar.level().right));
+    }
+}
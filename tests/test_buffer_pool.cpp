@@ -0,0 +1,54 @@
+#include <catch2/catch.hpp>
+#include "../../common/buffer-pool.h"
+#include "../../common/realtime-scope.h"
+#include <cstdint>
+
+using namespace openmeters;
+
+TEST_CASE("BufferPool - aligned blocks from a fixed arena", "[common]") {
+    common::BufferPool pool;
+    REQUIRE(pool.reserve(1024));
+    REQUIRE(pool.capacity() == 1024);
+
+    SECTION("Blocks are aligned and disjoint") {
+        auto* a = pool.acquireArray<float>(3);
+        auto* b = pool.acquireArray<float>(5);
+        REQUIRE(a != nullptr);
+        REQUIRE(b != nullptr);
+        REQUIRE(reinterpret_cast<std::uintptr_t>(a) % common::BufferPool::kDefaultAlignment == 0);
+        REQUIRE(reinterpret_cast<std::uintptr_t>(b) % common::BufferPool::kDefaultAlignment == 0);
+        REQUIRE(b >= a + 3);
+    }
+
+    SECTION("Exhaustion returns null instead of allocating") {
+        REQUIRE(pool.acquire(1000) != nullptr);
+        REQUIRE(pool.acquire(64) == nullptr);
+    }
+
+    SECTION("Reset reuses the same storage") {
+        void* first = pool.acquire(512);
+        REQUIRE(pool.acquire(256) != nullptr);
+        REQUIRE(pool.highWaterMark() >= 768);
+        pool.reset();
+        REQUIRE(pool.used() == 0);
+        REQUIRE(pool.acquire(512) == first);
+        REQUIRE(pool.highWaterMark() >= 768);
+    }
+
+    SECTION("Rejects invalid alignment") {
+        REQUIRE(pool.acquire(16, 3) == nullptr);
+    }
+}
+
+TEST_CASE("RealtimeScope - nests per thread", "[common]") {
+    REQUIRE_FALSE(common::isRealtimeThread());
+    {
+        const common::RealtimeScope outer;
+        {
+            const common::RealtimeScope inner;
+            REQUIRE(common::isRealtimeThread());
+        }
+        REQUIRE(common::isRealtimeThread());
+    }
+    REQUIRE_FALSE(common::isRealtimeThread());
+}
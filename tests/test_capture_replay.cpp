@@ -0,0 +1,214 @@
+#include <catch2/catch.hpp>
+#include "../../core/audio/capture-trace.h"
+#include "../../core/audio/replay-source.h"
+#include "../../core/audio/audio-engine.h"
+#include "../../common/spsc-ring.h"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <limits>
+#include <memory>
+#include <thread>
+
+using namespace openmeters;
+namespace CaptureFlags = core::audio::CaptureFlags;
+
+namespace {
+
+struct PacketSpec {
+    std::uint32_t frames;
+    std::uint32_t flags;
+    std::uint64_t arrivalMs;
+};
+
+// Irregular sizes, a silent packet and a discontinuity, as WASAPI delivers them
+constexpr PacketSpec kPattern[] = {
+    {480, 0, 0},
+    {441, 0, 10},
+    {512, CaptureFlags::Silent, 21},
+    {480, CaptureFlags::DataDiscontinuity, 40},
+    {96, 0, 42},
+};
+
+std::filesystem::path writeTrace(const char* name) {
+    const auto path = std::filesystem::temp_directory_path() / name;
+
+    common::AudioFormat format;
+    format.channelCount = 2;
+    core::audio::CaptureTraceWriter writer;
+    REQUIRE(writer.open(path.string(), core::audio::SampleFormat::Int16, format));
+
+    std::vector<std::int16_t> samples(1024 * 2);
+    std::uint64_t position = 0;
+    for (const PacketSpec& spec : kPattern) {
+        for (std::size_t i = 0; i < spec.frames * 2; ++i) {
+            samples[i] = static_cast<std::int16_t>(position + i);
+        }
+        core::audio::CapturePacketInfo info;
+        info.arrivalNs = spec.arrivalMs * 1000000;
+        info.devicePosition = position;
+        info.frameCount = spec.frames;
+        info.flags = spec.flags;
+        REQUIRE(writer.recordPacket(info, samples.data()));
+        position += spec.frames;
+    }
+    writer.close();
+    REQUIRE(writer.droppedPackets() == 0);
+    return path;
+}
+
+// Records packet sizes on the replay thread into fixed storage
+class PacketLog : public core::audio::IAudioDataCallback {
+public:
+    bool onAudioBlock(const core::audio::AudioBlock& block) override {
+        const int index = m_count.load();
+        if (index < static_cast<int>(m_frames.size())) {
+            m_frames[index] = static_cast<std::uint32_t>(block.frameCount);
+            m_float[index] = block.sampleFormat == core::audio::SampleFormat::Float32;
+            m_silent[index] = block.silent && !block.data;
+            m_count.store(index + 1);
+        }
+        return true;
+    }
+
+    void onAudioData(const float*, std::size_t, const common::AudioFormat&) override {}
+    void onMeterData(const common::MeterSnapshot&) override {}
+
+    std::array<std::uint32_t, 16> m_frames{};
+    std::array<bool, 16> m_float{};
+    std::array<bool, 16> m_silent{};
+    std::atomic<int> m_count{0};
+};
+
+void waitForEnd(const core::audio::IAudioSource& source) {
+    while (source.isCapturing()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+} // namespace
+
+TEST_CASE("SpscByteRing - framed records", "[replay]") {
+    common::SpscByteRing ring;
+    REQUIRE(ring.reserve(100));
+    REQUIRE(ring.capacity() == 128);
+
+    const char header[4] = {'a', 'b', 'c', 'd'};
+    const char payload[60] = {};
+    REQUIRE(ring.write(header, 4, payload, 60));
+    REQUIRE(ring.write(header, 4, payload, 60));
+    REQUIRE_FALSE(ring.write(header, 4)); // Full: record rejected whole
+
+    char out[100];
+    REQUIRE(ring.read(out, 100) == 100);
+    REQUIRE(ring.readable() == 28);
+    REQUIRE(ring.write(header, 4, payload, 60)); // Wraps around
+    REQUIRE(ring.read(out, 100) == 92);
+    REQUIRE(ring.readable() == 0);
+}
+
+TEST_CASE("Capture trace - round trip", "[replay]") {
+    const auto path = writeTrace("openmeters-roundtrip.omtrace");
+
+    core::audio::CaptureTraceReader reader;
+    REQUIRE(reader.open(path.string()));
+    REQUIRE(reader.sampleFormat() == core::audio::SampleFormat::Int16);
+    REQUIRE(reader.format().channelCount == 2);
+    REQUIRE(reader.maxFrameCount() == 512);
+
+    const auto& packets = reader.packets();
+    REQUIRE(packets.size() == std::size(kPattern));
+    std::uint64_t position = 0;
+    for (std::size_t i = 0; i < packets.size(); ++i) {
+        REQUIRE(packets[i].info.frameCount == kPattern[i].frames);
+        REQUIRE(packets[i].info.flags == kPattern[i].flags);
+        REQUIRE(packets[i].info.arrivalNs == kPattern[i].arrivalMs * 1000000);
+        REQUIRE(packets[i].info.devicePosition == position);
+        if (kPattern[i].flags & CaptureFlags::Silent) {
+            REQUIRE(packets[i].data == nullptr);
+        } else {
+            const auto* samples = static_cast<const std::int16_t*>(packets[i].data);
+            REQUIRE(samples[1] == static_cast<std::int16_t>(position + 1));
+        }
+        position += kPattern[i].frames;
+    }
+
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("Capture trace - open fails when the buffer cannot be allocated", "[replay]") {
+    const auto path = std::filesystem::temp_directory_path() / "openmeters-nobuffer.omtrace";
+    core::audio::CaptureTraceWriter writer;
+    REQUIRE_FALSE(writer.open(path.string(), core::audio::SampleFormat::Int16, common::AudioFormat{48000, 2},
+                              std::numeric_limits<std::size_t>::max()));
+    REQUIRE_FALSE(std::filesystem::exists(path));
+    REQUIRE_FALSE(writer.isOpen());
+}
+
+TEST_CASE("ReplaySource - reproduces the packet pattern", "[replay]") {
+    const auto path = writeTrace("openmeters-replay.omtrace");
+
+    SECTION("Accelerated") {
+        core::audio::ReplaySourceConfig config;
+        config.tracePath = path.string();
+        config.speed = 0.0;
+
+        core::audio::ReplaySource source(config);
+        PacketLog log;
+        REQUIRE(source.initialize());
+        source.registerCallback(&log);
+        REQUIRE(source.start());
+        waitForEnd(source);
+        source.stop();
+
+        REQUIRE(log.m_count.load() == static_cast<int>(std::size(kPattern)));
+        for (std::size_t i = 0; i < std::size(kPattern); ++i) {
+            REQUIRE(log.m_frames[i] == kPattern[i].frames);
+            // Silent packets arrive as flagged float32 without samples, the rest in native int16
+            REQUIRE(log.m_float[i] == ((kPattern[i].flags & CaptureFlags::Silent) != 0));
+            REQUIRE(log.m_silent[i] == ((kPattern[i].flags & CaptureFlags::Silent) != 0));
+        }
+    }
+
+    SECTION("Paced keeps recorded timing") {
+        core::audio::ReplaySourceConfig config;
+        config.tracePath = path.string();
+        config.speed = 4.0;
+
+        core::audio::ReplaySource source(config);
+        REQUIRE(source.initialize());
+        const auto start = std::chrono::steady_clock::now();
+        REQUIRE(source.start());
+        waitForEnd(source);
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+        source.stop();
+
+        REQUIRE(source.packetsDelivered() == std::size(kPattern));
+        REQUIRE(elapsed >= std::chrono::microseconds(42000 / 4));
+    }
+
+    SECTION("Drives the engine") {
+        core::audio::ReplaySourceConfig config;
+        config.tracePath = path.string();
+        config.speed = 0.0;
+
+        core::audio::AudioEngine engine(std::make_unique<core::audio::ReplaySource>(config));
+        REQUIRE(engine.initialize());
+        REQUIRE(engine.getFormat().channelCount == 2);
+        REQUIRE(engine.start());
+        while (engine.isCapturing()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+
+        // Recorded device flags show up in the engine stats
+        const auto stats = engine.getStats();
+        REQUIRE(stats.packets == std::size(kPattern));
+        REQUIRE(stats.frames == 480 + 441 + 512 + 480 + 96);
+        REQUIRE(stats.discontinuities == 1);
+        REQUIRE(stats.silentPackets == 1);
+        engine.shutdown();
+    }
+
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,280 @@
+#include <catch2/catch.hpp>
+#include "../../common/config.h"
+#include "../../common/file-watcher.h"
+#include "../../core/audio/audio-engine.h"
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+#include <vector>
+
+using namespace openmeters;
+
+namespace {
+
+std::filesystem::path tempConfigPath(const char* name) {
+    return std::filesystem::temp_directory_path() / name;
+}
+
+void writeFile(const std::filesystem::path& path, const std::string& text) {
+    std::ofstream file(path, std::ios::trunc);
+    file << text;
+}
+
+// Delivers packets synchronously from the test thread
+class ManualSource : public core::audio::IAudioSource {
+public:
+    bool initialize() override { return true; }
+    bool start() override { return true; }
+    void stop() override {}
+    void shutdown() override {}
+    [[nodiscard]] common::AudioFormat getFormat() const override { return {}; }
+    [[nodiscard]] bool isCapturing() const override { return true; }
+    void registerCallback(core::audio::IAudioDataCallback* callback) override { m_callback = callback; }
+    void unregisterCallback(core::audio::IAudioDataCallback*) override { m_callback = nullptr; }
+    void setStatsCollector(core::audio::StatsCollector*) override {}
+
+    // One 10 ms stereo packet at a constant level
+    void push(float level) {
+        std::vector<float> samples(480 * 2, level);
+        m_callback->onAudioData(samples.data(), 480, common::AudioFormat{});
+    }
+
+private:
+    core::audio::IAudioDataCallback* m_callback = nullptr;
+};
+
+class LastSnapshot : public core::audio::IAudioDataCallback {
+public:
+    void onAudioData(const float*, std::size_t, const common::AudioFormat&) override {}
+    void onMeterData(const common::MeterSnapshot& snapshot) override { m_snapshot = snapshot; }
+
+    common::MeterSnapshot m_snapshot;
+};
+
+} // namespace
+
+TEST_CASE("ConfigManager - publishes versioned snapshots", "[config]") {
+    common::ConfigManager::reset();
+    std::uint64_t version = 0;
+    {
+        const common::ConfigManager::ReadGuard before;
+
+        common::AppConfig config = before.config();
+        config.meterDecayRate = 0.5f;
+        version = common::ConfigManager::publish(config);
+
+        REQUIRE(version == before.snapshot().version + 1);
+        REQUIRE(common::ConfigManager::version() == version);
+        REQUIRE(common::ConfigManager::config().meterDecayRate == 0.5f);
+
+        // Publishing an identical config makes no new version
+        REQUIRE(common::ConfigManager::publish(config) == version);
+
+        // Replaced snapshots wait while a reader is active; the pinned one
+        // is immutable and stays valid
+        config.meterDecayRate = 0.25f;
+        REQUIRE(common::ConfigManager::publish(config) == version + 1);
+        REQUIRE(common::ConfigManager::retiredSnapshots() >= 1);
+        REQUIRE(before.config().meterDecayRate == common::AppConfig{}.meterDecayRate);
+    }
+
+    // With no reader left, the next publish frees every replaced snapshot
+    common::ConfigManager::reset();
+    REQUIRE(common::ConfigManager::retiredSnapshots() == 0);
+    REQUIRE(common::ConfigManager::config() == common::AppConfig{});
+}
+
+TEST_CASE("ConfigManager - edits do not overwrite a newer snapshot", "[config]") {
+    common::ConfigManager::reset();
+    const std::uint64_t base = common::ConfigManager::version();
+
+    // A reload lands while a working copy of base is being edited
+    common::AppConfig reloaded;
+    reloaded.meterDecayRate = 0.25f;
+    const std::uint64_t reloadVersion = common::ConfigManager::publish(reloaded);
+
+    common::AppConfig edit;
+    edit.meterDecayRate = 0.5f;
+    std::uint64_t version = 0;
+    REQUIRE_FALSE(common::ConfigManager::publishIfVersion(base, edit, &version));
+    REQUIRE(version == reloadVersion);
+    REQUIRE(common::ConfigManager::config().meterDecayRate == 0.25f);
+
+    // Editing the current snapshot goes through
+    REQUIRE(common::ConfigManager::publishIfVersion(reloadVersion, edit, &version));
+    REQUIRE(version == reloadVersion + 1);
+    REQUIRE(common::ConfigManager::config().meterDecayRate == 0.5f);
+
+    common::ConfigManager::reset();
+}
+
+TEST_CASE("ConfigManager - readers see whole snapshots while writers publish", "[config]") {
+    common::ConfigManager::reset();
+    std::atomic<bool> stop{false};
+    std::atomic<bool> torn{false};
+
+    // Every snapshot (the default one included) has both fields equal; a
+    // reader must never see them differ
+    std::thread reader([&] {
+        while (!stop.load()) {
+            const common::ConfigManager::ReadGuard guard;
+            const common::AppConfig& config = guard.config();
+            if (config.meterUpdateRate != static_cast<float>(config.statsLogInterval)) {
+                torn.store(true);
+            }
+        }
+    });
+
+    common::AppConfig config;
+    for (int i = 1; i <= 500; ++i) {
+        config.meterUpdateRate = static_cast<float>(i);
+        config.statsLogInterval = i;
+        common::ConfigManager::publish(config);
+    }
+    stop.store(true);
+    reader.join();
+
+    REQUIRE_FALSE(torn.load());
+    common::ConfigManager::reset();
+}
+
+TEST_CASE("ConfigManager - load, save and reload", "[config]") {
+    const auto path = tempConfigPath("openmeters_test_config.json");
+    std::filesystem::remove(path);
+    common::ConfigManager::reset();
+
+    // Missing file: nothing published, path remembered
+    const std::uint64_t start = common::ConfigManager::version();
+    REQUIRE_FALSE(common::ConfigManager::load(path.string()));
+    REQUIRE(common::ConfigManager::version() == start);
+    REQUIRE(common::ConfigManager::configPath() == path.string());
+
+    writeFile(path, R"({"meterDecayRate": 0.5, "meterUpdateRate": 30.0})");
+    REQUIRE(common::ConfigManager::reload());
+    REQUIRE(common::ConfigManager::config().meterDecayRate == 0.5f);
+    REQUIRE(common::ConfigManager::config().meterUpdateRate == 30.0f);
+
+    // Unparseable file: current snapshot kept
+    const std::uint64_t loaded = common::ConfigManager::version();
+    writeFile(path, "{ not json");
+    REQUIRE_FALSE(common::ConfigManager::reload());
+    REQUIRE(common::ConfigManager::version() == loaded);
+
+    // Round trip through save()
+    REQUIRE(common::ConfigManager::save());
+    common::ConfigManager::reset();
+    REQUIRE(common::ConfigManager::reload());
+    REQUIRE(common::ConfigManager::config().meterDecayRate == 0.5f);
+
+    common::ConfigManager::reset();
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("FileWatcher - reloads config when the file changes", "[config]") {
+    const auto path = tempConfigPath("openmeters_test_watch.json");
+    writeFile(path, R"({"meterDecayRate": 0.9})");
+    common::ConfigManager::reset();
+    REQUIRE(common::ConfigManager::load(path.string()));
+
+    std::atomic<int> reloads{0};
+    common::FileWatcher watcher;
+    REQUIRE(watcher.start(path.string(), [&] {
+        common::ConfigManager::reload();
+        reloads.fetch_add(1);
+    }));
+    REQUIRE(watcher.isRunning());
+
+    // Replace the file the way editors do: write a temporary, rename over
+    const auto temporary = tempConfigPath("openmeters_test_watch.json.tmp");
+    writeFile(temporary, R"({"meterDecayRate": 0.25})");
+    std::filesystem::rename(temporary, path);
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (common::ConfigManager::config().meterDecayRate != 0.25f &&
+           std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    REQUIRE(common::ConfigManager::config().meterDecayRate == 0.25f);
+    REQUIRE(reloads.load() >= 1);
+
+    watcher.stop();
+    REQUIRE_FALSE(watcher.isRunning());
+    common::ConfigManager::reset();
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("AudioEngine - peak hold follows the live decay rate", "[config][audio]") {
+    common::AppConfig config;
+    config.meterUpdateRate = 100.0f; // One display update per 10 ms packet
+    config.meterDecayRate = 0.5f;
+    config.meterHoldMs = 0.0f;
+    config.meterReleaseDbPerSecond = 100000.0f; // Reading gone within a packet
+    common::ConfigManager::publish(config);
+
+    auto source = std::make_unique<ManualSource>();
+    ManualSource* manual = source.get();
+    core::audio::AudioEngine engine(std::move(source));
+    LastSnapshot last;
+    engine.registerCallback(&last);
+    REQUIRE(engine.initialize());
+    REQUIRE(engine.start());
+
+    manual->push(0.8f);
+    REQUIRE(last.m_snapshot.level.left == Approx(0.8f));
+    REQUIRE(last.m_snapshot.peakHold.left == Approx(0.8f));
+    manual->push(0.0f);
+    REQUIRE(last.m_snapshot.peak.left == 0.0f);
+    REQUIRE(last.m_snapshot.level.left < 0.001f);
+    const float held = last.m_snapshot.peakHold.left;
+    manual->push(0.0f);
+    REQUIRE(last.m_snapshot.peakHold.left == Approx(held * 0.5f));
+
+    // Changes apply to the next packet, without restarting capture
+    config.meterDecayRate = 1.0f;
+    common::ConfigManager::publish(config);
+    manual->push(0.0f);
+    REQUIRE(last.m_snapshot.peakHold.left == Approx(held * 0.5f));
+
+    config.meterDecayRate = 0.0f;
+    common::ConfigManager::publish(config);
+    manual->push(0.0f);
+    REQUIRE(last.m_snapshot.peakHold.left == 0.0f);
+
+    engine.shutdown();
+    common::ConfigManager::reset();
+}
+
+TEST_CASE("AudioEngine - overs reach every reader with their stream position", "[config][audio]") {
+    common::AppConfig config;
+    config.overSampleCount = 3;
+    common::ConfigManager::publish(config);
+
+    auto source = std::make_unique<ManualSource>();
+    ManualSource* manual = source.get();
+    core::audio::AudioEngine engine(std::move(source));
+    REQUIRE(engine.initialize());
+    REQUIRE(engine.start());
+
+    manual->push(0.5f);
+    manual->push(1.0f); // Over on both channels at frame 480
+    std::uint64_t ui = 0;
+    std::uint64_t logger = 0;
+    common::OverEvent events[8];
+    REQUIRE(engine.readOverEvents(ui, events, 8, nullptr) == 2);
+    REQUIRE(events[0].position == 480);
+    REQUIRE(events[1].position == 480);
+    REQUIRE(engine.readOverEvents(logger, events, 8, nullptr) == 2);
+    REQUIRE(engine.readOverEvents(ui, events, 8, nullptr) == 0);
+
+    // A longer required run applies to the next packet
+    config.overSampleCount = 1000;
+    common::ConfigManager::publish(config);
+    manual->push(0.0f);
+    manual->push(1.0f);
+    REQUIRE(engine.readOverEvents(ui, events, 8, nullptr) == 0);
+
+    engine.shutdown();
+    common::ConfigManager::reset();
+}
@@ -0,0 +1,219 @@
+#include <catch2/catch.hpp>
+#include "../../common/clock.h"
+#include "../../common/config.h"
+#include "../../common/latency-histogram.h"
+#include "../../core/audio/audio-engine.h"
+#include "../../core/audio/engine-stats.h"
+#include "../../core/audio/synthetic-source.h"
+#include <atomic>
+#include <memory>
+#include <thread>
+
+using namespace openmeters;
+
+namespace {
+
+// Declines native blocks, so every packet is converted to float32 for it
+class FloatConsumer : public core::audio::IAudioDataCallback {
+public:
+    void onAudioData(const float*, std::size_t, const common::AudioFormat&) override {}
+    void onMeterData(const common::MeterSnapshot&) override {}
+};
+
+} // namespace
+
+TEST_CASE("LatencyHistogram - percentiles", "[stats]") {
+    common::LatencyHistogram histogram;
+    REQUIRE(histogram.summarize().count == 0);
+    REQUIRE(histogram.valueAtPercentile(50.0) == 0);
+
+    // 1..10000 ns uniformly
+    for (std::uint64_t value = 1; value <= 10000; ++value) {
+        histogram.record(value);
+    }
+
+    const auto summary = histogram.summarize();
+    REQUIRE(summary.count == 10000);
+    REQUIRE(summary.min == 1);
+    REQUIRE(summary.max == 10000);
+    REQUIRE(summary.mean == Approx(5000.5));
+
+    // Log-linear buckets: within 1/16 of the true value
+    REQUIRE(static_cast<double>(summary.p50) == Approx(5000.0).epsilon(1.0 / 16.0));
+    REQUIRE(static_cast<double>(summary.p90) == Approx(9000.0).epsilon(1.0 / 16.0));
+    REQUIRE(static_cast<double>(summary.p99) == Approx(9900.0).epsilon(1.0 / 16.0));
+    REQUIRE(summary.p999 <= summary.max);
+    REQUIRE(histogram.valueAtPercentile(100.0) == 10000);
+
+    // Small values are exact
+    common::LatencyHistogram small;
+    small.record(3);
+    small.record(7);
+    REQUIRE(small.valueAtPercentile(50.0) == 3);
+    REQUIRE(small.valueAtPercentile(100.0) == 7);
+
+    histogram.reset();
+    REQUIRE(histogram.count() == 0);
+}
+
+TEST_CASE("LatencyHistogram - extreme values", "[stats]") {
+    common::LatencyHistogram histogram;
+    histogram.record(0);
+    histogram.record(~std::uint64_t{0});
+    REQUIRE(histogram.count() == 2);
+    REQUIRE(histogram.valueAtPercentile(50.0) == 0);
+    REQUIRE(histogram.valueAtPercentile(100.0) == ~std::uint64_t{0});
+}
+
+TEST_CASE("AudioEngine - stats count packets and time each stage", "[stats][audio]") {
+    core::audio::SyntheticSourceConfig config;
+    config.sampleFormat = core::audio::SampleFormat::Int24Packed;
+    config.framesPerBlock = 256;
+    config.blockLimit = 40;
+    config.paced = false;
+
+    auto source = std::make_unique<core::audio::SyntheticSource>(config);
+    auto* sourcePtr = source.get();
+    core::audio::AudioEngine engine(std::move(source));
+    REQUIRE(engine.initialize());
+
+    FloatConsumer consumer;
+    sourcePtr->registerCallback(&consumer);
+
+    REQUIRE(engine.start());
+    while (engine.isCapturing()) {
+        std::this_thread::yield();
+    }
+
+    const auto stats = engine.getStats();
+    REQUIRE(stats.packets == 40);
+    REQUIRE(stats.frames == 40 * 256);
+    REQUIRE(stats.discontinuities == 0);
+    REQUIRE(stats.getBufferFailures == 0);
+    REQUIRE(stats.droppedPackets == 0);
+
+    // Packed 24-bit: both the meter and the consumer need one conversion per packet
+    REQUIRE(stats.fanOut.count == 40);
+    REQUIRE(stats.conversion.count == 40);
+    REQUIRE(stats.callback.count == 80);
+    REQUIRE(stats.peakMeter.count == 40);
+    REQUIRE(stats.rmsMeter.count == 40);
+    REQUIRE(stats.fanOut.max >= stats.callback.min);
+
+    const std::string line = core::audio::formatEngineStats(stats);
+    REQUIRE(line.find("40 packets") != std::string::npos);
+    REQUIRE(line.find("conversion") != std::string::npos);
+
+    sourcePtr->unregisterCallback(&consumer);
+    engine.shutdown();
+}
+
+TEST_CASE("StatsCollector - device read failures are reported with their last error", "[stats]") {
+    core::audio::StatsCollector collector;
+    REQUIRE(core::audio::formatEngineStats(collector.snapshot()).find("(last") == std::string::npos);
+
+    collector.recordGetBufferFailure(0x88890001u);
+    collector.recordGetBufferFailure(0x88890006u);
+    const auto stats = collector.snapshot();
+    REQUIRE(stats.getBufferFailures == 2);
+    REQUIRE(stats.lastGetBufferError == 0x88890006u);
+    REQUIRE(core::audio::formatEngineStats(stats).find("2 GetBuffer failures (last 0x88890006)") != std::string::npos);
+}
+
+TEST_CASE("AudioEngine - snapshots carry their capture time", "[stats][audio]") {
+    class CaptureTimes : public core::audio::IAudioDataCallback {
+    public:
+        void onAudioData(const float*, std::size_t, const common::AudioFormat&) override {}
+
+        void onMeterData(const common::MeterSnapshot& snapshot) override {
+            if (snapshot.captureTimeNs == 0 || snapshot.captureTimeNs < m_latest.load()) {
+                m_outOfOrder.store(true);
+            }
+            m_latest.store(snapshot.captureTimeNs);
+        }
+
+        std::atomic<std::uint64_t> m_latest{0};
+        std::atomic<bool> m_outOfOrder{false};
+    };
+
+    core::audio::SyntheticSourceConfig config;
+    config.blockLimit = 20;
+    config.paced = false;
+
+    core::audio::AudioEngine engine(std::make_unique<core::audio::SyntheticSource>(config));
+    CaptureTimes times;
+    engine.registerCallback(&times);
+    REQUIRE(engine.initialize());
+
+    const std::uint64_t before = common::monotonicNanos();
+    REQUIRE(engine.start());
+    while (engine.isCapturing()) {
+        std::this_thread::yield();
+    }
+
+    REQUIRE_FALSE(times.m_outOfOrder.load());
+    REQUIRE(times.m_latest.load() >= before);
+
+    // A headless "renderer" presenting the newest snapshot
+    engine.recordDisplayLatency(times.m_latest.load());
+    engine.recordDisplayLatency(0); // Unknown capture time: ignored
+    const auto display = engine.getStats().display;
+    REQUIRE(display.count == 1);
+    REQUIRE(display.max <= common::monotonicNanos() - times.m_latest.load());
+
+    engine.shutdown();
+}
+
+TEST_CASE("AudioEngine - snapshots slow down while the input is silent", "[stats][audio]") {
+    class SnapshotCount : public core::audio::IAudioDataCallback {
+    public:
+        void onAudioData(const float*, std::size_t, const common::AudioFormat&) override {}
+
+        void onMeterData(const common::MeterSnapshot& snapshot) override {
+            m_snapshots.fetch_add(1);
+            if (snapshot.idle) {
+                m_idle.fetch_add(1);
+            }
+        }
+
+        std::atomic<int> m_snapshots{0};
+        std::atomic<int> m_idle{0};
+    };
+
+    const auto run = [](float amplitude) {
+        core::audio::SyntheticSourceConfig config;
+        config.format = {48000, 2};
+        config.amplitude = amplitude;
+        config.blockLimit = 300; // 3 s of 10 ms packets
+        config.paced = false;
+
+        core::audio::AudioEngine engine(std::make_unique<core::audio::SyntheticSource>(config));
+        auto counts = std::make_unique<SnapshotCount>();
+        engine.registerCallback(counts.get());
+        REQUIRE(engine.initialize());
+        REQUIRE(engine.start());
+        while (engine.isCapturing()) {
+            std::this_thread::yield();
+        }
+        engine.shutdown();
+        return counts;
+    };
+
+    common::ConfigManager::reset();
+    common::AppConfig config;
+    config.idleAfterSeconds = 1.0f;
+    config.idleUpdateRate = 4.0f;
+    common::ConfigManager::publish(config);
+
+    // 99 packets before the idle time is reached, the one that reaches it,
+    // then one snapshot per 250 ms
+    const auto silent = run(0.0f);
+    REQUIRE(silent->m_snapshots.load() == 99 + 1 + 8);
+    REQUIRE(silent->m_idle.load() == 1 + 8);
+
+    const auto tone = run(0.5f);
+    REQUIRE(tone->m_snapshots.load() == 300);
+    REQUIRE(tone->m_idle.load() == 0);
+
+    common::ConfigManager::reset();
+}
@@ -0,0 +1,155 @@
+#include <catch2/catch.hpp>
+#include "../../core/audio/format-convert.h"
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+using namespace openmeters;
+using core::audio::SampleFormat;
+using core::audio::SimdLevel;
+
+namespace {
+
+/**
+ * Restores the detected SIMD level when a test section ends.
+ */
+struct SimdLevelGuard {
+    ~SimdLevelGuard() {
+        core::audio::setSimdLevel(core::audio::supportedSimdLevel());
+    }
+};
+
+std::vector<float> rampSignal(std::size_t count) {
+    std::vector<float> samples(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        samples[i] = std::sin(static_cast<float>(i) * 0.37f) * 0.9f;
+    }
+    return samples;
+}
+
+} // namespace
+
+TEST_CASE("Format convert - integer to float scaling", "[convert]") {
+    float out[4] = {};
+
+    SECTION("Int16") {
+        const std::int16_t in[] = {0, 16384, -32768, 32767};
+        core::audio::convertToFloat32(in, SampleFormat::Int16, out, 4);
+        REQUIRE(out[0] == 0.0f);
+        REQUIRE(out[1] == Approx(0.5f));
+        REQUIRE(out[2] == -1.0f);
+        REQUIRE(out[3] == Approx(1.0f).margin(0.0001f));
+    }
+
+    SECTION("Int24 packed") {
+        // 0x400000 (0.5), 0xC00000 (-0.5), 0x800000 (-1.0), 0x000001
+        const std::uint8_t in[] = {
+            0x00, 0x00, 0x40,
+            0x00, 0x00, 0xC0,
+            0x00, 0x00, 0x80,
+            0x01, 0x00, 0x00
+        };
+        core::audio::convertToFloat32(in, SampleFormat::Int24Packed, out, 4);
+        REQUIRE(out[0] == Approx(0.5f));
+        REQUIRE(out[1] == Approx(-0.5f));
+        REQUIRE(out[2] == -1.0f);
+        REQUIRE(out[3] == Approx(1.0f / 8388608.0f));
+    }
+
+    SECTION("Int24 in 32 (low-aligned)") {
+        const std::int32_t in[] = {0x400000, -0x400000, -0x800000, 0};
+        core::audio::convertToFloat32(in, SampleFormat::Int24In32, out, 4);
+        REQUIRE(out[0] == Approx(0.5f));
+        REQUIRE(out[1] == Approx(-0.5f));
+        REQUIRE(out[2] == -1.0f);
+        REQUIRE(out[3] == 0.0f);
+    }
+
+    SECTION("Float64") {
+        const double in[] = {0.25, -0.75, 1.0, 0.0};
+        core::audio::convertToFloat32(in, SampleFormat::Float64, out, 4);
+        REQUIRE(out[0] == 0.25f);
+        REQUIRE(out[1] == -0.75f);
+        REQUIRE(out[2] == 1.0f);
+        REQUIRE(out[3] == 0.0f);
+    }
+}
+
+TEST_CASE("Format convert - SIMD kernels match scalar", "[convert]") {
+    SimdLevelGuard guard;
+
+    // Odd length exercises vector bodies and scalar tails
+    const std::size_t count = 1037;
+    const auto reference = rampSignal(count);
+
+    const SampleFormat formats[] = {
+        SampleFormat::Int16,
+        SampleFormat::Int24Packed,
+        SampleFormat::Int24In32,
+        SampleFormat::Int32,
+        SampleFormat::Float64
+    };
+
+    for (SampleFormat format : formats) {
+        std::vector<std::uint8_t> encoded(count * core::audio::bytesPerSample(format) + 1);
+
+        // Offset by one byte to exercise unaligned loads
+        void* source = encoded.data() + 1;
+        core::audio::setSimdLevel(SimdLevel::Scalar);
+        core::audio::convertFromFloat32(reference.data(), source, format, count);
+
+        std::vector<float> scalar(count);
+        core::audio::convertToFloat32(source, format, scalar.data(), count);
+
+        core::audio::setSimdLevel(core::audio::supportedSimdLevel());
+        std::vector<float> simd(count);
+        core::audio::convertToFloat32(source, format, simd.data(), count);
+
+        std::vector<std::uint8_t> reencoded(encoded.size());
+        core::audio::convertFromFloat32(reference.data(), reencoded.data() + 1, format, count);
+
+        REQUIRE(std::memcmp(scalar.data(), simd.data(), count * sizeof(float)) == 0);
+        REQUIRE(std::memcmp(encoded.data() + 1, reencoded.data() + 1, encoded.size() - 1) == 0);
+    }
+}
+
+TEST_CASE("Format convert - round trip and clipping", "[convert]") {
+    const std::size_t count = 256;
+    const auto reference = rampSignal(count);
+
+    SECTION("Int24 round trip is within one LSB") {
+        std::vector<std::uint8_t> encoded(count * 3);
+        std::vector<float> decoded(count);
+        core::audio::convertFromFloat32(reference.data(), encoded.data(), SampleFormat::Int24Packed, count);
+        core::audio::convertToFloat32(encoded.data(), SampleFormat::Int24Packed, decoded.data(), count);
+        for (std::size_t i = 0; i < count; ++i) {
+            REQUIRE(decoded[i] == Approx(reference[i]).margin(1.0 / 8388608.0));
+        }
+    }
+
+    SECTION("Out-of-range input clips to full scale") {
+        const float in[] = {2.0f, -2.0f, 1.0f, -1.0f, 2.0f, -2.0f, 1.0f, -1.0f, 5.0f};
+        std::int16_t out[9] = {};
+        core::audio::convertFromFloat32(in, out, SampleFormat::Int16, 9);
+        REQUIRE(out[0] == 32767);
+        REQUIRE(out[1] == -32768);
+        REQUIRE(out[2] == 32767);
+        REQUIRE(out[3] == -32768);
+        REQUIRE(out[8] == 32767);
+    }
+
+    SECTION("TPDF dither stays within one LSB") {
+        core::audio::TpdfDither dither(1234);
+        std::vector<std::int16_t> plain(count);
+        std::vector<std::int16_t> dithered(count);
+        core::audio::convertFromFloat32(reference.data(), plain.data(), SampleFormat::Int16, count);
+        core::audio::convertFromFloat32(reference.data(), dithered.data(), SampleFormat::Int16, count, &dither);
+
+        int differing = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            REQUIRE(std::abs(plain[i] - dithered[i]) <= 1);
+            differing += (plain[i] != dithered[i]) ? 1 : 0;
+        }
+        REQUIRE(differing > 0);
+    }
+}
@@ -0,0 +1,93 @@
+#include <catch2/catch.hpp>
+#include "../../core/meters/peak-meter.h"
+#include "../../core/meters/rms-meter.h"
+#include "../../core/meters/integer-kernels.h"
+#include "../../common/audio-format.h"
+#include <cmath>
+#include <vector>
+
+using namespace openmeters;
+
+namespace {
+
+std::vector<std::int16_t> makeInt16(std::size_t count) {
+    std::vector<std::int16_t> samples(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        samples[i] = static_cast<std::int16_t>(std::lround(std::sin(static_cast<double>(i) * 0.11) * 30000.0));
+    }
+    return samples;
+}
+
+} // namespace
+
+TEST_CASE("Integer meters - match float path", "[meters]") {
+    core::meters::PeakMeter peakMeter;
+    core::meters::RmsMeter rmsMeter;
+    common::AudioFormat format;
+    format.sampleRate = 48000;
+    format.channelCount = 2;
+
+    // Odd frame count exercises SIMD bodies and scalar tails
+    const std::size_t frames = 517;
+    const auto ints = makeInt16(frames * 2);
+    std::vector<float> floats(ints.size());
+    for (std::size_t i = 0; i < ints.size(); ++i) {
+        floats[i] = static_cast<float>(ints[i]) / 32768.0f;
+    }
+
+    SECTION("Int16 stereo") {
+        const auto peakInt = peakMeter.process(ints.data(), frames, format);
+        const auto peakFloat = peakMeter.process(floats.data(), frames, format);
+        REQUIRE(peakInt.left == Approx(peakFloat.left));
+        REQUIRE(peakInt.right == Approx(peakFloat.right));
+
+        const auto rmsInt = rmsMeter.process(ints.data(), frames, format);
+        const auto rmsFloat = rmsMeter.process(floats.data(), frames, format);
+        REQUIRE(rmsInt.left == Approx(rmsFloat.left).epsilon(1e-4));
+        REQUIRE(rmsInt.right == Approx(rmsFloat.right).epsilon(1e-4));
+    }
+
+    SECTION("Int32 mono") {
+        format.channelCount = 1;
+        std::vector<std::int32_t> wide(ints.size());
+        for (std::size_t i = 0; i < ints.size(); ++i) {
+            wide[i] = static_cast<std::int32_t>(ints[i]) * 65536;
+        }
+
+        const auto peakInt = peakMeter.process(wide.data(), ints.size(), format);
+        const auto peakFloat = peakMeter.process(floats.data(), ints.size(), format);
+        REQUIRE(peakInt.left == Approx(peakFloat.left));
+        REQUIRE(peakInt.right == Approx(peakFloat.left));
+
+        const auto rmsInt = rmsMeter.process(wide.data(), ints.size(), format);
+        const auto rmsFloat = rmsMeter.process(floats.data(), ints.size(), format);
+        REQUIRE(rmsInt.left == Approx(rmsFloat.left).epsilon(1e-4));
+    }
+}
+
+TEST_CASE("Integer kernels - full scale edge cases", "[meters]") {
+    SECTION("Int16 negative full scale") {
+        std::vector<std::int16_t> samples(64, 0);
+        samples[33] = -32768;
+        std::uint32_t peaks[2] = {};
+        core::meters::kernels::peakInt16(samples.data(), 32, 2, peaks);
+        REQUIRE(peaks[0] == 0);
+        REQUIRE(peaks[1] == 32768);
+    }
+
+    SECTION("Int32 negative full scale") {
+        std::vector<std::int32_t> samples(40, 0);
+        samples[12] = INT32_MIN;
+        std::uint32_t peaks[1] = {};
+        core::meters::kernels::peakInt32(samples.data(), 40, 1, peaks);
+        REQUIRE(peaks[0] == 2147483648u);
+    }
+
+    SECTION("Int16 sum of squares is exact") {
+        std::vector<std::int16_t> samples(1000, -32768);
+        std::uint64_t sums[2] = {};
+        core::meters::kernels::sumSquaresInt16(samples.data(), 500, 2, sums);
+        REQUIRE(sums[0] == 500ull * 32768ull * 32768ull);
+        REQUIRE(sums[1] == sums[0]);
+    }
+}
@@ -0,0 +1,122 @@
+#include <catch2/catch.hpp>
+#include "../../core/library/library-scanner.h"
+#include "../../common/content-hash.h"
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+
+using namespace openmeters;
+
+namespace {
+
+/**
+ * Analyzer stub that records how often it runs.
+ */
+class CountingAnalyzer : public core::library::IFileAnalyzer {
+public:
+    std::string name() const override { return "counting"; }
+    std::uint32_t version() const override { return m_version; }
+
+    bool accepts(const std::string& path) const override {
+        return std::filesystem::path(path).extension() == ".wav";
+    }
+
+    bool analyze(const std::string& path, nlohmann::json& result) override {
+        m_calls.fetch_add(1);
+        result["size"] = std::filesystem::file_size(path);
+        return true;
+    }
+
+    std::atomic<int> m_calls{0};
+    std::uint32_t m_version = 1;
+};
+
+void writeFile(const std::filesystem::path& path, const std::string& contents) {
+    std::filesystem::create_directories(path.parent_path());
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file << contents;
+}
+
+} // namespace
+
+TEST_CASE("Content hash - streaming matches one-shot", "[library]") {
+    std::string data;
+    for (int i = 0; i < 1000; ++i) {
+        data.push_back(static_cast<char>(i * 31));
+    }
+
+    const auto oneShot = common::ContentHasher::hash(data.data(), data.size());
+
+    common::ContentHasher hasher;
+    for (std::size_t offset = 0; offset < data.size(); offset += 7) {
+        hasher.update(data.data() + offset, std::min<std::size_t>(7, data.size() - offset));
+    }
+
+    REQUIRE(hasher.digest() == oneShot);
+    REQUIRE(common::ContentHasher::hash(nullptr, 0) == 0xEF46DB3751D8E999ULL);
+}
+
+TEST_CASE("Library scanner - incremental rescan", "[library]") {
+    const auto root = std::filesystem::temp_directory_path() / "openmeters-scan-test";
+    std::filesystem::remove_all(root);
+    writeFile(root / "a.wav", "first file");
+    writeFile(root / "sub" / "b.wav", "second file");
+    writeFile(root / "sub" / "deeper" / "c.wav", "third file");
+    writeFile(root / "notes.txt", "ignored");
+
+    core::library::ScanOptions options;
+    options.roots = {root.string()};
+    options.cachePath = (root / "cache.json").string();
+    options.threadCount = 4;
+
+    CountingAnalyzer analyzer;
+    core::library::LibraryScanner scanner(analyzer);
+
+    SECTION("Unchanged files are served from cache") {
+        auto first = scanner.scan(options);
+        REQUIRE(first.filesFound == 3);
+        REQUIRE(first.analyzed == 3);
+        REQUIRE(analyzer.m_calls == 3);
+
+        auto second = scanner.scan(options);
+        REQUIRE(second.filesFound == 3);
+        REQUIRE(second.cached == 3);
+        REQUIRE(second.analyzed == 0);
+        REQUIRE(analyzer.m_calls == 3);
+    }
+
+    SECTION("Changed content and analyzer version invalidate entries") {
+        scanner.scan(options);
+        writeFile(root / "a.wav", "first file, edited");
+
+        auto second = scanner.scan(options);
+        REQUIRE(second.analyzed == 1);
+        REQUIRE(second.cached == 2);
+
+        analyzer.m_version = 2;
+        auto third = scanner.scan(options);
+        REQUIRE(third.analyzed == 3);
+    }
+
+    SECTION("Metadata hash mode") {
+        options.hashMode = core::library::HashMode::Metadata;
+        scanner.scan(options);
+        auto second = scanner.scan(options);
+        REQUIRE(second.cached == 3);
+    }
+
+    std::filesystem::remove_all(root);
+}
+
+TEST_CASE("Scan cache - unwritable directory fails without throwing", "[library]") {
+    const auto root = std::filesystem::temp_directory_path() / "openmeters-cache-blocked";
+    std::filesystem::remove_all(root);
+    writeFile(root / "file", "not a directory");
+
+    core::library::ScanCache cache;
+    bool saved = true;
+    REQUIRE_NOTHROW(saved = cache.save((root / "file" / "cache" / "scan.json").string()));
+    REQUIRE_FALSE(saved);
+
+    std::filesystem::remove_all(root);
+}
@@ -0,0 +1,388 @@
+#include <catch2/catch.hpp>
+#include "../../common/logger.h"
+#include "../../common/log-ring.h"
+#include "../../common/mapped-file.h"
+#include "../../common/mpsc-queue.h"
+#include "../../common/realtime-scope.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace openmeters;
+
+namespace {
+
+std::vector<std::string> readLines(const std::filesystem::path& path) {
+    std::vector<std::string> lines;
+    std::ifstream in(path);
+    std::string line;
+    while (std::getline(in, line)) {
+        lines.push_back(line);
+    }
+    return lines;
+}
+
+std::vector<common::LogRingRecord> decodeRing(const std::uint8_t* data, std::size_t size) {
+    std::vector<common::LogRingRecord> records;
+    const long long count = common::LogRing::decode(data, size, [&records](const common::LogRingRecord& record) {
+        records.push_back(record);
+    });
+    REQUIRE(count == static_cast<long long>(records.size()));
+    return records;
+}
+
+std::vector<common::LogRingRecord> decodeRingFile(const std::filesystem::path& path) {
+    common::MappedFile file;
+    REQUIRE(file.open(path.string()));
+    return decodeRing(file.data(), file.size());
+}
+
+} // namespace
+
+TEST_CASE("MpscRecordQueue - records spanning cells and a full queue", "[logger]") {
+    common::MpscRecordQueue queue(common::MemoryTag::Logging);
+    REQUIRE(queue.reserve(6));
+    REQUIRE(queue.capacity() == 8);
+
+    const std::string header = "hdr:";
+    const std::string longText(300, 'x'); // 304 bytes: three cells
+    REQUIRE(queue.push(header.data(), header.size(), longText.data(), longText.size()));
+    REQUIRE(queue.push("a", 1));
+
+    // Three + one cells used; a five-cell record does not fit
+    const std::string tooBig(common::MpscRecordQueue::kCellPayload * 5, 'y');
+    REQUIRE_FALSE(queue.push(tooBig.data(), tooBig.size()));
+
+    std::vector<char> out(common::MpscRecordQueue::kMaxRecordBytes);
+    REQUIRE(queue.pop(out.data(), out.size()) == header.size() + longText.size());
+    REQUIRE(std::string(out.data(), header.size() + longText.size()) == header + longText);
+    REQUIRE(queue.pop(out.data(), out.size()) == 1);
+    REQUIRE(out[0] == 'a');
+    REQUIRE(queue.pop(out.data(), out.size()) == 0);
+
+    // Freed cells are reusable, including across the wrap
+    REQUIRE(queue.push(tooBig.data(), tooBig.size()));
+    REQUIRE(queue.pop(out.data(), out.size()) == tooBig.size());
+}
+
+TEST_CASE("MpscRecordQueue - concurrent producers", "[logger]") {
+    common::MpscRecordQueue queue(common::MemoryTag::Logging);
+    REQUIRE(queue.reserve(64));
+
+    constexpr int kProducers = 4;
+    constexpr std::uint32_t kRecords = 5000;
+    std::vector<std::thread> producers;
+    for (int p = 0; p < kProducers; ++p) {
+        producers.emplace_back([&queue, p] {
+            for (std::uint32_t i = 0; i < kRecords; ++i) {
+                // Vary the size so records cover one to three cells
+                std::uint32_t record[60] = {static_cast<std::uint32_t>(p), i};
+                const std::size_t bytes = 8 + (i % 3) * 100;
+                while (!queue.push(record, bytes)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    // Each producer's records arrive whole and in order
+    std::vector<std::uint32_t> next(kProducers, 0);
+    std::uint32_t received = 0;
+    std::uint32_t record[common::MpscRecordQueue::kMaxRecordBytes / 4];
+    while (received < kProducers * kRecords) {
+        const std::size_t bytes = queue.pop(record, sizeof(record));
+        if (bytes == 0) {
+            std::this_thread::yield();
+            continue;
+        }
+        REQUIRE(record[0] < static_cast<std::uint32_t>(kProducers));
+        REQUIRE(record[1] == next[record[0]]);
+        REQUIRE(bytes == 8 + (record[1] % 3) * 100);
+        ++next[record[0]];
+        ++received;
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+    REQUIRE(queue.pop(record, sizeof(record)) == 0);
+}
+
+TEST_CASE("Logger - asynchronous mode writes every queued record on shutdown", "[logger]") {
+    const auto path = std::filesystem::temp_directory_path() / "openmeters_test_async.log";
+    std::filesystem::remove(path);
+
+    REQUIRE(common::Logger::initialize(path.string(), common::LogLevel::Info, false, common::LogMode::Asynchronous));
+
+    constexpr int kThreads = 4;
+    constexpr int kMessages = 500;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([t] {
+            for (int i = 0; i < kMessages; ++i) {
+                LOG_INFO("thread " + std::to_string(t) + " message " + std::to_string(i));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    LOG_WARNING(std::string(5000, 'z')); // Longer than one record
+    const std::uint64_t dropped = common::Logger::droppedMessages();
+    common::Logger::shutdown();
+
+    const auto lines = readLines(path);
+    std::vector<int> next(kThreads, 0);
+    std::size_t messages = 0;
+    bool sawShutdown = false;
+    bool sawTruncated = false;
+    for (const auto& line : lines) {
+        const auto at = line.find("] thread ");
+        if (at != std::string::npos) {
+            // Call site survives the round trip through the site table
+            REQUIRE(line.find("[test_logger.cpp:") != std::string::npos);
+            int thread = 0;
+            int index = 0;
+            REQUIRE(std::sscanf(line.c_str() + at, "] thread %d message %d", &thread, &index) == 2);
+            REQUIRE(index >= next[thread]); // Per-thread order (gaps only from drops)
+            next[thread] = index + 1;
+            ++messages;
+        }
+        sawShutdown = sawShutdown || line.find("Logger shutting down") != std::string::npos;
+        sawTruncated = sawTruncated || (line.find("[WARN ]") != std::string::npos && line.find("[truncated]") != std::string::npos);
+    }
+    REQUIRE(messages + dropped == kThreads * kMessages);
+    REQUIRE(sawShutdown);
+    REQUIRE(sawTruncated);
+
+    // After shutdown the logger falls back to synchronous console output
+    common::Logger::info("after shutdown");
+
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("formatLogMessage - placeholders, specs and escapes", "[logger]") {
+    auto format = [](std::string_view pattern, auto... values) {
+        const common::LogArg args[] = {common::makeLogArg(values)...};
+        std::string out;
+        common::formatLogMessage(out, pattern, args, sizeof...(values));
+        return out;
+    };
+
+    REQUIRE(format("{} frames at {} Hz", 480, 48000u) == "480 frames at 48000 Hz");
+    REQUIRE(format("peak {:.2f} dB", -3.14159) == "peak -3.14 dB");
+    REQUIRE(format("{} {}", 0.1, 1e21) == "0.1 1e+21");
+    REQUIRE(format("hr 0x{:x}", 0x88890004u) == "hr 0x88890004");
+    REQUIRE(format("{} {} {}", true, 'c', std::string("text")) == "true c text");
+    REQUIRE(format("{{literal}} {}", "arg") == "{literal} arg");
+    REQUIRE(format("{} and {}", 1) == "1 and {}");
+    REQUIRE(format("none", 1, 2) == "none");
+}
+
+TEST_CASE("encodeLogArgs - round trip and truncation", "[logger]") {
+    const std::string text = "device name";
+    const common::LogArg args[] = {
+        common::makeLogArg(-7), common::makeLogArg(std::uint64_t{1} << 40), common::makeLogArg(2.5),
+        common::makeLogArg(false), common::makeLogArg('x'), common::makeLogArg(text)
+    };
+
+    std::uint8_t buffer[128];
+    bool truncated = false;
+    const std::size_t bytes = common::encodeLogArgs(args, 6, buffer, sizeof(buffer), &truncated);
+    REQUIRE_FALSE(truncated);
+
+    common::LogArg decoded[common::kMaxLogArgs];
+    REQUIRE(common::decodeLogArgs(buffer, bytes, decoded, common::kMaxLogArgs) == 6);
+    std::string out;
+    common::formatLogMessage(out, "{} {} {} {} {} {}", decoded, 6);
+    REQUIRE(out == "-7 1099511627776 2.5 false x device name");
+
+    // Strings are cut to the space left (tag and length take 3 bytes)
+    REQUIRE(common::encodeLogArgs(args + 5, 1, buffer, 9, &truncated) == 9);
+    REQUIRE(truncated);
+    REQUIRE(common::decodeLogArgs(buffer, 9, decoded, common::kMaxLogArgs) == 1);
+    REQUIRE(decoded[0].s == "device");
+}
+
+TEST_CASE("Logger - disabled levels skip argument evaluation", "[logger]") {
+    const auto previous = common::Logger::getMinLevel();
+    common::Logger::setMinLevel(common::LogLevel::Warning);
+
+    int evaluated = 0;
+    auto expensive = [&evaluated] {
+        ++evaluated;
+        return std::string("expensive");
+    };
+    LOG_DEBUG("value {}", expensive());
+    LOG_INFO("value " + expensive());
+    REQUIRE(evaluated == 0);
+    REQUIRE_FALSE(common::Logger::isEnabled(common::LogLevel::Info));
+    REQUIRE(common::Logger::isEnabled(common::LogLevel::Error));
+
+    common::Logger::setMinLevel(previous);
+}
+
+TEST_CASE("Logger - formatted calls are deferred to the writer thread", "[logger]") {
+    const auto path = std::filesystem::temp_directory_path() / "openmeters_test_format.log";
+    std::filesystem::remove(path);
+    REQUIRE(common::Logger::initialize(path.string(), common::LogLevel::Debug, false, common::LogMode::Asynchronous));
+
+    // No allocation or lock on the caller (fails OPENMETERS_RT_CHECK builds otherwise)
+    std::thread realtime([] {
+        const common::RealtimeScope scope;
+        const std::string_view device = "Speakers";
+        for (int packet = 0; packet < 3; ++packet) {
+            LOG_DEBUG("packet {} from {}: peak {:.1f}", packet, device, 0.5 * packet);
+        }
+    });
+    realtime.join();
+
+    common::Logger::shutdown();
+    common::Logger::setMinLevel(common::LogLevel::Info);
+
+    const auto lines = readLines(path);
+    int found = 0;
+    for (const auto& line : lines) {
+        if (line.find("[DEBUG]") != std::string::npos && line.find("packet ") != std::string::npos) {
+            REQUIRE(line.find("packet " + std::to_string(found) + " from Speakers: peak " +
+                              (found == 0 ? "0.0" : found == 1 ? "0.5" : "1.0")) != std::string::npos);
+            ++found;
+        }
+    }
+    REQUIRE(found == 3);
+
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("LogRing - records round trip through the mapped file", "[logger]") {
+    const auto path = std::filesystem::temp_directory_path() / "openmeters_test_ring.omlog";
+    std::filesystem::remove(path);
+    std::filesystem::remove(path.string() + ".prev");
+
+    common::LogRing ring;
+    REQUIRE(ring.open(path.string(), common::LogRing::kMinCapacity));
+    ring.write(1, 1000000000, "/src/core/audio/engine.cpp", 42, "verbatim {} text", nullptr, 0);
+    const common::LogArg args[] = {common::makeLogArg(480), common::makeLogArg(std::string_view("Speakers"))};
+    ring.write(3, 2000000000, "C:\\src\\wasapi.cpp", 7, "{} frames from {}", args, 2);
+
+    // Read while still open, as after a crash: the mapping is the file
+    const auto records = decodeRingFile(path);
+    REQUIRE(records.size() == 2);
+    REQUIRE(records[0].level == 1);
+    REQUIRE(records[0].timeNs == 1000000000);
+    REQUIRE(records[0].file == "engine.cpp");
+    REQUIRE(records[0].line == 42);
+    REQUIRE(records[0].message == "verbatim {} text");
+    REQUIRE(records[1].level == 3);
+    REQUIRE(records[1].file == "wasapi.cpp");
+    REQUIRE(records[1].message == "480 frames from Speakers");
+
+    // Reopening keeps the previous run's ring next to the new one
+    ring.close();
+    REQUIRE(ring.open(path.string(), common::LogRing::kMinCapacity));
+    ring.close();
+    REQUIRE(decodeRingFile(path).empty());
+    REQUIRE(decodeRingFile(path.string() + ".prev").size() == 2);
+
+    std::filesystem::remove(path);
+    std::filesystem::remove(path.string() + ".prev");
+}
+
+TEST_CASE("LogRing - wrap keeps the newest records and skips torn ones", "[logger]") {
+    const auto path = std::filesystem::temp_directory_path() / "openmeters_test_ring_wrap.omlog";
+    std::filesystem::remove(path);
+
+    common::LogRing ring;
+    REQUIRE(ring.open(path.string(), common::LogRing::kMinCapacity));
+
+    // Writers on several threads, several laps of the ring
+    constexpr int kThreads = 4;
+    constexpr int kRecords = 2000;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&ring, t] {
+            for (int i = 0; i < kRecords; ++i) {
+                const common::LogArg args[] = {common::makeLogArg(t), common::makeLogArg(i)};
+                ring.write(1, i, "test.cpp", t, "thread {} record {}", args, 2);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    // One more once every writer is done: no late copy can damage it
+    const common::LogArg lastArgs[] = {common::makeLogArg(0), common::makeLogArg(kRecords)};
+    ring.write(1, kRecords, "test.cpp", 0, "thread {} record {}", lastArgs, 2);
+    REQUIRE(ring.bytesWritten() > 4 * common::LogRing::kMinCapacity);
+
+    common::MappedFile file;
+    REQUIRE(file.open(path.string()));
+    const auto records = decodeRing(file.data(), file.size());
+    // Records are 88 bytes (see below): the window holds all but the one cut
+    // by the wrap and up to two per thread hit by a copy that landed a lap late
+    REQUIRE(records.size() >= common::LogRing::kMinCapacity / 88 - 1 - 2 * kThreads);
+    REQUIRE(records.size() < kThreads * kRecords);
+
+    // Per thread: strictly increasing; the newest record survives
+    std::vector<int> last(kThreads, -1);
+    for (const auto& record : records) {
+        int thread = 0;
+        int index = 0;
+        REQUIRE(std::sscanf(record.message.c_str(), "thread %d record %d", &thread, &index) == 2);
+        REQUIRE(static_cast<std::uint32_t>(thread) == record.line);
+        REQUIRE(index > last[thread]);
+        last[thread] = index;
+    }
+    REQUIRE(last[0] == kRecords);
+
+    // A record whose commit word never landed (crash mid-write) is skipped.
+    // Every record here is 88 bytes: 40 header + 8 file + 19 pattern + 18
+    // argument bytes, padded; the commit word is at offset 12
+    std::vector<std::uint8_t> image(file.data(), file.data() + file.size());
+    std::uint64_t end;
+    std::memcpy(&end, image.data() + 64, sizeof(end));
+    const std::size_t newest = static_cast<std::size_t>(end - 88) & (common::LogRing::kMinCapacity - 1);
+    std::memset(image.data() + 128 + newest + 12, 0, 4);
+    const auto afterCrash = decodeRing(image.data(), image.size());
+    REQUIRE(afterCrash.size() == records.size() - 1);
+
+    // So is one whose body changed after the commit (a writer a lap behind
+    // finishing its copy late); byte 48 is the first pattern byte
+    std::vector<std::uint8_t> lapped(file.data(), file.data() + file.size());
+    lapped[128 + ((newest + 48) & (common::LogRing::kMinCapacity - 1))] ^= 0x20;
+    REQUIRE(decodeRing(lapped.data(), lapped.size()).size() == records.size() - 1);
+
+    ring.close();
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("Logger - binary log ring receives every emitted record", "[logger]") {
+    const auto logPath = std::filesystem::temp_directory_path() / "openmeters_test_ring.log";
+    const auto ringPath = std::filesystem::temp_directory_path() / "openmeters_test_logger.omlog";
+    std::filesystem::remove(ringPath);
+
+    REQUIRE(common::Logger::initialize(logPath.string(), common::LogLevel::Info, false, common::LogMode::Asynchronous));
+    REQUIRE(common::Logger::openBinaryLog(ringPath.string(), common::LogRing::kMinCapacity));
+    LOG_INFO("ring {} of {}", 1, 2);
+    LOG_WARNING(std::string("ring 2 of 2"));
+    LOG_DEBUG("below the level {}", 3);
+
+    // Decodable before shutdown, i.e. without the writer thread's help
+    const auto records = decodeRingFile(ringPath);
+    std::vector<std::string> messages;
+    for (const auto& record : records) {
+        if (record.message.rfind("ring ", 0) == 0) {
+            REQUIRE(record.file == "test_logger.cpp");
+            messages.push_back(record.message);
+        }
+    }
+    REQUIRE(messages == std::vector<std::string>{"ring 1 of 2", "ring 2 of 2"});
+
+    common::Logger::shutdown();
+    std::filesystem::remove(logPath);
+    std::filesystem::remove(ringPath);
+}
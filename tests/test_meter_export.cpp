@@ -0,0 +1,186 @@
+#include <catch2/catch.hpp>
+#include "../../client/openmeters-shm.h"
+#include "../../core/audio/meter-exporter.h"
+#include <atomic>
+#include <string>
+#include <thread>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+using namespace openmeters;
+
+namespace {
+
+constexpr common::AudioFormat kStereo{48000, 2};
+
+// Unique per process so parallel test runs do not share a segment
+std::string segmentName(const char* suffix) {
+#ifdef _WIN32
+    return std::string("openmeters-test-") + suffix;
+#else
+    return "openmeters-test-" + std::to_string(getpid()) + "-" + suffix;
+#endif
+}
+
+common::MeterSnapshot snapshotFor(std::uint64_t i) {
+    // Every field derives from i, so a torn copy shows as a mismatch
+    const float value = static_cast<float>(i % 1000000);
+    common::MeterSnapshot snapshot;
+    snapshot.timestampMs = i;
+    snapshot.captureTimeNs = i * 3;
+    snapshot.peak = {value, value + 1.0f};
+    snapshot.level = {value + 2.0f, value + 3.0f};
+    snapshot.peakHold = {value + 4.0f, value + 5.0f};
+    snapshot.rms = {value + 6.0f, value + 7.0f};
+    return snapshot;
+}
+
+} // namespace
+
+TEST_CASE("MeterExporter - readers see the newest snapshot", "[meter-export]") {
+    const std::string name = segmentName("basic");
+    om_shm_reader reader;
+    REQUIRE(om_shm_open(&reader, name.c_str()) == OM_SHM_NOT_FOUND);
+
+    core::audio::MeterExporter exporter;
+    REQUIRE_FALSE(exporter.open("bad/name", kStereo));
+    REQUIRE(exporter.open(name, kStereo));
+    REQUIRE(om_shm_open(&reader, name.c_str()) == OM_SHM_OK);
+    REQUIRE(reader.segment->sample_rate == 48000);
+    REQUIRE(reader.segment->channel_count == 2);
+    REQUIRE(reader.segment->frame_size == sizeof(om_meter_frame));
+
+    om_meter_frame frame;
+    std::uint64_t sequence = 99;
+    REQUIRE(om_shm_read(&reader, &frame, &sequence) == OM_SHM_OK);
+    REQUIRE(sequence == 0); // Nothing published yet
+
+    exporter.onMeterData(snapshotFor(41));
+    exporter.onMeterData(snapshotFor(42));
+    REQUIRE(exporter.published() == 2);
+    REQUIRE(om_shm_read(&reader, &frame, &sequence) == OM_SHM_OK);
+    REQUIRE(sequence == 2);
+    REQUIRE(frame.timestamp_ms == 42);
+    REQUIRE(frame.capture_time_ns == 126);
+    REQUIRE(frame.peak[0] == 42.0f);
+    REQUIRE(frame.peak[1] == 43.0f);
+    REQUIRE(frame.level[1] == 45.0f);
+    REQUIRE(frame.peak_hold[0] == 46.0f);
+    REQUIRE(frame.rms[1] == 49.0f);
+
+    // Readers that keep their mapping see the exporter go away
+    exporter.close();
+    REQUIRE(om_shm_read(&reader, &frame, &sequence) == OM_SHM_STOPPED);
+    REQUIRE(frame.timestamp_ms == 42);
+    om_shm_close(&reader);
+    REQUIRE(reader.segment == nullptr);
+#ifndef _WIN32
+    REQUIRE(om_shm_open(&reader, name.c_str()) == OM_SHM_NOT_FOUND);
+#endif
+}
+
+TEST_CASE("MeterExporter - a segment in use is not taken over", "[meter-export]") {
+    const std::string name = segmentName("owned");
+    core::audio::MeterExporter first;
+    core::audio::MeterExporter second;
+    REQUIRE(first.open(name, kStereo));
+    REQUIRE_FALSE(second.open(name, kStereo));
+
+    // The first writer's segment is intact and still its own
+    first.onMeterData(snapshotFor(7));
+    om_shm_reader reader;
+    REQUIRE(om_shm_open(&reader, name.c_str()) == OM_SHM_OK);
+    om_meter_frame frame;
+    REQUIRE(om_shm_read(&reader, &frame, nullptr) == OM_SHM_OK);
+    REQUIRE(frame.timestamp_ms == 7);
+    om_shm_close(&reader);
+
+    // Once it is gone the name is free again
+    first.close();
+    REQUIRE(second.open(name, kStereo));
+}
+
+#ifndef _WIN32
+
+TEST_CASE("MeterExporter - takes over a segment left by a dead writer", "[meter-export]") {
+    // A pid that is certainly gone: a child that has exited and been reaped
+    const pid_t child = fork();
+    REQUIRE(child >= 0);
+    if (child == 0) {
+        _exit(0);
+    }
+    REQUIRE(waitpid(child, nullptr, 0) == child);
+
+    const std::string name = segmentName("stale");
+    const std::string path = "/" + name;
+    const int fd = shm_open(path.c_str(), O_RDWR | O_CREAT | O_EXCL, 0644);
+    REQUIRE(fd >= 0);
+    REQUIRE(ftruncate(fd, sizeof(om_shm_segment)) == 0);
+    om_shm_segment header = {};
+    header.magic = OM_SHM_MAGIC;
+    header.writer_pid = static_cast<std::uint64_t>(child);
+    REQUIRE(write(fd, &header, sizeof(header)) == static_cast<ssize_t>(sizeof(header)));
+    close(fd);
+
+    core::audio::MeterExporter exporter;
+    REQUIRE(exporter.open(name, kStereo));
+    om_shm_reader reader;
+    REQUIRE(om_shm_open(&reader, name.c_str()) == OM_SHM_OK);
+    REQUIRE(reader.segment->writer_pid == static_cast<std::uint64_t>(getpid()));
+    om_shm_close(&reader);
+}
+
+#endif
+
+TEST_CASE("MeterExporter - concurrent readers never see a torn frame", "[meter-export]") {
+    const std::string name = segmentName("torn");
+    core::audio::MeterExporter exporter;
+    REQUIRE(exporter.open(name, kStereo));
+
+    std::atomic<bool> done{false};
+    std::atomic<int> torn{0};
+    std::atomic<int> reads{0};
+    auto poll = [&] {
+        om_shm_reader reader;
+        if (om_shm_open(&reader, name.c_str()) != OM_SHM_OK) {
+            torn.fetch_add(1000);
+            return;
+        }
+        std::uint64_t last = 0;
+        while (!done.load(std::memory_order_relaxed)) {
+            om_meter_frame frame;
+            std::uint64_t sequence = 0;
+            if (om_shm_read(&reader, &frame, &sequence) != OM_SHM_OK) {
+                continue;
+            }
+            reads.fetch_add(1, std::memory_order_relaxed);
+            const float value = static_cast<float>(frame.timestamp_ms % 1000000);
+            const bool consistent = frame.capture_time_ns == frame.timestamp_ms * 3 && frame.peak[0] == value &&
+                                    frame.peak[1] == value + 1.0f && frame.level[0] == value + 2.0f &&
+                                    frame.peak_hold[1] == value + 5.0f && frame.rms[1] == value + 7.0f;
+            // Snapshot i is published as the i-th frame; the sequence never goes back
+            if (!consistent || (sequence != 0 && frame.timestamp_ms != sequence) || sequence < last) {
+                torn.fetch_add(1);
+            }
+            last = sequence;
+        }
+        om_shm_close(&reader);
+    };
+
+    std::thread first(poll);
+    std::thread second(poll);
+    for (std::uint64_t i = 1; i <= 2000000; ++i) {
+        exporter.onMeterData(snapshotFor(i));
+    }
+    done.store(true);
+    first.join();
+    second.join();
+
+    REQUIRE(torn.load() == 0);
+    REQUIRE(reads.load() > 0);
+}
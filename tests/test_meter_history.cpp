@@ -0,0 +1,143 @@
+#include <catch2/catch.hpp>
+#include "../../common/meter-history.h"
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace openmeters;
+
+namespace {
+
+common::MeterSnapshot snapshotAt(std::uint64_t timestampMs, float peak, float rms) {
+    common::MeterSnapshot snapshot;
+    snapshot.timestampMs = timestampMs;
+    snapshot.peak = {peak, peak * 0.5f};
+    snapshot.rms = {rms, rms * 0.5f};
+    return snapshot;
+}
+
+} // namespace
+
+TEST_CASE("MeterHistory - range queries match a scan of the snapshots", "[meter-history]") {
+    common::MeterHistory history;
+    REQUIRE(history.configure({{10, 64}, {100, 48}, {1000, 16}}));
+
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> level(0.0f, 1.0f);
+    std::uniform_int_distribution<int> step(3, 17);
+    std::vector<common::MeterSnapshot> snapshots;
+
+    std::uint64_t now = 0;
+    for (int i = 0; i < 2000; ++i) {
+        now += static_cast<std::uint64_t>(step(rng));
+        snapshots.push_back(snapshotAt(now, level(rng), level(rng)));
+        history.add(snapshots.back());
+
+        if (i % 7 != 0) {
+            continue;
+        }
+        std::uniform_int_distribution<std::uint64_t> point(0, now + 50);
+        std::uint64_t from = point(rng);
+        std::uint64_t to = point(rng);
+        if (from > to) {
+            std::swap(from, to);
+        }
+        const common::MeterAggregate aggregate = history.query(from, to + 1);
+        if (aggregate.snapshots == 0) {
+            continue;
+        }
+
+        // The answer covers whole buckets around [from, to]; scan the same span
+        REQUIRE(aggregate.endMs > std::min(to, now));
+        float peakMax = 0.0f;
+        float rmsMin = 1.0f;
+        double energy = 0.0;
+        std::uint32_t count = 0;
+        for (const auto& snapshot : snapshots) {
+            if (snapshot.timestampMs >= aggregate.startMs && snapshot.timestampMs < aggregate.endMs) {
+                peakMax = std::max(peakMax, snapshot.peak.left);
+                rmsMin = std::min(rmsMin, snapshot.rms.left);
+                energy += static_cast<double>(snapshot.rms.left) * snapshot.rms.left;
+                ++count;
+            }
+        }
+        REQUIRE(aggregate.snapshots == count);
+        REQUIRE(aggregate.peakMax.left == peakMax);
+        REQUIRE(aggregate.peakMax.right == peakMax * 0.5f);
+        REQUIRE(aggregate.rmsMin.left == rmsMin);
+        REQUIRE(aggregate.rmsMean.left == Approx(std::sqrt(energy / count)).epsilon(1e-5));
+    }
+}
+
+TEST_CASE("MeterHistory - picks the finest level that reaches back far enough", "[meter-history]") {
+    common::MeterHistory history;
+    REQUIRE(history.configure({{10, 100}, {1000, 60}})); // 1 s, then 1 min
+
+    for (std::uint64_t t = 0; t < 30000; t += 10) {
+        history.add(snapshotAt(t, t == 5000 ? 0.9f : 0.1f, 0.1f));
+    }
+
+    // Last 500 ms (widened to whole 10 ms buckets): the old peak is not in range
+    const common::MeterAggregate recent = history.queryLast(500);
+    REQUIRE(recent.startMs == 29490);
+    REQUIRE(recent.endMs == 30000);
+    REQUIRE(recent.peakMax.left == Approx(0.1f));
+
+    // Last 28 s: only the 1 s level reaches back that far
+    const common::MeterAggregate longer = history.queryLast(28000);
+    REQUIRE(longer.startMs == 1000);
+    REQUIRE(longer.endMs == 30000);
+    REQUIRE(longer.peakMax.left == Approx(0.9f));
+    REQUIRE(longer.snapshots == 2900);
+}
+
+TEST_CASE("MeterHistory - gaps read as empty and stale buckets are cleared", "[meter-history]") {
+    common::MeterHistory history;
+    REQUIRE(history.configure({{10, 16}}));
+
+    for (std::uint64_t t = 0; t < 160; t += 10) {
+        history.add(snapshotAt(t, 0.8f, 0.5f));
+    }
+    // Skip 5 buckets; their slots held the loud lap
+    history.add(snapshotAt(210, 0.2f, 0.1f));
+
+    std::vector<common::MeterAggregate> buckets(16);
+    REQUIRE(history.copyBuckets(0, buckets.size(), buckets.data()) == 16);
+    REQUIRE(buckets.back().startMs == 210);
+    REQUIRE(buckets.back().peakMax.left == Approx(0.2f));
+    for (int i = 10; i < 15; ++i) {
+        REQUIRE(buckets[i].snapshots == 0);
+    }
+    REQUIRE(buckets[9].peakMax.left == Approx(0.8f));
+    REQUIRE(history.query(160, 210).snapshots == 0);
+
+    // A gap longer than the ring empties it
+    history.add(snapshotAt(5000, 0.3f, 0.1f));
+    const common::MeterAggregate all = history.query(0, 6000);
+    REQUIRE(all.snapshots == 1);
+    REQUIRE(all.peakMax.left == Approx(0.3f));
+}
+
+TEST_CASE("MeterHistory - restarts and configuration", "[meter-history]") {
+    common::MeterHistory history;
+    REQUIRE(history.levelCount() == 3);
+    REQUIRE(history.level(0).resolutionMs == 10);
+    REQUIRE(history.query(0, 1000).snapshots == 0);
+
+    // Power mean, not the mean of the readings
+    history.add(snapshotAt(1000, 0.5f, 0.0f));
+    history.add(snapshotAt(1001, 0.5f, 1.0f));
+    REQUIRE(history.queryLast(10).rmsMean.left == Approx(std::sqrt(0.5f)));
+    REQUIRE(history.queryLast(10).rmsMin.left == 0.0f);
+    REQUIRE(history.queryLast(10).rmsMax.left == 1.0f);
+
+    // Time going backwards (engine restart) starts over
+    history.add(snapshotAt(20, 0.1f, 0.1f));
+    REQUIRE(history.newestMs() == 20);
+    REQUIRE(history.query(0, 2000).snapshots == 1);
+
+    REQUIRE_FALSE(history.configure({{0, 10}}));
+    REQUIRE_FALSE(history.configure({{10, 0}}));
+    REQUIRE(history.levelCount() == 3);
+}
@@ -0,0 +1,279 @@
+#include <catch2/catch.hpp>
+#include "../../common/clock.h"
+#include "../../common/meter-log.h"
+#include "../../core/audio/meter-logger.h"
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace openmeters;
+using common::MeterLogEntry;
+using common::MeterLogReader;
+using common::MeterLogWriter;
+
+namespace {
+
+std::filesystem::path tempPath(const char* name) {
+    return std::filesystem::temp_directory_path() / name;
+}
+
+double toDb(float linear) {
+    return 20.0 * std::log10(static_cast<double>(linear));
+}
+
+// Quantized to the step (or silence below the floor)
+void requireClose(float decoded, float original, double step) {
+    if (original <= 0.0f || toDb(original) < MeterLogWriter::kFloorDb + step) {
+        REQUIRE(decoded == 0.0f);
+        return;
+    }
+    REQUIRE(decoded > 0.0f);
+    REQUIRE(std::abs(toDb(decoded) - toDb(original)) <= step / 2 + 1e-6);
+}
+
+std::vector<MeterLogEntry> readAll(const MeterLogReader& reader) {
+    std::vector<MeterLogEntry> all;
+    std::vector<MeterLogEntry> chunk;
+    for (std::size_t i = 0; i < reader.chunkCount(); ++i) {
+        REQUIRE(reader.readChunk(i, chunk));
+        all.insert(all.end(), chunk.begin(), chunk.end());
+    }
+    return all;
+}
+
+} // namespace
+
+TEST_CASE("MeterLog - entries round-trip through several chunks", "[meter-log]") {
+    const auto path = tempPath("openmeters_meter_log.ommeter");
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<float> level(0.0f, 1.2f);
+    std::uniform_int_distribution<int> jitter(0, 3);
+
+    // Irregular timestamps, silence, over-full scale and sub-floor levels
+    std::vector<MeterLogEntry> entries;
+    std::uint64_t now = 1700000000000ull;
+    for (std::uint32_t i = 0; i < 2 * MeterLogWriter::kChunkEntries + 100; ++i) {
+        now += 10 + static_cast<std::uint64_t>(jitter(rng)) * (i % 50 == 0 ? 1000 : 1);
+        MeterLogEntry entry{now, {level(rng), level(rng)}, {level(rng), 0.0f}};
+        if (i % 97 == 0) {
+            entry.peak.left = 1e-9f;
+        }
+        entries.push_back(entry);
+    }
+
+    MeterLogWriter writer;
+    REQUIRE(writer.open(path.string()));
+    REQUIRE_FALSE(writer.open(path.string()));
+    for (const MeterLogEntry& entry : entries) {
+        REQUIRE(writer.append(entry));
+    }
+    REQUIRE_FALSE(writer.append({1ull << 62, {}, {}}));
+    REQUIRE(writer.close());
+    REQUIRE(writer.bytesWritten() == std::filesystem::file_size(path));
+
+    MeterLogReader reader;
+    REQUIRE(reader.open(path.string()));
+    REQUIRE(reader.isComplete());
+    REQUIRE(reader.chunkCount() == 3);
+    REQUIRE(reader.entryCount() == entries.size());
+    REQUIRE(reader.dbStep() == Approx(0.1));
+
+    const std::vector<MeterLogEntry> decoded = readAll(reader);
+    REQUIRE(decoded.size() == entries.size());
+    for (std::size_t i = 0; i < entries.size(); ++i) {
+        REQUIRE(decoded[i].timestampMs == entries[i].timestampMs);
+        requireClose(decoded[i].peak.left, entries[i].peak.left, 0.1);
+        requireClose(decoded[i].peak.right, entries[i].peak.right, 0.1);
+        requireClose(decoded[i].rms.left, entries[i].rms.left, 0.1);
+        REQUIRE(decoded[i].rms.right == 0.0f);
+    }
+
+    // Seek into the middle chunk
+    const std::uint64_t from = entries[5000].timestampMs;
+    const std::uint64_t to = entries[5010].timestampMs;
+    REQUIRE(reader.findChunk(from) == 1);
+    REQUIRE(reader.findChunk(entries.back().timestampMs + 1) == reader.chunkCount());
+    std::vector<std::uint64_t> times;
+    REQUIRE(reader.readRange(from, to, [&](const MeterLogEntry& entry) { times.push_back(entry.timestampMs); }) == 10);
+    REQUIRE(times.front() == from);
+    REQUIRE(times.back() == entries[5009].timestampMs);
+
+    reader.close();
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("MeterLog - intervals aggregate snapshots", "[meter-log]") {
+    const auto path = tempPath("openmeters_meter_log_interval.ommeter");
+    MeterLogWriter writer;
+    REQUIRE(writer.open(path.string(), 1000, 0.01));
+
+    // Two seconds of 10 ms snapshots, one loud peak in the first
+    for (std::uint64_t t = 0; t < 2000; t += 10) {
+        common::MeterSnapshot snapshot;
+        snapshot.timestampMs = 5000 + t;
+        snapshot.peak = {t == 500 ? 0.9f : 0.2f, 0.1f};
+        snapshot.rms = {t < 1000 && t % 20 == 0 ? 0.5f : 0.0f, 0.25f};
+        REQUIRE(writer.add(snapshot));
+    }
+    REQUIRE(writer.entryCount() == 1); // The second interval is still open
+    REQUIRE(writer.close());
+
+    MeterLogReader reader;
+    REQUIRE(reader.open(path.string()));
+    REQUIRE(reader.header().intervalMs == 1000);
+    const std::vector<MeterLogEntry> entries = readAll(reader);
+    REQUIRE(entries.size() == 2);
+    REQUIRE(entries[0].timestampMs == 5000);
+    REQUIRE(entries[1].timestampMs == 6000);
+    REQUIRE(entries[0].peak.left == Approx(0.9f).epsilon(0.001));
+    REQUIRE(entries[1].peak.left == Approx(0.2f).epsilon(0.001));
+    REQUIRE(entries[0].rms.left == Approx(0.5f / std::sqrt(2.0f)).epsilon(0.001)); // Power mean
+    REQUIRE(entries[1].rms.left == 0.0f);
+    REQUIRE(entries[1].rms.right == Approx(0.25f).epsilon(0.001));
+
+    reader.close();
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("MeterLog - a day at one entry per second stays small", "[meter-log]") {
+    const auto path = tempPath("openmeters_meter_log_day.ommeter");
+    MeterLogWriter writer;
+    REQUIRE(writer.open(path.string(), 1000));
+
+    // Programme-like levels: slow drift with small variation, plus an hour of silence
+    std::mt19937 rng(11);
+    std::normal_distribution<float> wobble(0.0f, 1.5f);
+    std::uint64_t t = 1700000000000ull;
+    for (int second = 0; second < 86400; ++second, t += 1000) {
+        const bool silent = second >= 3600 && second < 7200;
+        const float base = -20.0f + 6.0f * std::sin(static_cast<float>(second) / 600.0f);
+        const float peak = silent ? 0.0f : std::pow(10.0f, (base + 8.0f + wobble(rng)) / 20.0f);
+        const float rms = silent ? 0.0f : std::pow(10.0f, (base + wobble(rng)) / 20.0f);
+        REQUIRE(writer.append({t, {peak, peak}, {rms, rms}}));
+    }
+    REQUIRE(writer.close());
+
+    // Under 5 bytes per stereo entry (peak and RMS, 0.1 dB steps): about
+    // 12 MB for a month of 1 s entries
+    const auto bytes = std::filesystem::file_size(path);
+    REQUIRE(bytes < 86400 * 5);
+
+    MeterLogReader reader;
+    REQUIRE(reader.open(path.string()));
+    REQUIRE(reader.entryCount() == 86400);
+    reader.close();
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("MeterLog - logs that were never closed are still readable", "[meter-log]") {
+    const auto path = tempPath("openmeters_meter_log_open.ommeter");
+    const auto copy = tempPath("openmeters_meter_log_crash.ommeter");
+
+    MeterLogWriter writer;
+    REQUIRE(writer.open(path.string()));
+    for (std::uint32_t i = 0; i < MeterLogWriter::kChunkEntries + 50; ++i) {
+        REQUIRE(writer.append({1000 + i * 10ull, {0.5f, 0.5f}, {0.25f, 0.25f}}));
+    }
+    REQUIRE(writer.flush()); // Short chunk
+    REQUIRE(writer.append({999999, {0.5f, 0.5f}, {0.25f, 0.25f}})); // Buffered only
+
+    // What a crash would leave behind, plus a torn chunk header at the end
+    std::filesystem::copy_file(path, copy, std::filesystem::copy_options::overwrite_existing);
+    std::filesystem::resize_file(copy, std::filesystem::file_size(copy) + 20);
+
+    MeterLogReader reader;
+    REQUIRE(reader.open(copy.string()));
+    REQUIRE_FALSE(reader.isComplete());
+    REQUIRE(reader.chunkCount() == 2);
+    REQUIRE(reader.chunk(1).entryCount == 50);
+    REQUIRE(reader.entryCount() == MeterLogWriter::kChunkEntries + 50);
+    REQUIRE(readAll(reader).back().timestampMs == 1000 + (MeterLogWriter::kChunkEntries + 49) * 10ull);
+    reader.close();
+
+    REQUIRE(writer.close());
+    REQUIRE(reader.open(path.string()));
+    REQUIRE(reader.isComplete());
+    REQUIRE(reader.chunkCount() == 3);
+    reader.close();
+
+    // Not a meter log
+    std::filesystem::resize_file(copy, 16);
+    REQUIRE_FALSE(reader.open(copy.string()));
+
+    std::filesystem::remove(path);
+    std::filesystem::remove(copy);
+}
+
+TEST_CASE("MeterLogger - logs snapshots between start and stop with wall clock times", "[meter-log]") {
+    const std::filesystem::path dir = tempPath("openmeters_meter_logger_test");
+    std::filesystem::remove_all(dir);
+    const auto path = dir / "meters.ommeter";
+
+    core::audio::MeterLogger logger;
+    common::MeterSnapshot snapshot;
+    snapshot.peak = {0.5f, 0.25f};
+    snapshot.rms = {0.1f, 0.1f};
+    logger.onMeterData(snapshot); // Not logging yet
+
+    REQUIRE(logger.start(path.string(), 0));
+    REQUIRE(logger.isLogging());
+    REQUIRE_FALSE(logger.start(path.string(), 0));
+
+    const auto before = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    for (int i = 0; i < 300; ++i) {
+        snapshot.captureTimeNs = common::monotonicNanos();
+        logger.onMeterData(snapshot);
+    }
+    logger.stop();
+    REQUIRE_FALSE(logger.isLogging());
+    logger.onMeterData(snapshot); // Stopped
+    REQUIRE(logger.snapshotsLogged() == 300);
+    REQUIRE(logger.droppedSnapshots() == 0);
+
+    MeterLogReader reader;
+    REQUIRE(reader.open(path.string()));
+    const std::vector<MeterLogEntry> entries = readAll(reader);
+    REQUIRE(entries.size() == 300);
+    REQUIRE(static_cast<long long>(entries.front().timestampMs) >= before - 1000);
+    REQUIRE(static_cast<long long>(entries.front().timestampMs) <= before + 60000);
+    REQUIRE(entries.back().peak.right == Approx(0.25f).epsilon(0.02));
+    reader.close();
+
+    std::filesystem::remove_all(dir);
+}
+
+TEST_CASE("MeterLogger - readings reach the file within the flush interval", "[meter-log]") {
+    const std::filesystem::path dir = tempPath("openmeters_meter_logger_flush_test");
+    std::filesystem::remove_all(dir);
+    const auto path = dir / "meters.ommeter";
+
+    core::audio::MeterLogger logger;
+    REQUIRE(logger.start(path.string(), 0, 1));
+
+    common::MeterSnapshot snapshot;
+    snapshot.peak = {0.5f, 0.5f};
+    for (int i = 0; i < 10; ++i) {
+        snapshot.captureTimeNs = common::monotonicNanos();
+        logger.onMeterData(snapshot);
+    }
+
+    // Still logging: what a crash now would leave behind
+    std::size_t onDisk = 0;
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (onDisk == 0 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        MeterLogReader reader;
+        if (reader.open(path.string())) {
+            onDisk = readAll(reader).size();
+        }
+    }
+    REQUIRE(logger.isLogging());
+    REQUIRE(onDisk == 10);
+
+    logger.stop();
+    std::filesystem::remove_all(dir);
+}
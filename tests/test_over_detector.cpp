@@ -0,0 +1,226 @@
+#include <catch2/catch.hpp>
+#include "../../core/meters/over-detector.h"
+#include "../../common/audio-format.h"
+#include "../../common/event-ring.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+using namespace openmeters;
+
+namespace {
+
+common::AudioFormat makeFormat(common::ChannelCount channels) {
+    common::AudioFormat format;
+    format.sampleRate = 48000;
+    format.channelCount = channels;
+    return format;
+}
+
+// Reads everything pushed so far
+std::vector<common::OverEvent> drain(const common::EventRing<common::OverEvent>& ring, std::uint64_t& cursor) {
+    std::vector<common::OverEvent> events(ring.capacity());
+    events.resize(ring.read(cursor, events.data(), events.size()));
+    return events;
+}
+
+// Overs found by walking every sample, for comparison with the detector
+std::vector<std::pair<std::uint64_t, std::size_t>> referenceOvers(
+    const std::vector<float>& samples, std::size_t channels, float threshold, std::uint32_t runLength) {
+    std::vector<std::pair<std::uint64_t, std::size_t>> overs;
+    for (std::size_t ch = 0; ch < std::min<std::size_t>(channels, 2); ++ch) {
+        std::uint32_t run = 0;
+        for (std::size_t frame = 0; frame * channels < samples.size(); ++frame) {
+            run = std::abs(samples[frame * channels + ch]) >= threshold ? run + 1 : 0;
+            if (run == runLength) {
+                overs.emplace_back(frame + 1 - runLength, ch);
+            }
+        }
+    }
+    std::sort(overs.begin(), overs.end());
+    return overs;
+}
+
+} // namespace
+
+TEST_CASE("Over detector - counts consecutive samples", "[meters][overs]") {
+    common::EventRing<common::OverEvent> ring;
+    REQUIRE(ring.reserve(64));
+    std::uint64_t cursor = 0;
+    core::meters::OverDetector detector;
+    detector.setEventSink(&ring);
+    const auto mono = makeFormat(1);
+
+    SECTION("Runs shorter than the run length are not overs") {
+        const float samples[] = {0.0f, 1.0f, 1.0f, 0.0f, -1.0f, -1.0f, 0.5f};
+        detector.process(samples, 7, mono);
+        REQUIRE(detector.overCount() == 0);
+        REQUIRE(drain(ring, cursor).empty());
+    }
+
+    SECTION("One event per run, at the run's first sample") {
+        std::vector<float> samples(100, 0.0f);
+        std::fill(samples.begin() + 10, samples.begin() + 40, -1.0f); // One long run
+        std::fill(samples.begin() + 50, samples.begin() + 53, 1.0f);  // Exactly three
+        detector.process(samples.data(), samples.size(), mono);
+        const auto events = drain(ring, cursor);
+        REQUIRE(events.size() == 2);
+        REQUIRE(events[0].position == 10);
+        REQUIRE(events[0].samples == 3);
+        REQUIRE(events[1].position == 50);
+        REQUIRE(events[1].channel == 0);
+        REQUIRE(detector.position() == 100);
+    }
+
+    SECTION("Runs carry across packets") {
+        std::vector<float> samples(20, 0.0f);
+        samples[19] = 1.0f;
+        detector.process(samples.data(), samples.size(), mono, 1000000000);
+        samples.assign(20, 0.0f);
+        samples[0] = 1.0f;
+        samples[1] = 1.0f;
+        detector.process(samples.data(), samples.size(), mono, 2000000000);
+        const auto events = drain(ring, cursor);
+        REQUIRE(events.size() == 1);
+        REQUIRE(events[0].position == 19);
+        // One frame before the second packet's capture time
+        REQUIRE(events[0].captureTimeNs == 2000000000 - 1000000000 / 48000);
+    }
+
+    SECTION("Silence ends runs and advances the position") {
+        std::vector<float> samples(20, 0.0f);
+        samples[18] = 1.0f;
+        samples[19] = 1.0f;
+        detector.process(samples.data(), samples.size(), mono);
+        detector.processSilence(100);
+        samples.assign(20, 0.0f);
+        samples[0] = 1.0f;
+        detector.process(samples.data(), samples.size(), mono);
+        REQUIRE(detector.overCount() == 0);
+        REQUIRE(detector.position() == 140);
+    }
+
+    SECTION("Threshold and run length are configurable") {
+        core::meters::OverSettings settings;
+        settings.thresholdDb = -6.0f;
+        settings.runLength = 1;
+        detector.configure(settings);
+        const float samples[] = {0.4f, 0.6f, 0.0f, -0.55f};
+        detector.process(samples, 4, mono);
+        REQUIRE(detector.overCount() == 2);
+    }
+}
+
+TEST_CASE("Over detector - matches a sample-by-sample scan", "[meters][overs]") {
+    // Clipped bursts of random lengths at random offsets, so runs start and
+    // end at every position within the eight-sample compare
+    std::uint32_t state = 7;
+    const auto next = [&state] {
+        state = state * 1664525u + 1013904223u;
+        return state >> 8;
+    };
+
+    for (const common::ChannelCount channels : {1, 2}) {
+        std::vector<float> samples(4801 * channels, 0.25f);
+        for (int burst = 0; burst < 200; ++burst) {
+            const std::size_t start = next() % samples.size();
+            const std::size_t length = next() % 12;
+            for (std::size_t i = start; i < std::min(samples.size(), start + length); ++i) {
+                samples[i] = (next() & 1) ? 1.0f : -1.0f;
+            }
+        }
+        const auto expected = referenceOvers(samples, channels, 1.0f, 3);
+        REQUIRE(!expected.empty());
+
+        for (const std::size_t packet : {std::size_t{1}, std::size_t{5}, std::size_t{480}, std::size_t{4801}}) {
+            common::EventRing<common::OverEvent> ring;
+            REQUIRE(ring.reserve(4096));
+            core::meters::OverDetector detector;
+            core::meters::OverSettings settings;
+            settings.thresholdDb = 0.0f;
+            detector.configure(settings);
+            detector.setEventSink(&ring);
+            const auto format = makeFormat(channels);
+            const std::size_t frames = samples.size() / channels;
+            for (std::size_t start = 0; start < frames; start += packet) {
+                detector.process(samples.data() + start * channels, std::min(packet, frames - start), format);
+            }
+
+            std::uint64_t cursor = 0;
+            std::vector<std::pair<std::uint64_t, std::size_t>> found;
+            for (const auto& event : drain(ring, cursor)) {
+                found.emplace_back(event.position, event.channel);
+            }
+            std::sort(found.begin(), found.end());
+            REQUIRE(found == expected);
+        }
+    }
+}
+
+TEST_CASE("Over detector - integer input", "[meters][overs]") {
+    const auto stereo = makeFormat(2);
+
+    SECTION("int16: full scale in both directions") {
+        core::meters::OverDetector detector;
+        // Left: 32767 x3 (-0.0003 dBFS, over at -0.01); right: -32768 x3
+        std::vector<std::int16_t> samples(32, 0);
+        for (std::size_t frame = 4; frame < 7; ++frame) {
+            samples[frame * 2] = 32767;
+            samples[frame * 2 + 1] = -32768;
+        }
+        detector.process(samples.data(), 16, stereo);
+        REQUIRE(detector.overCount() == 2);
+
+        // 0 dBFS: only -32768 reaches it
+        core::meters::OverSettings settings;
+        settings.thresholdDb = 0.0f;
+        detector.configure(settings);
+        detector.reset();
+        detector.process(samples.data(), 16, stereo);
+        REQUIRE(detector.overCount() == 1);
+    }
+
+    SECTION("int32: below the threshold is not an over") {
+        core::meters::OverDetector detector;
+        std::vector<std::int32_t> samples(32, 0);
+        for (std::size_t frame = 4; frame < 7; ++frame) {
+            samples[frame * 2] = 2140000000;       // -0.03 dBFS
+            samples[frame * 2 + 1] = -2147483647;  // Full scale
+        }
+        detector.process(samples.data(), 16, stereo);
+        REQUIRE(detector.overCount() == 1);
+    }
+}
+
+TEST_CASE("Event ring - every reader sees every event", "[overs]") {
+    common::EventRing<common::OverEvent> ring;
+    REQUIRE(ring.reserve(8));
+    REQUIRE(ring.capacity() == 8);
+
+    std::uint64_t first = 0;
+    std::uint64_t second = 0;
+    for (std::uint64_t i = 0; i < 5; ++i) {
+        common::OverEvent event;
+        event.position = i;
+        ring.push(event);
+    }
+    common::OverEvent events[8];
+    REQUIRE(ring.read(first, events, 8) == 5);
+    REQUIRE(events[4].position == 4);
+    REQUIRE(ring.read(second, events, 2) == 2);
+    REQUIRE(ring.read(second, events, 8) == 3);
+    REQUIRE(events[0].position == 2);
+    REQUIRE(ring.read(first, events, 8) == 0);
+
+    // A reader that falls behind loses the oldest events, and is told so
+    for (std::uint64_t i = 5; i < 20; ++i) {
+        common::OverEvent event;
+        event.position = i;
+        ring.push(event);
+    }
+    std::uint64_t lost = 0;
+    REQUIRE(ring.read(first, events, 8, &lost) == 8);
+    REQUIRE(lost == 7);
+    REQUIRE(events[0].position == 12);
+    REQUIRE(first == ring.writeIndex());
+}
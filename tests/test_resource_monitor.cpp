@@ -0,0 +1,86 @@
+#include <catch2/catch.hpp>
+#include "../../common/buffer-pool.h"
+#include "../../common/resource-monitor.h"
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+using namespace openmeters;
+
+namespace {
+
+void burnCpu(std::chrono::milliseconds duration) {
+    const auto end = std::chrono::steady_clock::now() + duration;
+    volatile double sink = 0.0;
+    while (std::chrono::steady_clock::now() < end) {
+        for (int i = 0; i < 1000; ++i) {
+            sink = sink + 1.0;
+        }
+    }
+}
+
+} // namespace
+
+TEST_CASE("ResourceMonitor - CPU time per thread role", "[resources]") {
+    const auto before = common::ResourceMonitor::sample().thread(common::ThreadRole::Ui);
+
+    std::atomic<bool> registered{false};
+    std::atomic<bool> release{false};
+    std::thread worker([&] {
+        common::ResourceMonitor::registerCurrentThread(common::ThreadRole::Ui);
+        registered.store(true);
+        burnCpu(std::chrono::milliseconds(150));
+        while (!release.load()) {
+            std::this_thread::yield();
+        }
+    });
+    while (!registered.load()) {
+        std::this_thread::yield();
+    }
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    const auto during = common::ResourceMonitor::sample().thread(common::ThreadRole::Ui);
+    REQUIRE(during.threads == before.threads + 1);
+    REQUIRE(during.cpuPercent > 0.0);
+
+    release.store(true);
+    worker.join();
+
+    // Exited threads keep their CPU time in the role total
+    std::this_thread::sleep_for(std::chrono::milliseconds(120));
+    const auto after = common::ResourceMonitor::sample().thread(common::ThreadRole::Ui);
+    REQUIRE(after.threads == before.threads);
+    REQUIRE(after.cpuSeconds - before.cpuSeconds >= 0.05);
+    REQUIRE(after.cpuSeconds >= during.cpuSeconds);
+}
+
+TEST_CASE("ResourceMonitor - tagged arena bytes", "[resources]") {
+    const auto before = common::ResourceMonitor::sample().tag(common::MemoryTag::Analysis);
+
+    {
+        common::BufferPool pool(common::MemoryTag::Analysis);
+        REQUIRE(pool.reserve(1 << 20));
+        const auto reserved = common::ResourceMonitor::sample().tag(common::MemoryTag::Analysis);
+        REQUIRE(reserved.bytes == before.bytes + (1 << 20));
+        REQUIRE(reserved.peakBytes >= reserved.bytes);
+
+        REQUIRE(pool.reserve(1 << 10)); // Re-reserve replaces the old storage
+        REQUIRE(common::ResourceMonitor::sample().tag(common::MemoryTag::Analysis).bytes == before.bytes + (1 << 10));
+    }
+
+    const auto released = common::ResourceMonitor::sample().tag(common::MemoryTag::Analysis);
+    REQUIRE(released.bytes == before.bytes);
+    REQUIRE(released.peakBytes >= before.bytes + (1 << 20));
+}
+
+TEST_CASE("ResourceMonitor - format", "[resources]") {
+    common::ResourceUsage usage;
+    usage.threads[static_cast<std::size_t>(common::ThreadRole::Capture)].threads = 1;
+    usage.threads[static_cast<std::size_t>(common::ThreadRole::Capture)].cpuPercent = 0.25;
+    usage.memory[static_cast<std::size_t>(common::MemoryTag::Audio)].bytes = 2 * 1024 * 1024;
+
+    const std::string text = common::ResourceMonitor::format(usage);
+    REQUIRE(text.find("capture 0.25%") != std::string::npos);
+    REQUIRE(text.find("audio 2.0 MB") != std::string::npos);
+    REQUIRE(text.find("ui") == std::string::npos); // Idle roles are omitted
+}
@@ -0,0 +1,207 @@
+#include <catch2/catch.hpp>
+#include "../../core/audio/audio-engine.h"
+#include "../../core/audio/callback-dispatcher.h"
+#include "../../core/audio/synthetic-source.h"
+#include "../../common/realtime-scope.h"
+#include "../../common/rt-check.h"
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+using namespace openmeters;
+
+namespace {
+
+// Records the latest meter values; assertions happen on the test thread
+class SnapshotCallback : public core::audio::IAudioDataCallback {
+public:
+    void onAudioData(const float*, std::size_t, const common::AudioFormat&) override {}
+
+    void onMeterData(const common::MeterSnapshot& snapshot) override {
+        m_peakLeft.store(snapshot.peak.left);
+        m_rmsLeft.store(snapshot.rms.left);
+        m_count.fetch_add(1);
+    }
+
+    std::atomic<float> m_peakLeft{0.0f};
+    std::atomic<float> m_rmsLeft{0.0f};
+    std::atomic<int> m_count{0};
+};
+
+// Needs float data, so packed 24-bit packets go through conversion
+class FloatCallback : public core::audio::IAudioDataCallback {
+public:
+    void onAudioData(const float* buffer, std::size_t frameCount, const common::AudioFormat& format) override {
+        m_lastSample.store(buffer[frameCount * format.samplesPerFrame() - 1]);
+        m_count.fetch_add(1);
+    }
+
+    void onMeterData(const common::MeterSnapshot&) override {}
+
+    std::atomic<float> m_lastSample{0.0f};
+    std::atomic<int> m_count{0};
+};
+
+} // namespace
+
+TEST_CASE("AudioEngine - meters a synthetic source", "[audio][rt]") {
+    core::audio::SyntheticSourceConfig config;
+    config.amplitude = 0.5f;
+    config.blockLimit = 50;
+    config.paced = false;
+
+    SECTION("Float32") {
+        config.sampleFormat = core::audio::SampleFormat::Float32;
+    }
+    SECTION("Int16") {
+        config.sampleFormat = core::audio::SampleFormat::Int16;
+    }
+    SECTION("Int24 packed (converted)") {
+        config.sampleFormat = core::audio::SampleFormat::Int24Packed;
+    }
+
+    auto source = std::make_unique<core::audio::SyntheticSource>(config);
+    auto* sourcePtr = source.get();
+    core::audio::AudioEngine engine(std::move(source));
+
+    SnapshotCallback snapshots;
+    FloatCallback floats;
+    engine.registerCallback(&snapshots);
+    REQUIRE(engine.initialize());
+    sourcePtr->registerCallback(&floats);
+
+    REQUIRE(engine.start());
+    while (engine.isCapturing()) {
+        std::this_thread::yield();
+    }
+
+    REQUIRE(sourcePtr->blocksDelivered() == 50);
+    REQUIRE(snapshots.m_count.load() == 50);
+    REQUIRE(floats.m_count.load() == 50);
+    REQUIRE(snapshots.m_peakLeft.load() == Approx(0.5f).margin(1e-3));
+    REQUIRE(snapshots.m_rmsLeft.load() == Approx(0.5f / std::sqrt(2.0f)).margin(1e-2));
+
+    engine.shutdown();
+}
+
+TEST_CASE("CallbackDispatcher - unregister while running", "[audio][rt]") {
+    core::audio::SyntheticSourceConfig config;
+    config.paced = false;
+
+    core::audio::AudioEngine engine(std::make_unique<core::audio::SyntheticSource>(config));
+    SnapshotCallback first;
+    SnapshotCallback second;
+    engine.registerCallback(&first);
+    REQUIRE(engine.initialize());
+    REQUIRE(engine.start());
+
+    // Registration churn from the control thread while packets flow
+    for (int i = 0; i < 200; ++i) {
+        engine.registerCallback(&second);
+        engine.unregisterCallback(&second);
+    }
+    const int countAfterRemoval = second.m_count.load();
+    std::this_thread::yield();
+    REQUIRE(second.m_count.load() == countAfterRemoval);
+
+    engine.shutdown();
+    REQUIRE(first.m_count.load() > 0);
+}
+
+TEST_CASE("CallbackDispatcher - exhausted arena drops only the float path", "[audio][rt]") {
+    // Takes native blocks
+    class BlockCallback : public core::audio::IAudioDataCallback {
+    public:
+        bool onAudioBlock(const core::audio::AudioBlock&) override {
+            ++m_count;
+            return true;
+        }
+        void onAudioData(const float*, std::size_t, const common::AudioFormat&) override {}
+        void onMeterData(const common::MeterSnapshot&) override {}
+
+        int m_count = 0;
+    };
+
+    core::audio::CallbackDispatcher dispatcher;
+    FloatCallback floats;
+    BlockCallback blocks;
+    dispatcher.add(&floats);
+    dispatcher.add(&blocks);
+
+    // An arena too small for the float copy
+    common::BufferPool pool;
+    REQUIRE(pool.reserve(64));
+    const std::int16_t samples[480 * 2] = {};
+    core::audio::AudioBlock block;
+    block.data = samples;
+    block.frameCount = 480;
+    block.sampleFormat = core::audio::SampleFormat::Int16;
+
+    REQUIRE_FALSE(dispatcher.dispatchBlock(block, pool));
+    REQUIRE(floats.m_count.load() == 0);
+    REQUIRE(blocks.m_count == 1);
+    dispatcher.clear();
+}
+
+TEST_CASE("RT check - flags allocation and locks in a real-time scope", "[rt]") {
+    if (!common::rtCheckEnabled()) {
+        WARN("Built without OPENMETERS_RT_CHECK; interposition not active");
+        return;
+    }
+
+    common::resetRtViolations();
+    std::mutex mutex;
+    {
+        const common::RealtimeScope scope;
+        void* volatile block = std::malloc(64);
+        std::free(block);
+        mutex.lock();
+        mutex.unlock();
+    }
+    const auto violations = common::rtViolationCount();
+    common::resetRtViolations();
+
+    // malloc + free + pthread_mutex_lock
+    REQUIRE(violations == 3);
+}
+
+TEST_CASE("RT check - flags aligned allocation and trylock in a real-time scope", "[rt]") {
+    if (!common::rtCheckEnabled()) {
+        WARN("Built without OPENMETERS_RT_CHECK; interposition not active");
+        return;
+    }
+
+    common::resetRtViolations();
+    std::mutex mutex;
+    std::uint64_t afterNew = 0;
+    int memalignResult = -1;
+    bool locked = false;
+    {
+        const common::RealtimeScope scope;
+        std::uint64_t* volatile value = new (std::align_val_t{64}) std::uint64_t;
+        ::operator delete(value, std::align_val_t{64});
+        afterNew = common::rtViolationCount();
+
+        void* volatile block = std::aligned_alloc(64, 64);
+        std::free(block);
+        void* aligned = nullptr;
+        memalignResult = posix_memalign(&aligned, 64, 64);
+        std::free(aligned);
+        locked = mutex.try_lock();
+        if (locked) {
+            mutex.unlock();
+        }
+    }
+    const auto violations = common::rtViolationCount();
+    common::resetRtViolations();
+
+    // Aligned operator new + delete
+    REQUIRE(afterNew == 2);
+    // aligned_alloc + free + posix_memalign + free + pthread_mutex_trylock
+    REQUIRE(memalignResult == 0);
+    REQUIRE(locked);
+    REQUIRE(violations - afterNew == 5);
+}
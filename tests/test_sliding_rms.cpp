@@ -0,0 +1,169 @@
+#include <catch2/catch.hpp>
+#include "../../core/meters/sliding-rms.h"
+#include "../../common/audio-format.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+using namespace openmeters;
+
+namespace {
+
+constexpr common::SampleRate kRate = 48000;
+
+common::AudioFormat stereoFormat() {
+    common::AudioFormat format;
+    format.sampleRate = kRate;
+    format.channelCount = 2;
+    return format;
+}
+
+// Feed a stereo buffer in packets of the given size
+void feed(core::meters::SlidingRms& meter, const std::vector<float>& buffer, std::size_t packet = 480) {
+    const auto format = stereoFormat();
+    const std::size_t total = buffer.size() / 2;
+    for (std::size_t start = 0; start < total; start += packet) {
+        meter.process(buffer.data() + start * 2, std::min(packet, total - start), format);
+    }
+}
+
+std::vector<float> constant(float left, float right, std::size_t frameCount) {
+    std::vector<float> buffer(frameCount * 2);
+    for (std::size_t i = 0; i < frameCount; ++i) {
+        buffer[i * 2] = left;
+        buffer[i * 2 + 1] = right;
+    }
+    return buffer;
+}
+
+std::vector<float> sine(float amplitude, double frequency, std::size_t frameCount) {
+    std::vector<float> buffer(frameCount * 2);
+    for (std::size_t i = 0; i < frameCount; ++i) {
+        const float s = amplitude * static_cast<float>(std::sin(2.0 * 3.141592653589793 * frequency * i / kRate));
+        buffer[i * 2] = s;
+        buffer[i * 2 + 1] = s;
+    }
+    return buffer;
+}
+
+core::meters::SlidingRms makeMeter(float windowMs) {
+    core::meters::SlidingRms meter;
+    meter.configure(windowMs, kRate);
+    return meter;
+}
+
+} // namespace
+
+TEST_CASE("Sliding RMS - steady signals", "[meters][rms]") {
+    auto meter = makeMeter(300.0f);
+
+    SECTION("Constant per channel") {
+        feed(meter, constant(0.5f, 0.25f, 14400));
+        REQUIRE(meter.value().left == Approx(0.5f));
+        REQUIRE(meter.value().right == Approx(0.25f));
+    }
+
+    SECTION("Sine reads amplitude / sqrt(2)") {
+        feed(meter, sine(1.0f, 1000.0, 28800));
+        REQUIRE(meter.value().left == Approx(0.7071f).epsilon(0.001));
+    }
+
+    SECTION("Reset clears the window") {
+        feed(meter, constant(0.5f, 0.5f, 14400));
+        meter.reset();
+        REQUIRE(meter.value().left == 0.0f);
+        feed(meter, constant(0.1f, 0.1f, 480));
+        REQUIRE(meter.value().left == Approx(0.1f));
+    }
+}
+
+TEST_CASE("Sliding RMS - window length", "[meters][rms]") {
+    for (const float windowMs : {50.0f, 300.0f, 3000.0f}) {
+        auto meter = makeMeter(windowMs);
+        const std::size_t window = meter.windowFrames();
+        REQUIRE(std::abs(static_cast<double>(window) - windowMs * kRate / 1000.0) <= windowMs * kRate / 100000.0);
+
+        // A burst fills the window, then leaves it exactly one window later
+        feed(meter, constant(1.0f, 1.0f, window));
+        REQUIRE(meter.value().left == Approx(1.0f));
+        feed(meter, constant(0.0f, 0.0f, window / 2));
+        REQUIRE(meter.value().left == Approx(std::sqrt(0.5f)).epsilon(0.02));
+        feed(meter, constant(0.0f, 0.0f, window - window / 2));
+        REQUIRE(meter.value().left == 0.0f);
+    }
+}
+
+TEST_CASE("Sliding RMS - independent of packet size", "[meters][rms]") {
+    const auto signal = sine(0.7f, 440.0, 30000);
+    auto large = makeMeter(50.0f);
+    auto small = makeMeter(50.0f);
+    feed(large, signal, 1024);
+    feed(small, signal, 37);
+    REQUIRE(small.value().left == Approx(large.value().left).epsilon(1e-6));
+    REQUIRE(small.value().right == Approx(large.value().right).epsilon(1e-6));
+}
+
+TEST_CASE("Sliding RMS - silence without samples", "[meters][rms]") {
+    const auto format = stereoFormat();
+    auto zeros = makeMeter(50.0f);
+    auto silent = makeMeter(50.0f);
+    const auto signal = sine(0.7f, 440.0, 5000);
+    feed(zeros, signal);
+    feed(silent, signal);
+
+    // Partial windows, with packets that do not line up with blocks
+    const std::size_t packets[] = {37, 480, 1, 1000};
+    for (const std::size_t packet : packets) {
+        feed(zeros, constant(0.0f, 0.0f, packet));
+        silent.processSilence(packet, format);
+        REQUIRE(silent.value().left == Approx(zeros.value().left).epsilon(1e-6));
+        REQUIRE(silent.value().right == Approx(zeros.value().right).epsilon(1e-6));
+    }
+
+    // Longer than the window: exactly zero
+    silent.processSilence(silent.windowFrames() * 3, format);
+    REQUIRE(silent.value().left == 0.0f);
+    feed(silent, constant(0.5f, 0.5f, silent.windowFrames() * 2));
+    REQUIRE(silent.value().left == Approx(0.5f).epsilon(1e-4));
+}
+
+TEST_CASE("Sliding RMS - no drift after loud passages", "[meters][rms]") {
+    auto meter = makeMeter(50.0f);
+
+    // Many windows of loud noise-like values, then a quiet tone
+    std::vector<float> loud(48000 * 2);
+    std::uint32_t state = 1;
+    for (auto& sample : loud) {
+        state = state * 1664525u + 1013904223u;
+        sample = static_cast<float>(state >> 8) / 16777216.0f * 2.0f - 1.0f;
+    }
+    for (int i = 0; i < 20; ++i) {
+        feed(meter, loud);
+    }
+    // One more packet: the loud part did not end on a block boundary
+    feed(meter, constant(1e-6f, 1e-6f, meter.windowFrames() + 480));
+    REQUIRE(meter.value().left == Approx(1e-6f).epsilon(1e-4));
+    REQUIRE(meter.value().right == Approx(1e-6f).epsilon(1e-4));
+}
+
+TEST_CASE("Sliding RMS - integer input and mono", "[meters][rms]") {
+    std::vector<float> f(4800);
+    std::vector<std::int16_t> i16(4800);
+    for (std::size_t i = 0; i < f.size(); ++i) {
+        i16[i] = static_cast<std::int16_t>((i % 7) * 4000 - 12000);
+        f[i] = static_cast<float>(i16[i]) / 32768.0f;
+    }
+    auto fromFloat = makeMeter(50.0f);
+    auto fromInt16 = makeMeter(50.0f);
+    fromFloat.process(f.data(), 2400, stereoFormat());
+    fromInt16.process(i16.data(), 2400, stereoFormat());
+    REQUIRE(fromInt16.value().left == Approx(fromFloat.value().left));
+    REQUIRE(fromInt16.value().right == Approx(fromFloat.value().right));
+
+    common::AudioFormat mono;
+    mono.sampleRate = kRate;
+    mono.channelCount = 1;
+    auto monoMeter = makeMeter(50.0f);
+    monoMeter.process(f.data(), 4800, mono);
+    REQUIRE(monoMeter.value().right == monoMeter.value().left);
+}
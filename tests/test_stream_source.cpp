@@ -0,0 +1,227 @@
+#include <catch2/catch.hpp>
+#include "../../core/audio/stream-source.h"
+#include "../../core/audio/wav-writer.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+#include <vector>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace openmeters;
+using core::audio::SampleFormat;
+using core::audio::StreamSource;
+using core::audio::StreamSourceConfig;
+
+namespace {
+
+constexpr std::size_t kCapacity = 1 << 16;
+
+// Copies delivered Int16 samples into fixed storage on the source thread
+class SampleLog : public core::audio::IAudioDataCallback {
+public:
+    SampleLog() : m_samples(kCapacity) {}
+
+    bool onAudioBlock(const core::audio::AudioBlock& block) override {
+        m_format.store(static_cast<int>(block.sampleFormat));
+        const std::size_t used = m_sampleCount.load();
+        const std::size_t samples = std::min(block.sampleCount(), kCapacity - used);
+        if (block.sampleFormat == SampleFormat::Int16) {
+            std::memcpy(m_samples.data() + used, block.data, samples * sizeof(std::int16_t));
+        }
+        m_sampleCount.store(used + samples);
+        m_blocks.fetch_add(1);
+        return true;
+    }
+
+    void onAudioData(const float*, std::size_t, const common::AudioFormat&) override {}
+    void onMeterData(const common::MeterSnapshot&) override {}
+
+    std::vector<std::int16_t> m_samples;
+    std::atomic<std::size_t> m_sampleCount{0};
+    std::atomic<int> m_blocks{0};
+    std::atomic<int> m_format{0};
+};
+
+void waitForEnd(const core::audio::IAudioSource& source) {
+    while (source.isCapturing()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+template <typename Predicate>
+bool waitFor(Predicate predicate) {
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (!predicate()) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+std::vector<std::int16_t> ramp(std::size_t samples, int offset = 0) {
+    std::vector<std::int16_t> values(samples);
+    for (std::size_t i = 0; i < samples; ++i) {
+        values[i] = static_cast<std::int16_t>(static_cast<int>(i) + offset);
+    }
+    return values;
+}
+
+} // namespace
+
+TEST_CASE("StreamSource - WAV file", "[stream]") {
+    const auto path = std::filesystem::temp_directory_path() / "openmeters-stream.wav";
+    const common::AudioFormat mono{44100, 1};
+
+    // 1000 frames: two full 480-frame blocks and a partial one
+    const std::vector<std::int16_t> samples = ramp(1000);
+    std::vector<float> floats(samples.size());
+    for (std::size_t i = 0; i < samples.size(); ++i) {
+        floats[i] = static_cast<float>(samples[i]) / 32768.0f;
+    }
+    core::audio::WavWriter writer;
+    REQUIRE(writer.open(path.string(), mono, SampleFormat::Int16));
+    REQUIRE(writer.write(floats.data(), floats.size()));
+    REQUIRE(writer.close());
+
+    StreamSourceConfig config;
+    config.path = path.string();
+    config.paced = false;
+    StreamSource source(config);
+    REQUIRE(source.initialize());
+    REQUIRE(source.getFormat().sampleRate == 44100);
+    REQUIRE(source.getFormat().channelCount == 1);
+    REQUIRE(source.sampleFormat() == SampleFormat::Int16);
+
+    SampleLog log;
+    source.registerCallback(&log);
+    REQUIRE(source.start());
+    waitForEnd(source);
+
+    REQUIRE(log.m_blocks.load() == 3);
+    REQUIRE(log.m_sampleCount.load() == samples.size());
+    REQUIRE(std::equal(samples.begin(), samples.end(), log.m_samples.begin()));
+
+    source.shutdown();
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("StreamSource - raw PCM file", "[stream]") {
+    const auto path = std::filesystem::temp_directory_path() / "openmeters-stream.raw";
+    const std::vector<std::int16_t> samples = ramp(960 * 2);
+    {
+        std::ofstream file(path, std::ios::binary);
+        file.write(reinterpret_cast<const char*>(samples.data()), static_cast<std::streamsize>(samples.size() * 2));
+    }
+
+    StreamSourceConfig config;
+    config.path = path.string();
+    config.format = {48000, 2};
+    config.sampleFormat = SampleFormat::Int16;
+    config.paced = false;
+
+    SECTION("Stops at the end") {
+        StreamSource source(config);
+        REQUIRE(source.initialize());
+        SampleLog log;
+        source.registerCallback(&log);
+        REQUIRE(source.start());
+        waitForEnd(source);
+
+        REQUIRE(log.m_blocks.load() == 2);
+        REQUIRE(log.m_sampleCount.load() == samples.size());
+        REQUIRE(log.m_samples[1919] == samples[1919]);
+        source.shutdown();
+    }
+
+    SECTION("Loops") {
+        config.loop = true;
+        StreamSource source(config);
+        REQUIRE(source.initialize());
+        SampleLog log;
+        source.registerCallback(&log);
+        REQUIRE(source.start());
+        REQUIRE(waitFor([&] { return log.m_blocks.load() >= 5; }));
+        source.stop();
+
+        // The third block is the start of the file again
+        REQUIRE(log.m_samples[2 * samples.size()] == samples[0]);
+        source.shutdown();
+    }
+
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("StreamSource - rejects unusable input", "[stream]") {
+    StreamSourceConfig config;
+    config.path = (std::filesystem::temp_directory_path() / "openmeters-missing.raw").string();
+    REQUIRE_FALSE(StreamSource(config).initialize());
+
+    // Raw input with an impossible format
+    const auto path = std::filesystem::temp_directory_path() / "openmeters-stream-bad.raw";
+    std::ofstream(path, std::ios::binary) << "data";
+    config.path = path.string();
+    config.format.channelCount = 0;
+    REQUIRE_FALSE(StreamSource(config).initialize());
+    std::filesystem::remove(path);
+}
+
+#ifndef _WIN32
+
+TEST_CASE("StreamSource - FIFO with reconnecting writers", "[stream]") {
+    const auto path = std::filesystem::temp_directory_path() / "openmeters-stream.fifo";
+    std::filesystem::remove(path);
+    REQUIRE(mkfifo(path.c_str(), 0600) == 0);
+
+    StreamSourceConfig config;
+    config.path = path.string();
+    config.format = {48000, 2};
+    config.sampleFormat = SampleFormat::Int16;
+    config.framesPerBlock = 100;
+    StreamSource source(config);
+    REQUIRE(source.initialize()); // No writer yet: must not block
+
+    SampleLog log;
+    source.registerCallback(&log);
+    REQUIRE(source.start());
+
+    // Two writers one after the other, each writing 150 frames
+    const auto writeOnce = [&](int offset) {
+        const int fd = open(path.c_str(), O_WRONLY);
+        REQUIRE(fd >= 0);
+        const std::vector<std::int16_t> samples = ramp(300, offset);
+        REQUIRE(write(fd, samples.data(), samples.size() * 2) == static_cast<ssize_t>(samples.size() * 2));
+        close(fd);
+    };
+    writeOnce(0);
+    REQUIRE(waitFor([&] { return log.m_sampleCount.load() == 300; }));
+    writeOnce(1000);
+    REQUIRE(waitFor([&] { return log.m_sampleCount.load() == 600; }));
+
+    // Each writer's tail arrives as a partial block when it closes
+    REQUIRE(log.m_blocks.load() == 4);
+    REQUIRE(log.m_samples[299] == 299);
+    REQUIRE(log.m_samples[300] == 1000);
+    REQUIRE(waitFor([&] { return source.reconnects() >= 1; }));
+    REQUIRE(source.isCapturing());
+
+    // An idle FIFO does not hold up stop()
+    const auto stopStart = std::chrono::steady_clock::now();
+    source.stop();
+    REQUIRE(std::chrono::steady_clock::now() - stopStart < std::chrono::seconds(2));
+
+    source.shutdown();
+    std::filesystem::remove(path);
+}
+
+#endif
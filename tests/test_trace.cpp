@@ -0,0 +1,125 @@
+#include <catch2/catch.hpp>
+#include "../../common/trace.h"
+#include <nlohmann/json.hpp>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <thread>
+
+using namespace openmeters;
+
+namespace {
+
+void innerWork() {
+    TRACE_ZONE("test.inner");
+    volatile int sink = 0;
+    for (int i = 0; i < 1000; ++i) {
+        sink = sink + i;
+    }
+}
+
+void outerWork() {
+    TRACE_ZONE("test.outer");
+    innerWork();
+    innerWork();
+}
+
+} // namespace
+
+TEST_CASE("Trace - zones export as Chrome trace events", "[trace]") {
+#ifndef OPENMETERS_TRACING
+    WARN("Built with OPENMETERS_TRACING=OFF; zones are compiled out");
+    return;
+#endif
+
+    common::trace::disable();
+    common::trace::clear();
+
+    // Nothing is recorded while disabled
+    outerWork();
+
+    common::trace::enable();
+    common::trace::registerThread("test-main");
+    outerWork();
+    std::thread worker([] {
+        common::trace::registerThread("test-worker");
+        outerWork();
+    });
+    worker.join();
+    common::trace::disable();
+
+    const auto path = std::filesystem::temp_directory_path() / "openmeters-trace.json";
+    REQUIRE(common::trace::exportChromeTrace(path.string()) == 6);
+
+    nlohmann::json trace;
+    std::ifstream(path) >> trace;
+    std::filesystem::remove(path);
+
+    std::map<std::string, int> zoneCounts;
+    std::map<int, std::string> threadNames;
+    double outerDuration = 0.0;
+    double innerDuration = 0.0;
+    for (const auto& event : trace["traceEvents"]) {
+        if (event["ph"] == "M") {
+            threadNames[event["tid"].get<int>()] = event["args"]["name"].get<std::string>();
+            continue;
+        }
+        REQUIRE(event["ph"] == "X");
+        const auto name = event["name"].get<std::string>();
+        ++zoneCounts[name];
+        (name == "test.outer" ? outerDuration : innerDuration) += event["dur"].get<double>();
+    }
+
+    REQUIRE(zoneCounts["test.outer"] == 2);
+    REQUIRE(zoneCounts["test.inner"] == 4);
+    REQUIRE(outerDuration >= innerDuration); // Outer zones enclose the inner ones
+
+    bool sawWorker = false;
+    for (const auto& [tid, name] : threadNames) {
+        sawWorker = sawWorker || name == "test-worker";
+    }
+    REQUIRE(sawWorker);
+}
+
+TEST_CASE("Trace - a reused thread ring starts empty", "[trace]") {
+#ifndef OPENMETERS_TRACING
+    WARN("Built with OPENMETERS_TRACING=OFF; zones are compiled out");
+    return;
+#endif
+
+    common::trace::disable();
+    common::trace::clear();
+    common::trace::enable();
+    std::thread first([] {
+        common::trace::registerThread("test-first");
+        outerWork();
+    });
+    first.join();
+
+    // Takes over the finished thread's ring
+    std::thread second([] {
+        common::trace::registerThread("test-second");
+        innerWork();
+    });
+    second.join();
+    common::trace::disable();
+
+    const auto path = std::filesystem::temp_directory_path() / "openmeters-trace-reuse.json";
+    REQUIRE(common::trace::exportChromeTrace(path.string()) == 1);
+
+    nlohmann::json trace;
+    std::ifstream(path) >> trace;
+    std::filesystem::remove(path);
+
+    std::map<int, std::string> threadNames;
+    std::map<std::string, std::string> zoneThreads;
+    for (const auto& event : trace["traceEvents"]) {
+        if (event["ph"] == "M") {
+            threadNames[event["tid"].get<int>()] = event["args"]["name"].get<std::string>();
+        } else {
+            zoneThreads[event["name"].get<std::string>()] = threadNames[event["tid"].get<int>()];
+        }
+    }
+    REQUIRE(zoneThreads.size() == 1);
+    REQUIRE(zoneThreads["test.inner"] == "test-second");
+}
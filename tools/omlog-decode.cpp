@@ -0,0 +1,84 @@
+// Decodes a binary log ring (Logger::openBinaryLog) into text, oldest first.
+//
+// Usage: omlog_decode <ring file> [--min-level 0-4]
+
+#include "../common/log-ring.h"
+#include "../common/mapped-file.h"
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <string>
+
+using namespace openmeters;
+
+namespace {
+
+const char* levelName(std::uint8_t level) {
+    switch (level) {
+        case 0:  return "DEBUG";
+        case 1:  return "INFO ";
+        case 2:  return "WARN ";
+        case 3:  return "ERROR";
+        case 4:  return "FATAL";
+        default: return "UNKNOWN";
+    }
+}
+
+// Same layout as the text log: [TIMESTAMP] [LEVEL] [FILE:LINE] MESSAGE
+void printRecord(const common::LogRingRecord& record) {
+    const std::time_t seconds = static_cast<std::time_t>(record.timeNs / 1000000000);
+    const int millis = static_cast<int>((record.timeNs / 1000000) % 1000);
+    char timestamp[32] = "?";
+    if (const std::tm* local = std::localtime(&seconds)) {
+        std::strftime(timestamp, sizeof(timestamp), "%Y-%m-%d %H:%M:%S", local);
+    }
+
+    std::printf("[%s.%03d] [%s]", timestamp, millis, levelName(record.level));
+    if (!record.file.empty()) {
+        std::printf(" [%s", record.file.c_str());
+        if (record.line > 0) {
+            std::printf(":%u", record.line);
+        }
+        std::printf("]");
+    }
+    std::printf(" %s%s\n", record.message.c_str(), record.truncated ? " [truncated]" : "");
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::string path;
+    int minLevel = 0;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--min-level" && i + 1 < argc) {
+            minLevel = std::atoi(argv[++i]);
+        } else if (path.empty() && arg.rfind("--", 0) != 0) {
+            path = arg;
+        } else {
+            path.clear();
+            break;
+        }
+    }
+    if (path.empty()) {
+        std::fprintf(stderr, "Usage: %s <ring file> [--min-level 0-4]\n", argv[0]);
+        return 2;
+    }
+
+    common::MappedFile file;
+    if (!file.open(path)) {
+        std::fprintf(stderr, "Failed to open %s\n", path.c_str());
+        return 1;
+    }
+
+    const long long records = common::LogRing::decode(file.data(), file.size(), [minLevel](const common::LogRingRecord& record) {
+        if (record.level >= minLevel) {
+            printRecord(record);
+        }
+    });
+    if (records < 0) {
+        std::fprintf(stderr, "%s is not a log ring\n", path.c_str());
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,99 @@
+// Converts a meter log (MeterLogger / MeterLogWriter) to CSV, oldest first.
+//
+// Usage: ommeter_csv <log file> [--from ms] [--to ms] [--linear] [--info]
+//
+// Levels are printed in dBFS (empty for silence) unless --linear is given.
+// --from/--to select [from, to) in the log's timestamps (ms since the
+// epoch for logs written by MeterLogger). --info prints the chunk index
+// to stderr instead.
+
+#include "../common/meter-log.h"
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <string>
+
+using namespace openmeters;
+
+namespace {
+
+void printLevel(float linear, bool asLinear) {
+    if (asLinear) {
+        std::printf(",%.6g", linear);
+    } else if (linear > 0.0f) {
+        std::printf(",%.2f", 20.0 * std::log10(static_cast<double>(linear)));
+    } else {
+        std::printf(",");
+    }
+}
+
+void printInfo(const common::MeterLogReader& reader) {
+    const common::MeterLogHeader& header = reader.header();
+    std::fprintf(stderr, "interval %u ms, step %.3f dB, %zu chunk(s), %llu entries%s\n",
+                 header.intervalMs, reader.dbStep(), reader.chunkCount(),
+                 static_cast<unsigned long long>(reader.entryCount()),
+                 reader.isComplete() ? "" : " (incomplete: no index)");
+    for (std::size_t i = 0; i < reader.chunkCount(); ++i) {
+        const common::MeterLogIndexEntry& chunk = reader.chunk(i);
+        std::fprintf(stderr, "  @%llu: %u entries, %llu - %llu ms\n",
+                     static_cast<unsigned long long>(chunk.offset), chunk.entryCount,
+                     static_cast<unsigned long long>(chunk.firstMs), static_cast<unsigned long long>(chunk.lastMs));
+    }
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::string path;
+    std::uint64_t fromMs = 0;
+    std::uint64_t toMs = std::numeric_limits<std::uint64_t>::max();
+    bool linear = false;
+    bool info = false;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--from" && i + 1 < argc) {
+            fromMs = std::strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--to" && i + 1 < argc) {
+            toMs = std::strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--linear") {
+            linear = true;
+        } else if (arg == "--info") {
+            info = true;
+        } else if (path.empty() && arg.rfind("--", 0) != 0) {
+            path = arg;
+        } else {
+            path.clear();
+            break;
+        }
+    }
+    if (path.empty()) {
+        std::fprintf(stderr, "Usage: %s <log file> [--from ms] [--to ms] [--linear] [--info]\n", argv[0]);
+        return 2;
+    }
+
+    common::MeterLogReader reader;
+    if (!reader.open(path)) {
+        std::fprintf(stderr, "%s is not a meter log\n", path.c_str());
+        return 1;
+    }
+    if (info) {
+        printInfo(reader);
+        return 0;
+    }
+
+    std::printf("time_ms,peak_left,peak_right,rms_left,rms_right\n");
+    const long long entries = reader.readRange(fromMs, toMs, [linear](const common::MeterLogEntry& entry) {
+        std::printf("%llu", static_cast<unsigned long long>(entry.timestampMs));
+        printLevel(entry.peak.left, linear);
+        printLevel(entry.peak.right, linear);
+        printLevel(entry.rms.left, linear);
+        printLevel(entry.rms.right, linear);
+        std::printf("\n");
+    });
+    if (entries < 0) {
+        std::fprintf(stderr, "%s is corrupt\n", path.c_str());
+        return 1;
+    }
+    return 0;
+}
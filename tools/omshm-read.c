@@ -0,0 +1,85 @@
+/*
+ * Prints the meter values another process publishes in shared memory
+ * (AppConfig::meterExportName), using only the C reader library.
+ *
+ * Usage: omshm_read [name] [--watch]
+ *
+ * --watch prints a line ten times a second until the exporter stops.
+ */
+
+#ifndef _WIN32
+#define _POSIX_C_SOURCE 200809L /* nanosleep in strict C builds */
+#endif
+
+#include "../client/openmeters-shm.h"
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#define om_sleep_ms(ms) Sleep(ms)
+#else
+#include <time.h>
+static void om_sleep_ms(long ms) {
+    struct timespec delay;
+    delay.tv_sec = ms / 1000;
+    delay.tv_nsec = (ms % 1000) * 1000000L;
+    nanosleep(&delay, NULL);
+}
+#endif
+
+static double to_db(float linear) {
+    return linear > 0.0f ? 20.0 * log10(linear) : -INFINITY;
+}
+
+static void print_frame(const om_meter_frame* frame, uint64_t sequence) {
+    printf("#%llu t=%llu ms  peak %6.1f %6.1f  level %6.1f %6.1f  rms %6.1f %6.1f dBFS\n",
+           (unsigned long long)sequence, (unsigned long long)frame->timestamp_ms,
+           to_db(frame->peak[0]), to_db(frame->peak[1]),
+           to_db(frame->level[0]), to_db(frame->level[1]),
+           to_db(frame->rms[0]), to_db(frame->rms[1]));
+}
+
+int main(int argc, char* argv[]) {
+    const char* name = NULL;
+    int watch = 0;
+    int i;
+    om_shm_reader reader;
+    om_meter_frame frame;
+    uint64_t sequence = 0;
+    int result;
+
+    for (i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--watch") == 0) {
+            watch = 1;
+        } else if (!name && strncmp(argv[i], "--", 2) != 0) {
+            name = argv[i];
+        } else {
+            fprintf(stderr, "Usage: %s [name] [--watch]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    result = om_shm_open(&reader, name);
+    if (result != OM_SHM_OK) {
+        fprintf(stderr, "%s\n", result == OM_SHM_NOT_FOUND ? "No meters published under that name"
+                                                           : "Not a compatible meter segment");
+        return 1;
+    }
+    printf("%u Hz, %u channel(s), writer pid %llu\n", reader.segment->sample_rate,
+           reader.segment->channel_count, (unsigned long long)reader.segment->writer_pid);
+
+    do {
+        result = om_shm_read(&reader, &frame, &sequence);
+        if (result != OM_SHM_BUSY) {
+            print_frame(&frame, sequence);
+        }
+        if (watch && result == OM_SHM_OK) {
+            om_sleep_ms(100);
+        }
+    } while (watch && result != OM_SHM_STOPPED);
+
+    om_shm_close(&reader);
+    return 0;
+}
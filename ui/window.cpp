@@ -1,12 +1,21 @@
 #include "window.h"
 #include "../common/logger.h"
 #include "../common/config.h"
+#include "../common/resource-monitor.h"
+#include "../common/trace.h"
 #include <imgui.h>
 #include <imgui_internal.h> // Required for direct DrawList access
 #include <imgui_impl_win32.h>
 #include <imgui_impl_dx11.h>
 #include <mutex>
 #include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <ctime>
+#include <chrono>
+#include <iomanip>
+#include <sstream>
+#include <string>
 
 #ifdef _WIN32
 #include <windows.h>
@@ -18,8 +27,48 @@ extern IMGUI_IMPL_API LRESULT ImGui_ImplWin32_WndProcHandler(HWND hWnd, UINT msg
 
 namespace openmeters::ui {
 
+namespace {
+
+// Audio kept before and after an over when dumping it
+constexpr double kOverDumpMarginSeconds = 2.0;
+
+// History graph: 10 s of 10 ms buckets
+constexpr std::size_t kGraphBuckets = 1000;
+
+// Recording formats offered in the settings window (config name, label, encoding)
+constexpr const char* kRecordingFormats[] = {"float32", "int24", "int16"};
+constexpr const char* kRecordingFormatLabels[] = {"32-bit Float", "24-bit", "16-bit"};
+constexpr core::audio::SampleFormat kRecordingSampleFormats[] = {
+    core::audio::SampleFormat::Float32,
+    core::audio::SampleFormat::Int24Packed,
+    core::audio::SampleFormat::Int16
+};
+
+// A settings edit worth publishing: discrete widgets when they change,
+// sliders when released rather than on every frame of a drag. Call right
+// after the widget.
+bool committed(bool changed) {
+    return (changed && !ImGui::IsItemActive()) || ImGui::IsItemDeactivatedAfterEdit();
+}
+
+int recordingFormatIndex(const std::string& name) {
+    for (int i = 0; i < 3; ++i) {
+        if (name == kRecordingFormats[i]) {
+            return i;
+        }
+    }
+    return 0;
+}
+
+} // namespace
+
 Window::Window() {
-    m_config = common::ConfigManager::get();
+    const common::ConfigManager::ReadGuard guard;
+    m_config = guard.config();
+    m_configVersion = guard.snapshot().version;
+    m_graphBuckets.resize(kGraphBuckets);
+    m_graphPeak.resize(kGraphBuckets);
+    m_graphRms.resize(kGraphBuckets);
 }
 
 Window::~Window() {
@@ -173,6 +222,8 @@ bool Window::initializeImGui() {
 
 void Window::run() {
     MSG msg = {};
+    common::trace::registerThread("ui");
+    common::ResourceMonitor::registerCurrentThread(common::ThreadRole::Ui);
     
     while (!m_shouldClose) {
         // Process Windows messages
@@ -188,15 +239,31 @@ void Window::run() {
             break;
         }
         
+        // Pick up settings reloaded from disk
+        syncConfig();
+        pollOvers();
+        
         // Render frame
         renderFrame();
         
-        // Sleep to limit CPU usage
-        Sleep(16); // ~60 FPS
+        // Wait out the frame interval (meterUpdateRate frames per second, or
+        // idleUpdateRate while the input is silent and settings are closed);
+        // input and the engine leaving idle end the wait early
+        bool idle = false;
+        {
+            std::lock_guard<std::mutex> lock(m_meterMutex);
+            idle = m_currentSnapshot.idle;
+        }
+        const float frameRate = idle && !m_showSettings
+            ? std::min(m_config.idleUpdateRate, m_config.meterUpdateRate)
+            : m_config.meterUpdateRate;
+        MsgWaitForMultipleObjects(0, nullptr, FALSE, static_cast<DWORD>(1000.0f / std::max(0.1f, frameRate)), QS_ALLINPUT);
     }
 }
 
 void Window::renderFrame() {
+    TRACE_ZONE("renderFrame");
+    
     // Start ImGui frame
     ImGui_ImplDX11_NewFrame();
     ImGui_ImplWin32_NewFrame();
@@ -223,6 +290,18 @@ void Window::renderFrame() {
     
     // Present
     m_swapChain->Present(1, 0); // VSync
+    
+    reportDisplayLatency();
+}
+
+void Window::reportDisplayLatency() {
+    // Present has returned: the values drawn this frame are on their way to
+    // the screen. Count each snapshot once, at its first presentation.
+    if (!m_engine || m_displayedCaptureNs == 0 || m_displayedCaptureNs == m_reportedCaptureNs) {
+        return;
+    }
+    m_engine->recordDisplayLatency(m_displayedCaptureNs);
+    m_reportedCaptureNs = m_displayedCaptureNs;
 }
 
 void Window::renderMeters() {
@@ -232,6 +311,7 @@ void Window::renderMeters() {
         std::lock_guard<std::mutex> lock(m_meterMutex);
         snapshot = m_currentSnapshot;
     }
+    m_displayedCaptureNs = snapshot.captureTimeNs;
     
     // Create main window (no title bar, no background)
     ImGuiWindowFlags flags = 
@@ -270,8 +350,26 @@ void Window::renderMeters() {
     // Draw peak meters
     if (m_config.showPeakMeter) {
         ImGui::Text("Peak");
-        drawMeter("##PeakL", snapshot.peak.left, ImVec2(-1, 20));
-        drawMeter("##PeakR", snapshot.peak.right, ImVec2(-1, 20));
+        drawMeter("##PeakL", snapshot.level.left, snapshot.peakHold.left, ImVec2(-1, 20));
+        drawMeter("##PeakR", snapshot.level.right, snapshot.peakHold.right, ImVec2(-1, 20));
+        
+        // Over indicator: latched until clicked
+        if (m_overCounts[0] > 0 || m_overCounts[1] > 0) {
+            ImGui::PushStyleColor(ImGuiCol_Button, ImVec4(0.85f, 0.0f, 0.0f, 1.0f));
+            char label[64];
+            std::snprintf(label, sizeof(label), "OVER  L %llu  R %llu",
+                          static_cast<unsigned long long>(m_overCounts[0]),
+                          static_cast<unsigned long long>(m_overCounts[1]));
+            if (ImGui::Button(label)) {
+                m_overCounts[0] = 0;
+                m_overCounts[1] = 0;
+            }
+            ImGui::PopStyleColor();
+        }
+    }
+    
+    if (m_recorder && m_recorder->isRecording()) {
+        ImGui::TextColored(ImVec4(1.0f, 0.2f, 0.2f, 1.0f), "REC");
     }
     
     ImGui::Spacing();
@@ -279,8 +377,12 @@ void Window::renderMeters() {
     // Draw RMS meters
     if (m_config.showRmsMeter) {
         ImGui::Text("RMS");
-        drawMeter("##RmsL", snapshot.rms.left, ImVec2(-1, 20));
-        drawMeter("##RmsR", snapshot.rms.right, ImVec2(-1, 20));
+        drawMeter("##RmsL", snapshot.rms.left, 0.0f, ImVec2(-1, 20));
+        drawMeter("##RmsR", snapshot.rms.right, 0.0f, ImVec2(-1, 20));
+    }
+    
+    if (m_config.showHistoryGraph) {
+        renderHistoryGraph();
     }
     
     // Settings button
@@ -315,7 +417,7 @@ void Window::setupStyle() {
     colors[ImGuiCol_ButtonActive] = ImVec4(0.45f, 0.45f, 0.45f, 1.00f);
 }
 
-void Window::drawMeter(const char* label, float value, const ImVec2& size) {
+void Window::drawMeter(const char* label, float value, float hold, const ImVec2& size) {
     ImGuiWindow* window = ImGui::GetCurrentWindow();
     if (window->SkipItems) return;
     
@@ -367,21 +469,131 @@ void Window::drawMeter(const char* label, float value, const ImVec2& size) {
             );
         }
     }
+    
+    // Peak hold marker
+    if (hold > 0.0f) {
+        const float h = std::clamp(hold, 0.0f, 1.0f);
+        const float x = bb.Min.x + style.FramePadding.x + h * (actualSize.x - style.FramePadding.x * 2);
+        window->DrawList->AddLine(
+            ImVec2(x, bb.Min.y + style.FramePadding.y),
+            ImVec2(x, bb.Max.y - style.FramePadding.y),
+            IM_COL32(255, 255, 255, 220),
+            2.0f
+        );
+    }
 }
 
 void Window::renderSettings() {
     ImGui::Begin("Settings", &m_showSettings);
+    bool edited = false;
+    
+    edited |= committed(ImGui::Checkbox("Always On Top", &m_config.alwaysOnTop));
+    edited |= committed(ImGui::Checkbox("Show Peak Meter", &m_config.showPeakMeter));
+    edited |= committed(ImGui::Checkbox("Show RMS Meter", &m_config.showRmsMeter));
+    edited |= committed(ImGui::Checkbox("Show History Graph", &m_config.showHistoryGraph));
+    edited |= committed(ImGui::Checkbox("Dark Mode", &m_config.darkMode));
+    
+    edited |= committed(ImGui::SliderFloat("UI Scale", &m_config.uiScale, 0.5f, 2.0f));
+    edited |= committed(ImGui::SliderFloat("Meter Update Rate", &m_config.meterUpdateRate, 30.0f, 120.0f));
+    edited |= committed(ImGui::SliderFloat("Peak Decay", &m_config.meterDecayRate, 0.5f, 1.0f));
+    
+    // Ballistics (PPM and VU timings are fixed by their standards)
+    static const char* const kBallistics[] = {"digital", "ppm1", "ppm2", "vu"};
+    static const char* const kBallisticsLabels[] = {"Digital Peak", "PPM Type I", "PPM Type II", "VU"};
+    int ballistics = 0;
+    for (int i = 0; i < 4; ++i) {
+        if (m_config.meterBallistics == kBallistics[i]) {
+            ballistics = i;
+        }
+    }
+    if (ImGui::Combo("Ballistics", &ballistics, kBallisticsLabels, 4)) {
+        m_config.meterBallistics = kBallistics[ballistics];
+        edited = true;
+    }
+    if (ballistics == 0) {
+        edited |= committed(ImGui::SliderFloat("Attack (ms)", &m_config.meterAttackMs, 0.0f, 20.0f));
+        edited |= committed(ImGui::SliderFloat("Release (dB/s)", &m_config.meterReleaseDbPerSecond, 5.0f, 60.0f));
+    }
+    edited |= committed(ImGui::SliderFloat("Peak Hold (ms)", &m_config.meterHoldMs, 0.0f, 5000.0f));
+    
+    // RMS integration time: fast, standard (VU-like) and slow
+    static const float kRmsWindows[] = {50.0f, 300.0f, 3000.0f};
+    static const char* const kRmsWindowLabels[] = {"50 ms", "300 ms", "3 s"};
+    int rmsWindow = 1;
+    for (int i = 0; i < 3; ++i) {
+        if (m_config.rmsWindowMs == kRmsWindows[i]) {
+            rmsWindow = i;
+        }
+    }
+    if (ImGui::Combo("RMS Window", &rmsWindow, kRmsWindowLabels, 3)) {
+        m_config.rmsWindowMs = kRmsWindows[rmsWindow];
+        edited = true;
+    }
+    edited |= committed(ImGui::SliderFloat("Over Threshold (dBFS)", &m_config.overThresholdDb, -3.0f, 0.0f));
+    edited |= committed(ImGui::SliderInt("Over Samples", &m_config.overSampleCount, 1, 10));
+    edited |= committed(ImGui::Checkbox("Save Audio Around Overs", &m_config.historyDumpOnOver));
+    if (m_history && ImGui::Button("Save History")) {
+        m_history->requestDumpLast(m_config.historyDumpDir + "/history-" + std::to_string(m_history->position()) + ".wav",
+                                   static_cast<double>(m_history->capacityFrames()) / m_history->format().sampleRate);
+    }
     
-    ImGui::Checkbox("Always On Top", &m_config.alwaysOnTop);
-    ImGui::Checkbox("Show Peak Meter", &m_config.showPeakMeter);
-    ImGui::Checkbox("Show RMS Meter", &m_config.showRmsMeter);
-    ImGui::Checkbox("Dark Mode", &m_config.darkMode);
+    // Recording (the format applies from the next take)
+    int recordingFormat = recordingFormatIndex(m_config.recordingFormat);
+    if (ImGui::Combo("Record Format", &recordingFormat, kRecordingFormatLabels, 3)) {
+        m_config.recordingFormat = kRecordingFormats[recordingFormat];
+        edited = true;
+    }
+    if (m_recorder) {
+        if (!m_recorder->isRecording()) {
+            if (ImGui::Button("Record")) {
+                startRecording();
+            }
+        } else {
+            if (ImGui::Button("Stop Recording")) {
+                m_recorder->stop();
+            }
+            ImGui::SameLine();
+            ImGui::Text("%.0f s", static_cast<double>(m_recorder->framesWritten()) / m_recorder->format().sampleRate);
+            if (m_recorder->droppedFrames() > 0) {
+                ImGui::SameLine();
+                ImGui::TextColored(ImVec4(1.0f, 0.3f, 0.3f, 1.0f), "%llu frames dropped",
+                                   static_cast<unsigned long long>(m_recorder->droppedFrames()));
+            }
+        }
+    }
+    
+    // Committed edits go live at once (the engine reads the snapshot per
+    // packet). A reload that landed since syncConfig() wins over the working
+    // copy; the next frame picks it up.
+    std::uint64_t publishedVersion = 0;
+    if (edited) {
+        if (common::ConfigManager::publishIfVersion(m_configVersion, m_config, &publishedVersion)) {
+            m_configVersion = publishedVersion;
+        } else {
+            LOG_INFO("Config reloaded while editing settings; edit discarded");
+        }
+    }
     
-    ImGui::SliderFloat("UI Scale", &m_config.uiScale, 0.5f, 2.0f);
-    ImGui::SliderFloat("Meter Update Rate", &m_config.meterUpdateRate, 30.0f, 120.0f);
+    // Capture-to-display latency (how stale the drawn meter is) and CPU use
+    if (m_engine) {
+        const auto stats = m_engine->getStats();
+        const auto& display = stats.display;
+        ImGui::Separator();
+        if (display.count > 0) {
+            ImGui::Text("Display latency: p50 %.1f ms, p99 %.1f ms, max %.1f ms",
+                static_cast<double>(display.p50) / 1e6,
+                static_cast<double>(display.p99) / 1e6,
+                static_cast<double>(display.max) / 1e6);
+        } else {
+            ImGui::TextUnformatted("Display latency: no data");
+        }
+        ImGui::Text("CPU: capture %.2f%%, ui %.2f%%, logger %.2f%%",
+            stats.resources.thread(common::ThreadRole::Capture).cpuPercent,
+            stats.resources.thread(common::ThreadRole::Ui).cpuPercent,
+            stats.resources.thread(common::ThreadRole::Logger).cpuPercent);
+    }
     
     if (ImGui::Button("Save")) {
-        common::ConfigManager::get() = m_config;
         common::ConfigManager::save();
         LOG_INFO("Settings saved");
     }
@@ -430,9 +642,94 @@ void Window::shutdown() {
     LOG_INFO("Window shutdown complete");
 }
 
+void Window::syncConfig() {
+    if (common::ConfigManager::version() == m_configVersion) {
+        return;
+    }
+    const common::ConfigManager::ReadGuard guard;
+    m_config = guard.config();
+    m_configVersion = guard.snapshot().version;
+}
+
+void Window::pollOvers() {
+    if (!m_engine) {
+        return;
+    }
+    common::OverEvent events[64];
+    std::uint64_t lost = 0;
+    while (const std::size_t count = m_engine->readOverEvents(m_overCursor, events, 64, &lost)) {
+        for (std::size_t i = 0; i < count; ++i) {
+            ++m_overCounts[std::min<std::size_t>(events[i].channel, 1)];
+            
+            // Keep the audio around the over (one file for overs close together)
+            if (m_history && m_config.historyDumpOnOver && events[i].position >= m_overDumpEnd) {
+                const std::uint64_t margin = static_cast<std::uint64_t>(kOverDumpMarginSeconds * m_history->format().sampleRate);
+                const std::uint64_t start = events[i].position > margin ? events[i].position - margin : 0;
+                m_history->requestDump(m_config.historyDumpDir + "/over-" + std::to_string(events[i].position) + ".wav",
+                                       start, static_cast<std::size_t>(events[i].position + margin - start));
+                m_overDumpEnd = events[i].position + margin;
+            }
+        }
+    }
+}
+
+void Window::setAudioEngine(core::audio::IAudioEngine* engine) {
+    m_engine = engine;
+}
+
+void Window::setAudioHistory(core::audio::AudioHistory* history) {
+    m_history = history;
+}
+
+void Window::setAudioRecorder(core::audio::AudioRecorder* recorder) {
+    m_recorder = recorder;
+}
+
+void Window::startRecording() {
+    const std::time_t now = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+    std::ostringstream name;
+    name << m_config.recordingDir << "/recording-" << std::put_time(std::localtime(&now), "%Y%m%d-%H%M%S") << ".wav";
+    m_recorder->start(name.str(), kRecordingSampleFormats[recordingFormatIndex(m_config.recordingFormat)]);
+}
+
 void Window::updateMeters(const common::MeterSnapshot& snapshot) {
-    std::lock_guard<std::mutex> lock(m_meterMutex);
-    m_currentSnapshot = snapshot;
+    bool resumed = false;
+    {
+        std::lock_guard<std::mutex> lock(m_meterMutex);
+        resumed = m_currentSnapshot.idle && !snapshot.idle;
+        m_currentSnapshot = snapshot;
+        m_meterHistory.add(snapshot);
+    }
+    if (resumed && m_hWnd) {
+        // The render loop may be in a long idle wait: end it now
+        PostMessageA(m_hWnd, WM_NULL, 0, 0);
+    }
+}
+
+void Window::renderHistoryGraph() {
+    std::size_t count = 0;
+    common::MeterAggregate lastMinute;
+    common::MeterAggregate lastHour;
+    {
+        std::lock_guard<std::mutex> lock(m_meterMutex);
+        count = m_meterHistory.copyBuckets(0, kGraphBuckets, m_graphBuckets.data());
+        lastMinute = m_meterHistory.queryLast(60 * 1000);
+        lastHour = m_meterHistory.queryLast(60 * 60 * 1000);
+    }
+    
+    // Louder channel per bucket; empty buckets (capture stopped) draw as silence
+    for (std::size_t i = 0; i < count; ++i) {
+        m_graphPeak[i] = m_graphBuckets[i].peakMax.getMax();
+        m_graphRms[i] = m_graphBuckets[i].rmsMean.getMax();
+    }
+    
+    ImGui::Text("History");
+    ImGui::PlotLines("##HistoryPeak", m_graphPeak.data(), static_cast<int>(count), 0, "Peak", 0.0f, 1.0f, ImVec2(-1, 40));
+    ImGui::PlotLines("##HistoryRms", m_graphRms.data(), static_cast<int>(count), 0, "RMS", 0.0f, 1.0f, ImVec2(-1, 40));
+    
+    const auto toDb = [](float value) { return value > 0.0f ? 20.0f * std::log10(value) : -120.0f; };
+    ImGui::Text("Max peak  1 min %.1f dB  1 h %.1f dB",
+                toDb(lastMinute.peakMax.getMax()), toDb(lastHour.peakMax.getMax()));
 }
 
 bool Window::shouldClose() const {
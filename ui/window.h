@@ -1,11 +1,16 @@
 #pragma once
 
 #include "../common/config.h"
+#include "../common/meter-history.h"
 #include "../common/meter-values.h"
+#include "../core/audio/audio-engine-interface.h"
+#include "../core/audio/audio-history.h"
+#include "../core/audio/audio-recorder.h"
 #include <windows.h>
 #include <d3d11.h>
 #include <memory>
 #include <mutex>
+#include <vector>
 
 // Forward declarations
 struct ImGuiContext;
@@ -57,6 +62,28 @@ public:
      */
     void updateMeters(const common::MeterSnapshot& snapshot);
     
+    /**
+     * Engine that receives capture-to-display latency after each Present
+     * and whose stats are shown in the settings window.
+     * 
+     * @param engine Audio engine (may be null; must outlive the window loop)
+     */
+    void setAudioEngine(core::audio::IAudioEngine* engine);
+    
+    /**
+     * Set the look-back history that "Save History" and over dumps read.
+     * 
+     * @param history Audio history (may be null; must outlive the window loop)
+     */
+    void setAudioHistory(core::audio::AudioHistory* history);
+    
+    /**
+     * Set the recorder driven by the Record button.
+     * 
+     * @param recorder Recorder (may be null; must outlive the window loop)
+     */
+    void setAudioRecorder(core::audio::AudioRecorder* recorder);
+    
     /**
      * Check if window should close.
      */
@@ -88,20 +115,46 @@ private:
      */
     void renderMeters();
     
+    /**
+     * Render the scrolling peak/RMS graph from the meter history.
+     */
+    void renderHistoryGraph();
+    
     /**
      * Render settings window.
      */
     void renderSettings();
     
+    /**
+     * Take the current config snapshot if it changed (file reload).
+     */
+    void syncConfig();
+    
+    /**
+     * Count the overs the engine detected since the last frame.
+     */
+    void pollOvers();
+    
+    /**
+     * Start a recording in the configured directory and format.
+     */
+    void startRecording();
+    
     /**
      * Setup custom ImGui style.
      */
     void setupStyle();
     
     /**
-     * Draw a segmented LED-style meter.
+     * Report the latency of the snapshot just presented (once per snapshot).
      */
-    void drawMeter(const char* label, float value, const ImVec2& size);
+    void reportDisplayLatency();
+    
+    /**
+     * Draw a segmented LED-style meter with a peak hold marker
+     * (hold <= 0 draws none).
+     */
+    void drawMeter(const char* label, float value, float hold, const ImVec2& size);
     
     /**
      * Window procedure.
@@ -128,9 +181,29 @@ private:
     // Meter data (protected by mutex)
     std::mutex m_meterMutex;
     common::MeterSnapshot m_currentSnapshot;
-    
-    // Configuration
+    common::MeterHistory m_meterHistory{common::MemoryTag::Ui}; // Every snapshot, for graphs
+    
+    // History graph (render thread only; sized once)
+    std::vector<common::MeterAggregate> m_graphBuckets;
+    std::vector<float> m_graphPeak;
+    std::vector<float> m_graphRms;
+    
+    // Capture-to-display latency (render thread only)
+    core::audio::IAudioEngine* m_engine = nullptr;
+    std::uint64_t m_displayedCaptureNs = 0; // Snapshot drawn this frame
+    std::uint64_t m_reportedCaptureNs = 0;  // Last snapshot reported to the engine
+    
+    // Overs (render thread only; counts latched until clicked)
+    std::uint64_t m_overCursor = 0;
+    std::uint64_t m_overCounts[2] = {};
+    core::audio::AudioHistory* m_history = nullptr;
+    std::uint64_t m_overDumpEnd = 0; // Overs before this are in the last over dump
+    core::audio::AudioRecorder* m_recorder = nullptr;
+    
+    // Configuration (working copy of the published snapshot; committed UI
+    // edits are published back unless a reload came first, reloads replace it)
     common::AppConfig m_config;
+    std::uint64_t m_configVersion = 0;
 };
 
 } // namespace openmeters::ui